@@ -52,7 +52,8 @@ module picaso_array #(
   parameter MAX_NET_LEVEL    = 3,    // how many levels of the binary tree to support (PE-node count = 2**MAX_LEVEL)
   parameter ID_WIDTH         = 8,    // width of the row/colum IDs
   parameter PE_CNT           = 16,   // Number of Processing-Elements in each block
-  parameter RF_DEPTH         = 1024  // Depth of the register-file (usually it's equal to register-width * register-count)
+  parameter RF_DEPTH         = 1024, // Depth of the register-file (usually it's equal to register-width * register-count)
+  parameter BOOTH_RADIX      = 2     // booth's encoding used by the ALUs for multiplication: 2 or 4
 ) (
   clk,
 
@@ -223,7 +224,8 @@ generate
             .CB_ROW_ID(g_row),
             .CB_COL_ID(g_col),
             .PE_CNT(PE_CNT),
-            .RF_DEPTH(RF_DEPTH) )
+            .RF_DEPTH(RF_DEPTH),
+            .BOOTH_RADIX(BOOTH_RADIX) )
           block (
             .clk(clk),
 
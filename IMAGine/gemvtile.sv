@@ -132,7 +132,8 @@ module gemvtile # (
           .MAX_NET_LEVEL(MAX_NET_LEVEL),
           .ID_WIDTH(ID_WIDTH),
           .PE_CNT(PE_CNT),
-          .RF_DEPTH(RF_DEPTH) )
+          .RF_DEPTH(RF_DEPTH),
+          .BOOTH_RADIX(BOOTH_RADIX) )
       picaso_arr2D (
         .clk(clk),
 
@@ -223,7 +224,8 @@ module gemvtile # (
       .PICASO_ID_WIDTH(ID_WIDTH),
       .TOKEN_WIDTH(CTRL_TOKEN_WIDTH),
       .PE_REG_WIDTH(PE_OPERAND_WIDTH),
-      .MAX_PRECISION(MAX_PRECISION) )
+      .MAX_PRECISION(MAX_PRECISION),
+      .BOOTH_RADIX(BOOTH_RADIX) )
     controller (
       .clk(clk),
       .instruction(ctrl_instruction),
@@ -34,6 +34,14 @@
   interfaces: FIFO-in, FIFO-out, and status registers. The clock domain
   crossing must be handled outside IMAGine, probably at the interface inputs.
 
+  Instructions from FIFO-in pass through a kernel cache before dispatch. A
+  kernel can be loaded into the cache once (KLOAD) and launched later with a
+  single instruction (KRUN), see _imagineIntf_kernelCache. A REPEAT instruction
+  dispatches the next instruction multiple times while incrementing one of its
+  fields, see _imagineIntf_repeatUnit. Before the repeat unit, a WRITE run
+  (WRUN) instruction is expanded into a run of WRITEs, see
+  _imagineIntf_writeRunDecoder.
+
 ================================================================================*/
 
 `timescale 1ns/100ps
@@ -191,6 +199,63 @@ module imagine_interface # (
   );
 
 
+  // -- Kernel cache
+  wire [IMAGINE_INSTR_WIDTH-1:0]      kcache_out_instruction;
+  wire                                kcache_out_valid;
+  wire                                kcache_out_next;
+
+  _imagineIntf_kernelCache #(.DEBUG(DEBUG))
+    kcache (
+      .clk(clk),
+      // top-level IOs
+      .in_instruction(instruction),
+      .in_valid(instructionValid),
+      .in_next(instructionNext),
+      // signals for the fetch-dispatch unit
+      .out_instruction(kcache_out_instruction),
+      .out_valid(kcache_out_valid),
+      .out_next(kcache_out_next)
+    );
+
+
+  // -- WRITE run decoder
+  wire [IMAGINE_INSTR_WIDTH-1:0]      wrun_out_instruction;
+  wire                                wrun_out_valid;
+  wire                                wrun_out_next;
+
+  _imagineIntf_writeRunDecoder #(.DEBUG(DEBUG))
+    wrunDecoder (
+      .clk(clk),
+      // instruction stream from the kernel cache
+      .in_instruction(kcache_out_instruction),
+      .in_valid(kcache_out_valid),
+      .in_next(kcache_out_next),
+      // signals for the repeat unit
+      .out_instruction(wrun_out_instruction),
+      .out_valid(wrun_out_valid),
+      .out_next(wrun_out_next)
+    );
+
+
+  // -- Repeat unit
+  wire [IMAGINE_INSTR_WIDTH-1:0]      repeat_out_instruction;
+  wire                                repeat_out_valid;
+  wire                                repeat_out_next;
+
+  _imagineIntf_repeatUnit #(.DEBUG(DEBUG))
+    rptUnit (
+      .clk(clk),
+      // instruction stream from the WRITE run decoder
+      .in_instruction(wrun_out_instruction),
+      .in_valid(wrun_out_valid),
+      .in_next(wrun_out_next),
+      // signals for the fetch-dispatch unit
+      .out_instruction(repeat_out_instruction),
+      .out_valid(repeat_out_valid),
+      .out_next(repeat_out_next)
+    );
+
+
   // -- Fetch and Dispatch unit
   wire [PICASO_INSTR_WORD_WIDTH-1:0]  fdUnit_gemvarr_instruction; 
   wire                                fdUnit_gemvarr_inputValid;
@@ -201,10 +266,10 @@ module imagine_interface # (
 
   _imagineIntf_fetchDispatch #(.DEBUG(DEBUG))
     fdUnit (
-      // top-level IOs
-      .instruction(instruction),
-      .instructionValid(instructionValid),
-      .instructionNext(instructionNext),
+      // instruction stream from the repeat unit
+      .instruction(repeat_out_instruction),
+      .instructionValid(repeat_out_valid),
+      .instructionNext(repeat_out_next),
       // signals for gemvarray_interface
       .gemvarr_instruction(fdUnit_gemvarr_instruction),
       .gemvarr_inputValid(fdUnit_gemvarr_inputValid),
@@ -355,6 +420,438 @@ endmodule
 
 
 
+// This is a submodule of IMAGine interface. This is not supposed to be Reusable.
+// This module sits between FIFO-in and the fetch-dispatch unit. It keeps an
+// instruction memory where the host can store kernels, so that a kernel is
+// streamed over FIFO-in only once and then launched with one KRUN instruction.
+//   - PASS: instructions are forwarded as-is; KCACHE instructions are consumed here.
+//   - LOAD: the next LENGTH instructions of FIFO-in are written to the cache.
+//   - RUN : the cached instructions are dispatched; FIFO-in is stalled until
+//           the last one is consumed, so the instruction order is preserved.
+// AK-NOTE: A cached kernel must not contain KCACHE instructions, the
+// fetch-dispatch unit does not accept them and the stream would stall.
+// AK-NOTE: The data words of a WRUN are arbitrary, a data word can look like
+// a KCACHE instruction. So, the WRUN headers are tracked in PASS, and their
+// data words (ceil(popcount(MASK)/2) of them) are forwarded without decoding.
+module _imagineIntf_kernelCache #(
+  parameter DEBUG = 1
+)  (
+  clk,
+  in_instruction,
+  in_valid,
+  in_next,
+  // signals for the fetch-dispatch unit
+  out_instruction,
+  out_valid,
+  out_next
+);
+
+
+  `include "imagine_interface.svh"
+  `include "ak_macros.v"
+
+  localparam INSTR_WIDTH = IMAGINE_INSTR_WIDTH,
+             OP_WIDTH    = IMAGINE_KCACHE_OP_WIDTH,
+             ID_WIDTH    = IMAGINE_KCACHE_ID_WIDTH,
+             LEN_WIDTH   = IMAGINE_KCACHE_LEN_WIDTH,
+             ADDR_WIDTH  = IMAGINE_KCACHE_ADDR_WIDTH,
+             MASK_WIDTH  = IMAGINE_WRUN_MASK_WIDTH,
+             SUBMODULE_CODE_WIDTH = IMAGINE_SUBMODULE_CODE_WIDTH;
+
+  localparam CACHE_DEPTH  = 2**ADDR_WIDTH,
+             KERNEL_COUNT = 2**ID_WIDTH,
+             WDCNT_WIDTH  = $clog2(MASK_WIDTH/2 + 1);   // counts the data words of a WRUN
+
+  // validate assumptions
+  `AK_ASSERT2(SUBMODULE_CODE_WIDTH + OP_WIDTH + ID_WIDTH + 1 + LEN_WIDTH + ADDR_WIDTH == INSTR_WIDTH, Kernel_cache_instruction_width_mismatch)
+  `AK_ASSERT2(2**(LEN_WIDTH-1) >= CACHE_DEPTH, Kernel_length_cannot_cover_the_cache)
+
+  // -- Module IOs
+  input                         clk;
+  input  [INSTR_WIDTH-1:0]      in_instruction;
+  input                         in_valid;
+  output reg                    in_next;
+
+  output reg [INSTR_WIDTH-1:0]  out_instruction;
+  output reg                    out_valid;
+  input                         out_next;
+
+
+  // -- Extract the kernel cache instruction fields
+  wire [SUBMODULE_CODE_WIDTH-1:0] submoduleCode;
+  wire [OP_WIDTH-1:0]             kcOpcode;
+  wire [ID_WIDTH-1:0]             kcKernelID;
+  wire [LEN_WIDTH-1:0]            kcLength;
+  wire [ADDR_WIDTH-1:0]           kcBase;
+  wire                            isKcacheInstr;
+
+  assign submoduleCode = in_instruction[INSTR_WIDTH-1 -: SUBMODULE_CODE_WIDTH],
+         kcOpcode      = in_instruction[INSTR_WIDTH-SUBMODULE_CODE_WIDTH-1 -: OP_WIDTH],
+         kcKernelID    = in_instruction[INSTR_WIDTH-SUBMODULE_CODE_WIDTH-OP_WIDTH-1 -: ID_WIDTH],
+         kcLength      = in_instruction[ADDR_WIDTH +: LEN_WIDTH],
+         kcBase        = in_instruction[ADDR_WIDTH-1:0];
+  assign isKcacheInstr = (submoduleCode == IMAGINE_SUBMODULE_KCACHE_SELECT);
+
+
+  // -- WRUN data words
+  wire                   isWrunInstr;
+  wire [WDCNT_WIDTH-1:0] wrunWordCount;   // no. of data words following the WRUN at the head
+  reg  [WDCNT_WIDTH-1:0] wrunWords = 0;   // data words left to pass, 0: the head is an instruction
+
+  // no. of set bits of _mask
+  function automatic [WDCNT_WIDTH:0] fn_popcount;
+    input [MASK_WIDTH-1:0] _mask;
+
+    begin
+      fn_popcount = 0;    // initial value
+      for(int i=0; i<MASK_WIDTH; ++i)
+        fn_popcount = fn_popcount + _mask[i];
+    end
+  endfunction
+
+  assign isWrunInstr   = (submoduleCode == IMAGINE_SUBMODULE_REPEAT_SELECT) && in_instruction[IMAGINE_WRUN_FLAG_BIT],
+         wrunWordCount = (fn_popcount(in_instruction[MASK_WIDTH-1:0]) + 1'b1) >> 1;   // two rows per data word
+
+
+  // -- Kernel table: base address and length of each cached kernel
+  // AK-NOTE: It is small and read asynchronously, should map to LUT-RAMs.
+  reg [ADDR_WIDTH-1:0] ktab_base[KERNEL_COUNT];
+  reg [LEN_WIDTH-1:0]  ktab_length[KERNEL_COUNT];
+
+  initial begin
+    for(int i=0; i<KERNEL_COUNT; ++i) begin
+      ktab_base[i]   = 0;
+      ktab_length[i] = 0;   // running a kernel that was never loaded is a NOP
+    end
+  end
+
+
+  // -- Instruction memory
+  // AK-NOTE: The read is synchronous to map it into a BRAM. So, the address
+  // of the next instruction is presented one cycle ahead of its use.
+  (* ram_style = "block" *)
+  reg [INSTR_WIDTH-1:0] imem[CACHE_DEPTH];
+  reg [INSTR_WIDTH-1:0] imem_rdata;
+  reg [ADDR_WIDTH-1:0]  imem_raddr;
+  reg [ADDR_WIDTH-1:0]  imem_waddr;
+  reg                   imem_wen;
+
+  always@(posedge clk) begin
+    if(imem_wen) imem[imem_waddr] <= in_instruction;
+    imem_rdata <= imem[imem_raddr];
+  end
+
+
+  // -- Controller
+  typedef enum logic [1:0] {
+    STATE_PASS,
+    STATE_LOAD,
+    STATE_RUN
+  } state_t;
+
+  state_t state = STATE_PASS;
+  reg [ADDR_WIDTH-1:0] ptr = 0;         // write pointer in LOAD, read pointer in RUN
+  reg [LEN_WIDTH-1:0]  remaining = 0;   // no. of instructions left to load/run
+
+  // combinatorial outputs
+  always@* begin
+    out_instruction = in_instruction;   // default: forward FIFO-in
+    out_valid  = 1'b0;
+    in_next    = 1'b0;
+    imem_wen   = 1'b0;
+    imem_waddr = ptr;
+    imem_raddr = ktab_base[kcKernelID];   // prefetch the first instruction of a KRUN
+    case(state)
+      STATE_PASS: begin
+        if(isKcacheInstr && wrunWords == 0) begin
+          in_next = in_valid;     // consume the KCACHE instruction
+        end else begin
+          out_valid = in_valid;
+          in_next   = out_next;
+        end
+      end
+
+      STATE_LOAD: begin
+        in_next  = in_valid;      // every instruction goes to the cache
+        imem_wen = in_valid;
+      end
+
+      STATE_RUN: begin
+        out_instruction = imem_rdata;
+        out_valid  = 1'b1;
+        imem_raddr = out_next ? ptr + 1'b1 : ptr;
+      end
+
+      default: ;
+    endcase
+  end
+
+  // state update
+  always@(posedge clk) begin
+    case(state)
+      STATE_PASS: begin
+        if(wrunWords != 0) begin
+          if(in_valid && out_next) wrunWords <= wrunWords - 1'b1;   // a data word passed
+        end else if(in_valid && isWrunInstr) begin
+          if(out_next) wrunWords <= wrunWordCount;    // the header passed, its data words follow
+        end else if(in_valid && isKcacheInstr) begin
+          if(kcOpcode == IMAGINE_KCACHE_KLOAD) begin
+            ktab_base[kcKernelID]   <= kcBase;
+            ktab_length[kcKernelID] <= kcLength;
+            ptr       <= kcBase;
+            remaining <= kcLength;
+            if(kcLength != 0) state <= STATE_LOAD;
+          end else if(kcOpcode == IMAGINE_KCACHE_KRUN) begin
+            ptr       <= ktab_base[kcKernelID];
+            remaining <= ktab_length[kcKernelID];
+            if(ktab_length[kcKernelID] != 0) state <= STATE_RUN;
+          end
+        end
+      end
+
+      STATE_LOAD: begin
+        if(in_valid) begin
+          ptr       <= ptr + 1'b1;
+          remaining <= remaining - 1'b1;
+          if(remaining == 1) state <= STATE_PASS;
+        end
+      end
+
+      STATE_RUN: begin
+        if(out_next) begin
+          ptr       <= ptr + 1'b1;
+          remaining <= remaining - 1'b1;
+          if(remaining == 1) state <= STATE_PASS;
+        end
+      end
+
+      default: state <= STATE_PASS;
+    endcase
+  end
+
+
+endmodule
+
+
+
+
+// This is a submodule of IMAGine interface. This is not supposed to be Reusable.
+// This module sits between the kernel cache and the repeat unit. A WRUN
+// instruction is consumed here, followed by its data words; a GEMV array WRITE
+// is dispatched for each set bit of MASK (row BASE+i), taking the data from the
+// halves of the data words in order. It compresses the row-by-row WRITEs of the
+// loaders (two rows per word), on FIFO-in and in the kernel cache.
+// AK-NOTE: WRUN is expanded before the repeat unit, so a REPEAT right before a
+// WRUN applies to its first WRITE only.
+module _imagineIntf_writeRunDecoder #(
+  parameter DEBUG = 1
+)  (
+  clk,
+  in_instruction,
+  in_valid,
+  in_next,
+  // signals for the repeat unit
+  out_instruction,
+  out_valid,
+  out_next
+);
+
+
+  `include "imagine_interface.svh"
+  `include "picaso_instruction_decoder.inc.v"
+  `include "ak_macros.v"
+
+  localparam INSTR_WIDTH = IMAGINE_INSTR_WIDTH,
+             BASE_WIDTH  = IMAGINE_WRUN_BASE_WIDTH,
+             MASK_WIDTH  = IMAGINE_WRUN_MASK_WIDTH,
+             DATA_WIDTH  = PICASO_INSTR_DATA_WIDTH,
+             ROW_WIDTH   = $clog2(MASK_WIDTH),
+             SUBMODULE_CODE_WIDTH = IMAGINE_SUBMODULE_CODE_WIDTH;
+
+  // validate assumptions
+  `AK_ASSERT2(SUBMODULE_CODE_WIDTH + BASE_WIDTH + 3 + 1 + MASK_WIDTH == INSTR_WIDTH, WRUN_instruction_width_mismatch)
+  `AK_ASSERT2(BASE_WIDTH == PICASO_INSTR_ADDR_WIDTH, WRUN_base_must_match_the_WRITE_address)
+  `AK_ASSERT2(2*DATA_WIDTH == INSTR_WIDTH, Data_word_must_hold_two_rows)
+  `AK_ASSERT2(PICASO_INSTR_OPCODE_WIDTH + PICASO_INSTR_ADDR_WIDTH + DATA_WIDTH == PICASO_INSTR_WORD_WIDTH, WRITE_instruction_width_mismatch)
+
+  // -- Module IOs
+  input                         clk;
+  input  [INSTR_WIDTH-1:0]      in_instruction;
+  input                         in_valid;
+  output                        in_next;
+
+  output [INSTR_WIDTH-1:0]      out_instruction;
+  output                        out_valid;
+  input                         out_next;
+
+
+  // -- Extract the WRUN instruction fields
+  wire [SUBMODULE_CODE_WIDTH-1:0] submoduleCode;
+  wire [BASE_WIDTH-1:0]           wrunBase;
+  wire [MASK_WIDTH-1:0]           wrunMask;
+  wire                            isWrunInstr;
+
+  assign submoduleCode = in_instruction[INSTR_WIDTH-1 -: SUBMODULE_CODE_WIDTH],
+         wrunBase      = in_instruction[INSTR_WIDTH-SUBMODULE_CODE_WIDTH-1 -: BASE_WIDTH],
+         wrunMask      = in_instruction[MASK_WIDTH-1:0];
+  assign isWrunInstr = (submoduleCode == IMAGINE_SUBMODULE_REPEAT_SELECT) && in_instruction[IMAGINE_WRUN_FLAG_BIT];
+
+
+  // priority encoder: position of the lowest set bit of _mask, 0 if none
+  function automatic [ROW_WIDTH-1:0] fn_lowest_set;
+    input [MASK_WIDTH-1:0] _mask;
+
+    begin
+      fn_lowest_set = 0;    // initial value
+      for(int i=MASK_WIDTH-1; i>=0; --i)
+        if(_mask[i]) fn_lowest_set = i;
+    end
+  endfunction
+
+
+  // -- Run state
+  reg [BASE_WIDTH-1:0] base = 0;
+  reg [MASK_WIDTH-1:0] pending = 0;     // rows left to write, 0: no WRUN pending
+  reg                  upperHalf = 0;   // data of the current row is in the upper half of the data word
+
+  wire                  isArmed;        // the data word at the head belongs to a WRUN
+  wire                  isLast;         // current row is the last one of the WRUN
+  wire [MASK_WIDTH-1:0] nextPending;
+  wire [BASE_WIDTH-1:0] rowAddr;
+  wire [DATA_WIDTH-1:0] rowData;
+
+  assign isArmed     = (pending != 0),
+         nextPending = pending & (pending - 1'b1),    // clears the lowest set bit
+         isLast      = (nextPending == 0),
+         rowAddr     = base + fn_lowest_set(pending),
+         rowData     = upperHalf ? in_instruction[INSTR_WIDTH-1 -: DATA_WIDTH] : in_instruction[DATA_WIDTH-1:0];
+
+  always@(posedge clk) begin
+    if(in_valid && !isArmed && isWrunInstr) begin
+      // consume the WRUN and arm for its data words
+      base      <= wrunBase;
+      pending   <= wrunMask;
+      upperHalf <= 1'b0;
+    end else if(isArmed && out_next) begin
+      // the current row was written
+      pending   <= nextPending;
+      upperHalf <= !upperHalf;
+    end
+  end
+
+
+  // -- Outputs
+  // AK-NOTE: The WRUN instruction itself is never dispatched. A data word is
+  // popped after the WRITE of its upper half, or of the last row.
+  assign out_instruction = isArmed ? {IMAGINE_SUBMODULE_GEMVARR_SELECT, PICASO_WRITE, rowAddr, rowData} : in_instruction,
+         out_valid = in_valid && (isArmed || !isWrunInstr),
+         in_next   = (in_valid && !isArmed && isWrunInstr) || (out_next && (!isArmed || upperHalf || isLast));
+
+
+endmodule
+
+
+
+
+// This is a submodule of IMAGine interface. This is not supposed to be Reusable.
+// This module sits between the WRITE run decoder and the fetch-dispatch unit. A
+// REPEAT instruction is consumed here; the instruction following it is then
+// dispatched COUNT times, adding (STRIDE << SHIFT) to the instruction word
+// after each dispatch. It compresses the strided sequences of the assembler
+// macros (e.g. the fold sweep of block-level accumulation).
+// AK-NOTE: The increment is added to the entire word, the assembler must make
+// sure the field does not overflow into its neighbours. The repeated
+// instruction must be a GEMV array or vector-shift register instruction.
+module _imagineIntf_repeatUnit #(
+  parameter DEBUG = 1
+)  (
+  clk,
+  in_instruction,
+  in_valid,
+  in_next,
+  // signals for the fetch-dispatch unit
+  out_instruction,
+  out_valid,
+  out_next
+);
+
+
+  `include "imagine_interface.svh"
+  `include "ak_macros.v"
+
+  localparam INSTR_WIDTH  = IMAGINE_INSTR_WIDTH,
+             COUNT_WIDTH  = IMAGINE_REPEAT_COUNT_WIDTH,
+             SHIFT_WIDTH  = IMAGINE_REPEAT_SHIFT_WIDTH,
+             STRIDE_WIDTH = IMAGINE_REPEAT_STRIDE_WIDTH,
+             SUBMODULE_CODE_WIDTH = IMAGINE_SUBMODULE_CODE_WIDTH;
+
+  // validate assumptions
+  `AK_ASSERT2(SUBMODULE_CODE_WIDTH + COUNT_WIDTH + SHIFT_WIDTH + 1 + STRIDE_WIDTH == INSTR_WIDTH, Repeat_instruction_width_mismatch)
+  `AK_ASSERT2(2**SHIFT_WIDTH >= INSTR_WIDTH, Repeat_shift_cannot_cover_the_instruction)
+
+  // -- Module IOs
+  input                         clk;
+  input  [INSTR_WIDTH-1:0]      in_instruction;
+  input                         in_valid;
+  output                        in_next;
+
+  output [INSTR_WIDTH-1:0]      out_instruction;
+  output                        out_valid;
+  input                         out_next;
+
+
+  // -- Extract the REPEAT instruction fields
+  wire [SUBMODULE_CODE_WIDTH-1:0] submoduleCode;
+  wire [COUNT_WIDTH-1:0]          rptCount;
+  wire [SHIFT_WIDTH-1:0]          rptShift;
+  wire [STRIDE_WIDTH-1:0]         rptStride;
+  wire                            isRepeatInstr;
+
+  assign submoduleCode = in_instruction[INSTR_WIDTH-1 -: SUBMODULE_CODE_WIDTH],
+         rptCount      = in_instruction[INSTR_WIDTH-SUBMODULE_CODE_WIDTH-1 -: COUNT_WIDTH],
+         rptShift      = in_instruction[STRIDE_WIDTH+1 +: SHIFT_WIDTH],
+         rptStride     = in_instruction[STRIDE_WIDTH-1:0];
+  assign isRepeatInstr = (submoduleCode == IMAGINE_SUBMODULE_REPEAT_SELECT);
+
+
+  // -- Repeat state
+  (* extract_enable = "yes", extract_reset = "yes" *)
+  reg [COUNT_WIDTH-1:0] remaining = 0;    // dispatches left for the instruction at the head, 0: no REPEAT pending
+  reg [INSTR_WIDTH-1:0] increment = 0;    // STRIDE << SHIFT
+  reg [INSTR_WIDTH-1:0] offset = 0;       // added to the instruction at the head, 0 if no REPEAT pending
+
+  wire isArmed;     // a REPEAT is pending for the instruction at the head
+  wire isLast;      // current dispatch is the last one of the instruction at the head
+  assign isArmed = (remaining != 0),
+         isLast  = (remaining <= 1);
+
+  always@(posedge clk) begin
+    if(in_valid && !isArmed && isRepeatInstr) begin
+      // consume the REPEAT and arm for the next instruction
+      remaining <= rptCount;
+      increment <= {{(INSTR_WIDTH-STRIDE_WIDTH){1'b0}}, rptStride} << rptShift;
+      offset    <= 0;
+    end else if(isArmed && out_next) begin
+      // the instruction at the head was dispatched once more
+      remaining <= remaining - 1'b1;
+      offset    <= isLast ? '0 : offset + increment;
+    end
+  end
+
+
+  // -- Outputs
+  // AK-NOTE: The REPEAT instruction itself is never dispatched. The instruction
+  // at the head is popped only after its last dispatch.
+  assign out_instruction = in_instruction + offset,
+         out_valid = in_valid && (isArmed || !isRepeatInstr),
+         in_next   = (in_valid && !isArmed && isRepeatInstr) || (out_next && isLast);
+
+
+endmodule
+
+
+
+
 // This is a submodule of IMAGine interface. This is not supposed to be Reusable.
 // This module uses parts of the GEMV tile to mimic the controller state and generates
 // signals needed for synchronization.
@@ -408,7 +905,8 @@ module gemvarray_interface # (
       .PICASO_ID_WIDTH(ID_WIDTH),
       .TOKEN_WIDTH(CTRL_TOKEN_WIDTH),
       .PE_REG_WIDTH(PE_OPERAND_WIDTH),
-      .MAX_PRECISION(MAX_PRECISION) )
+      .MAX_PRECISION(MAX_PRECISION),
+      .BOOTH_RADIX(BOOTH_RADIX) )
     controller (
       .clk(clk),
       .instruction(ctrl_instruction),
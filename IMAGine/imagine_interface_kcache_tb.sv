@@ -0,0 +1,256 @@
+/*********************************************************************************
+* Copyright (c) 2024, Computer Systems Design Lab, University of Arkansas        *
+*                                                                                *
+* All rights reserved.                                                           *
+*                                                                                *
+* Permission is hereby granted, free of charge, to any person obtaining a copy   *
+* of this software and associated documentation files (the "Software"), to deal  *
+* in the Software without restriction, including without limitation the rights   *
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      *
+* copies of the Software, and to permit persons to whom the Software is          *
+* furnished to do so, subject to the following conditions:                       *
+*                                                                                *
+* The above copyright notice and this permission notice shall be included in all *
+* copies or substantial portions of the Software.                                *
+*                                                                                *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       *
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    *
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         *
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  *
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  *
+* SOFTWARE.                                                                      *
+**********************************************************************************
+
+==================================================================================
+
+  Version: v1.0
+
+  Description:
+  Testbench of the kernel cache of imagine_interface (_imagineIntf_kernelCache).
+  An instruction stream is built together with the stream the fetch-dispatch
+  unit must receive: pass-through words, KLOADs with their kernels, KRUNs
+  (also of empty and never-loaded kernels, back-to-back and after reloads)
+  and WRUNs whose data words look like KCACHE instructions. The stream is
+  played twice: without stalls, then with random gaps on FIFO-in and random
+  stalls of the fetch-dispatch unit. The output must match word by word.
+  Run with "make sim-kcache" from work/.
+
+================================================================================*/
+
+
+`timescale 1ns/100ps
+
+
+module imagine_interface_kcache_tb;
+
+  `include "imagine_interface.svh"
+
+  localparam INSTR_WIDTH  = IMAGINE_INSTR_WIDTH,
+             KERNEL_COUNT = 2**IMAGINE_KCACHE_ID_WIDTH,
+             REGION_SIZE  = 2**IMAGINE_KCACHE_ADDR_WIDTH / KERNEL_COUNT,   // cache words per kernel ID
+             OPS          = 400,
+             TIMEOUT      = 200000;
+
+
+  // ---- Instruction encoders
+  function automatic [INSTR_WIDTH-1:0] instrKload(input int id, input int len, input int base);
+    return {IMAGINE_SUBMODULE_KCACHE_SELECT, IMAGINE_KCACHE_KLOAD, 4'(id), 1'b0, 11'(len), 10'(base)};
+  endfunction
+
+  function automatic [INSTR_WIDTH-1:0] instrKrun(input int id);
+    return {IMAGINE_SUBMODULE_KCACHE_SELECT, IMAGINE_KCACHE_KRUN, 4'(id), 22'b0};
+  endfunction
+
+  function automatic [INSTR_WIDTH-1:0] instrWrun(input int base, input [15:0] mask);
+    return {IMAGINE_SUBMODULE_REPEAT_SELECT, 10'(base), 3'b0, 1'b1, mask};
+  endfunction
+
+  // a GEMV array, vector shift or REPEAT instruction, forwarded as-is
+  function automatic [INSTR_WIDTH-1:0] instrOther();
+    logic [INSTR_WIDTH-1:0] w = $urandom;
+    case($urandom % 3)
+      0: w[31:30] = IMAGINE_SUBMODULE_GEMVARR_SELECT;
+      1: w[31:30] = IMAGINE_SUBMODULE_VECSHIFT_SELECT;
+      default: begin
+        w[31:30] = IMAGINE_SUBMODULE_REPEAT_SELECT;
+        w[IMAGINE_WRUN_FLAG_BIT] = 1'b0;
+      end
+    endcase
+    return w;
+  endfunction
+
+  // a word of any kind, used as kernel contents and WRUN data
+  function automatic [INSTR_WIDTH-1:0] anyWord();
+    case($urandom % 4)
+      0: return instrKload($urandom % KERNEL_COUNT, $urandom % 64, $urandom % 1024);
+      1: return instrKrun($urandom % KERNEL_COUNT);
+      default: return $urandom;
+    endcase
+  endfunction
+
+
+  // ---- Input stream and the expected output stream
+  logic [INSTR_WIDTH-1:0] inWords[$];
+  logic [INSTR_WIDTH-1:0] expWords[$];
+  logic [INSTR_WIDTH-1:0] kernel[KERNEL_COUNT][$];   // cached contents, by kernel ID
+
+  task automatic opPass();
+    logic [INSTR_WIDTH-1:0] w = instrOther();
+    inWords.push_back(w);
+    expWords.push_back(w);
+  endtask
+
+  // each kernel ID loads into its own region, so that reloads do not overlap
+  task automatic opKload(input int id, input int len);
+    inWords.push_back(instrKload(id, len, id*REGION_SIZE));
+    kernel[id].delete();
+    for(int i=0; i<len; i++) begin
+      logic [INSTR_WIDTH-1:0] w = anyWord();    // never decoded while loading
+      inWords.push_back(w);
+      kernel[id].push_back(w);
+    end
+  endtask
+
+  task automatic opKrun(input int id);
+    inWords.push_back(instrKrun(id));
+    foreach(kernel[id][i]) expWords.push_back(kernel[id][i]);
+  endtask
+
+  task automatic opWrun(input [15:0] mask);
+    logic [INSTR_WIDTH-1:0] w = instrWrun($urandom % 1024, mask);
+    inWords.push_back(w);
+    expWords.push_back(w);
+    for(int i=0; i<($countones(mask) + 1)/2; i++) begin
+      w = anyWord();    // must pass without decoding
+      inWords.push_back(w);
+      expWords.push_back(w);
+    end
+  endtask
+
+  initial begin
+    void'($urandom(17));
+    // directed cases
+    opPass();
+    opKrun(3);                      // never loaded: NOP
+    opKload(0, 20);
+    opPass();
+    opKrun(0);
+    opKload(1, 1);
+    opKrun(1);
+    opKrun(0);                      // back-to-back
+    opKrun(1);
+    opKload(2, 0);                  // empty kernel
+    opKrun(2);
+    opWrun(16'h001F);               // 3 data words
+    opKrun(1);
+    opWrun(16'h0000);               // no data words
+    opKrun(1);
+    opKload(0, REGION_SIZE);        // reload with the largest region
+    opKrun(0);
+    // random operations
+    for(int op=0; op<OPS; op++) begin
+      case($urandom % 5)
+        0: opPass();
+        1: opKload($urandom % KERNEL_COUNT, $urandom % (REGION_SIZE+1));
+        2: opWrun($urandom);
+        default: opKrun($urandom % KERNEL_COUNT);
+      endcase
+    end
+    opPass();
+    // the stream is played twice, so it ends with the kernel table cleared
+    for(int id=0; id<KERNEL_COUNT; id++) opKload(id, 0);
+  end
+
+
+  // ---- Device under test
+  reg clk = 0;
+  always #5 clk = ~clk;
+
+  reg  [INSTR_WIDTH-1:0] in_instruction = 0;
+  reg                    in_valid = 0;
+  wire                   in_next;
+  wire [INSTR_WIDTH-1:0] out_instruction;
+  wire                   out_valid;
+  reg                    out_next = 0;
+
+  _imagineIntf_kernelCache #(
+      .DEBUG(0) )
+    dut (
+      .clk(clk),
+      .in_instruction(in_instruction),
+      .in_valid(in_valid),
+      .in_next(in_next),
+      .out_instruction(out_instruction),
+      .out_valid(out_valid),
+      .out_next(out_next)
+    );
+
+
+  // ---- FIFO-in and the fetch-dispatch unit
+  // Transfers happen at a posedge when valid and next are both set. The
+  // inputs of the next cycle are set with the gaps/stalls of the pass.
+  bit running = 0;
+  int stallPct = 0;       // percentage of cycles without input or dispatch
+  int inIdx = 0;
+  int outIdx = 0;
+  int errors = 0;
+
+  always @(posedge clk) begin
+    if(running) begin
+      if(in_valid && in_next) inIdx = inIdx + 1;
+      if(out_valid && out_next) begin
+        if(outIdx >= expWords.size()) begin
+          $display("EROR: extra output word %h", out_instruction);
+          errors = errors + 1;
+        end else if(out_instruction !== expWords[outIdx]) begin
+          $display("EROR: output word %0d is %h, expected %h", outIdx, out_instruction, expWords[outIdx]);
+          errors = errors + 1;
+        end
+        outIdx = outIdx + 1;
+      end
+      in_valid       <= inIdx < inWords.size() && ($urandom % 100) >= stallPct;
+      in_instruction <= inIdx < inWords.size() ? inWords[inIdx] : '0;
+      out_next       <= ($urandom % 100) >= stallPct;
+    end else begin
+      in_valid <= 0;
+      out_next <= 0;
+    end
+  end
+
+
+  // plays the whole stream, it leaves the cache in PASS with an empty kernel table
+  // @param stall  percentage of cycles with a gap on FIFO-in or a dispatch stall
+  task automatic playStream(input int stall);
+    int cycles = 0;
+    stallPct = stall;
+    inIdx = 0;
+    outIdx = 0;
+    @(negedge clk);
+    running = 1;
+    while((inIdx < inWords.size() || outIdx < expWords.size()) && cycles < TIMEOUT) begin
+      @(posedge clk);
+      cycles = cycles + 1;
+    end
+    repeat(16) @(posedge clk);    // no extra words
+    running = 0;
+    if(cycles >= TIMEOUT) begin
+      $display("EROR: stall %0d%%: timeout, %0d of %0d words in, %0d of %0d out",
+               stall, inIdx, inWords.size(), outIdx, expWords.size());
+      errors = errors + 1;
+    end
+    $display("INFO: stall %0d%%: %0d words in, %0d out, %0d cycles", stall, inWords.size(), expWords.size(), cycles);
+  endtask
+
+
+  initial begin
+    #1;     // after the streams are built
+    playStream(0);
+    playStream(30);
+    if(errors == 0) $display("PASS: kernel cache, %0d words in, %0d out", inWords.size(), expWords.size());
+    else            $display("FAIL: kernel cache, %0d errors", errors);
+    $finish;
+  end
+
+
+endmodule
@@ -0,0 +1,108 @@
+
+`timescale 1 ns / 1 ps
+
+	module imagine_gemv_v1_0 #
+	(
+		// Users to add parameters here
+    parameter GEMVARR_BLK_ROW_CNT  = 16,  // No. of PiCaSO block rows in the entire GEMV array
+    parameter GEMVARR_BLK_COL_CNT  =  4,  // No. of PiCaSO block columns in the entire GEMV array
+    parameter GEMVARR_TILE_ROW_CNT =  4,  // No. of PiCaSO block rows in a GEMV tile
+    parameter GEMVARR_TILE_COL_CNT =  2,  // No. of PiCaSO block columns in a GEMV tile
+
+		// User parameters ends
+		// Do not modify the parameters beyond this line
+
+
+		// Parameters of Axi Slave Bus Interface S00_AXI
+		parameter integer C_S00_AXI_DATA_WIDTH	= 32,
+		parameter integer C_S00_AXI_ADDR_WIDTH	= 6
+	)
+	(
+		// Users to add ports here
+		input wire imagine_clk,
+
+		// Ports of Axi-Stream Slave Bus Interface S00_AXIS (instruction stream into FIFO-in)
+		// AK-NOTE: clocked by s00_axi_aclk; TLAST is accepted but not used,
+		// instructions are a flat word stream.
+		input wire [31 : 0] s00_axis_tdata,
+		input wire  s00_axis_tlast,
+		input wire  s00_axis_tvalid,
+		output wire  s00_axis_tready,
+
+		// EOV interrupt request (level-sensitive, active high, enabled by reg2 bit 1)
+		output wire eov_irq,
+
+		// User ports ends
+		// Do not modify the ports beyond this line
+
+
+		// Ports of Axi Slave Bus Interface S00_AXI
+		input wire  s00_axi_aclk,
+		input wire  s00_axi_aresetn,
+		input wire [C_S00_AXI_ADDR_WIDTH-1 : 0] s00_axi_awaddr,
+		input wire [2 : 0] s00_axi_awprot,
+		input wire  s00_axi_awvalid,
+		output wire  s00_axi_awready,
+		input wire [C_S00_AXI_DATA_WIDTH-1 : 0] s00_axi_wdata,
+		input wire [(C_S00_AXI_DATA_WIDTH/8)-1 : 0] s00_axi_wstrb,
+		input wire  s00_axi_wvalid,
+		output wire  s00_axi_wready,
+		output wire [1 : 0] s00_axi_bresp,
+		output wire  s00_axi_bvalid,
+		input wire  s00_axi_bready,
+		input wire [C_S00_AXI_ADDR_WIDTH-1 : 0] s00_axi_araddr,
+		input wire [2 : 0] s00_axi_arprot,
+		input wire  s00_axi_arvalid,
+		output wire  s00_axi_arready,
+		output wire [C_S00_AXI_DATA_WIDTH-1 : 0] s00_axi_rdata,
+		output wire [1 : 0] s00_axi_rresp,
+		output wire  s00_axi_rvalid,
+		input wire  s00_axi_rready
+	);
+// Instantiation of Axi Bus Interface S00_AXI
+	imagine_gemv_v1_0_S00_AXI # ( 
+    // User parameters
+    .GEMVARR_BLK_ROW_CNT(GEMVARR_BLK_ROW_CNT),
+    .GEMVARR_BLK_COL_CNT(GEMVARR_BLK_COL_CNT),
+    .GEMVARR_TILE_ROW_CNT(GEMVARR_TILE_ROW_CNT),
+    .GEMVARR_TILE_COL_CNT(GEMVARR_TILE_COL_CNT),
+    // End of user parameters
+
+		.C_S_AXI_DATA_WIDTH(C_S00_AXI_DATA_WIDTH),
+		.C_S_AXI_ADDR_WIDTH(C_S00_AXI_ADDR_WIDTH)
+	) imagine_gemv_v1_0_S00_AXI_inst (
+	    // ---- User ports
+	    .imagine_clk(imagine_clk),
+	    .S_AXIS_TDATA(s00_axis_tdata),
+	    .S_AXIS_TVALID(s00_axis_tvalid),
+	    .S_AXIS_TREADY(s00_axis_tready),
+	    .EOV_IRQ(eov_irq),
+	    // ---- End of User ports
+		.S_AXI_ACLK(s00_axi_aclk),
+		.S_AXI_ARESETN(s00_axi_aresetn),
+		.S_AXI_AWADDR(s00_axi_awaddr),
+		.S_AXI_AWPROT(s00_axi_awprot),
+		.S_AXI_AWVALID(s00_axi_awvalid),
+		.S_AXI_AWREADY(s00_axi_awready),
+		.S_AXI_WDATA(s00_axi_wdata),
+		.S_AXI_WSTRB(s00_axi_wstrb),
+		.S_AXI_WVALID(s00_axi_wvalid),
+		.S_AXI_WREADY(s00_axi_wready),
+		.S_AXI_BRESP(s00_axi_bresp),
+		.S_AXI_BVALID(s00_axi_bvalid),
+		.S_AXI_BREADY(s00_axi_bready),
+		.S_AXI_ARADDR(s00_axi_araddr),
+		.S_AXI_ARPROT(s00_axi_arprot),
+		.S_AXI_ARVALID(s00_axi_arvalid),
+		.S_AXI_ARREADY(s00_axi_arready),
+		.S_AXI_RDATA(s00_axi_rdata),
+		.S_AXI_RRESP(s00_axi_rresp),
+		.S_AXI_RVALID(s00_axi_rvalid),
+		.S_AXI_RREADY(s00_axi_rready)
+	);
+
+	// Add user logic here
+
+	// User logic ends
+
+	endmodule
@@ -0,0 +1,713 @@
+
+`timescale 1 ns / 1 ps
+
+    module imagine_gemv_v1_0_S00_AXI #
+    (
+        // Users to add parameters here
+        parameter GEMVARR_BLK_ROW_CNT  = 16,    // No. of PiCaSO block rows in the entire GEMV array
+        parameter GEMVARR_BLK_COL_CNT  =  4,    // No. of PiCaSO block columns in the entire GEMV array
+        parameter GEMVARR_TILE_ROW_CNT =  4,    // No. of PiCaSO block rows in a GEMV tile
+        parameter GEMVARR_TILE_COL_CNT =  2,    // No. of PiCaSO block columns in a GEMV tile
+
+        // User parameters ends
+        // Do not modify the parameters beyond this line
+
+        // Width of S_AXI data bus
+        parameter integer C_S_AXI_DATA_WIDTH    = 32,
+        // Width of S_AXI address bus
+        parameter integer C_S_AXI_ADDR_WIDTH    = 6
+    )
+    (
+        // Users to add ports here
+        input wire imagine_clk,
+        // FIFO-in AXI-Stream slave, clocked by S_AXI_ACLK
+        input wire [31:0] S_AXIS_TDATA,
+        input wire  S_AXIS_TVALID,
+        output wire  S_AXIS_TREADY,
+        // EOV interrupt request, level-sensitive, active high
+        output wire EOV_IRQ,
+
+        // User ports ends
+        // Do not modify the ports beyond this line
+
+        // Global Clock Signal
+        input wire  S_AXI_ACLK,
+        // Global Reset Signal. This Signal is Active LOW
+        input wire  S_AXI_ARESETN,
+        // Write address (issued by master, acceped by Slave)
+        input wire [C_S_AXI_ADDR_WIDTH-1 : 0] S_AXI_AWADDR,
+        // Write channel Protection type. This signal indicates the
+            // privilege and security level of the transaction, and whether
+            // the transaction is a data access or an instruction access.
+        input wire [2 : 0] S_AXI_AWPROT,
+        // Write address valid. This signal indicates that the master signaling
+            // valid write address and control information.
+        input wire  S_AXI_AWVALID,
+        // Write address ready. This signal indicates that the slave is ready
+            // to accept an address and associated control signals.
+        output wire  S_AXI_AWREADY,
+        // Write data (issued by master, acceped by Slave) 
+        input wire [C_S_AXI_DATA_WIDTH-1 : 0] S_AXI_WDATA,
+        // Write strobes. This signal indicates which byte lanes hold
+            // valid data. There is one write strobe bit for each eight
+            // bits of the write data bus.    
+        input wire [(C_S_AXI_DATA_WIDTH/8)-1 : 0] S_AXI_WSTRB,
+        // Write valid. This signal indicates that valid write
+            // data and strobes are available.
+        input wire  S_AXI_WVALID,
+        // Write ready. This signal indicates that the slave
+            // can accept the write data.
+        output wire  S_AXI_WREADY,
+        // Write response. This signal indicates the status
+            // of the write transaction.
+        output wire [1 : 0] S_AXI_BRESP,
+        // Write response valid. This signal indicates that the channel
+            // is signaling a valid write response.
+        output wire  S_AXI_BVALID,
+        // Response ready. This signal indicates that the master
+            // can accept a write response.
+        input wire  S_AXI_BREADY,
+        // Read address (issued by master, acceped by Slave)
+        input wire [C_S_AXI_ADDR_WIDTH-1 : 0] S_AXI_ARADDR,
+        // Protection type. This signal indicates the privilege
+            // and security level of the transaction, and whether the
+            // transaction is a data access or an instruction access.
+        input wire [2 : 0] S_AXI_ARPROT,
+        // Read address valid. This signal indicates that the channel
+            // is signaling valid read address and control information.
+        input wire  S_AXI_ARVALID,
+        // Read address ready. This signal indicates that the slave is
+            // ready to accept an address and associated control signals.
+        output wire  S_AXI_ARREADY,
+        // Read data (issued by slave)
+        output wire [C_S_AXI_DATA_WIDTH-1 : 0] S_AXI_RDATA,
+        // Read response. This signal indicates the status of the
+            // read transfer.
+        output wire [1 : 0] S_AXI_RRESP,
+        // Read valid. This signal indicates that the channel is
+            // signaling the required read data.
+        output wire  S_AXI_RVALID,
+        // Read ready. This signal indicates that the master can
+            // accept the read data and response information.
+        input wire  S_AXI_RREADY
+    );
+
+    // AXI4LITE signals
+    reg [C_S_AXI_ADDR_WIDTH-1 : 0]  axi_awaddr;
+    reg     axi_awready;
+    reg     axi_wready;
+    reg [1 : 0]     axi_bresp;
+    reg     axi_bvalid;
+    reg [C_S_AXI_ADDR_WIDTH-1 : 0]  axi_araddr;
+    reg     axi_arready;
+    reg [C_S_AXI_DATA_WIDTH-1 : 0]  axi_rdata;
+    reg [1 : 0]     axi_rresp;
+    reg     axi_rvalid;
+
+    // Example-specific design signals
+    // local parameter for addressing 32 bit / 64 bit C_S_AXI_DATA_WIDTH
+    // ADDR_LSB is used for addressing 32/64 bit registers/memories
+    // ADDR_LSB = 2 for 32 bits (n downto 2)
+    // ADDR_LSB = 3 for 64 bits (n downto 3)
+    localparam integer ADDR_LSB = (C_S_AXI_DATA_WIDTH/32) + 1;
+    localparam integer OPT_MEM_ADDR_BITS = 3;
+    //----------------------------------------------
+    //-- Signals for user logic register space example
+    //------------------------------------------------
+    //-- Number of Slave Registers 16
+    reg [C_S_AXI_DATA_WIDTH-1:0]    slv_reg0;
+    reg [C_S_AXI_DATA_WIDTH-1:0]    slv_reg1;
+    reg [C_S_AXI_DATA_WIDTH-1:0]    slv_reg2;
+    reg [C_S_AXI_DATA_WIDTH-1:0]    slv_reg3;
+    reg [C_S_AXI_DATA_WIDTH-1:0]    slv_reg4;
+    reg [C_S_AXI_DATA_WIDTH-1:0]    slv_reg5;
+    reg [C_S_AXI_DATA_WIDTH-1:0]    slv_reg6;
+    reg [C_S_AXI_DATA_WIDTH-1:0]    slv_reg7;
+    // AK-NOTE: reg8 - reg15 are read-only without reset, setting their initial value.
+    reg [C_S_AXI_DATA_WIDTH-1:0]    slv_reg8  = 0;
+    reg [C_S_AXI_DATA_WIDTH-1:0]    slv_reg9  = 0;
+    reg [C_S_AXI_DATA_WIDTH-1:0]    slv_reg10 = 0;
+    reg [C_S_AXI_DATA_WIDTH-1:0]    slv_reg11 = 0;
+    reg [C_S_AXI_DATA_WIDTH-1:0]    slv_reg12 = 0;
+    reg [C_S_AXI_DATA_WIDTH-1:0]    slv_reg13 = 0;
+    reg [C_S_AXI_DATA_WIDTH-1:0]    slv_reg14 = 0;
+    reg [C_S_AXI_DATA_WIDTH-1:0]    slv_reg15 = 0;
+    wire     slv_reg_rden;
+    wire     slv_reg_wren;
+    reg [C_S_AXI_DATA_WIDTH-1:0]     reg_data_out;
+    integer  byte_index;
+    reg  aw_en;
+
+    // I/O Connections assignments
+
+    assign S_AXI_AWREADY    = axi_awready;
+    assign S_AXI_WREADY = axi_wready;
+    assign S_AXI_BRESP  = axi_bresp;
+    assign S_AXI_BVALID = axi_bvalid;
+    assign S_AXI_ARREADY    = axi_arready;
+    assign S_AXI_RDATA  = axi_rdata;
+    assign S_AXI_RRESP  = axi_rresp;
+    assign S_AXI_RVALID = axi_rvalid;
+    // Implement axi_awready generation
+    // axi_awready is asserted for one S_AXI_ACLK clock cycle when both
+    // S_AXI_AWVALID and S_AXI_WVALID are asserted. axi_awready is
+    // de-asserted when reset is low.
+
+    always @( posedge S_AXI_ACLK )
+    begin
+      if ( S_AXI_ARESETN == 1'b0 )
+        begin
+          axi_awready <= 1'b0;
+          aw_en <= 1'b1;
+        end 
+      else
+        begin    
+          if (~axi_awready && S_AXI_AWVALID && S_AXI_WVALID && aw_en)
+            begin
+              // slave is ready to accept write address when 
+              // there is a valid write address and write data
+              // on the write address and data bus. This design 
+              // expects no outstanding transactions. 
+              axi_awready <= 1'b1;
+              aw_en <= 1'b0;
+            end
+            else if (S_AXI_BREADY && axi_bvalid)
+                begin
+                  aw_en <= 1'b1;
+                  axi_awready <= 1'b0;
+                end
+          else           
+            begin
+              axi_awready <= 1'b0;
+            end
+        end 
+    end       
+
+    // Implement axi_awaddr latching
+    // This process is used to latch the address when both 
+    // S_AXI_AWVALID and S_AXI_WVALID are valid. 
+
+    always @( posedge S_AXI_ACLK )
+    begin
+      if ( S_AXI_ARESETN == 1'b0 )
+        begin
+          axi_awaddr <= 0;
+        end 
+      else
+        begin    
+          if (~axi_awready && S_AXI_AWVALID && S_AXI_WVALID && aw_en)
+            begin
+              // Write Address latching 
+              axi_awaddr <= S_AXI_AWADDR;
+            end
+        end 
+    end       
+
+    // Implement axi_wready generation
+    // axi_wready is asserted for one S_AXI_ACLK clock cycle when both
+    // S_AXI_AWVALID and S_AXI_WVALID are asserted. axi_wready is 
+    // de-asserted when reset is low. 
+
+    always @( posedge S_AXI_ACLK )
+    begin
+      if ( S_AXI_ARESETN == 1'b0 )
+        begin
+          axi_wready <= 1'b0;
+        end 
+      else
+        begin    
+          if (~axi_wready && S_AXI_WVALID && S_AXI_AWVALID && aw_en )
+            begin
+              // slave is ready to accept write data when 
+              // there is a valid write address and write data
+              // on the write address and data bus. This design 
+              // expects no outstanding transactions. 
+              axi_wready <= 1'b1;
+            end
+          else
+            begin
+              axi_wready <= 1'b0;
+            end
+        end 
+    end       
+
+    // Implement memory mapped register select and write logic generation
+    // The write data is accepted and written to memory mapped registers when
+    // axi_awready, S_AXI_WVALID, axi_wready and S_AXI_WVALID are asserted. Write strobes are used to
+    // select byte enables of slave registers while writing.
+    // These registers are cleared when reset (active low) is applied.
+    // Slave register write enable is asserted when valid address and data are available
+    // and the slave is ready to accept the write address and write data.
+    assign slv_reg_wren = axi_wready && S_AXI_WVALID && axi_awready && S_AXI_AWVALID;
+
+    always @( posedge S_AXI_ACLK )
+    begin
+      if ( S_AXI_ARESETN == 1'b0 )
+        begin
+          slv_reg0 <= 0;
+          slv_reg1 <= 0;
+          slv_reg2 <= 0;
+          slv_reg3 <= 0;
+          slv_reg4 <= 0;
+          slv_reg5 <= 0;
+          slv_reg6 <= 0;
+          slv_reg7 <= 0;
+          // AK-NOTE: reg8 - reg15 are read-only
+          // slv_reg8 <= 0;
+          // slv_reg9 <= 0;
+          // slv_reg10 <= 0;
+          // slv_reg11 <= 0;
+          // slv_reg12 <= 0;
+          // slv_reg13 <= 0;
+          // slv_reg14 <= 0;
+          // slv_reg15 <= 0;
+        end 
+      else begin
+        if (slv_reg_wren)
+          begin
+            case ( axi_awaddr[ADDR_LSB+OPT_MEM_ADDR_BITS:ADDR_LSB] )
+              4'h0:
+                for ( byte_index = 0; byte_index <= (C_S_AXI_DATA_WIDTH/8)-1; byte_index = byte_index+1 )
+                  if ( S_AXI_WSTRB[byte_index] == 1 ) begin
+                    // Respective byte enables are asserted as per write strobes 
+                    // Slave register 0
+                    slv_reg0[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];
+                  end  
+              4'h1:
+                for ( byte_index = 0; byte_index <= (C_S_AXI_DATA_WIDTH/8)-1; byte_index = byte_index+1 )
+                  if ( S_AXI_WSTRB[byte_index] == 1 ) begin
+                    // Respective byte enables are asserted as per write strobes 
+                    // Slave register 1
+                    slv_reg1[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];
+                  end  
+              4'h2:
+                for ( byte_index = 0; byte_index <= (C_S_AXI_DATA_WIDTH/8)-1; byte_index = byte_index+1 )
+                  if ( S_AXI_WSTRB[byte_index] == 1 ) begin
+                    // Respective byte enables are asserted as per write strobes 
+                    // Slave register 2
+                    slv_reg2[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];
+                  end  
+              4'h3:
+                for ( byte_index = 0; byte_index <= (C_S_AXI_DATA_WIDTH/8)-1; byte_index = byte_index+1 )
+                  if ( S_AXI_WSTRB[byte_index] == 1 ) begin
+                    // Respective byte enables are asserted as per write strobes 
+                    // Slave register 3
+                    slv_reg3[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];
+                  end  
+              4'h4:
+                for ( byte_index = 0; byte_index <= (C_S_AXI_DATA_WIDTH/8)-1; byte_index = byte_index+1 )
+                  if ( S_AXI_WSTRB[byte_index] == 1 ) begin
+                    // Respective byte enables are asserted as per write strobes 
+                    // Slave register 4
+                    slv_reg4[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];
+                  end  
+              4'h5:
+                for ( byte_index = 0; byte_index <= (C_S_AXI_DATA_WIDTH/8)-1; byte_index = byte_index+1 )
+                  if ( S_AXI_WSTRB[byte_index] == 1 ) begin
+                    // Respective byte enables are asserted as per write strobes 
+                    // Slave register 5
+                    slv_reg5[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];
+                  end  
+              4'h6:
+                for ( byte_index = 0; byte_index <= (C_S_AXI_DATA_WIDTH/8)-1; byte_index = byte_index+1 )
+                  if ( S_AXI_WSTRB[byte_index] == 1 ) begin
+                    // Respective byte enables are asserted as per write strobes 
+                    // Slave register 6
+                    slv_reg6[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];
+                  end  
+              4'h7:
+                for ( byte_index = 0; byte_index <= (C_S_AXI_DATA_WIDTH/8)-1; byte_index = byte_index+1 )
+                  if ( S_AXI_WSTRB[byte_index] == 1 ) begin
+                    // Respective byte enables are asserted as per write strobes 
+                    // Slave register 7
+                    slv_reg7[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];
+                  end  
+              4'h8:
+                for ( byte_index = 0; byte_index <= (C_S_AXI_DATA_WIDTH/8)-1; byte_index = byte_index+1 )
+                  if ( S_AXI_WSTRB[byte_index] == 1 ) begin
+                    // Respective byte enables are asserted as per write strobes 
+                    // Slave register 8
+                    //slv_reg8[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];    // AK-NOTE: read-only register
+                  end  
+              4'h9:
+                for ( byte_index = 0; byte_index <= (C_S_AXI_DATA_WIDTH/8)-1; byte_index = byte_index+1 )
+                  if ( S_AXI_WSTRB[byte_index] == 1 ) begin
+                    // Respective byte enables are asserted as per write strobes 
+                    // Slave register 9
+                    //slv_reg9[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];    // AK-NOTE: read-only register
+                  end  
+              4'hA:
+                for ( byte_index = 0; byte_index <= (C_S_AXI_DATA_WIDTH/8)-1; byte_index = byte_index+1 )
+                  if ( S_AXI_WSTRB[byte_index] == 1 ) begin
+                    // Respective byte enables are asserted as per write strobes 
+                    // Slave register 10
+                    //slv_reg10[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];   // AK-NOTE: read-only register
+                  end  
+              4'hB:
+                for ( byte_index = 0; byte_index <= (C_S_AXI_DATA_WIDTH/8)-1; byte_index = byte_index+1 )
+                  if ( S_AXI_WSTRB[byte_index] == 1 ) begin
+                    // Respective byte enables are asserted as per write strobes 
+                    // Slave register 11
+                    //slv_reg11[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];   // AK-NOTE: read-only register
+                  end  
+              4'hC:
+                for ( byte_index = 0; byte_index <= (C_S_AXI_DATA_WIDTH/8)-1; byte_index = byte_index+1 )
+                  if ( S_AXI_WSTRB[byte_index] == 1 ) begin
+                    // Respective byte enables are asserted as per write strobes 
+                    // Slave register 12
+                    //slv_reg12[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];   // AK-NOTE: read-only register
+                  end  
+              4'hD:
+                for ( byte_index = 0; byte_index <= (C_S_AXI_DATA_WIDTH/8)-1; byte_index = byte_index+1 )
+                  if ( S_AXI_WSTRB[byte_index] == 1 ) begin
+                    // Respective byte enables are asserted as per write strobes 
+                    // Slave register 13
+                    //slv_reg13[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];   // AK-NOTE: read-only register
+                  end  
+              4'hE:
+                for ( byte_index = 0; byte_index <= (C_S_AXI_DATA_WIDTH/8)-1; byte_index = byte_index+1 )
+                  if ( S_AXI_WSTRB[byte_index] == 1 ) begin
+                    // Respective byte enables are asserted as per write strobes 
+                    // Slave register 14
+                    //slv_reg14[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];   // AK-NOTE: read-only register
+                  end  
+              4'hF:
+                for ( byte_index = 0; byte_index <= (C_S_AXI_DATA_WIDTH/8)-1; byte_index = byte_index+1 )
+                  if ( S_AXI_WSTRB[byte_index] == 1 ) begin
+                    // Respective byte enables are asserted as per write strobes 
+                    // Slave register 15
+                    //slv_reg15[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];   // AK-NOTE: read-only register
+                  end  
+              default : begin
+                          slv_reg0 <= slv_reg0;
+                          slv_reg1 <= slv_reg1;
+                          slv_reg2 <= slv_reg2;
+                          slv_reg3 <= slv_reg3;
+                          slv_reg4 <= slv_reg4;
+                          slv_reg5 <= slv_reg5;
+                          slv_reg6 <= slv_reg6;
+                          slv_reg7 <= slv_reg7;
+                          // AK-NOTE: reg8 - reg15 are read-only
+                          // slv_reg8 <= slv_reg8;
+                          // slv_reg9 <= slv_reg9;
+                          // slv_reg10 <= slv_reg10;
+                          // slv_reg11 <= slv_reg11;
+                          // slv_reg12 <= slv_reg12;
+                          // slv_reg13 <= slv_reg13;
+                          // slv_reg14 <= slv_reg14;
+                          // slv_reg15 <= slv_reg15;
+                        end
+            endcase
+          end
+      end
+    end    
+
+    // Implement write response logic generation
+    // The write response and response valid signals are asserted by the slave 
+    // when axi_wready, S_AXI_WVALID, axi_wready and S_AXI_WVALID are asserted.  
+    // This marks the acceptance of address and indicates the status of 
+    // write transaction.
+
+    always @( posedge S_AXI_ACLK )
+    begin
+      if ( S_AXI_ARESETN == 1'b0 )
+        begin
+          axi_bvalid  <= 0;
+          axi_bresp   <= 2'b0;
+        end 
+      else
+        begin    
+          if (axi_awready && S_AXI_AWVALID && ~axi_bvalid && axi_wready && S_AXI_WVALID)
+            begin
+              // indicates a valid write response is available
+              axi_bvalid <= 1'b1;
+              axi_bresp  <= 2'b0; // 'OKAY' response 
+            end                   // work error responses in future
+          else
+            begin
+              if (S_AXI_BREADY && axi_bvalid) 
+                //check if bready is asserted while bvalid is high) 
+                //(there is a possibility that bready is always asserted high)   
+                begin
+                  axi_bvalid <= 1'b0; 
+                end  
+            end
+        end
+    end   
+
+    // Implement axi_arready generation
+    // axi_arready is asserted for one S_AXI_ACLK clock cycle when
+    // S_AXI_ARVALID is asserted. axi_awready is 
+    // de-asserted when reset (active low) is asserted. 
+    // The read address is also latched when S_AXI_ARVALID is 
+    // asserted. axi_araddr is reset to zero on reset assertion.
+
+    always @( posedge S_AXI_ACLK )
+    begin
+      if ( S_AXI_ARESETN == 1'b0 )
+        begin
+          axi_arready <= 1'b0;
+          axi_araddr  <= 32'b0;
+        end 
+      else
+        begin    
+          if (~axi_arready && S_AXI_ARVALID)
+            begin
+              // indicates that the slave has acceped the valid read address
+              axi_arready <= 1'b1;
+              // Read address latching
+              axi_araddr  <= S_AXI_ARADDR;
+            end
+          else
+            begin
+              axi_arready <= 1'b0;
+            end
+        end 
+    end       
+
+    // Implement axi_arvalid generation
+    // axi_rvalid is asserted for one S_AXI_ACLK clock cycle when both 
+    // S_AXI_ARVALID and axi_arready are asserted. The slave registers 
+    // data are available on the axi_rdata bus at this instance. The 
+    // assertion of axi_rvalid marks the validity of read data on the 
+    // bus and axi_rresp indicates the status of read transaction.axi_rvalid 
+    // is deasserted on reset (active low). axi_rresp and axi_rdata are 
+    // cleared to zero on reset (active low).  
+    always @( posedge S_AXI_ACLK )
+    begin
+      if ( S_AXI_ARESETN == 1'b0 )
+        begin
+          axi_rvalid <= 0;
+          axi_rresp  <= 0;
+        end 
+      else
+        begin    
+          if (axi_arready && S_AXI_ARVALID && ~axi_rvalid)
+            begin
+              // Valid read data is available at the read data bus
+              axi_rvalid <= 1'b1;
+              axi_rresp  <= 2'b0; // 'OKAY' response
+            end   
+          else if (axi_rvalid && S_AXI_RREADY)
+            begin
+              // Read data is accepted by the master
+              axi_rvalid <= 1'b0;
+            end                
+        end
+    end    
+
+    // Implement memory mapped register select and read logic generation
+    // Slave register read enable is asserted when valid address is available
+    // and the slave is ready to accept the read address.
+    assign slv_reg_rden = axi_arready & S_AXI_ARVALID & ~axi_rvalid;
+    always @(*)
+    begin
+          // Address decoding for reading registers
+          case ( axi_araddr[ADDR_LSB+OPT_MEM_ADDR_BITS:ADDR_LSB] )
+            4'h0   : reg_data_out <= slv_reg0;
+            4'h1   : reg_data_out <= slv_reg1;
+            4'h2   : reg_data_out <= slv_reg2;
+            4'h3   : reg_data_out <= slv_reg3;
+            4'h4   : reg_data_out <= slv_reg4;
+            4'h5   : reg_data_out <= slv_reg5;
+            4'h6   : reg_data_out <= slv_reg6;
+            4'h7   : reg_data_out <= slv_reg7;
+            4'h8   : reg_data_out <= slv_reg8;
+            4'h9   : reg_data_out <= slv_reg9;
+            4'hA   : reg_data_out <= slv_reg10;
+            4'hB   : reg_data_out <= slv_reg11;
+            4'hC   : reg_data_out <= slv_reg12;
+            4'hD   : reg_data_out <= slv_reg13;
+            4'hE   : reg_data_out <= slv_reg14;
+            4'hF   : reg_data_out <= slv_reg15;
+            default : reg_data_out <= 0;
+          endcase
+    end
+
+    // Output register or memory read data
+    always @( posedge S_AXI_ACLK )
+    begin
+      if ( S_AXI_ARESETN == 1'b0 )
+        begin
+          axi_rdata  <= 0;
+        end 
+      else
+        begin    
+          // When there is a valid read address (S_AXI_ARVALID) with 
+          // acceptance of read address by the slave (axi_arready), 
+          // output the read dada 
+          if (slv_reg_rden)
+            begin
+              axi_rdata <= reg_data_out;     // register read data
+            end   
+        end
+    end    
+
+
+    // ---- Add user logic here
+    wire proc_clk;
+    assign proc_clk = S_AXI_ACLK;
+
+    // Instantiating the pulseGen modules
+    wire rdTrigger, rdPulse;
+    wire wrTrigger, wrPulse;
+    
+    pulseGen rd_pulseGen (
+        .clk(proc_clk),
+        .trigger(rdTrigger),
+        .pulse(rdPulse)
+    );
+    
+    pulseGen wr_pulseGen (
+        .clk(proc_clk),
+        .trigger(wrTrigger),
+        .pulse(wrPulse)
+    );
+
+
+    // Instantiating IMAGine IP 
+    `include "imagine_interface.svh"
+    localparam FIFOIN_DWIDTH = IMAGINE_INSTR_WIDTH,
+               FIFOUT_DWIDTH = 32;      // AK-NOTE: Must match with the imagine_ip instance
+    localparam FIFO_DEPTH = 1024,           // AK-NOTE: Must match with the depth of fifo_generator_0
+               FIFO_COUNT_WIDTH = 11;       // wide enough to hold FIFO_DEPTH
+
+    wire                      imgip_fifo_srst;
+    wire [FIFOIN_DWIDTH-1:0]  imgip_finp_din;
+    wire                      imgip_finp_wr_en;
+    wire                      imgip_finp_full;
+    wire [FIFO_COUNT_WIDTH-1:0] imgip_finp_freeSlots;
+    wire                      imgip_fout_rd_en;
+    wire                      imgip_fout_valid;
+    wire [FIFOUT_DWIDTH-1:0]  imgip_fout_dout;
+    wire [FIFO_COUNT_WIDTH-1:0] imgip_fout_fillLevel;
+    wire                      imgip_fout_packMode;
+    wire                      imgip_eov_interrupt;
+    wire                      imgip_clear_eovInterrupt;
+
+    imagine_ip #(
+        .DEBUG(0),
+        .DATAOUT_WIDTH(16),        // data-output from imagine-interface/vecshift-register
+        .GEMVARR_BLK_ROW_CNT(GEMVARR_BLK_ROW_CNT),    // No. of PiCaSO rows in the entire array
+        .GEMVARR_BLK_COL_CNT(GEMVARR_BLK_COL_CNT),    // No. of PiCaSO columns in the entire array
+        .GEMVARR_TILE_ROW_CNT(GEMVARR_TILE_ROW_CNT),  // No. of PiCaSO rows in a tile
+        .GEMVARR_TILE_COL_CNT(GEMVARR_TILE_COL_CNT),  // No. of PiCaSO columns in a tile
+        .FIFO_DEPTH(FIFO_DEPTH))
+      imgip_inst (
+        .clk_proc(proc_clk),
+        .clk_img(imagine_clk),
+        
+        // FIFO-in signals
+        .fifo_srst(imgip_fifo_srst),
+        .finp_din(imgip_finp_din),
+        .finp_wr_en(imgip_finp_wr_en),
+        .finp_full(imgip_finp_full),
+        .finp_freeSlots(imgip_finp_freeSlots),
+
+        // FIFO-in AXI-Stream signals
+        .finp_axis_tdata(S_AXIS_TDATA),
+        .finp_axis_tvalid(S_AXIS_TVALID),
+        .finp_axis_tready(S_AXIS_TREADY),
+        
+        // FIFO-out signals
+        .fout_rd_en(imgip_fout_rd_en),
+        .fout_valid(imgip_fout_valid),
+        .fout_dout(imgip_fout_dout),
+        .fout_fillLevel(imgip_fout_fillLevel),
+        .fout_packMode(imgip_fout_packMode),
+        
+        // imagine signals
+        .eov_interrupt(imgip_eov_interrupt),
+        .clear_eovInterrupt(imgip_clear_eovInterrupt)
+      );
+
+
+    // imagine-ip input register map:
+    // finp-data input    : reg0
+    // fifo-control reg   : reg1 (bit control)
+    // imagine-control reg: reg2 (bit control)
+    // reserved R/W regs  : reg 3-7
+
+    // imagine-ip output register map:
+    // fout-data output      : reg8
+    // fifo-status reg       : reg9
+    // imagine-status reg    : reg10
+    // finp-free-slots reg   : reg11 (no. of words that can be written without checking full)
+    // fout-fill-level reg   : reg12 (no. of words that can be read without checking valid)
+    // fifo-depth reg        : reg13
+    // magic-number regs     : reg 14-15
+
+    // bits of slv_reg1
+    localparam BIT_FIFO_RST = 0,
+               BIT_FINP_WR  = 1,
+               BIT_FOUT_RD  = 2,
+               BIT_FINP_AUTOWR = 3,   // auto-strobe mode: writing reg0 pushes the word into FIFO-in
+               BIT_FOUT_AUTORD = 4,   // auto-strobe mode: reading reg8 pops the word from FIFO-out
+               BIT_FOUT_PACK   = 5;   // packed mode: two data per FIFO-out word
+    // bits of slv_reg2
+    localparam BIT_IMG_CLREOV = 0,
+               BIT_IMG_EOVIE  = 1;    // enables the EOV interrupt request line
+    // bits of slv_reg9
+    localparam BIT_FINP_FULL = 0,
+               BIT_FOUT_VALID = 1;
+    // bits of slv_reg10
+    localparam BIT_IMG_EOVINT = 0;
+
+
+    // pulse generator inputs
+    assign wrTrigger = slv_reg1[BIT_FINP_WR],
+           rdTrigger = slv_reg1[BIT_FOUT_RD];
+
+    // auto-strobe pulses
+    // AK-NOTE: slv_reg0 is updated at the end of the write cycle, so the
+    // FIFO-in write is delayed by one cycle to push the new content. The
+    // FIFO-out read is issued in the same cycle reg8 is latched into axi_rdata,
+    // so slv_reg8 holds the next word before the next read can be accepted.
+    reg  autoWrPulse = 0;
+    wire autoRdPulse;
+
+    always@(posedge proc_clk) begin
+      autoWrPulse <= slv_reg_wren && slv_reg1[BIT_FINP_AUTOWR]
+                     && (axi_awaddr[ADDR_LSB+OPT_MEM_ADDR_BITS:ADDR_LSB] == 4'h0);
+    end
+
+    assign autoRdPulse = slv_reg_rden && slv_reg1[BIT_FOUT_AUTORD]
+                         && (axi_araddr[ADDR_LSB+OPT_MEM_ADDR_BITS:ADDR_LSB] == 4'h8);
+
+    // imgine-ip inputs 
+    // AK-NOTE: FIFO read/write signals are connected to pulse generators
+    // and auto-strobe pulses.
+    assign imgip_fifo_srst  = slv_reg1[BIT_FIFO_RST],
+           imgip_finp_din   = slv_reg0,
+           imgip_finp_wr_en = wrPulse || autoWrPulse,
+           imgip_fout_rd_en = rdPulse || autoRdPulse,
+           imgip_fout_packMode = slv_reg1[BIT_FOUT_PACK],
+           imgip_clear_eovInterrupt = slv_reg2[BIT_IMG_CLREOV];
+
+    // EOV interrupt: eov_interrupt is driven from imagine_clk, bring it
+    // to proc_clk before using it in the register map and the IRQ line.
+    reg [1:0] eovSync = 0;
+    reg       eovIrq  = 0;
+    always@(posedge proc_clk) begin
+      eovSync <= {eovSync[0], imgip_eov_interrupt};
+      eovIrq  <= eovSync[1] && slv_reg2[BIT_IMG_EOVIE];
+    end
+    assign EOV_IRQ = eovIrq;
+
+    // imagine-ip outputs
+    always@(posedge proc_clk) begin
+      slv_reg8 <= imgip_fout_dout;
+      slv_reg9[BIT_FINP_FULL]   <= imgip_finp_full;
+      slv_reg9[BIT_FOUT_VALID]  <= imgip_fout_valid;
+      slv_reg10[BIT_IMG_EOVINT] <= eovSync[1];
+      slv_reg11 <= imgip_finp_freeSlots;    // AK-NOTE: FIFO counts are already synchronized to proc_clk
+      slv_reg12 <= imgip_fout_fillLevel;
+      slv_reg13 <= FIFO_DEPTH;
+      // {reg15, reg14}: char arr[] = "IMAGine\0"
+      slv_reg14 <= "GAMI";
+      slv_reg15 <= {8'h0, "eni"};   // NOTE: To detect if register map is working
+    end
+
+    // ---- User logic ends
+
+    endmodule
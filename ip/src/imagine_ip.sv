@@ -0,0 +1,368 @@
+
+`timescale 1 ns / 1 ps
+
+
+
+module imagine_ip #(
+    parameter DEBUG = 0,
+    parameter DATAOUT_WIDTH = 16,         // data-output from imagine-interface/vecshift-register
+    parameter GEMVARR_BLK_ROW_CNT  = 16,  // No. of PiCaSO rows in the entire array
+    parameter GEMVARR_BLK_COL_CNT  =  4,  // No. of PiCaSO columns in the entire array
+    parameter GEMVARR_TILE_ROW_CNT =  4,  // No. of PiCaSO rows in a tile
+    parameter GEMVARR_TILE_COL_CNT =  2,  // No. of PiCaSO columns in a tile
+    parameter FIFO_DEPTH = 1024           // AK-NOTE: Must match with the depth of fifo_generator_0
+) (
+    clk_proc,
+    clk_img,
+
+    // FIFO-in signals
+    fifo_srst,
+    finp_din,
+    finp_wr_en,
+    finp_full,
+    finp_freeSlots,
+
+    // FIFO-in AXI-Stream signals
+    finp_axis_tdata,
+    finp_axis_tvalid,
+    finp_axis_tready,
+
+    // FIFO-out signals
+    fout_rd_en,
+    fout_valid,
+    fout_dout,
+    fout_fillLevel,
+    fout_packMode,
+
+    // imagine signals
+    eov_interrupt,
+    clear_eovInterrupt
+);
+
+
+  `include "imagine_interface.svh"
+  `include "vecshift_tile.svh"
+  `include "picaso_instruction_decoder.inc.v"
+  `include "clogb2_func.v"
+
+
+  localparam DATA_ATTRIB_WIDTH = VECSHIFT_STATUS_WIDTH,
+             GEMVARR_INSTR_WIDTH  = PICASO_INSTR_WORD_WIDTH;
+
+  localparam FIFOIN_DWIDTH = IMAGINE_INSTR_WIDTH,
+             FIFOUT_DWIDTH = 32;      // data and attributes
+
+  localparam FIFO_COUNT_WIDTH = clogb2(FIFO_DEPTH);   // wide enough to hold FIFO_DEPTH
+
+
+
+  // -- IO Ports
+  input                       clk_proc, clk_img;
+  input                       fifo_srst;
+  input [FIFOIN_DWIDTH-1:0]   finp_din;
+  input                       finp_wr_en;
+  output                      finp_full;
+  output [FIFO_COUNT_WIDTH-1:0] finp_freeSlots;
+  input [FIFOIN_DWIDTH-1:0]   finp_axis_tdata;
+  input                       finp_axis_tvalid;
+  output                      finp_axis_tready;
+  input                       fout_rd_en;
+  output                      fout_valid;
+  output [FIFOUT_DWIDTH-1:0]  fout_dout;
+  output [FIFO_COUNT_WIDTH-1:0] fout_fillLevel;
+  input                       fout_packMode;
+  output                      eov_interrupt;
+  input                       clear_eovInterrupt;
+
+
+
+
+  // -- imagine_interface IO
+  wire [IMAGINE_INSTR_WIDTH-1:0]  imgInt_instruction;
+  wire                            imgInt_instructionValid;
+  wire                            imgInt_instructionNext;
+  wire   [DATAOUT_WIDTH-1:0]      imgInt_dataout;
+  wire   [DATA_ATTRIB_WIDTH-1:0]  imgInt_dataAttrib;
+  wire                            imgInt_dataoutValid;
+  wire                            imgInt_eovInterrupt;
+  wire                            imgInt_clearEOV;
+
+  wire [GEMVARR_INSTR_WIDTH-1:0]  imgInt_gemvarr_instruction;
+  wire                            imgInt_gemvarr_inputValid;
+  wire [VECSHIFT_INSTR_WIDTH-1:0] imgInt_shreg_instruction;
+  wire                            imgInt_shreg_inputValid;
+
+  wire  [DATAOUT_WIDTH-1:0]       imgInt_shreg_parallelOut;
+  wire  [DATA_ATTRIB_WIDTH-1:0]   imgInt_shreg_statusOut;
+
+
+  (* keep_hierarchy = "yes" *)
+  imagine_wrapper #(
+      .DEBUG(DEBUG),
+      .BLK_ROW_CNT(GEMVARR_BLK_ROW_CNT),
+      .BLK_COL_CNT(GEMVARR_BLK_COL_CNT),
+      .TILE_ROW_CNT(GEMVARR_TILE_ROW_CNT),
+      .TILE_COL_CNT(GEMVARR_TILE_COL_CNT),
+      .DATAOUT_WIDTH(DATAOUT_WIDTH))
+    imagineTop (
+			.clk(clk_img),
+			// FIFO-in interface
+			.instruction(imgInt_instruction),
+			.instructionValid(imgInt_instructionValid),
+			.instructionNext(imgInt_instructionNext),
+			// FIFO-out interface
+			.dataout(imgInt_dataout),
+      .dataAttrib(imgInt_dataAttrib),
+			.dataoutValid(imgInt_dataoutValid),
+			// status signals
+			.eovInterrupt(imgInt_eovInterrupt),
+      .clearEOV(imgInt_clearEOV),
+
+			// Debug probes
+			.dbg_clk_enable(1'b1)
+    );
+
+
+
+  // Instantiate the FIFO-in
+  wire                       fifoin_srst;
+  wire [FIFOIN_DWIDTH-1:0]   fifoin_din;
+  wire                       fifoin_wr_en;
+  wire                       fifoin_rd_en;
+  wire [FIFOIN_DWIDTH-1:0]   fifoin_dout;
+  wire                       fifoin_full;
+  wire                       fifoin_wr_ack;
+  wire                       fifoin_overflow;
+  wire                       fifoin_empty;
+  wire                       fifoin_valid;
+  wire                       fifoin_underflow;
+  wire                       fifoin_wr_rst_busy;
+  wire                       fifoin_rd_rst_busy;
+
+
+  fifo_generator_0 fifoIn (
+    .srst(fifoin_srst),                // input wire srst
+    .wr_clk(clk_proc),                 // input wire wr_clk, write from processor
+    .rd_clk(clk_img),                  // input wire rd_clk, read from imagine
+    .din(fifoin_din),                  // input wire [31 : 0] din
+    .wr_en(fifoin_wr_en),              // input wire wr_en
+    .rd_en(fifoin_rd_en),              // input wire rd_en
+    .dout(fifoin_dout),                // output wire [31 : 0] dout
+    .full(fifoin_full),                // output wire full
+    .wr_ack(fifoin_wr_ack),            // output wire wr_ack
+    .overflow(fifoin_overflow),        // output wire overflow
+    .empty(fifoin_empty),              // output wire empty
+    .valid(fifoin_valid),              // output wire valid
+    .underflow(fifoin_underflow),      // output wire underflow
+    .wr_rst_busy(fifoin_wr_rst_busy),  // output wire wr_rst_busy
+    .rd_rst_busy(fifoin_rd_rst_busy)   // output wire rd_rst_busy
+  );
+
+
+  // Instantiate the FIFO-in
+  wire                     fifoout_srst;
+  wire [FIFOUT_DWIDTH-1:0] fifoout_din;
+  wire                     fifoout_rd_en;
+  wire                     fifoout_wr_en;
+  wire [FIFOUT_DWIDTH-1:0] fifoout_dout;
+  wire                     fifoout_full;
+  wire                     fifoout_wr_ack;
+  wire                     fifoout_overflow;
+  wire                     fifoout_empty;
+  wire                     fifoout_valid;
+  wire                     fifoout_underflow;
+  wire                     fifoout_wr_rst_busy;
+  wire                     fifoout_rd_rst_busy;
+
+
+  fifo_generator_0 fifoOut (
+    .srst(fifoout_srst),                // input wire srst
+    .wr_clk(clk_img),                   // input wire wr_clk, write from imagine
+    .rd_clk(clk_proc),                  // input wire rd_clk, read from processor
+    .din(fifoout_din),                  // input wire [31 : 0] din
+    .wr_en(fifoout_wr_en),              // input wire wr_en
+    .rd_en(fifoout_rd_en),              // input wire rd_en
+    .dout(fifoout_dout),                // output wire [31 : 0] dout
+    .full(fifoout_full),                // output wire full
+    .wr_ack(fifoout_wr_ack),            // output wire wr_ack
+    .overflow(fifoout_overflow),        // output wire overflow
+    .empty(fifoout_empty),              // output wire empty
+    .valid(fifoout_valid),              // output wire valid
+    .underflow(fifoout_underflow),      // output wire underflow
+    .wr_rst_busy(fifoout_wr_rst_busy),  // output wire wr_rst_busy
+    .rd_rst_busy(fifoout_rd_rst_busy)   // output wire rd_rst_busy
+  );
+
+
+  // -- FIFO occupancy counters
+  // AK-NOTE: The builtin FIFOs don't provide data counts. So, the words
+  // written and read are counted on their own clock domains, and the count
+  // of the other side is brought over through a gray-coded synchronizer.
+  // The synchronized count lags behind, so the free-slot count of FIFO-in
+  // and the fill-level of FIFO-out are always conservative (never over-reported).
+  wire [FIFO_COUNT_WIDTH-1:0] finpCnt_wrCount;    // clk_proc domain
+  wire [FIFO_COUNT_WIDTH-1:0] finpCnt_rdCount;    // clk_proc domain (synchronized)
+  wire [FIFO_COUNT_WIDTH-1:0] foutCnt_wrCount;    // clk_proc domain (synchronized)
+  wire [FIFO_COUNT_WIDTH-1:0] foutCnt_rdCount;    // clk_proc domain
+
+  fifoCountSync #(.COUNT_WIDTH(FIFO_COUNT_WIDTH))
+    finpCounter (
+      .clk_local(clk_proc),
+      .clk_remote(clk_img),
+      .rst_local(fifo_srst),
+      .incr_local(fifoin_wr_en && !fifoin_full),
+      .incr_remote(fifoin_rd_en && fifoin_valid),
+      .count_local(finpCnt_wrCount),
+      .count_remote(finpCnt_rdCount)
+    );
+
+  fifoCountSync #(.COUNT_WIDTH(FIFO_COUNT_WIDTH))
+    foutCounter (
+      .clk_local(clk_proc),
+      .clk_remote(clk_img),
+      .rst_local(fifoout_srst),
+      .incr_local(fifoout_rd_en && fifoout_valid),
+      .incr_remote(fifoout_wr_en && !fifoout_full),
+      .count_local(foutCnt_rdCount),
+      .count_remote(foutCnt_wrCount)
+    );
+
+
+  // -- local interconnect
+  // FIFO-in write arbitration
+  // AK-NOTE: Both the register path (finp_*) and the AXI-Stream path write
+  // into FIFO-in on clk_proc. The register path has priority; the stream is
+  // back-pressured in that cycle, so no word is lost from either path.
+  wire axisAccept;
+  assign finp_axis_tready = !fifoin_full && !finp_wr_en && !fifo_srst,
+         axisAccept       = finp_axis_tvalid && finp_axis_tready;
+
+  // FIFO-in inputs
+  assign fifoin_rd_en = imgInt_instructionNext,
+         fifoin_din   = finp_wr_en ? finp_din : finp_axis_tdata,
+         fifoin_srst  = fifo_srst,
+         fifoin_wr_en = finp_wr_en || axisAccept;
+          
+  // FIFO-out inputs
+  localparam BIT_ISDATA = 24,   // 24th bit is the isData bit
+             BIT_ISLAST = 25;   // next bit is the isLast bit
+  wire [FIFOUT_DWIDTH-1:0] dataOutPacket;
+  assign dataOutPacket[0 +: DATAOUT_WIDTH] = imgInt_dataout;     // lower 16-bits holds the data
+  assign dataOutPacket[24 +: 8] = {8'h0, imgInt_dataAttrib};     // upper 8-bits holds the data attributes
+  assign dataOutPacket[23:DATAOUT_WIDTH] = 8'h0;                 // other bits are 0s
+
+  // Packed output mode: two consecutive data are paired into one FIFO-out word,
+  // {second, first}. At the end of a vector, an unpaired datum is flushed with
+  // 0 in the upper half. The end-of-vector is reported by the eovInterrupt.
+  // AK-NOTE: fout_packMode comes from clk_proc; it should only be changed
+  // while no output vector is in flight.
+  reg [1:0] packModeSync = 0;
+  reg [DATAOUT_WIDTH-1:0] packFirst = 0;      // first datum of the pair
+  reg                     packHeld  = 0;      // packFirst holds a datum
+  wire packMode, isLastData;
+
+  always@(posedge clk_img) packModeSync <= {packModeSync[0], fout_packMode};
+  assign packMode   = packModeSync[1],
+         isLastData = imgInt_dataAttrib[BIT_ISLAST-BIT_ISDATA];
+
+  always@(posedge clk_img) begin
+    if(!packMode)
+      packHeld <= 0;
+    else if(imgInt_dataoutValid) begin
+      packHeld  <= !packHeld && !isLastData;      // hold the first datum unless the vector ends
+      packFirst <= imgInt_dataout;
+    end
+  end
+
+  wire [FIFOUT_DWIDTH-1:0] packedPacket;
+  wire                     packedWrite;
+  assign packedPacket = packHeld ? {imgInt_dataout, packFirst}
+                                 : {{DATAOUT_WIDTH{1'b0}}, imgInt_dataout},
+         packedWrite  = imgInt_dataoutValid && (packHeld || isLastData);
+
+  assign fifoout_din = packMode ? packedPacket : dataOutPacket,
+         fifoout_wr_en = packMode ? packedWrite : imgInt_dataoutValid,
+         fifoout_rd_en = fout_rd_en,
+         fifoout_srst  = 1'b0;    // TODO: fifout reset should be driven by imagine; not using it right now.
+
+  // imagineTop inputs
+  assign imgInt_clearEOV = clear_eovInterrupt,
+         imgInt_instruction = fifoin_dout,
+         imgInt_instructionValid = fifoin_valid;
+
+  // top-level outputs
+  assign finp_full  = fifoin_full,
+         fout_valid = fifoout_valid,
+         fout_dout  = fifoout_dout,
+         eov_interrupt = imgInt_eovInterrupt;
+
+  assign finp_freeSlots = FIFO_DEPTH - (finpCnt_wrCount - finpCnt_rdCount),   // modular subtraction gives the occupancy
+         fout_fillLevel = foutCnt_wrCount - foutCnt_rdCount;
+
+
+
+endmodule
+
+
+	
+	
+	
+
+
+
+// Counts the increments on two clock domains: the local and the remote.
+// The remote count is brought over to the local clock domain through a
+// gray-coded 2-flop synchronizer, so that all the bits change coherently.
+// Reset is only applied on the local clock domain: it aligns the local count
+// with the synchronized remote count (i.e., local - remote becomes 0).
+module fifoCountSync #(
+  parameter COUNT_WIDTH = 11
+) (
+  input  wire                   clk_local,
+  input  wire                   clk_remote,
+  input  wire                   rst_local,
+  input  wire                   incr_local,
+  input  wire                   incr_remote,
+  output wire [COUNT_WIDTH-1:0] count_local,
+  output wire [COUNT_WIDTH-1:0] count_remote
+);
+
+  reg [COUNT_WIDTH-1:0] localCount  = 0;
+  reg [COUNT_WIDTH-1:0] remoteCount = 0;     // binary count on the remote domain
+  reg [COUNT_WIDTH-1:0] remoteGray  = 0;     // gray-coded count on the remote domain
+
+  (* ASYNC_REG = "TRUE" *)
+  reg [COUNT_WIDTH-1:0] syncGray0 = 0, syncGray1 = 0;   // synchronizer flops on the local domain
+
+  reg [COUNT_WIDTH-1:0] syncBin;     // synchronized count converted back to binary
+  integer i;
+
+
+  // remote clock domain
+  always @(posedge clk_remote) begin
+    if(incr_remote) remoteCount <= remoteCount + 1;
+    remoteGray <= remoteCount ^ (remoteCount >> 1);
+  end
+
+
+  // local clock domain
+  always @(posedge clk_local) begin
+    syncGray0 <= remoteGray;
+    syncGray1 <= syncGray0;
+    if(rst_local) localCount <= syncBin;
+    else if(incr_local) localCount <= localCount + 1;
+  end
+
+
+  // gray to binary conversion
+  always @* begin
+    syncBin[COUNT_WIDTH-1] = syncGray1[COUNT_WIDTH-1];
+    for(i=COUNT_WIDTH-2; i>=0; i=i-1)
+      syncBin[i] = syncBin[i+1] ^ syncGray1[i];
+  end
+
+
+  assign count_local  = localCount,
+         count_remote = syncBin;
+
+endmodule
@@ -0,0 +1,40 @@
+module pulseGen (
+  input wire clk,
+  input wire trigger,
+  output wire pulse
+);
+
+  localparam SCODE_WIDTH = 2;
+  localparam ST_IDLE = 0,
+             ST_HIGH = 1,
+             ST_LOW  = 2;
+
+
+  reg [SCODE_WIDTH-1:0] state = ST_IDLE;
+  reg pulse_reg = 0;
+
+
+  // transition table
+  always @(posedge clk) begin
+    case (state)
+      ST_IDLE: begin
+        if (trigger) begin
+          state <= ST_HIGH;
+        end
+      end
+      ST_HIGH: begin
+        if(!trigger) state <= ST_IDLE;
+        else         state <= ST_LOW;
+      end
+      ST_LOW: begin
+        if(!trigger) state <= ST_IDLE;
+      end
+      default: begin
+        state <= ST_IDLE;
+      end
+    endcase
+  end
+
+  assign pulse = (state == ST_HIGH);    // output is high on the ST_HIGH state
+
+endmodule
@@ -0,0 +1,108 @@
+/*********************************************************************************
+* Copyright (c) 2024, Computer Systems Design Lab, University of Arkansas        *
+*                                                                                *
+* All rights reserved.                                                           *
+*                                                                                *
+* Permission is hereby granted, free of charge, to any person obtaining a copy   *
+* of this software and associated documentation files (the "Software"), to deal  *
+* in the Software without restriction, including without limitation the rights   *
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      *
+* copies of the Software, and to permit persons to whom the Software is          *
+* furnished to do so, subject to the following conditions:                       *
+*                                                                                *
+* The above copyright notice and this permission notice shall be included in all *
+* copies or substantial portions of the Software.                                *
+*                                                                                *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       *
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    *
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         *
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  *
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  *
+* SOFTWARE.                                                                      *
+**********************************************************************************
+
+==================================================================================
+
+  Version: v1.0
+
+  Description:
+  Behavioral model of fifo_generator_0 (ip/src/fifo_generator_0), used in
+  place of the Xilinx IP in the IP-level testbenches. It models the
+  configuration of the xci: independent clocks, first-word-fall-through,
+  1024 x 32-bit, valid flag and synchronous reset on the write clock.
+  The flags have no clock-crossing latency, so the FIFO counters of
+  imagine_ip always lag behind the model.
+
+================================================================================*/
+
+
+`timescale 1ns/100ps
+
+
+module fifo_generator_0 #(
+  parameter DEPTH = 1024,
+  parameter WIDTH = 32
+) (
+  input  wire             srst,
+  input  wire             wr_clk,
+  input  wire             rd_clk,
+  input  wire [WIDTH-1:0] din,
+  input  wire             wr_en,
+  input  wire             rd_en,
+  output wire [WIDTH-1:0] dout,
+  output wire             full,
+  output reg              wr_ack = 0,
+  output reg              overflow = 0,
+  output wire             empty,
+  output wire             valid,
+  output reg              underflow = 0,
+  output wire             wr_rst_busy,
+  output wire             rd_rst_busy
+);
+
+  `include "clogb2_func.v"
+
+  localparam PTR_WIDTH = clogb2(DEPTH);    // one more bit than the address, tells full from empty
+
+  reg [WIDTH-1:0]     mem [0:DEPTH-1];
+  reg [PTR_WIDTH-1:0] wrPtr = 0;
+  reg [PTR_WIDTH-1:0] rdPtr = 0;
+  wire [PTR_WIDTH-1:0] occupancy;
+
+
+  // write clock domain
+  always @(posedge wr_clk) begin
+    if(srst) begin
+      wrPtr <= rdPtr;     // drops the content
+      wr_ack <= 0;
+      overflow <= 0;
+    end else begin
+      if(wr_en && !full) begin
+        mem[wrPtr % DEPTH] <= din;
+        wrPtr <= wrPtr + 1;
+      end
+      wr_ack   <= wr_en && !full;
+      overflow <= wr_en && full;
+    end
+  end
+
+
+  // read clock domain, the head is shown on dout while valid (FWFT)
+  always @(posedge rd_clk) begin
+    if(rd_en && valid) rdPtr <= rdPtr + 1;
+    underflow <= rd_en && !valid;
+  end
+
+
+  assign occupancy = wrPtr - rdPtr,
+         full  = (occupancy == DEPTH),
+         empty = (occupancy == 0),
+         valid = !empty,
+         dout  = mem[rdPtr % DEPTH];
+
+  assign wr_rst_busy = 1'b0,
+         rd_rst_busy = 1'b0;
+
+
+endmodule
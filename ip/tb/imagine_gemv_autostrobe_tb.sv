@@ -0,0 +1,186 @@
+/*********************************************************************************
+* Copyright (c) 2024, Computer Systems Design Lab, University of Arkansas        *
+*                                                                                *
+* All rights reserved.                                                           *
+*                                                                                *
+* Permission is hereby granted, free of charge, to any person obtaining a copy   *
+* of this software and associated documentation files (the "Software"), to deal  *
+* in the Software without restriction, including without limitation the rights   *
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      *
+* copies of the Software, and to permit persons to whom the Software is          *
+* furnished to do so, subject to the following conditions:                       *
+*                                                                                *
+* The above copyright notice and this permission notice shall be included in all *
+* copies or substantial portions of the Software.                                *
+*                                                                                *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       *
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    *
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         *
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  *
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  *
+* SOFTWARE.                                                                      *
+**********************************************************************************
+
+==================================================================================
+
+  Version: v1.0
+
+  Description:
+  Testbench of the auto-strobe modes of the IMAGine IP (reg1 bits 3 and 4).
+  It checks that
+    - with FINP_AUTOWR, each write of reg0 pushes one word into FIFO-in
+      (also repeated words), with one bus transaction per word, and that
+      writes of other registers push nothing
+    - the words reach imagine_wrapper in order
+    - with FOUT_AUTORD, each read of reg8 returns the head of FIFO-out and
+      pops it, and that reads of other registers pop nothing
+    - without the modes, reg0 writes and reg8 reads have no side effect
+      and the pulse-gen path still works
+  Run with "make sim-ip-autostrobe" from work/.
+
+================================================================================*/
+
+
+`timescale 1ns/100ps
+
+
+module imagine_gemv_autostrobe_tb;
+
+  imagine_gemv_tbsys sys ();
+
+  localparam FIFO_DEPTH = 1024,
+             WORD_CNT   = 200,
+             DATA_CNT   = 50;
+
+  // tags of the pushed words
+  localparam TAG_AUTO  = 1,
+             TAG_PULSE = 2;
+
+  int errors = 0;
+
+  task automatic check(input string what, input logic [31:0] got, input logic [31:0] exp);
+    if(got !== exp) begin
+      $display("EROR: %s: %0d (%h), expected %0d (%h)", what, got, got, exp, exp);
+      errors = errors + 1;
+    end
+  endtask
+
+  task automatic checkReg(input string what, input int r, input logic [31:0] exp);
+    logic [31:0] val;
+    sys.axiRead(r, val);
+    check(what, val, exp);
+  endtask
+
+  // the words of a tag taken by imagine_wrapper must be the expected ones, in order
+  task automatic checkTag(input int tag, input logic [31:0] expected[$]);
+    int n = 0;
+    foreach(sys.consumed[i]) begin
+      if(sys.consumed[i][25:16] == tag) begin
+        if(n < expected.size()) check($sformatf("word %0d of tag %0d", n, tag), sys.consumed[i], expected[n]);
+        n = n + 1;
+      end
+    end
+    check($sformatf("words of tag %0d", tag), n, expected.size());
+  endtask
+
+
+  initial begin
+    logic [31:0] val;
+    logic [31:0] words[$];
+    logic [15:0] vector[$];
+    bit ok;
+    int writesBefore, readsBefore, consumedBefore;
+
+    void'($urandom(3));
+    wait(sys.ready);
+    sys.settle();
+
+    // ---- auto-strobe FIFO-in write
+    sys.setFifoCtrl((1 << sys.BIT_FINP_AUTOWR) | (1 << sys.BIT_FOUT_AUTORD));
+    sys.stallImagine(1);
+    writesBefore = sys.busWrites;
+    for(int i=0; i<WORD_CNT; i++) begin
+      words.push_back(sys.nopWord(TAG_AUTO, i/2));    // each word twice, back-to-back
+      sys.pushWord(words[i]);
+    end
+    check("bus writes of the words", sys.busWrites - writesBefore, WORD_CNT);
+    sys.settle();
+    checkReg("free slots after the words", sys.REG_FINP_FREE, FIFO_DEPTH-WORD_CNT);
+    // other registers do not push
+    sys.axiWrite(sys.REG_IMG_CTRL, 0);
+    sys.axiWrite(3, 32'hFFFF_FFFF);
+    sys.axiWrite(sys.REG_FIFO_CTRL, sys.fifoCtrl);
+    sys.settle();
+    checkReg("free slots after other writes", sys.REG_FINP_FREE, FIFO_DEPTH-WORD_CNT);
+    sys.stallImagine(0);
+    sys.waitConsumed(WORD_CNT, ok);
+    sys.settle();
+    checkTag(TAG_AUTO, words);
+    check("dropped words", sys.finpDropped, 0);
+
+    // ---- auto-strobe FIFO-out read
+    for(int i=0; i<DATA_CNT; i++) vector.push_back($urandom);
+    sys.emitVector(vector, 20);
+    sys.settle();
+    checkReg("fill level of the vector", sys.REG_FOUT_FILL, DATA_CNT);
+    writesBefore = sys.busWrites;
+    readsBefore  = sys.busReads;
+    for(int i=0; i<DATA_CNT; i++) begin
+      sys.popWord(val);
+      check($sformatf("FIFO-out word %0d", i), val, sys.foutWord(vector[i], i == DATA_CNT-1));
+      if(i % 10 == 5) begin
+        // other registers do not pop
+        sys.axiRead(sys.REG_FIFO_STATUS, val);
+        sys.axiRead(sys.REG_FOUT_FILL, val);
+        readsBefore = readsBefore + 2;
+      end
+    end
+    check("bus reads of the data", sys.busReads - readsBefore, DATA_CNT);
+    check("bus writes of the data", sys.busWrites - writesBefore, 0);
+    sys.settle();
+    checkReg("fill level after the reads", sys.REG_FOUT_FILL, 0);
+    sys.axiRead(sys.REG_FIFO_STATUS, val);
+    check("valid flag after the reads", val[sys.BIT_FOUT_VALID], 0);
+
+    // ---- without auto-strobe, reg0 writes and reg8 reads have no side effect
+    sys.setFifoCtrl(0);
+    sys.stallImagine(1);
+    for(int i=0; i<3; i++) sys.axiWrite(sys.REG_FINP_DATA, sys.nopWord(TAG_PULSE, 100+i));
+    sys.settle();
+    checkReg("free slots after plain reg0 writes", sys.REG_FINP_FREE, FIFO_DEPTH);
+    words.delete();
+    words.push_back(sys.nopWord(TAG_PULSE, 0));
+    sys.pushWord(words[0]);
+    sys.settle();
+    checkReg("free slots after a pulse-gen push", sys.REG_FINP_FREE, FIFO_DEPTH-1);
+    consumedBefore = sys.consumed.size();
+    sys.stallImagine(0);
+    sys.waitConsumed(consumedBefore+1, ok);
+    checkTag(TAG_PULSE, words);
+
+    vector.delete();
+    vector.push_back(16'h1234);
+    vector.push_back(16'hABCD);
+    sys.emitVector(vector, 0);
+    sys.settle();
+    for(int i=0; i<2; i++) begin
+      sys.axiRead(sys.REG_FOUT_DATA, val);
+      check("plain reg8 read", val, sys.foutWord(vector[0], 0));
+    end
+    sys.settle();
+    checkReg("fill level after plain reg8 reads", sys.REG_FOUT_FILL, 2);
+    for(int i=0; i<2; i++) begin
+      sys.popWord(val);
+      check("pulse-gen pop", val, sys.foutWord(vector[i], i == 1));
+    end
+    sys.settle();
+    checkReg("fill level after pulse-gen pops", sys.REG_FOUT_FILL, 0);
+
+    if(errors == 0) $display("PASS: IMAGine IP auto-strobe modes");
+    else            $display("FAIL: IMAGine IP auto-strobe modes, %0d errors", errors);
+    $finish;
+  end
+
+
+endmodule
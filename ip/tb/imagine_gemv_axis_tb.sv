@@ -0,0 +1,166 @@
+/*********************************************************************************
+* Copyright (c) 2024, Computer Systems Design Lab, University of Arkansas        *
+*                                                                                *
+* All rights reserved.                                                           *
+*                                                                                *
+* Permission is hereby granted, free of charge, to any person obtaining a copy   *
+* of this software and associated documentation files (the "Software"), to deal  *
+* in the Software without restriction, including without limitation the rights   *
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      *
+* copies of the Software, and to permit persons to whom the Software is          *
+* furnished to do so, subject to the following conditions:                       *
+*                                                                                *
+* The above copyright notice and this permission notice shall be included in all *
+* copies or substantial portions of the Software.                                *
+*                                                                                *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       *
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    *
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         *
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  *
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  *
+* SOFTWARE.                                                                      *
+**********************************************************************************
+
+==================================================================================
+
+  Version: v1.0
+
+  Description:
+  Testbench of the AXI-Stream instruction port of the IMAGine IP. A
+  behavioral DMA engine streams programs into FIFO-in, which feeds the real
+  imagine_wrapper. It checks that
+    - a submission returns right away and the program reaches
+      imagine_wrapper in order
+    - the stream runs at one word per AXI clock while FIFO-in has space
+    - a full FIFO-in holds the stream back without dropping words
+    - register path writes during a stream (with gaps) keep the order of
+      both sources and lose no word
+  The stream must never be held back while FIFO-in could take the word.
+  Run with "make sim-ip-axis" from work/.
+
+================================================================================*/
+
+
+`timescale 1ns/100ps
+
+
+module imagine_gemv_axis_tb;
+
+  imagine_gemv_tbsys sys ();
+
+  localparam FIFO_DEPTH = 1024,
+             PROG_LEN   = 4000;
+
+  // tags of the pushed words
+  localparam TAG_PROG   = 1,
+             TAG_BURST  = 2,
+             TAG_FULL   = 3,
+             TAG_STREAM = 4,
+             TAG_REG    = 5;
+
+  int errors = 0;
+
+  task automatic check(input string what, input logic [31:0] got, input logic [31:0] exp);
+    if(got !== exp) begin
+      $display("EROR: %s: %0d (%h), expected %0d (%h)", what, got, got, exp, exp);
+      errors = errors + 1;
+    end
+  endtask
+
+  task automatic checkReg(input string what, input int r, input logic [31:0] exp);
+    logic [31:0] val;
+    sys.axiRead(r, val);
+    check(what, val, exp);
+  endtask
+
+  // the words of a tag must have been taken in order, without gaps
+  task automatic checkOrder(input int tag, input int count);
+    int seq = 0;
+    foreach(sys.consumed[i]) begin
+      if(sys.consumed[i][25:16] == tag) begin
+        check($sformatf("word %0d of tag %0d", seq, tag), sys.consumed[i], sys.nopWord(tag, seq));
+        seq = seq + 1;
+      end
+    end
+    check($sformatf("words of tag %0d", tag), seq, count);
+  endtask
+
+  function automatic void makeProgram(ref logic [31:0] prog[$], input int tag, input int len);
+    prog.delete();
+    for(int i=0; i<len; i++) prog.push_back(sys.nopWord(tag, i));
+  endfunction
+
+
+  initial begin
+    logic [31:0] prog[$];
+    bit ok;
+    int total = 0;
+    realtime submitTime;
+
+    void'($urandom(4));
+    wait(sys.ready);
+    sys.settle();
+
+    // a whole program, while IMAGine takes the words
+    makeProgram(prog, TAG_PROG, PROG_LEN);
+    submitTime = $realtime;
+    sys.dmaSubmit(prog, 0);
+    if($realtime != submitTime || !sys.dmaBusy) begin
+      $display("EROR: DMA submission did not return right away");
+      errors = errors + 1;
+    end
+    sys.dmaWait();
+    total = total + PROG_LEN;
+    sys.waitConsumed(total, ok);
+    checkOrder(TAG_PROG, PROG_LEN);
+    $display("INFO: program of %0d words streamed in %0d AXI clock cycles", PROG_LEN, sys.dmaCycles);
+
+    // one word per clock while FIFO-in has space
+    sys.stallImagine(1);
+    makeProgram(prog, TAG_BURST, FIFO_DEPTH);
+    sys.dmaSubmit(prog, 0);
+    sys.dmaWait();
+    check("cycles of a burst that fits FIFO-in", sys.dmaCycles, FIFO_DEPTH);
+    sys.settle();
+    checkReg("free slots after the burst", sys.REG_FINP_FREE, 0);
+    sys.stallImagine(0);
+    total = total + FIFO_DEPTH;
+    sys.waitConsumed(total, ok);
+    checkOrder(TAG_BURST, FIFO_DEPTH);
+
+    // a full FIFO-in holds the stream back
+    sys.stallImagine(1);
+    makeProgram(prog, TAG_FULL, FIFO_DEPTH + 500);
+    sys.dmaSubmit(prog, 0);
+    repeat(2*FIFO_DEPTH) @(posedge sys.aclk);
+    if(!sys.dmaBusy) begin
+      $display("EROR: stream was not held back by a full FIFO-in");
+      errors = errors + 1;
+    end
+    sys.stallImagine(0);
+    sys.dmaWait();
+    total = total + FIFO_DEPTH + 500;
+    sys.waitConsumed(total, ok);
+    checkOrder(TAG_FULL, FIFO_DEPTH + 500);
+
+    // register path writes during a stream with gaps
+    sys.setFifoCtrl(1 << sys.BIT_FINP_AUTOWR);
+    makeProgram(prog, TAG_STREAM, 2000);
+    sys.dmaSubmit(prog, 30);
+    for(int i=0; i<300; i++) sys.pushWord(sys.nopWord(TAG_REG, i));
+    sys.dmaWait();
+    total = total + 2000 + 300;
+    sys.waitConsumed(total, ok);
+    checkOrder(TAG_STREAM, 2000);
+    checkOrder(TAG_REG, 300);
+
+    check("dropped words", sys.finpDropped, 0);
+    check("stream stalls with space in FIFO-in", sys.axisStalls, 0);
+    if(errors == 0) $display("PASS: IMAGine IP AXI-Stream instruction port");
+    else            $display("FAIL: IMAGine IP AXI-Stream instruction port, %0d errors", errors);
+    $finish;
+  end
+
+
+endmodule
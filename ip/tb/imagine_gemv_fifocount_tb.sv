@@ -0,0 +1,193 @@
+/*********************************************************************************
+* Copyright (c) 2024, Computer Systems Design Lab, University of Arkansas        *
+*                                                                                *
+* All rights reserved.                                                           *
+*                                                                                *
+* Permission is hereby granted, free of charge, to any person obtaining a copy   *
+* of this software and associated documentation files (the "Software"), to deal  *
+* in the Software without restriction, including without limitation the rights   *
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      *
+* copies of the Software, and to permit persons to whom the Software is          *
+* furnished to do so, subject to the following conditions:                       *
+*                                                                                *
+* The above copyright notice and this permission notice shall be included in all *
+* copies or substantial portions of the Software.                                *
+*                                                                                *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       *
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    *
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         *
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  *
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  *
+* SOFTWARE.                                                                      *
+**********************************************************************************
+
+==================================================================================
+
+  Version: v1.0
+
+  Description:
+  Testbench of the FIFO counts of the IMAGine IP (reg11-13). It checks
+    - the FIFO depth and the magic number registers
+    - the FIFO-in free slots with a stalled IMAGine, up to a full FIFO-in
+    - a kernel load that reads the free slots once per burst, while IMAGine
+      takes the words: the free slots are never over-reported, no word is
+      dropped or reordered, and the status reads are far fewer than with a
+      full-flag check per word
+    - the FIFO-out fill level while data are written and popped
+    - the counts after a FIFO reset
+  Run with "make sim-ip-fifocount" from work/.
+
+================================================================================*/
+
+
+`timescale 1ns/100ps
+
+
+module imagine_gemv_fifocount_tb;
+
+  imagine_gemv_tbsys sys ();
+
+  localparam FIFO_DEPTH = 1024,
+             KERNEL_LEN = 3000;
+
+  // tags of the pushed words
+  localparam TAG_FILL   = 1,
+             TAG_KERNEL = 2,
+             TAG_RESET  = 3;
+
+  int errors = 0;
+
+  task automatic check(input string what, input logic [31:0] got, input logic [31:0] exp);
+    if(got !== exp) begin
+      $display("EROR: %s: %0d (%h), expected %0d (%h)", what, got, got, exp, exp);
+      errors = errors + 1;
+    end
+  endtask
+
+  task automatic checkReg(input string what, input int r, input logic [31:0] exp);
+    logic [31:0] val;
+    sys.axiRead(r, val);
+    check(what, val, exp);
+  endtask
+
+  // the words of a tag must have been taken in order, without gaps
+  task automatic checkOrder(input int tag, input int count);
+    int seq = 0;
+    foreach(sys.consumed[i]) begin
+      if(sys.consumed[i][25:16] == tag) begin
+        check($sformatf("word %0d of tag %0d", seq, tag), sys.consumed[i], sys.nopWord(tag, seq));
+        seq = seq + 1;
+      end
+    end
+    check($sformatf("words of tag %0d", tag), seq, count);
+  endtask
+
+
+  initial begin
+    logic [31:0] val;
+    logic [15:0] vector[$];
+    bit ok;
+    int pushed, burst, statusReads, consumedBefore;
+
+    void'($urandom(2));
+    wait(sys.ready);
+
+    // constant registers
+    checkReg("FIFO depth", sys.REG_FIFO_DEPTH, FIFO_DEPTH);
+    checkReg("magic number 0", sys.REG_MAGIC0, "GAMI");
+    checkReg("magic number 1", sys.REG_MAGIC1, {8'h0, "eni"});
+
+    // empty FIFOs
+    sys.settle();
+    checkReg("free slots after reset", sys.REG_FINP_FREE, FIFO_DEPTH);
+    checkReg("fill level after reset", sys.REG_FOUT_FILL, 0);
+
+    // FIFO-in free slots, nothing is taken while IMAGine is stalled
+    sys.stallImagine(1);
+    for(int i=0; i<100; i++) sys.pushWord(sys.nopWord(TAG_FILL, i));
+    sys.settle();
+    checkReg("free slots after 100 words", sys.REG_FINP_FREE, FIFO_DEPTH-100);
+    for(int i=100; i<FIFO_DEPTH; i++) sys.pushWord(sys.nopWord(TAG_FILL, i));
+    sys.settle();
+    checkReg("free slots of a full FIFO-in", sys.REG_FINP_FREE, 0);
+    sys.axiRead(sys.REG_FIFO_STATUS, val);
+    check("full flag", val[sys.BIT_FINP_FULL], 1);
+    sys.stallImagine(0);
+    sys.waitConsumed(FIFO_DEPTH, ok);
+    sys.settle();
+    checkReg("free slots after IMAGine took the words", sys.REG_FINP_FREE, FIFO_DEPTH);
+    checkOrder(TAG_FILL, FIFO_DEPTH);
+
+    // kernel load: one free-slot read per burst (img_pushInstrBurst)
+    pushed = 0;
+    statusReads = 0;
+    while(pushed < KERNEL_LEN) begin
+      sys.axiRead(sys.REG_FINP_FREE, val);
+      statusReads = statusReads + 1;
+      if(val > sys.finpTrueFree()) begin
+        $display("EROR: %0d free slots reported, only %0d free", val, sys.finpTrueFree());
+        errors = errors + 1;
+      end
+      burst = (val < KERNEL_LEN-pushed) ? val : KERNEL_LEN-pushed;
+      for(int i=0; i<burst; i++) begin
+        sys.pushWord(sys.nopWord(TAG_KERNEL, pushed));
+        pushed = pushed + 1;
+      end
+    end
+    sys.waitConsumed(FIFO_DEPTH + KERNEL_LEN, ok);
+    if(!ok) begin
+      $display("EROR: kernel was not taken, %0d words", sys.consumed.size() - FIFO_DEPTH);
+      errors = errors + 1;
+    end
+    checkOrder(TAG_KERNEL, KERNEL_LEN);
+    check("dropped words", sys.finpDropped, 0);
+    $display("INFO: kernel of %0d words loaded with %0d status reads (%0d with a check per word)",
+             KERNEL_LEN, statusReads, KERNEL_LEN);
+    if(statusReads*16 > KERNEL_LEN) begin
+      $display("EROR: too many status reads");
+      errors = errors + 1;
+    end
+
+    // FIFO-out fill level
+    for(int i=0; i<40; i++) vector.push_back($urandom);
+    sys.emitVector(vector, 30);
+    sys.settle();
+    checkReg("fill level of a vector", sys.REG_FOUT_FILL, 40);
+    sys.axiRead(sys.REG_FIFO_STATUS, val);
+    check("valid flag", val[sys.BIT_FOUT_VALID], 1);
+    for(int i=0; i<40; i++) begin
+      sys.popWord(val);
+      check($sformatf("FIFO-out word %0d", i), val, sys.foutWord(vector[i], i == 39));
+      if(i == 14) begin
+        sys.settle();
+        checkReg("fill level after 15 pops", sys.REG_FOUT_FILL, 25);
+      end
+    end
+    sys.settle();
+    checkReg("fill level after all pops", sys.REG_FOUT_FILL, 0);
+    sys.axiRead(sys.REG_FIFO_STATUS, val);
+    check("valid flag of an empty FIFO-out", val[sys.BIT_FOUT_VALID], 0);
+
+    // FIFO reset drops the content of FIFO-in
+    sys.stallImagine(1);
+    for(int i=0; i<10; i++) sys.pushWord(sys.nopWord(TAG_RESET, i));
+    sys.settle();
+    checkReg("free slots before reset", sys.REG_FINP_FREE, FIFO_DEPTH-10);
+    sys.setFifoCtrl(1 << sys.BIT_FIFO_RST);
+    sys.settle();
+    sys.setFifoCtrl(0);
+    sys.settle();
+    checkReg("free slots after reset", sys.REG_FINP_FREE, FIFO_DEPTH);
+    consumedBefore = sys.consumed.size();
+    sys.stallImagine(0);
+    sys.settle();
+    check("words taken after reset", sys.consumed.size(), consumedBefore);
+
+    if(errors == 0) $display("PASS: IMAGine IP FIFO counts");
+    else            $display("FAIL: IMAGine IP FIFO counts, %0d errors", errors);
+    $finish;
+  end
+
+
+endmodule
@@ -0,0 +1,155 @@
+/*********************************************************************************
+* Copyright (c) 2024, Computer Systems Design Lab, University of Arkansas        *
+*                                                                                *
+* All rights reserved.                                                           *
+*                                                                                *
+* Permission is hereby granted, free of charge, to any person obtaining a copy   *
+* of this software and associated documentation files (the "Software"), to deal  *
+* in the Software without restriction, including without limitation the rights   *
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      *
+* copies of the Software, and to permit persons to whom the Software is          *
+* furnished to do so, subject to the following conditions:                       *
+*                                                                                *
+* The above copyright notice and this permission notice shall be included in all *
+* copies or substantial portions of the Software.                                *
+*                                                                                *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       *
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    *
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         *
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  *
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  *
+* SOFTWARE.                                                                      *
+**********************************************************************************
+
+==================================================================================
+
+  Version: v1.0
+
+  Description:
+  Testbench of the packed FIFO-out mode of the IMAGine IP (reg1 bit 5).
+  The same vectors (odd and even lengths) are written into FIFO-out in the
+  unpacked mode, then in the packed mode. It checks that
+    - the unpacked words carry the data and the attributes
+    - the packed words are {second, first} of the unpacked results, with 0
+      in the upper half of an unpaired last datum, so a vector takes
+      ceil(length/2) words and reads
+    - data are never paired across back-to-back vectors
+    - the unpacked mode works again after the packed mode
+  Run with "make sim-ip-packed" from work/.
+
+================================================================================*/
+
+
+`timescale 1ns/100ps
+
+
+module imagine_gemv_packed_tb;
+
+  imagine_gemv_tbsys sys ();
+
+  localparam VEC_CNT = 6;
+  localparam int VEC_LEN [VEC_CNT] = '{1, 2, 7, 64, 33, 256};
+
+  int errors = 0;
+
+  task automatic check(input string what, input logic [31:0] got, input logic [31:0] exp);
+    if(got !== exp) begin
+      $display("EROR: %s: %0d (%h), expected %0d (%h)", what, got, got, exp, exp);
+      errors = errors + 1;
+    end
+  endtask
+
+  task automatic checkReg(input string what, input int r, input logic [31:0] exp);
+    logic [31:0] val;
+    sys.axiRead(r, val);
+    check(what, val, exp);
+  endtask
+
+  // switches the FIFO-out mode, then waits for the mode to reach the IMAGine clock
+  task automatic setPacked(input bit enable);
+    sys.setFifoCtrl((1 << sys.BIT_FOUT_AUTORD) | (32'(enable) << sys.BIT_FOUT_PACK));
+    sys.settle();
+  endtask
+
+  // pops a packed vector and checks it against its unpacked results
+  task automatic popPacked(input string what, input logic [15:0] unpacked[$]);
+    logic [31:0] val;
+    logic [31:0] words[$];
+    sys.foutPackedWords(unpacked, words);
+    foreach(words[i]) begin
+      sys.popWord(val);
+      check($sformatf("%s, packed word %0d", what, i), val, words[i]);
+    end
+  endtask
+
+
+  initial begin
+    logic [31:0] val;
+    logic [15:0] vectors[VEC_CNT][$];
+    logic [15:0] unpacked[VEC_CNT][$];
+    logic [15:0] vector[$];
+    int readsBefore, unpackedReads, packedReads;
+    int packedWords = 0;
+
+    void'($urandom(5));
+    wait(sys.ready);
+    for(int v=0; v<VEC_CNT; v++)
+      for(int i=0; i<VEC_LEN[v]; i++) vectors[v].push_back($urandom);
+
+    // unpacked results
+    setPacked(0);
+    readsBefore = sys.busReads;
+    for(int v=0; v<VEC_CNT; v++) begin
+      sys.emitVector(vectors[v], 30);
+      sys.settle();
+      for(int i=0; i<VEC_LEN[v]; i++) begin
+        sys.popWord(val);
+        check($sformatf("vector %0d, unpacked word %0d", v, i), val, sys.foutWord(vectors[v][i], i == VEC_LEN[v]-1));
+        unpacked[v].push_back(val[15:0]);
+      end
+    end
+    unpackedReads = sys.busReads - readsBefore;
+
+    // packed results, a vector at a time
+    setPacked(1);
+    readsBefore = sys.busReads;
+    for(int v=0; v<VEC_CNT; v++) begin
+      sys.emitVector(vectors[v], 30);
+      sys.settle();
+      checkReg($sformatf("fill level of packed vector %0d", v), sys.REG_FOUT_FILL, (VEC_LEN[v]+1)/2);
+      popPacked($sformatf("vector %0d", v), unpacked[v]);
+      packedWords = packedWords + (VEC_LEN[v]+1)/2;
+    end
+    packedReads = sys.busReads - readsBefore - VEC_CNT;     // without the fill-level reads
+    check("reads of the packed vectors", packedReads, packedWords);
+    $display("INFO: FIFO-out reads, unpacked %0d, packed %0d", unpackedReads, packedReads);
+
+    // back-to-back vectors of odd length are not paired with each other
+    sys.emitVector(vectors[2], 0);
+    sys.emitVector(unpacked[4], 0);
+    sys.settle();
+    checkReg("fill level of back-to-back vectors", sys.REG_FOUT_FILL, (VEC_LEN[2]+1)/2 + (VEC_LEN[4]+1)/2);
+    popPacked("first back-to-back vector", unpacked[2]);
+    popPacked("second back-to-back vector", unpacked[4]);
+
+    // unpacked mode again
+    setPacked(0);
+    vector = '{16'h0001, 16'h8000, 16'hFFFF};
+    sys.emitVector(vector, 0);
+    sys.settle();
+    checkReg("fill level after the packed mode", sys.REG_FOUT_FILL, 3);
+    foreach(vector[i]) begin
+      sys.popWord(val);
+      check($sformatf("unpacked word %0d after the packed mode", i), val, sys.foutWord(vector[i], i == 2));
+    end
+
+    sys.settle();
+    checkReg("fill level at the end", sys.REG_FOUT_FILL, 0);
+    if(errors == 0) $display("PASS: IMAGine IP packed FIFO-out mode");
+    else            $display("FAIL: IMAGine IP packed FIFO-out mode, %0d errors", errors);
+    $finish;
+  end
+
+
+endmodule
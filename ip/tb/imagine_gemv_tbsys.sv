@@ -0,0 +1,358 @@
+/*********************************************************************************
+* Copyright (c) 2024, Computer Systems Design Lab, University of Arkansas        *
+*                                                                                *
+* All rights reserved.                                                           *
+*                                                                                *
+* Permission is hereby granted, free of charge, to any person obtaining a copy   *
+* of this software and associated documentation files (the "Software"), to deal  *
+* in the Software without restriction, including without limitation the rights   *
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      *
+* copies of the Software, and to permit persons to whom the Software is          *
+* furnished to do so, subject to the following conditions:                       *
+*                                                                                *
+* The above copyright notice and this permission notice shall be included in all *
+* copies or substantial portions of the Software.                                *
+*                                                                                *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       *
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    *
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         *
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  *
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  *
+* SOFTWARE.                                                                      *
+**********************************************************************************
+
+==================================================================================
+
+  Version: v1.0
+
+  Description:
+  Test system of the IMAGine IP (imagine_gemv_v1_0) for the IP-level
+  testbenches. It provides
+    - the AXI clock and a gated IMAGine clock, to stall the IMAGine side
+    - an AXI4-Lite master with the register accesses of the driver, which
+      counts the bus transactions
+    - a behavioral DMA engine on the AXI-Stream port of FIFO-in
+    - a monitor of the words that imagine_wrapper takes from FIFO-in
+    - a data source on the imagine_wrapper outputs, that writes data
+      vectors into FIFO-out (forced on the imagine_ip nets)
+  FIFO-in/out are the behavioral model in fifo_generator_0_model.sv.
+
+================================================================================*/
+
+
+`timescale 1ns/100ps
+
+
+module imagine_gemv_tbsys #(
+  parameter AXI_CLK_PERIOD = 10,
+  parameter IMG_CLK_PERIOD = 6,
+  parameter TIMEOUT = 200000     // clock cycles of a wait
+);
+
+  // register map of imagine_gemv_v1_0_S00_AXI
+  localparam REG_FINP_DATA   = 0,
+             REG_FIFO_CTRL   = 1,
+             REG_IMG_CTRL    = 2,
+             REG_FOUT_DATA   = 8,
+             REG_FIFO_STATUS = 9,
+             REG_IMG_STATUS  = 10,
+             REG_FINP_FREE   = 11,
+             REG_FOUT_FILL   = 12,
+             REG_FIFO_DEPTH  = 13,
+             REG_MAGIC0      = 14,
+             REG_MAGIC1      = 15;
+  // bits of REG_FIFO_CTRL
+  localparam BIT_FIFO_RST    = 0,
+             BIT_FINP_WR     = 1,
+             BIT_FOUT_RD     = 2,
+             BIT_FINP_AUTOWR = 3,
+             BIT_FOUT_AUTORD = 4,
+             BIT_FOUT_PACK   = 5;
+  // bits of REG_FIFO_STATUS
+  localparam BIT_FINP_FULL  = 0,
+             BIT_FOUT_VALID = 1;
+
+  localparam FIFO_DEPTH = 1024;
+
+
+  // ---- Clocks and reset
+  reg  aclk = 0;
+  reg  imgClkFree = 0;
+  bit  imgClkEn = 1;
+  wire imgClk;
+  reg  aresetn = 0;
+  bit  ready = 0;     // set after the reset
+
+  always #(AXI_CLK_PERIOD/2.0) aclk = ~aclk;
+  always #(IMG_CLK_PERIOD/2.0) imgClkFree = ~imgClkFree;
+  assign imgClk = imgClkFree && imgClkEn;
+
+  initial begin
+    repeat(8) @(posedge aclk);
+    aresetn = 1;
+    repeat(4) @(posedge aclk);
+    ready = 1;
+  end
+
+  // stops (or restarts) the IMAGine clock, nothing is taken from FIFO-in while stopped
+  task automatic stallImagine(input bit stall);
+    @(negedge imgClkFree);
+    imgClkEn = !stall;
+  endtask
+
+
+  // ---- Device under test
+  reg  [5:0]  awaddr = 0;
+  reg         awvalid = 0;
+  wire        awready;
+  reg  [31:0] wdata = 0;
+  reg         wvalid = 0;
+  wire        wready;
+  wire [1:0]  bresp;
+  wire        bvalid;
+  reg         bready = 1;
+  reg  [5:0]  araddr = 0;
+  reg         arvalid = 0;
+  wire        arready;
+  wire [31:0] rdata;
+  wire [1:0]  rresp;
+  wire        rvalid;
+  reg         rready = 1;
+  reg  [31:0] axisData = 0;
+  reg         axisLast = 0;
+  reg         axisValid = 0;
+  wire        axisReady;
+  wire        eovIrq;
+
+  imagine_gemv_v1_0 dut (
+      .imagine_clk(imgClk),
+      .s00_axis_tdata(axisData),
+      .s00_axis_tlast(axisLast),
+      .s00_axis_tvalid(axisValid),
+      .s00_axis_tready(axisReady),
+      .eov_irq(eovIrq),
+      .s00_axi_aclk(aclk),
+      .s00_axi_aresetn(aresetn),
+      .s00_axi_awaddr(awaddr),
+      .s00_axi_awprot(3'b0),
+      .s00_axi_awvalid(awvalid),
+      .s00_axi_awready(awready),
+      .s00_axi_wdata(wdata),
+      .s00_axi_wstrb(4'hF),
+      .s00_axi_wvalid(wvalid),
+      .s00_axi_wready(wready),
+      .s00_axi_bresp(bresp),
+      .s00_axi_bvalid(bvalid),
+      .s00_axi_bready(bready),
+      .s00_axi_araddr(araddr),
+      .s00_axi_arprot(3'b0),
+      .s00_axi_arvalid(arvalid),
+      .s00_axi_arready(arready),
+      .s00_axi_rdata(rdata),
+      .s00_axi_rresp(rresp),
+      .s00_axi_rvalid(rvalid),
+      .s00_axi_rready(rready)
+    );
+
+
+  // ---- AXI4-Lite master
+  int busWrites = 0;
+  int busReads  = 0;
+  logic [31:0] fifoCtrl = 0;    // shadow of REG_FIFO_CTRL, as kept by the driver
+
+  task automatic axiWrite(input int r, input logic [31:0] data);
+    @(negedge aclk);
+    awaddr  = r << 2;
+    awvalid = 1;
+    wdata   = data;
+    wvalid  = 1;
+    do @(posedge aclk); while(!(awready && wready));
+    @(negedge aclk);
+    awvalid = 0;
+    wvalid  = 0;
+    while(!bvalid) @(posedge aclk);
+    busWrites = busWrites + 1;
+  endtask
+
+  task automatic axiRead(input int r, output logic [31:0] data);
+    @(negedge aclk);
+    araddr  = r << 2;
+    arvalid = 1;
+    do @(posedge aclk); while(!arready);
+    @(negedge aclk);
+    arvalid = 0;
+    do @(posedge aclk); while(!rvalid);
+    data = rdata;
+    busReads = busReads + 1;
+  endtask
+
+  task automatic setFifoCtrl(input logic [31:0] data);
+    fifoCtrl = data;
+    axiWrite(REG_FIFO_CTRL, data);
+  endtask
+
+  // a pulse-gen bit of REG_FIFO_CTRL is set then cleared (img_genFinpWrPulse/img_genFoutRdPulse)
+  task automatic pulseFifoCtrl(input int bitNo);
+    axiWrite(REG_FIFO_CTRL, fifoCtrl | (1 << bitNo));
+    axiWrite(REG_FIFO_CTRL, fifoCtrl);
+  endtask
+
+  // pushes a word into FIFO-in through the register path, the pulse is
+  // not needed in auto-strobe mode
+  task automatic pushWord(input logic [31:0] w);
+    axiWrite(REG_FINP_DATA, w);
+    if(!fifoCtrl[BIT_FINP_AUTOWR]) pulseFifoCtrl(BIT_FINP_WR);
+  endtask
+
+  // pops the head of FIFO-out through the register path, the pulse is
+  // not needed in auto-strobe mode
+  task automatic popWord(output logic [31:0] w);
+    axiRead(REG_FOUT_DATA, w);
+    if(!fifoCtrl[BIT_FOUT_AUTORD]) pulseFifoCtrl(BIT_FOUT_RD);
+  endtask
+
+  // waits for the registers to follow the FIFOs (clock-crossing and register latency)
+  task automatic settle();
+    repeat(16) @(posedge aclk);
+  endtask
+
+
+  // ---- FIFO-in consumer monitor
+  // a GEMV-array NOP, the other bits are ignored by the array. They carry
+  // a tag and a sequence number to check the order.
+  function automatic logic [31:0] nopWord(input int tag, input int seq);
+    return {2'b00, 4'b0000, 10'(tag), 16'(seq)};
+  endfunction
+
+  logic [31:0] consumed[$];     // words taken by imagine_wrapper, in order
+
+  always @(posedge imgClk) begin
+    if(dut.imagine_gemv_v1_0_S00_AXI_inst.imgip_inst.fifoin_rd_en
+       && dut.imagine_gemv_v1_0_S00_AXI_inst.imgip_inst.fifoin_valid)
+      consumed.push_back(dut.imagine_gemv_v1_0_S00_AXI_inst.imgip_inst.fifoin_dout);
+  end
+
+  // words written into a full FIFO-in (dropped)
+  int finpDropped = 0;
+
+  always @(posedge aclk) begin
+    if(dut.imagine_gemv_v1_0_S00_AXI_inst.imgip_inst.fifoIn.wr_en
+       && dut.imagine_gemv_v1_0_S00_AXI_inst.imgip_inst.fifoIn.full)
+      finpDropped = finpDropped + 1;
+  end
+
+  // true free slots of FIFO-in, to check that the register never over-reports
+  function automatic int finpTrueFree();
+    return FIFO_DEPTH - dut.imagine_gemv_v1_0_S00_AXI_inst.imgip_inst.fifoIn.occupancy;
+  endfunction
+
+  // waits until imagine_wrapper has taken n words in total
+  task automatic waitConsumed(input int n, output bit ok);
+    int cycles = 0;
+    while(consumed.size() < n && cycles < TIMEOUT) begin
+      @(posedge aclk);
+      cycles = cycles + 1;
+    end
+    ok = consumed.size() >= n;
+  endtask
+
+
+  // ---- DMA engine on the AXI-Stream port
+  bit dmaBusy = 0;
+  int dmaCycles = 0;        // clock cycles of the last transfer
+  int axisStalls = 0;       // cycles the stream was held back while FIFO-in could take the word
+
+  // starts the transfer of a program and returns right away (img_submitProgramDMA)
+  // @param gapPct  percentage of cycles the DMA engine has no word ready
+  task automatic dmaSubmit(input logic [31:0] words[$], input int gapPct);
+    wait(!dmaBusy);
+    dmaBusy = 1;
+    fork
+      begin
+        int cycles = 0;
+        foreach(words[i]) begin
+          @(negedge aclk);
+          axisValid = 0;
+          while(($urandom % 100) < gapPct) begin
+            @(negedge aclk);
+            cycles = cycles + 1;
+          end
+          axisValid = 1;
+          axisData  = words[i];
+          axisLast  = (i == words.size()-1);
+          do begin
+            @(posedge aclk);
+            cycles = cycles + 1;
+          end while(!axisReady);
+        end
+        @(negedge aclk);
+        axisValid = 0;
+        axisLast  = 0;
+        dmaCycles = cycles;
+        dmaBusy   = 0;
+      end
+    join_none
+  endtask
+
+  // waits for the end of the transfer (img_waitDMA)
+  task automatic dmaWait();
+    wait(!dmaBusy);
+  endtask
+
+  // AK-NOTE: The stream may only be held back by a full FIFO-in, a register
+  // path write in the same cycle, or a FIFO reset.
+  always @(posedge aclk) begin
+    if(axisValid && !axisReady
+       && !dut.imagine_gemv_v1_0_S00_AXI_inst.imgip_inst.fifoin_full
+       && !dut.imagine_gemv_v1_0_S00_AXI_inst.imgip_inst.finp_wr_en
+       && !dut.imagine_gemv_v1_0_S00_AXI_inst.imgip_inst.fifo_srst)
+      axisStalls = axisStalls + 1;
+  end
+
+
+  // ---- FIFO-out data source
+  // AK-NOTE: The GEMV array only outputs data after a complete program, so
+  // the outputs of imagine_wrapper are overridden with the data source. The
+  // words written into FIFO-out are {attributes, 8'h0, data}.
+  reg [15:0] srcData = 0;
+  reg [1:0]  srcAttrib = 0;     // {isLast, isData}
+  reg        srcValid = 0;
+
+  initial begin
+    force dut.imagine_gemv_v1_0_S00_AXI_inst.imgip_inst.imgInt_dataout      = srcData;
+    force dut.imagine_gemv_v1_0_S00_AXI_inst.imgip_inst.imgInt_dataAttrib   = srcAttrib;
+    force dut.imagine_gemv_v1_0_S00_AXI_inst.imgip_inst.imgInt_dataoutValid = srcValid;
+  end
+
+  // writes a vector into FIFO-out, one element per IMAGine clock with random gaps
+  // @param gapPct  percentage of cycles without an element
+  task automatic emitVector(input logic [15:0] data[$], input int gapPct);
+    foreach(data[i]) begin
+      while(($urandom % 100) < gapPct) begin
+        @(negedge imgClk);
+        srcValid = 0;
+      end
+      @(negedge imgClk);
+      srcValid  = 1;
+      srcData   = data[i];
+      srcAttrib = {i == data.size()-1, 1'b1};
+    end
+    @(negedge imgClk);
+    srcValid = 0;
+  endtask
+
+  // the FIFO-out word of an element in the unpacked format
+  function automatic logic [31:0] foutWord(input logic [15:0] data, input bit isLast);
+    return {6'b0, isLast, 1'b1, 8'h0, data};
+  endfunction
+
+  // the FIFO-out words of a vector in the packed format, {second, first}
+  function automatic void foutPackedWords(input logic [15:0] data[$], ref logic [31:0] words[$]);
+    words.delete();
+    for(int i=0; i<data.size(); i+=2)
+      words.push_back({(i+1 < data.size()) ? data[i+1] : 16'h0, data[i]});
+  endfunction
+
+
+endmodule
@@ -54,7 +54,8 @@ Usage:
 module alu_serial_ff #(
   // Parameters
   parameter DEBUG = 1,
-  parameter STREAM_WIDTH = 16   // How many x/y streams are coming
+  parameter STREAM_WIDTH = 16,  // How many x/y streams are coming
+  parameter BOOTH_RADIX = 2     // booth's encoding used by the ALUs: 2 or 4
 )(
   clk,         // clock
   reset,       // reset registers
@@ -139,7 +140,7 @@ module alu_serial_ff #(
   *     alu_unit_arr[i].y   <- y_streams[i]
   *     alu_unit_arr[i].out -> out_streams[i]
   */
-  alu_serial_unit #(.DEBUG(DEBUG))
+  alu_serial_unit #(.DEBUG(DEBUG), .BOOTH_RADIX(BOOTH_RADIX))
     alu_unit_arr[STREAM_WIDTH-1:0] (
       .clk(clk),
       .reset(reset),
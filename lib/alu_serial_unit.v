@@ -32,8 +32,9 @@
   This module uses the boothR2_serial_alu module to build the configurable
   alu unit for PiCaSO.
 
-  Version: v1.1
-  <----update me---->
+  Version: v1.2
+  Added the booth's radix-4 variant, selected by the BOOTH_RADIX parameter.
+  In radix-4 mode, each UPDATEPP pass consumes 2 multiplier bits.
 
 ================================================================================*/
 
@@ -48,14 +49,22 @@ Usage:
     reset   : Use it to reset the registers
     out     : Connect the output stream
 
+Radix-4 mode (BOOTH_RADIX = 4):
+    loadMbit           : Saves the multiplier bit 2j into curMbit_reg (alone),
+                         or bit 2j+1 into prevMbit_reg (with opLoad)
+    loadMbit && ce_alu : Sign-extension cycle, computes using the sign bits
+                         of the last computed bit instead of x and y
+
 check alu_serial_unit_params.v for opConfig codes.
 */
 
 `timescale 1ns/100ps
+`include "ak_macros.v"
 
 
 module alu_serial_unit #(
-  parameter DEBUG = 1
+  parameter DEBUG = 1,
+  parameter BOOTH_RADIX = 2   // booth's encoding to use for multiplication: 2 or 4
 ) (
   clk,        // clock
   reset,      // reset registers
@@ -85,6 +94,8 @@ module alu_serial_unit #(
 
   localparam OP_WIDTH = ALU_OP_WIDTH;  // short-hand, removing the scope-prefix
 
+  `AK_ASSERT(BOOTH_RADIX == 2 || BOOTH_RADIX == 4)
+
 
   // IO ports
   input                  clk;   
@@ -172,10 +183,48 @@ module alu_serial_unit #(
   endfunction
 
 
+  /*
+  Booth'r Radix-4 Encoding table
+  -----------------------------------------------------
+    mult |  Return code {dbl, op}
+  -------|---------------------------------------------
+    000  |  Copy-X (no change to partial product, NOP)
+    001  |  ADD    (X + Y)
+    010  |  ADD    (X + Y)
+    011  |  ADD    (X + 2Y)
+    100  |  SUB    (X - 2Y)
+    101  |  SUB    (X - Y)
+    110  |  SUB    (X - Y)
+    111  |  COPY-X (no change to partial product, NOP)
+  -----------------------------------------------------
+  */
+  function automatic [2:0] boothEncode4;
+    input [2:0] _mult;
+
+    begin
+      // Booth's radix-4 encoding
+      (* full_case, parallel_case *)
+      case (_mult) 
+          3'b000: boothEncode4 = {1'b0, BOOTHR2_CPX};   // NOP
+          3'b001: boothEncode4 = {1'b0, BOOTHR2_ADD};
+          3'b010: boothEncode4 = {1'b0, BOOTHR2_ADD};
+          3'b011: boothEncode4 = {1'b1, BOOTHR2_ADD};
+          3'b100: boothEncode4 = {1'b1, BOOTHR2_SUB};
+          3'b101: boothEncode4 = {1'b0, BOOTHR2_SUB};
+          3'b110: boothEncode4 = {1'b0, BOOTHR2_SUB};
+          3'b111: boothEncode4 = {1'b0, BOOTHR2_CPX};   // NOP
+      endcase
+    end
+  endfunction
+
+
   // Internal Signals
   (* extract_enable = "yes", extract_reset = "yes" *)
   reg   prevMbit_reg = 0;   // default reset value, it has explicit reset
   wire  prevMbit_reg_in;    // input to the prevMbit_reg
+  wire  prevMbit_load;      // load enable of the prevMbit_reg
+  wire  alu_x;              // operand-1 stream of the full-adder/subtractor
+  wire  alu_y;              // operand-2 stream of the full-adder/subtractor
 
   (* extract_enable = "yes", extract_reset = "yes" *)
   reg  [BOOTHR2_OP_WIDTH-1 : 0] op_reg = 0;       // default reset value, it has explicit reset
@@ -187,12 +236,12 @@ module alu_serial_unit #(
   always @(posedge clk) begin
     if (local_ce) begin  // don't change state if local_ce is low
       if (resetMbit)     prevMbit_reg <= 0;               // clear the mbit-reg if requested
-      else if (loadMbit) prevMbit_reg <= prevMbit_reg_in; // load the register if requested
+      else if (prevMbit_load) prevMbit_reg <= prevMbit_reg_in; // load the register if requested
       else               prevMbit_reg <= prevMbit_reg;    // otherwise, hold the old value
     end
   end
 
-  assign prevMbit_reg_in = x;   // for booth's radix-2, multiplier-bit will be coming through x
+  assign prevMbit_reg_in = x;   // multiplier-bit will be coming through x
 
 
   // Load op-code to the op_reg register based on the requested configuration
@@ -205,7 +254,69 @@ module alu_serial_unit #(
           op_reg <= op_reg;         // if opLoad not set, hold the current value
   end
 
-  assign op_reg_in = opEncoder(opConfig, {x, prevMbit_reg});   // generate input for op_reg. x: current multiplier bit, prevMbit: previous multiplier bit
+
+  // Radix-specific logic: op-code generation and operand streams of the full-adder/subtractor
+  generate
+    if (BOOTH_RADIX == 4) begin: radix4
+      // AK-NOTE: A radix-4 pass adds 0, +/-y, or +/-2y to the 16-bit partial-product
+      // window, which needs 2 more bits than the window. So, the FSM runs two
+      // sign-extension cycles at the end of the pass. The sign-extension cycle is
+      // signaled by asserting loadMbit along with ce_alu, which is never used
+      // otherwise. This way, no new control signal needs to run through the
+      // PiCaSO array.
+      (* extract_enable = "yes" *)
+      reg   curMbit_reg = 0;    // multiplier bit 2j, saved one cycle before the op-code is loaded
+      (* extract_enable = "yes", extract_reset = "yes" *)
+      reg   dbl_reg = 0;        // doubles y (+/-2y of booth's radix-4 encoding)
+      (* extract_enable = "yes", extract_reset = "yes" *)
+      reg   x_dly_reg = 0;      // x of the last computed bit, sign bit at the end of the pass
+      (* extract_enable = "yes", extract_reset = "yes" *)
+      reg   y_dly_reg = 0;      // y of the last computed bit, stream of 2y and sign bit at the end of the pass
+
+      wire       extend = ce_alu & loadMbit;   // sign-extension cycle
+      wire [2:0] booth  = boothEncode4({x, curMbit_reg, prevMbit_reg});   // x: multiplier bit 2j+1
+
+      always @(posedge clk) begin
+        if (local_ce && loadMbit && !opLoad && !ce_alu)
+          curMbit_reg <= x;     // multiplier bit 2j is coming through x
+        else
+          curMbit_reg <= curMbit_reg;
+      end
+
+      always @(posedge clk) begin
+        if(reset)
+          dbl_reg <= 0;
+        else if(opLoad && local_ce)
+          dbl_reg <= opConfig[2] & booth[2];    // only booth's encoding may double y
+        else
+          dbl_reg <= dbl_reg;
+      end
+
+      // delayed streams are updated only for the computed bits, not for the sign-extension cycles
+      always @(posedge clk) begin
+        if(reset) begin
+          x_dly_reg <= 0;
+          y_dly_reg <= 0;     // also the LSB of 2y
+        end else if(ce_alu && !extend && local_ce) begin
+          x_dly_reg <= x;
+          y_dly_reg <= y;
+        end else begin
+          x_dly_reg <= x_dly_reg;
+          y_dly_reg <= y_dly_reg;
+        end
+      end
+
+      assign prevMbit_load = loadMbit & opLoad;   // saves multiplier bit 2j+1 for the next pass
+      assign op_reg_in = opConfig[2] ? booth[1:0] : opConfig[1:0];
+      assign alu_x = extend ? x_dly_reg : x;
+      assign alu_y = (extend | dbl_reg) ? y_dly_reg : y;
+    end else begin: radix2
+      assign prevMbit_load = loadMbit;
+      assign op_reg_in = opEncoder(opConfig, {x, prevMbit_reg});   // generate input for op_reg. x: current multiplier bit, prevMbit: previous multiplier bit
+      assign alu_x = x;
+      assign alu_y = y;
+    end
+  endgenerate
 
 
 
@@ -214,8 +325,8 @@ module alu_serial_unit #(
     boothR2_ALU (
       .clk(clk),
       .reset(reset),
-      .x(x), 
-      .y(y),
+      .x(alu_x), 
+      .y(alu_y),
       .ce(ce_alu),
       .op(op_reg),
       .out(out),
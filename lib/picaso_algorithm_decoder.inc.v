@@ -2,7 +2,7 @@
 // Include it where this module is used to get the named constants.
 
 
-localparam PICASO_ALGO_CODE_WIDTH = 4;
+localparam PICASO_ALGO_CODE_WIDTH = 5;
 
 
 // control codes 0-0: All control codes must be unique
@@ -27,7 +27,16 @@ localparam [PICASO_ALGO_CODE_WIDTH-1:0]
   PICASO_ALGO_bStreamWrite               = 11,
   // following control codes are defined for ACCUM-ROW FSM
   PICASO_ALGO_accumRow_setup             = 12,
-  PICASO_ALGO_accumRow_headstart         = 13;
+  PICASO_ALGO_accumRow_headstart         = 13,
+  // following control codes are defined for FILLREG FSM
+  PICASO_ALGO_bFillWrite                 = 14,
+  // following control codes are defined for MULT FSM (rest of the states are reused from UPDATEPP FSM)
+  PICASO_ALGO_aluMbitRst                 = 15,
+  // following control codes are defined for booth's radix-4 UPDATEPP and MULT FSMs (check footnote [2])
+  PICASO_ALGO_aluRst_opmxAopB_multReadInc      = 16,
+  PICASO_ALGO_multRead_1                       = 17,
+  PICASO_ALGO_opmxLoadParam_mbitLoad_bRead     = 18,
+  PICASO_ALGO_aluExt_bWrite                    = 19;
 
 
 
@@ -53,4 +62,18 @@ localparam [PICASO_ALGO_CODE_WIDTH-1:0]
 *       state for loading from the parameter register is not essential. However, I kept it
 *       unmodified to minimize changes and leaving room for future adjustment, in case
 *       I need to use two different configurations in the UPDATEPP FSM.
+*
+* [2] The radix-4 UPDATEPP pass reads 2 multiplier bits before the partial-product
+*     and multiplicand bits, so the pass takes one more cycle to start.
+*
+*       1. PICASO_ALGO_aluRst_opmxAopB_multReadInc : reads bit 2j and increments ptr-A1
+*       2. PICASO_ALGO_multRead_1                  : reads bit 2j+1
+*       3. PICASO_ALGO_bRead_0
+*       4. PICASO_ALGO_opmxLoadParam_mbitLoad_bRead: saves bit 2j in the ALU
+*       5. PICASO_ALGO_aluLoadParam_bRead          : loads the op-code using bits 2j+1, 2j, 2j-1
+*
+*     The sum can be 2 bits wider than the 16-bit partial-product window. So, the
+*     last PICASO_ALGO_aluDis_bWrite of the pass is replaced by 2 cycles of
+*     PICASO_ALGO_aluExt_bWrite, which compute the 2 extra bits while writing the
+*     previous ones. PICASO_ALGO_aluDis_bWrite_1 writes the last one.
 */
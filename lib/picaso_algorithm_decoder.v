@@ -178,6 +178,28 @@ module picaso_algorithm_decoder #(
   endtask
 
 
+  // clears the previous multiplier-bit storage of booth's ALU
+  task alu_mbitReset;
+    picaso_aluMbitReset = 1;
+  endtask
+
+
+  // saves the multiplier-bit in booth's radix-4 ALU (without loading the op-code)
+  task alu_mbitLoad;
+    picaso_aluMbitLoad = 1;
+  endtask
+
+
+  // sign-extension cycle of booth's radix-4 ALU.
+  // AK-NOTE: It is encoded as aluEn + aluMbitLoad, which is not used otherwise (check alu_serial_unit).
+  task alu_extend;
+    begin
+      picaso_aluEn = 1;
+      picaso_aluMbitLoad = 1;
+    end
+  endtask
+
+
   // loads alu configuration from top-level parameter register
   task alu_loadConf_param;
     begin
@@ -231,6 +253,16 @@ module picaso_algorithm_decoder #(
   endtask
 
 
+  // Same as bram_multRead, but increments ptrA1 to read the next multiplier bit (booth's radix-4)
+  task bram_multRead_inc;
+    begin
+      sel_portA_ptr = 1;
+      picaso_opmuxEn = 1;
+      inc_ptrA1 = 1;
+    end
+  endtask
+
+
   // writes the alu output to BRAM and increments the pointer, uses B1.
   // also, keeps opmux enabled.
   task bram_aluWrite_inc;
@@ -258,6 +290,16 @@ module picaso_algorithm_decoder #(
   endtask
 
 
+  // writes the external data to BRAM and increments the pointer, uses A0.
+  task bram_fillWrite_inc;
+    begin
+      sel_portA_ptr = 0;
+      picaso_extDataSave = 1;
+      inc_ptrA0 = 1;
+    end
+  endtask
+
+
   // loads the network-level from the top-level parameter register
   task net_loadLevel;
     begin
@@ -343,6 +385,32 @@ module picaso_algorithm_decoder #(
         //; // no other signal needs to be asserted here, transition table takes care of the rest.
       end
 
+      // FILLREG algorithm signals
+      PICASO_ALGO_bFillWrite: bram_fillWrite_inc;
+
+      // MULT algorithm signals (rest of the states are reused from UPDATEPP)
+      PICASO_ALGO_aluMbitRst: alu_mbitReset;
+
+      // booth's radix-4 UPDATEPP and MULT signals (rest of the states are reused from above)
+      PICASO_ALGO_aluRst_opmxAopB_multReadInc: begin
+        alu_reset;
+        opmux_loadConf_AopB;
+        bram_multRead_inc;
+      end
+
+      PICASO_ALGO_multRead_1: bram_multRead;
+
+      PICASO_ALGO_opmxLoadParam_mbitLoad_bRead: begin
+        opmux_loadConf_param;
+        alu_mbitLoad;
+        bram_read_inc;
+      end
+
+      PICASO_ALGO_aluExt_bWrite: begin
+        alu_extend;
+        bram_aluWrite_inc;
+      end
+
       // default to NOP
       PICASO_ALGO_NOP: ;    // initial values are NOP
       default: ;            // initial values are NOP
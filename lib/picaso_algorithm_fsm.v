@@ -84,7 +84,9 @@ module picaso_algorithm_fsm #(
   parameter DEBUG = 1,
   parameter PRECISION_WIDTH = -1,
   parameter INSTR_PARAM_WIDTH = -1,
-  parameter NET_LEVEL_WIDTH = -1
+  parameter NET_LEVEL_WIDTH = -1,
+  parameter PE_REG_WIDTH = -1,
+  parameter BOOTH_RADIX = -1
 ) (
   clk,                // clock
   precision,          // current precision value
@@ -98,6 +100,9 @@ module picaso_algorithm_fsm #(
   clrNetCaptureEn,   // clears the netCaptureEn flip-flop
   setPicasoPtrIncr,  // sets the picasoPtrIncr flip-flop
   clrPicasoPtrIncr,  // clears the picasoPtrIncr flip-flop
+  // special signals for multiplication algorithm
+  multNextPass,      // moves the pointers to the next multiplier bit
+  multLastPass,      // current pass is for the last multiplier bit
 
   // Debug probes
   dbg_clk_enable
@@ -109,6 +114,8 @@ module picaso_algorithm_fsm #(
   `AK_ASSERT2(PRECISION_WIDTH > 0, PRECISION_WIDTH_not_set)
   `AK_ASSERT2(NET_LEVEL_WIDTH > 0, NET_LEVEL_WIDTH_not_set)
   `AK_ASSERT2(INSTR_PARAM_WIDTH >= 0, INSTR_PARAM_WIDTH_not_set)
+  `AK_ASSERT2(PE_REG_WIDTH > 0, PE_REG_WIDTH_not_set)
+  `AK_ASSERT2(BOOTH_RADIX > 0, BOOTH_RADIX_not_set)
 
   
   // IO Ports
@@ -125,6 +132,9 @@ module picaso_algorithm_fsm #(
   output   setPicasoPtrIncr;
   output   clrPicasoPtrIncr;
 
+  output   multNextPass;
+  input    multLastPass;
+
   // Debug probes
   input   dbg_clk_enable;
 
@@ -154,6 +164,7 @@ module picaso_algorithm_fsm #(
   localparam COUNT0_VAL_WIDTH = 3,
              COUNT1_VAL_WIDTH = `AK_MAX(PRECISION_WIDTH, 4);  // Counter-1 needs to support upto given precision value and head-start count for ACCUM-ROW.
                                                               // 4-bits can handle head-start of upto 16 (load-val=15), which implies 32 blocks, and so 32x16 = 512 columns, and so 512x512 = 262K 2D array (Alveo U55 can support upto 64K array)
+  `AK_ASSERT2(PE_REG_WIDTH <= (1 << COUNT1_VAL_WIDTH), PE_REG_WIDTH_too_big_for_counter1)     // FILLREG loads (PE_REG_WIDTH - 1)
   wire [COUNT0_VAL_WIDTH-1:0] tran_tables_count0_val;
   wire                        tran_tables_count0_load;
   wire                        tran_tables_count0_en;
@@ -169,11 +180,15 @@ module picaso_algorithm_fsm #(
   wire      tran_tables_setPicasoPtrIncr;
   wire      tran_tables_clrPicasoPtrIncr;
 
+  wire      tran_tables_multNextPass;
+  wire      tran_tables_multLastPass;
+
   _algorithm_fsm_transition_tables #(
       .DEBUG(DEBUG),
       .SEL_WIDTH(ALGORITHM_SEL_WIDTH),
       .STATE_CODE_WIDTH(STATE_CODE_WIDTH),
-      .COUNT0_VAL_WIDTH(COUNT0_VAL_WIDTH) )
+      .COUNT0_VAL_WIDTH(COUNT0_VAL_WIDTH),
+      .BOOTH_RADIX(BOOTH_RADIX) )
     tran_tables (
       .selAlgo(selAlgo),
       .cur_state(state_reg),
@@ -193,7 +208,10 @@ module picaso_algorithm_fsm #(
       .setNetCaptureEn(tran_tables_setNetCaptureEn),
       .clrNetCaptureEn(tran_tables_clrNetCaptureEn),
       .setPicasoPtrIncr(tran_tables_setPicasoPtrIncr),
-      .clrPicasoPtrIncr(tran_tables_clrPicasoPtrIncr)
+      .clrPicasoPtrIncr(tran_tables_clrPicasoPtrIncr),
+
+      .multNextPass(tran_tables_multNextPass),
+      .multLastPass(tran_tables_multLastPass)
     );
 
 
@@ -246,6 +264,7 @@ module picaso_algorithm_fsm #(
       .PRECISION_WIDTH(PRECISION_WIDTH),
       .INSTR_PARAM_WIDTH(INSTR_PARAM_WIDTH),
       .NET_LEVEL_WIDTH(NET_LEVEL_WIDTH),
+      .PE_REG_WIDTH(PE_REG_WIDTH),
       .VAL_WIDTH(COUNT1_VAL_WIDTH) )
     counter1_valman(
       .precision(precision),
@@ -270,7 +289,9 @@ module picaso_algorithm_fsm #(
   assign setNetCaptureEn = tran_tables_setNetCaptureEn,
          clrNetCaptureEn = tran_tables_clrNetCaptureEn,
          setPicasoPtrIncr = tran_tables_setPicasoPtrIncr,
-         clrPicasoPtrIncr = tran_tables_clrPicasoPtrIncr;
+         clrPicasoPtrIncr = tran_tables_clrPicasoPtrIncr,
+         multNextPass = tran_tables_multNextPass;
+  assign tran_tables_multLastPass = multLastPass;
 
 
   // ---- Connect debug probes
@@ -295,6 +316,7 @@ module _counter1_val_manager #(
   parameter PRECISION_WIDTH = -1,
   parameter INSTR_PARAM_WIDTH = -1,
   parameter NET_LEVEL_WIDTH = -1,
+  parameter PE_REG_WIDTH = -1,
   parameter VAL_WIDTH = -1
 ) (
   precision,    // current precision
@@ -308,6 +330,7 @@ module _counter1_val_manager #(
   `AK_ASSERT2(PRECISION_WIDTH > 0, PRECISION_WIDTH_not_set)
   `AK_ASSERT2(INSTR_PARAM_WIDTH >= 0, INSTR_PARAM_WIDTH_not_set)
   `AK_ASSERT2(NET_LEVEL_WIDTH > 0, NET_LEVEL_WIDTH_not_set)
+  `AK_ASSERT2(PE_REG_WIDTH > 0, PE_REG_WIDTH_not_set)
   `AK_ASSERT2(VAL_WIDTH > 0, VAL_WIDTH_not_set)
 
 
@@ -340,6 +363,9 @@ module _counter1_val_manager #(
         loadVal = (1 << _netLevel) - 1;
       end
 
+      // One iteration per register row, (PE_REG_WIDTH - 1) is loaded as val0 is used as counter-expired signal
+      ALGORITHM_CTR1_SEL_REGWIDTH: loadVal = PE_REG_WIDTH - 1;
+
       // default hit is invalid: simulation-time warning
       default: $display("WARN: unsupported select for counter1_val_manager only, select: b%0b (%s:%0d)  %0t", select, `__FILE__, `__LINE__, $time);
     endcase
@@ -357,7 +383,8 @@ module _algorithm_fsm_transition_tables #(
   parameter DEBUG = 1,
   parameter SEL_WIDTH = -1,
   parameter STATE_CODE_WIDTH = -1,
-  parameter COUNT0_VAL_WIDTH = -1
+  parameter COUNT0_VAL_WIDTH = -1,
+  parameter BOOTH_RADIX = -1
 ) (
   selAlgo,        // selects one of the algorithms
 
@@ -379,7 +406,11 @@ module _algorithm_fsm_transition_tables #(
   setNetCaptureEn,   // sets the netCaptureEn flip-flop
   clrNetCaptureEn,   // clears the netCaptureEn flip-flop
   setPicasoPtrIncr,  // sets the picasoPtrIncr flip-flop
-  clrPicasoPtrIncr   // clears the picasoPtrIncr flip-flop
+  clrPicasoPtrIncr,  // clears the picasoPtrIncr flip-flop
+
+  // special signals for multiplication algorithm
+  multNextPass,      // moves the pointers to the next multiplier bit
+  multLastPass       // current pass is for the last multiplier bit
 );
 
 
@@ -388,6 +419,7 @@ module _algorithm_fsm_transition_tables #(
   `AK_ASSERT2(SEL_WIDTH>0, SEL_WIDTH_not_set)
   `AK_ASSERT2(STATE_CODE_WIDTH>0, STATE_CODE_WIDTH_not_set)
   `AK_ASSERT2(COUNT0_VAL_WIDTH>0, COUNT0_VAL_WIDTH_not_set)
+  `AK_ASSERT2(BOOTH_RADIX>0, BOOTH_RADIX_not_set)
 
 
 
@@ -413,6 +445,9 @@ module _algorithm_fsm_transition_tables #(
   output reg      setPicasoPtrIncr;
   output reg      clrPicasoPtrIncr;
 
+  output reg      multNextPass;
+  input  wire     multLastPass;
+
 
   // ---- Instantiate transition tables
   // -- ALU-OP transitions
@@ -471,7 +506,8 @@ module _algorithm_fsm_transition_tables #(
   transition_updatepp #(
       .DEBUG(DEBUG),
       .STATE_CODE_WIDTH(STATE_CODE_WIDTH),
-      .COUNT0_VAL_WIDTH(COUNT0_VAL_WIDTH) )
+      .COUNT0_VAL_WIDTH(COUNT0_VAL_WIDTH),
+      .BOOTH_RADIX(BOOTH_RADIX) )
     updatepp_table(
       .cur_state(updatepp_cur_state),
       .next_state(updatepp_next_state),
@@ -572,21 +608,110 @@ module _algorithm_fsm_transition_tables #(
     );
 
 
+  // -- FILLREG transitions
+  wire [STATE_CODE_WIDTH-1:0] fillreg_cur_state;
+  wire [STATE_CODE_WIDTH-1:0] fillreg_next_state;
+  wire                        fillreg_algo_done;
+
+  wire [COUNT0_VAL_WIDTH-1:0] fillreg_count0_val;
+  wire                        fillreg_count0_load;
+  wire                        fillreg_count0_en;
+  wire                        fillreg_count0_done;
+
+  wire [ALGORITHM_CTR1_SEL_WIDTH-1:0] fillreg_count1_valSelect;
+  wire                                fillreg_count1_load;
+  wire                                fillreg_count1_en;
+  wire                                fillreg_count1_done;
+
+
+  transition_fillreg #(
+      .DEBUG(DEBUG),
+      .STATE_CODE_WIDTH(STATE_CODE_WIDTH),
+      .COUNT0_VAL_WIDTH(COUNT0_VAL_WIDTH) )
+    fillreg_table(
+      .cur_state(fillreg_cur_state),
+      .next_state(fillreg_next_state),
+      .algo_done(fillreg_algo_done),
+
+      .count0_val(fillreg_count0_val),
+      .count0_load(fillreg_count0_load),
+      .count0_en(fillreg_count0_en),
+      .count0_done(fillreg_count0_done),
+
+      .count1_valSelect(fillreg_count1_valSelect),
+      .count1_load(fillreg_count1_load),
+      .count1_en(fillreg_count1_en),
+      .count1_done(fillreg_count1_done)
+    );
+
+
+  // -- MULT transitions
+  wire [STATE_CODE_WIDTH-1:0] mult_cur_state;
+  wire [STATE_CODE_WIDTH-1:0] mult_next_state;
+  wire                        mult_algo_done;
+
+  wire [COUNT0_VAL_WIDTH-1:0] mult_count0_val;
+  wire                        mult_count0_load;
+  wire                        mult_count0_en;
+  wire                        mult_count0_done;
+
+  wire [ALGORITHM_CTR1_SEL_WIDTH-1:0] mult_count1_valSelect;
+  wire                                mult_count1_load;
+  wire                                mult_count1_en;
+  wire                                mult_count1_done;
+
+  wire                                mult_multNextPass;
+  wire                                mult_multLastPass;
+
+
+  transition_mult #(
+      .DEBUG(DEBUG),
+      .STATE_CODE_WIDTH(STATE_CODE_WIDTH),
+      .COUNT0_VAL_WIDTH(COUNT0_VAL_WIDTH),
+      .BOOTH_RADIX(BOOTH_RADIX) )
+    mult_table(
+      .cur_state(mult_cur_state),
+      .next_state(mult_next_state),
+      .algo_done(mult_algo_done),
+
+      .count0_val(mult_count0_val),
+      .count0_load(mult_count0_load),
+      .count0_en(mult_count0_en),
+      .count0_done(mult_count0_done),
+
+      .count1_valSelect(mult_count1_valSelect),
+      .count1_load(mult_count1_load),
+      .count1_en(mult_count1_en),
+      .count1_done(mult_count1_done),
+
+      .multNextPass(mult_multNextPass),
+      .multLastPass(mult_multLastPass)
+    );
+
+
   // ---- connect common inputs
   assign aluop_cur_state = cur_state,
          accumrow_cur_state = cur_state,
          updatepp_cur_state = cur_state,
-         stream_cur_state = cur_state;
+         stream_cur_state = cur_state,
+         fillreg_cur_state = cur_state,
+         mult_cur_state = cur_state;
 
   assign aluop_count0_done = count0_done,
          accumrow_count0_done = count0_done,
          updatepp_count0_done = count0_done,
-         stream_count0_done = count0_done;
+         stream_count0_done = count0_done,
+         fillreg_count0_done = count0_done,
+         mult_count0_done = count0_done;
 
   assign aluop_count1_done = count1_done,
          accumrow_count1_done = count1_done,
          updatepp_count1_done = count1_done,
-         stream_count1_done = count1_done;
+         stream_count1_done = count1_done,
+         fillreg_count1_done = count1_done,
+         mult_count1_done = count1_done;
+
+  assign mult_multLastPass = multLastPass;
 
 
   // ---- multiplex between above tables
@@ -604,6 +729,7 @@ module _algorithm_fsm_transition_tables #(
     clrNetCaptureEn  = 0;
     setPicasoPtrIncr = 0;
     clrPicasoPtrIncr = 0;
+    multNextPass     = 0;
 
     // select between transition tables based on selAlgo
     (* full_case, parallel_case *)
@@ -658,6 +784,30 @@ module _algorithm_fsm_transition_tables #(
         clrPicasoPtrIncr = accumrow_clrPicasoPtrIncr;
       end
 
+      ALGORITHM_FILLREG: begin
+        next_state  = fillreg_next_state;
+        algo_done   = fillreg_algo_done;
+        count0_val  = fillreg_count0_val;
+        count0_load = fillreg_count0_load;
+        count0_en   = fillreg_count0_en;
+        count1_load = fillreg_count1_load;
+        count1_en   = fillreg_count1_en;
+        count1_valSelect = fillreg_count1_valSelect;
+      end
+
+      ALGORITHM_MULT: begin
+        next_state  = mult_next_state;
+        algo_done   = mult_algo_done;
+        count0_val  = mult_count0_val;
+        count0_load = mult_count0_load;
+        count0_en   = mult_count0_en;
+        count1_load = mult_count1_load;
+        count1_en   = mult_count1_en;
+        count1_valSelect = mult_count1_valSelect;
+        // connect special signals for multiplication algorithm
+        multNextPass = mult_multNextPass;
+      end
+
       default: $display("EROR: This algorithm selection code not valid, selAlgo = %b (%0t)", selAlgo, $time);
     endcase
   end
@@ -47,7 +47,8 @@ module picaso_controller #(
   parameter PICASO_ID_WIDTH = 8,     // width of PiCaSO block row/column IDs
   parameter TOKEN_WIDTH = 2,         // width of sequencing tokens
   parameter PE_REG_WIDTH = 16,       // width of the PE registers
-  parameter MAX_PRECISION = 16       // largest precision to support
+  parameter MAX_PRECISION = 16,      // largest precision to support
+  parameter BOOTH_RADIX = 2          // booth's encoding used by the PiCaSO ALUs: 2 or 4
 ) (
   clk,
   instruction,           // instruction word
@@ -106,6 +107,7 @@ module picaso_controller #(
   // Check if module parameters are consistent with include file parameters
   `AK_ASSERT(INSTRUCTION_WIDTH == PICASO_INSTR_WORD_WIDTH)
   `AK_ASSERT(PICASO_ID_WIDTH == PICASO_INSTR_ID_WIDTH)
+  `AK_ASSERT(BOOTH_RADIX == 2 || BOOTH_RADIX == 4)
 
 
   //localparam INSTR_WIDTH = PICASO_INSTR_WORD_WIDTH;
@@ -514,7 +516,8 @@ module picaso_controller #(
       .INSTR_PARAM_WIDTH(INSTR_PARAM_WIDTH),
       .NET_LEVEL_WIDTH(NET_LEVEL_WIDTH),
       .PE_REG_WIDTH(PE_REG_WIDTH),
-      .PRECISION_WIDTH(PRECISION_REG_WIDTH) )
+      .PRECISION_WIDTH(PRECISION_REG_WIDTH),
+      .BOOTH_RADIX(BOOTH_RADIX) )
     multicycle_driver (
       .clk(clk),
       .enTransition(multcycle_enTransition),
@@ -0,0 +1,210 @@
+/*********************************************************************************
+* Copyright (c) 2023, Computer Systems Design Lab, University of Arkansas        *
+*                                                                                *
+* All rights reserved.                                                           *
+*                                                                                *
+* Permission is hereby granted, free of charge, to any person obtaining a copy   *
+* of this software and associated documentation files (the "Software"), to deal  *
+* in the Software without restriction, including without limitation the rights   *
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      *
+* copies of the Software, and to permit persons to whom the Software is          *
+* furnished to do so, subject to the following conditions:                       *
+*                                                                                *
+* The above copyright notice and this permission notice shall be included in all *
+* copies or substantial portions of the Software.                                *
+*                                                                                *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       *
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    *
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         *
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  *
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  *
+* SOFTWARE.                                                                      *
+**********************************************************************************
+
+==================================================================================
+
+  Version: v1.0
+
+  Description:
+  Testbench of the FILLREG super-op on picaso_controller. A program of
+  SELECT, FILLREG, WRITE, FILLREG is streamed with the nextInstr handshake
+  of the front-end, and the BRAM writes driven on the PiCaSO control port
+  are recorded. Each FILLREG must produce PE_REG_WIDTH selective writes of
+  its DATA field to the rows of register RD, in order, and the instructions
+  around it must not be dropped or reordered. Run with "make sim-fillreg"
+  from work/.
+
+================================================================================*/
+
+
+`timescale 1ns/100ps
+`include "ak_macros.v"
+
+
+module picaso_controller_fillreg_tb;
+
+  `include "picaso_instruction_decoder.inc.v"
+
+  localparam INSTR_WIDTH  = PICASO_INSTR_WORD_WIDTH,
+             ADDR_WIDTH   = PICASO_INSTR_ADDR_WIDTH,
+             DATA_WIDTH   = PICASO_INSTR_DATA_WIDTH,
+             PE_REG_WIDTH = 16,
+             TIMEOUT      = 1000;   // clock cycles
+
+  // Instruction words (same encoding as the driver, without the submodule code)
+  localparam [INSTR_WIDTH-1:0] INSTR_SELECT_ALL = 30'h18C00000;
+
+  function [INSTR_WIDTH-1:0] instrFillreg(input integer rd, input [DATA_WIDTH-1:0] data);
+    instrFillreg = {PICASO_SUPEROP, 10'b0, data} | (rd << 19) | (PICASO_SCODE_FILLREG << 16);
+  endfunction
+
+  function [INSTR_WIDTH-1:0] instrWrite(input [ADDR_WIDTH-1:0] addr, input [DATA_WIDTH-1:0] data);
+    instrWrite = {PICASO_WRITE, addr, data};
+  endfunction
+
+
+  // ---- Clock and the device under test
+  reg clk = 0;
+  always #5 clk = ~clk;
+
+  reg  [INSTR_WIDTH-1:0]  instruction = PICASO_NOP;
+  reg                     inputValid = 0;
+  wire                    busy, nextInstr;
+  wire                    extDataSave, saveAluOut, selOp;
+  wire [DATA_WIDTH-1:0]   extDataIn;
+  wire [ADDR_WIDTH-1:0]   addrA;
+
+  picaso_controller #(
+      .DEBUG(0),
+      .INSTRUCTION_WIDTH(INSTR_WIDTH),
+      .PE_REG_WIDTH(PE_REG_WIDTH),
+      .MAX_PRECISION(16) )
+    dut (
+      .clk(clk),
+      .instruction(instruction),
+      .token_in(2'b0),
+      .inputValid(inputValid),
+      .token_out(),
+      .busy(busy),
+      .nextInstr(nextInstr),
+      .picaso_netLevel(),
+      .picaso_netConfLoad(),
+      .picaso_netCaptureEn(),
+      .picaso_aluConf(),
+      .picaso_aluConfLoad(),
+      .picaso_aluEn(),
+      .picaso_aluReset(),
+      .picaso_aluMbitReset(),
+      .picaso_aluMbitLoad(),
+      .picaso_opmuxConfLoad(),
+      .picaso_opmuxConf(),
+      .picaso_opmuxEn(),
+      .picaso_extDataSave(extDataSave),
+      .picaso_extDataIn(extDataIn),
+      .picaso_saveAluOut(saveAluOut),
+      .picaso_addrA(addrA),
+      .picaso_addrB(),
+      .picaso_selRow(),
+      .picaso_selCol(),
+      .picaso_selMode(),
+      .picaso_selEn(),
+      .picaso_selOp(selOp),
+      .picaso_ptrLoad(),
+      .picaso_ptrIncr(),
+      .dbg_clk_enable(1'b1)
+    );
+
+
+  // ---- Program and the expected BRAM writes
+  localparam PROG_LEN  = 4,
+             MAX_WRITE = 64;
+
+  reg [INSTR_WIDTH-1:0] prog [0:PROG_LEN-1];
+  reg [ADDR_WIDTH-1:0]  expAddr [0:MAX_WRITE-1];
+  reg [DATA_WIDTH-1:0]  expData [0:MAX_WRITE-1];
+  integer expCount = 0;
+
+  task expectFill(input integer rd, input [DATA_WIDTH-1:0] data);
+    integer i;
+    for(i=0; i<PE_REG_WIDTH; i=i+1) begin
+      expAddr[expCount] = rd*PE_REG_WIDTH + i;
+      expData[expCount] = data;
+      expCount = expCount + 1;
+    end
+  endtask
+
+  initial begin
+    prog[0] = INSTR_SELECT_ALL;
+    prog[1] = instrFillreg(5, 16'hA5C3);
+    prog[2] = instrWrite(5*PE_REG_WIDTH + 3, 16'h0F0F);     // right after a FILLREG
+    prog[3] = instrFillreg(6, 16'hFFFF);
+    expectFill(5, 16'hA5C3);
+    expAddr[expCount] = 5*PE_REG_WIDTH + 3;
+    expData[expCount] = 16'h0F0F;
+    expCount = expCount + 1;
+    expectFill(6, 16'hFFFF);
+  end
+
+
+  // ---- Front-end: a new instruction is presented when the controller asks for it
+  integer pc = 0;
+  always @(negedge clk) begin
+    if(nextInstr && pc < PROG_LEN) begin
+      instruction <= prog[pc];
+      inputValid  <= 1;
+      pc <= pc + 1;
+    end else begin
+      instruction <= PICASO_NOP;
+      inputValid  <= 0;
+    end
+  end
+
+
+  // ---- Monitor the BRAM writes on the control port
+  integer wrCount = 0;
+  integer errors = 0;
+  always @(posedge clk) begin
+    if(saveAluOut) begin
+      $display("EROR: unexpected ALU write at %0t", $time);
+      errors = errors + 1;
+    end
+    if(extDataSave) begin
+      if(wrCount >= expCount) begin
+        $display("EROR: extra write [%0d] = %h", addrA, extDataIn);
+        errors = errors + 1;
+      end else if(addrA !== expAddr[wrCount] || extDataIn !== expData[wrCount] || selOp !== 1) begin
+        $display("EROR: write %0d: [%0d] = %h selOp=%b, expected [%0d] = %h selOp=1",
+                 wrCount, addrA, extDataIn, selOp, expAddr[wrCount], expData[wrCount]);
+        errors = errors + 1;
+      end
+      wrCount = wrCount + 1;
+    end
+  end
+
+
+  // ---- Run until the program is drained and the controller stays idle
+  integer cycles = 0;
+  integer idle = 0;
+  initial begin
+    while(idle < 8 && cycles < TIMEOUT) begin
+      @(posedge clk);
+      cycles = cycles + 1;
+      if(pc == PROG_LEN && !busy && nextInstr) idle = idle + 1;
+      else idle = 0;
+    end
+    if(idle < 8) begin
+      $display("EROR: timeout, %0d of %0d instructions issued", pc, PROG_LEN);
+      errors = errors + 1;
+    end
+    if(wrCount != expCount) begin
+      $display("EROR: %0d writes, expected %0d", wrCount, expCount);
+      errors = errors + 1;
+    end
+    if(errors == 0) $display("PASS: picaso_controller FILLREG, %0d writes", wrCount);
+    else            $display("FAIL: picaso_controller FILLREG, %0d errors", errors);
+    $finish;
+  end
+
+
+endmodule
@@ -0,0 +1,137 @@
+/*********************************************************************************
+* Copyright (c) 2023, Computer Systems Design Lab, University of Arkansas        *
+*                                                                                *
+* All rights reserved.                                                           *
+*                                                                                *
+* Permission is hereby granted, free of charge, to any person obtaining a copy   *
+* of this software and associated documentation files (the "Software"), to deal  *
+* in the Software without restriction, including without limitation the rights   *
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      *
+* copies of the Software, and to permit persons to whom the Software is          *
+* furnished to do so, subject to the following conditions:                       *
+*                                                                                *
+* The above copyright notice and this permission notice shall be included in all *
+* copies or substantial portions of the Software.                                *
+*                                                                                *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       *
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    *
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         *
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  *
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  *
+* SOFTWARE.                                                                      *
+**********************************************************************************
+
+==================================================================================
+
+  Version: v1.0
+
+  Description:
+  Testbench of the MULT instruction on picaso_controller_tbsys (controller
+  and one PiCaSO block). For random and extreme 16-bit operands of the 16
+  PEs, it checks that:
+    - MULT over bits 0..15 leaves the signed 32-bit product in {rd, rd+1},
+      also for back-to-back MULTs with swapped operands
+    - the result is the same as the CLRMBIT + 16 UPDATEPP sequence that
+      MULT replaces
+    - a partial MULT (bits 0..7) writes the same rows as CLRMBIT + UPDATEPP
+      over the same bits
+  Run with "make sim-mult" from work/.
+
+================================================================================*/
+
+
+`timescale 1ns/100ps
+
+
+module picaso_controller_mult_tb;
+
+  localparam PE_CNT = 16,
+             ROUNDS = 4;
+
+  // register map: operands, then 2-register partial-products
+  localparam R_MD       = 1,     // multiplicand
+             R_MR       = 2,     // multiplier
+             R_MULT     = 4,     // MULT bits 0..15
+             R_SWAP     = 6,     // MULT bits 0..15, operands swapped
+             R_UPDATEPP = 8,     // CLRMBIT + UPDATEPP 0..15
+             R_PART     = 10,    // MULT bits 0..7
+             R_PART_UPP = 12;    // CLRMBIT + UPDATEPP 0..7
+
+  // AK-NOTE: With booth's radix-2, the 17-bit window of the ALU overflows for
+  // the multiplicand -32768, so its product is not checked against the exact
+  // value. MULT must still match the UPDATEPP sequence.
+  localparam [15:0] MD_OVERFLOW = 16'h8000;
+
+  reg clk = 0;
+  always #5 clk = ~clk;
+
+  picaso_controller_tbsys #(.BOOTH_RADIX(2)) sys (.clk(clk));
+
+
+  logic [15:0] md [PE_CNT];
+  logic [15:0] mr [PE_CNT];
+  int errors = 0;
+
+  // operands of a round: the extremes in round 0, random afterwards
+  task automatic makeOperands(input int round);
+    static const logic [15:0] extremes [PE_CNT] = '{16'h0000, 16'h0001, 16'hFFFF, 16'h7FFF,
+                                                     16'h8000, 16'h8001, 16'h5555, 16'hAAAA,
+                                                     16'h0002, 16'hFFFE, 16'h00FF, 16'hFF00,
+                                                     16'h7FFF, 16'h8000, 16'h1234, 16'hEDCB};
+    for(int p=0; p<PE_CNT; p++) begin
+      if(round == 0) begin
+        md[p] = extremes[p];
+        mr[p] = extremes[(p*5 + 3) % PE_CNT];
+      end else begin
+        md[p] = $urandom;
+        mr[p] = $urandom;
+      end
+    end
+  endtask
+
+
+  task automatic check(input string what, input logic signed [63:0] got, input logic signed [63:0] exp, input int p);
+    if(got !== exp) begin
+      $display("EROR: %s, PE %0d: %0d * %0d = %0d, expected %0d", what, p, $signed(md[p]), $signed(mr[p]), got, exp);
+      errors = errors + 1;
+    end
+  endtask
+
+
+  initial begin
+    bit ok;
+    logic signed [63:0] product;
+    void'($urandom(16));
+    for(int round=0; round<ROUNDS; round++) begin
+      makeOperands(round);
+      sys.push(sys.instrSelectAll());
+      sys.pushWriteReg(R_MD, md);
+      sys.pushWriteReg(R_MR, mr);
+      sys.push(sys.instrMult(R_MULT, R_MR, R_MD, 0, 15));
+      sys.push(sys.instrMult(R_SWAP, R_MD, R_MR, 0, 15));     // back-to-back
+      sys.push(sys.instrClrmbit());
+      for(int b=0; b<16; b++) sys.push(sys.instrUpdatepp(R_UPDATEPP, R_MR, R_MD, b));
+      sys.push(sys.instrMult(R_PART, R_MR, R_MD, 0, 7));
+      sys.push(sys.instrClrmbit());
+      for(int b=0; b<8; b++) sys.push(sys.instrUpdatepp(R_PART_UPP, R_MR, R_MD, b));
+      sys.run(ok);
+      if(!ok) begin
+        $display("EROR: round %0d did not finish", round);
+        errors = errors + 1;
+      end
+      for(int p=0; p<PE_CNT; p++) begin
+        product = $signed(md[p]) * $signed(mr[p]);
+        if(md[p] != MD_OVERFLOW) check("MULT", sys.peValue(R_MULT, p, 32), product, p);
+        if(mr[p] != MD_OVERFLOW) check("MULT swapped", sys.peValue(R_SWAP, p, 32), product, p);
+        check("UPDATEPP", sys.peValue(R_UPDATEPP, p, 32), sys.peValue(R_MULT, p, 32), p);
+        check("partial MULT", sys.peValue(R_PART, p, 32), sys.peValue(R_PART_UPP, p, 32), p);
+      end
+    end
+    if(errors == 0) $display("PASS: picaso_controller MULT, %0d rounds", ROUNDS);
+    else            $display("FAIL: picaso_controller MULT, %0d errors", errors);
+    $finish;
+  end
+
+
+endmodule
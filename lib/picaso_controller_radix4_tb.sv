@@ -0,0 +1,183 @@
+/*********************************************************************************
+* Copyright (c) 2023, Computer Systems Design Lab, University of Arkansas        *
+*                                                                                *
+* All rights reserved.                                                           *
+*                                                                                *
+* Permission is hereby granted, free of charge, to any person obtaining a copy   *
+* of this software and associated documentation files (the "Software"), to deal  *
+* in the Software without restriction, including without limitation the rights   *
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      *
+* copies of the Software, and to permit persons to whom the Software is          *
+* furnished to do so, subject to the following conditions:                       *
+*                                                                                *
+* The above copyright notice and this permission notice shall be included in all *
+* copies or substantial portions of the Software.                                *
+*                                                                                *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       *
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    *
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         *
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  *
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  *
+* SOFTWARE.                                                                      *
+**********************************************************************************
+
+==================================================================================
+
+  Version: v1.0
+
+  Description:
+  Testbench of the booth's radix-4 ALU variant against radix-2. Two
+  picaso_controller_tbsys instances, one per BOOTH_RADIX, run the same
+  operands on their 16 PEs:
+    - MULT over bits 0..15 and the CLRMBIT + UPDATEPP sequence of each radix
+      (16 passes for radix-2, 8 for radix-4)
+    - a partial MULT over bits 0..7
+    - ALU-OP ADD and SUB, which must not be affected by the radix
+  The radix-4 results must be exact and bit-identical to radix-2, except
+  for the radix-2 overflow (multiplicand -32768), where only radix-4 is
+  checked. A single MULT must also take fewer cycles with radix-4.
+  Run with "make sim-radix4" from work/.
+
+================================================================================*/
+
+
+`timescale 1ns/100ps
+
+
+module picaso_controller_radix4_tb;
+
+  `include "picaso_instruction_decoder.inc.v"
+
+  localparam PE_CNT = 16,
+             ROUNDS = 6;
+
+  // register map: operands, then 2-register partial-products
+  localparam R_MD       = 1,     // multiplicand
+             R_MR       = 2,     // multiplier
+             R_ADD      = 3,     // md + mr
+             R_SUB      = 4,     // md - mr
+             R_MULT     = 6,     // MULT bits 0..15
+             R_UPDATEPP = 8,     // CLRMBIT + UPDATEPP over bits 0..15
+             R_PART     = 10;    // MULT bits 0..7
+
+  // AK-NOTE: With booth's radix-2, the 17-bit window of the ALU overflows for
+  // the multiplicand -32768, radix-4 is exact for it.
+  localparam [15:0] MD_OVERFLOW = 16'h8000;
+
+  reg clk = 0;
+  always #5 clk = ~clk;
+
+  picaso_controller_tbsys #(.BOOTH_RADIX(2)) sys2 (.clk(clk));
+  picaso_controller_tbsys #(.BOOTH_RADIX(4)) sys4 (.clk(clk));
+
+
+  logic [15:0] md [PE_CNT];
+  logic [15:0] mr [PE_CNT];
+  int errors = 0;
+
+  // operands of a round: the extremes in round 0, random afterwards
+  task automatic makeOperands(input int round);
+    static const logic [15:0] extremes [PE_CNT] = '{16'h0000, 16'h0001, 16'hFFFF, 16'h7FFF,
+                                                     16'h8000, 16'h8001, 16'h5555, 16'hAAAA,
+                                                     16'h0002, 16'hFFFE, 16'h00FF, 16'hFF00,
+                                                     16'h7FFF, 16'h8000, 16'h1234, 16'hEDCB};
+    for(int p=0; p<PE_CNT; p++) begin
+      if(round == 0) begin
+        md[p] = extremes[p];
+        mr[p] = extremes[(p*5 + 3) % PE_CNT];
+      end else begin
+        md[p] = $urandom;
+        mr[p] = $urandom;
+      end
+    end
+  endtask
+
+
+  task automatic check(input string what, input int p, input logic signed [63:0] got, input logic signed [63:0] exp);
+    if(got !== exp) begin
+      $display("EROR: %s, PE %0d, md=%0d mr=%0d: %0d, expected %0d", what, p, $signed(md[p]), $signed(mr[p]), got, exp);
+      errors = errors + 1;
+    end
+  endtask
+
+
+  // pushes the same program to both systems, UPDATEPP steps by the radix's bits per pass
+  task automatic pushProgram();
+    sys2.push(sys2.instrSelectAll());
+    sys2.pushWriteReg(R_MD, md);
+    sys2.pushWriteReg(R_MR, mr);
+    sys2.push(sys2.instrAluop(PICASO_FN_ALU_ADD, R_ADD, R_MD, R_MR));
+    sys2.push(sys2.instrAluop(PICASO_FN_ALU_SUB, R_SUB, R_MD, R_MR));
+    sys2.push(sys2.instrMult(R_MULT, R_MR, R_MD, 0, 15));
+    sys2.push(sys2.instrClrmbit());
+    for(int b=0; b<16; b++) sys2.push(sys2.instrUpdatepp(R_UPDATEPP, R_MR, R_MD, b));
+    sys2.push(sys2.instrMult(R_PART, R_MR, R_MD, 0, 7));
+
+    sys4.push(sys4.instrSelectAll());
+    sys4.pushWriteReg(R_MD, md);
+    sys4.pushWriteReg(R_MR, mr);
+    sys4.push(sys4.instrAluop(PICASO_FN_ALU_ADD, R_ADD, R_MD, R_MR));
+    sys4.push(sys4.instrAluop(PICASO_FN_ALU_SUB, R_SUB, R_MD, R_MR));
+    sys4.push(sys4.instrMult(R_MULT, R_MR, R_MD, 0, 15));
+    sys4.push(sys4.instrClrmbit());
+    for(int b=0; b<16; b+=2) sys4.push(sys4.instrUpdatepp(R_UPDATEPP, R_MR, R_MD, b));
+    sys4.push(sys4.instrMult(R_PART, R_MR, R_MD, 0, 7));
+  endtask
+
+
+  // runs both systems on their programs
+  task automatic runBoth(input string what);
+    bit ok2, ok4;
+    fork
+      sys2.run(ok2);
+      sys4.run(ok4);
+    join
+    if(!ok2 || !ok4) begin
+      $display("EROR: %s did not finish, radix-2 %0d, radix-4 %0d", what, ok2, ok4);
+      errors = errors + 1;
+    end
+  endtask
+
+
+  initial begin
+    logic signed [63:0] product, partial;
+    void'($urandom(19));
+    for(int round=0; round<ROUNDS; round++) begin
+      makeOperands(round);
+      pushProgram();
+      runBoth($sformatf("round %0d", round));
+      for(int p=0; p<PE_CNT; p++) begin
+        product = $signed(md[p]) * $signed(mr[p]);
+        partial = $signed(md[p]) * $signed(mr[p][7:0]);
+        // radix-4 is exact
+        check("radix-4 MULT", p, sys4.peValue(R_MULT, p, 32), product);
+        check("radix-4 UPDATEPP", p, sys4.peValue(R_UPDATEPP, p, 32), product);
+        check("radix-4 partial MULT", p, sys4.peValue(R_PART, p, 24), partial);
+        // and bit-identical to radix-2
+        if(md[p] != MD_OVERFLOW) begin
+          check("radix-2 MULT", p, sys2.peValue(R_MULT, p, 32), sys4.peValue(R_MULT, p, 32));
+          check("radix-2 UPDATEPP", p, sys2.peValue(R_UPDATEPP, p, 32), sys4.peValue(R_UPDATEPP, p, 32));
+          check("radix-2 partial MULT", p, sys2.peValue(R_PART, p, 24), sys4.peValue(R_PART, p, 24));
+        end
+        check("radix-4 ADD", p, sys4.peValue(R_ADD, p, 16), 64'(signed'(16'(md[p] + mr[p]))));
+        check("radix-2 ADD", p, sys2.peValue(R_ADD, p, 16), sys4.peValue(R_ADD, p, 16));
+        check("radix-2 SUB", p, sys2.peValue(R_SUB, p, 16), sys4.peValue(R_SUB, p, 16));
+      end
+    end
+    // latency of a single MULT
+    sys2.push(sys2.instrMult(R_MULT, R_MR, R_MD, 0, 15));
+    sys4.push(sys4.instrMult(R_MULT, R_MR, R_MD, 0, 15));
+    runBoth("single MULT");
+    $display("INFO: MULT cycles, radix-2 %0d, radix-4 %0d", sys2.runCycles, sys4.runCycles);
+    if(sys4.runCycles >= sys2.runCycles) begin
+      $display("EROR: radix-4 MULT is not faster");
+      errors = errors + 1;
+    end
+    if(errors == 0) $display("PASS: booth radix-4 vs radix-2, %0d rounds", ROUNDS);
+    else            $display("FAIL: booth radix-4 vs radix-2, %0d errors", errors);
+    $finish;
+  end
+
+
+endmodule
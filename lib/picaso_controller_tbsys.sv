@@ -0,0 +1,307 @@
+/*********************************************************************************
+* Copyright (c) 2023, Computer Systems Design Lab, University of Arkansas        *
+*                                                                                *
+* All rights reserved.                                                           *
+*                                                                                *
+* Permission is hereby granted, free of charge, to any person obtaining a copy   *
+* of this software and associated documentation files (the "Software"), to deal  *
+* in the Software without restriction, including without limitation the rights   *
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      *
+* copies of the Software, and to permit persons to whom the Software is          *
+* furnished to do so, subject to the following conditions:                       *
+*                                                                                *
+* The above copyright notice and this permission notice shall be included in all *
+* copies or substantial portions of the Software.                                *
+*                                                                                *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       *
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    *
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         *
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  *
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  *
+* SOFTWARE.                                                                      *
+**********************************************************************************
+
+==================================================================================
+
+  Version: v1.0
+
+  Description:
+  Simulation-only system for the controller testbenches: a picaso_controller
+  driving a single PiCaSO block (picaso_ff), with the same parameters as
+  gemvtile.svh except BOOTH_RADIX. A program is pushed with push() and
+  streamed by run() using the nextInstr handshake of the front-end. The PE
+  registers are read back from the register-file of the block with
+  peValue(), bit i of register r of PE p is at ram[r*PE_REG_WIDTH + i][p].
+
+  Usage from a testbench (sys is the instance name):
+      sys.push(sys.instrSelectAll());
+      sys.pushWriteReg(1, values);
+      sys.push(sys.instrMult(4, 2, 1, 0, 15));
+      sys.run(ok);
+      if(sys.peValue(4, p, 32) !== expected) ...
+
+================================================================================*/
+
+
+`timescale 1ns/100ps
+`include "ak_macros.v"
+
+
+module picaso_controller_tbsys #(
+  parameter BOOTH_RADIX = 2,        // booth's encoding of the ALUs: 2 or 4
+  parameter PROG_DEPTH  = 1024,     // largest program that can be pushed
+  parameter TIMEOUT     = 100000    // clock cycles allowed for a run
+) (
+  clk
+);
+
+  `include "clogb2_func.v"
+  `include "boothR2_serial_alu.inc.v"
+  `include "opmux_ff.inc.v"
+  `include "picaso_ff.inc.v"
+  `include "picaso_instruction_decoder.inc.v"
+
+  localparam PE_REG_WIDTH     = 16,
+             MAX_PRECISION    = 16,
+             NET_STREAM_WIDTH = 1,
+             MAX_NET_LEVEL    = 3,
+             NET_LEVEL_WIDTH  = clogb2(MAX_NET_LEVEL),
+             ID_WIDTH         = PICASO_INSTR_ID_WIDTH,
+             PE_CNT           = PICASO_INSTR_DATA_WIDTH,
+             RF_DEPTH         = 1024,
+             TOKEN_WIDTH      = 3,
+             INSTR_WIDTH      = PICASO_INSTR_WORD_WIDTH,
+             ADDR_WIDTH       = PICASO_INSTR_ADDR_WIDTH,
+             DATA_WIDTH       = PICASO_INSTR_DATA_WIDTH,
+             REG_BASE_WIDTH   = PICASO_INSTR_REG_BASE_WIDTH,
+             SCODE_WIDTH      = PICASO_INSTR_SCODE_WIDTH;
+
+  input clk;
+
+
+  // ---- Instruction encoders (same encoding as the assembler, without the submodule code)
+  function automatic [INSTR_WIDTH-1:0] instrSelectAll();
+    return 30'h18C00000;
+  endfunction
+
+  function automatic [INSTR_WIDTH-1:0] instrWrite(input int addr, input [DATA_WIDTH-1:0] data);
+    return {PICASO_WRITE, ADDR_WIDTH'(addr), data};
+  endfunction
+
+  function automatic [INSTR_WIDTH-1:0] instrFillreg(input int rd, input [DATA_WIDTH-1:0] data);
+    return {PICASO_SUPEROP, ADDR_WIDTH'((rd << SCODE_WIDTH) | PICASO_SCODE_FILLREG), data};
+  endfunction
+
+  function automatic [INSTR_WIDTH-1:0] instrClrmbit();
+    return {PICASO_SUPEROP, ADDR_WIDTH'(PICASO_SCODE_CLRMBIT), DATA_WIDTH'(0)};
+  endfunction
+
+  // rd = rs1 op rs2, fn: PICASO_FN_ALU_*
+  function automatic [INSTR_WIDTH-1:0] instrAluop(input int fn, input int rd, input int rs1, input int rs2);
+    return {PICASO_ALUOP, ADDR_WIDTH'((fn << REG_BASE_WIDTH) | rd), DATA_WIDTH'((rs2 << REG_BASE_WIDTH) | rs1)};
+  endfunction
+
+  // ppreg = rd, multiplier = rs1, multiplicand = rs2
+  function automatic [INSTR_WIDTH-1:0] instrUpdatepp(input int rd, input int rs1, input int rs2, input int bitNo);
+    return {PICASO_UPDATEPP, ADDR_WIDTH'((bitNo << REG_BASE_WIDTH) | rd), DATA_WIDTH'((rs2 << REG_BASE_WIDTH) | rs1)};
+  endfunction
+
+  function automatic [INSTR_WIDTH-1:0] instrMult(input int rd, input int rs1, input int rs2, input int firstBit, input int lastBit);
+    return {PICASO_MULT, ADDR_WIDTH'((firstBit << REG_BASE_WIDTH) | rd),
+            DATA_WIDTH'((lastBit << (2*REG_BASE_WIDTH)) | (rs2 << REG_BASE_WIDTH) | rs1)};
+  endfunction
+
+
+  // ---- Controller and the PiCaSO block
+  wire                          ctrl_busy, ctrl_nextInstr;
+  wire [NET_LEVEL_WIDTH-1:0]    netLevel;
+  wire                          netConfLoad, netCaptureEn;
+  wire [ALU_OP_WIDTH-1:0]       aluConf;
+  wire                          aluConfLoad, aluEn, aluReset, aluMbitReset, aluMbitLoad;
+  wire                          opmuxConfLoad, opmuxEn;
+  wire [OPMUX_CONF_WIDTH-1:0]   opmuxConf;
+  wire                          extDataSave, saveAluOut;
+  wire [DATA_WIDTH-1:0]         extDataIn;
+  wire [ADDR_WIDTH-1:0]         addrA, addrB;
+  wire [ID_WIDTH-1:0]           selRow, selCol;
+  wire [PICASO_SEL_MODE_WIDTH-1:0] selMode;
+  wire                          selEn, selOp, ptrLoad, ptrIncr;
+
+  reg  [INSTR_WIDTH-1:0]        instruction = PICASO_NOP;
+  reg                           inputValid = 0;
+
+  picaso_controller #(
+      .DEBUG(0),
+      .INSTRUCTION_WIDTH(INSTR_WIDTH),
+      .NET_LEVEL_WIDTH(NET_LEVEL_WIDTH),
+      .OPERAND_WIDTH(PE_REG_WIDTH),
+      .PICASO_ID_WIDTH(ID_WIDTH),
+      .TOKEN_WIDTH(TOKEN_WIDTH),
+      .PE_REG_WIDTH(PE_REG_WIDTH),
+      .MAX_PRECISION(MAX_PRECISION),
+      .BOOTH_RADIX(BOOTH_RADIX) )
+    controller (
+      .clk(clk),
+      .instruction(instruction),
+      .token_in({TOKEN_WIDTH{1'b0}}),
+      .inputValid(inputValid),
+      .token_out(),
+      .busy(ctrl_busy),
+      .nextInstr(ctrl_nextInstr),
+      .picaso_netLevel(netLevel),
+      .picaso_netConfLoad(netConfLoad),
+      .picaso_netCaptureEn(netCaptureEn),
+      .picaso_aluConf(aluConf),
+      .picaso_aluConfLoad(aluConfLoad),
+      .picaso_aluEn(aluEn),
+      .picaso_aluReset(aluReset),
+      .picaso_aluMbitReset(aluMbitReset),
+      .picaso_aluMbitLoad(aluMbitLoad),
+      .picaso_opmuxConfLoad(opmuxConfLoad),
+      .picaso_opmuxConf(opmuxConf),
+      .picaso_opmuxEn(opmuxEn),
+      .picaso_extDataSave(extDataSave),
+      .picaso_extDataIn(extDataIn),
+      .picaso_saveAluOut(saveAluOut),
+      .picaso_addrA(addrA),
+      .picaso_addrB(addrB),
+      .picaso_selRow(selRow),
+      .picaso_selCol(selCol),
+      .picaso_selMode(selMode),
+      .picaso_selEn(selEn),
+      .picaso_selOp(selOp),
+      .picaso_ptrLoad(ptrLoad),
+      .picaso_ptrIncr(ptrIncr),
+      .dbg_clk_enable(1'b1)
+    );
+
+  picaso_ff #(
+      .DEBUG(0),
+      .NET_STREAM_WIDTH(NET_STREAM_WIDTH),
+      .MAX_NET_LEVEL(MAX_NET_LEVEL),
+      .ID_WIDTH(ID_WIDTH),
+      .CB_ROW_ID(0),
+      .CB_COL_ID(0),
+      .PE_CNT(PE_CNT),
+      .RF_DEPTH(RF_DEPTH),
+      .BOOTH_RADIX(BOOTH_RADIX) )
+    block (
+      .clk(clk),
+      .netLevel(netLevel),
+      .netConfLoad(netConfLoad),
+      .netCaptureEn(netCaptureEn),
+      .eastIn({NET_STREAM_WIDTH{1'b0}}),
+      .westOut(),
+      .aluConf(aluConf),
+      .aluConfLoad(aluConfLoad),
+      .aluEn(aluEn),
+      .aluReset(aluReset),
+      .aluMbitReset(aluMbitReset),
+      .aluMbitLoad(aluMbitLoad),
+      .opmuxConfLoad(opmuxConfLoad),
+      .opmuxConf(opmuxConf),
+      .opmuxEn(opmuxEn),
+      .extDataSave(extDataSave),
+      .extDataIn(extDataIn),
+      .extDataOut(),
+      .saveAluOut(saveAluOut),
+      .addrA(addrA),
+      .addrB(addrB),
+      .selRow(selRow),
+      .selCol(selCol),
+      .selMode(selMode),
+      .selEn(selEn),
+      .selOp(selOp),
+      .selActive(),
+      .ptrLoad(ptrLoad),
+      .ptrIncr(ptrIncr),
+      .serialOut(),
+      .serialOutValid(),
+      .dbg_clk_enable(1'b1),
+      .dbg_rf_wea(),
+      .dbg_rf_web(),
+      .dbg_rf_dia(),
+      .dbg_rf_dib(),
+      .dbg_rf_doa(),
+      .dbg_rf_dob(),
+      .dbg_rf_addra(),
+      .dbg_rf_addrb(),
+      .dbg_opmux_opnX(),
+      .dbg_opmux_opnY(),
+      .dbg_alu_x_streams(),
+      .dbg_alu_y_streams(),
+      .dbg_alu_out_streams(),
+      .dbg_net_localIn(),
+      .dbg_net_captureOut()
+    );
+
+
+  // ---- Program memory and the front-end
+  reg [INSTR_WIDTH-1:0] prog [0:PROG_DEPTH-1];
+  int  progLen = 0;
+  int  pc = 0;
+  bit  running = 0;
+  int  runCycles = 0;     // clock cycles of the last run, until the controller is idle
+
+  // a new instruction is presented when the controller asks for it
+  always @(negedge clk) begin
+    if(running && ctrl_nextInstr && pc < progLen) begin
+      instruction <= prog[pc];
+      inputValid  <= 1;
+      pc <= pc + 1;
+    end else begin
+      instruction <= PICASO_NOP;
+      inputValid  <= 0;
+    end
+  end
+
+
+  // appends an instruction to the program
+  task automatic push(input [INSTR_WIDTH-1:0] instr);
+    if(progLen >= PROG_DEPTH) $fatal(1, "picaso_controller_tbsys: program is larger than PROG_DEPTH");
+    prog[progLen] = instr;
+    progLen = progLen + 1;
+  endtask
+
+
+  // appends the WRITEs of PE values to register r, one row per bit
+  task automatic pushWriteReg(input int r, input logic [PE_REG_WIDTH-1:0] values [PE_CNT]);
+    logic [DATA_WIDTH-1:0] row;
+    for(int i=0; i<PE_REG_WIDTH; i++) begin
+      for(int p=0; p<PE_CNT; p++) row[p] = values[p][i];
+      push(instrWrite(r*PE_REG_WIDTH + i, row));
+    end
+  endtask
+
+
+  // streams the program, then waits until the controller stays idle
+  // @param ok  0 if the program did not finish within TIMEOUT cycles
+  task automatic run(output bit ok);
+    int cycles = 0;
+    int idle = 0;
+    pc = 0;
+    running = 1;
+    while(idle < 8 && cycles < TIMEOUT) begin
+      @(posedge clk);
+      cycles = cycles + 1;
+      if(pc == progLen && !ctrl_busy && ctrl_nextInstr) idle = idle + 1;
+      else idle = 0;
+    end
+    running = 0;
+    progLen = 0;
+    runCycles = cycles - idle;
+    ok = (idle >= 8);
+  endtask
+
+
+  // value of a PE register read from the register-file, sign-extended
+  // @param width  no. of rows to read, from register r onwards (32 for a product)
+  function automatic logic signed [63:0] peValue(input int r, input int pe, input int width);
+    logic signed [63:0] v;
+    for(int i=0; i<64; i++) v[i] = block.regfile.ram[r*PE_REG_WIDTH + (i < width ? i : width-1)][pe];
+    return v;
+  endfunction
+
+
+endmodule
@@ -46,7 +46,8 @@ module picaso_ff #(
   parameter CB_ROW_ID        = -1,   // row-ID of the compute-block (must initialize with a non-negative number of ID_WIDTH size)
   parameter CB_COL_ID        = -1,   // column-ID of the compute-block
   parameter PE_CNT           = 16,   // Number of Processing-Elements in each block
-  parameter RF_DEPTH         = 1024  // Depth of the register-file (usually it's equal to register-width * register-count)
+  parameter RF_DEPTH         = 1024, // Depth of the register-file (usually it's equal to register-width * register-count)
+  parameter BOOTH_RADIX      = 2     // booth's encoding used by the ALU for multiplication: 2 or 4
 ) (
   clk,
 
@@ -288,7 +289,8 @@ module picaso_ff #(
 
   alu_serial_ff #(
       .DEBUG(DEBUG),
-      .STREAM_WIDTH(ALU_STREAM_WIDTH) )
+      .STREAM_WIDTH(ALU_STREAM_WIDTH),
+      .BOOTH_RADIX(BOOTH_RADIX) )
     aluInst (
       .clk(clk),
       .reset(aluInst_reset),
@@ -55,7 +55,8 @@ module picaso_fsm_vars #(
   parameter OPCODE_WIDTH = -1,
   parameter PICASO_ID_WIDTH = -1,
   parameter REG_BASE_WIDTH = -1,
-  parameter PE_REG_WIDTH = -1
+  parameter PE_REG_WIDTH = -1,
+  parameter BOOTH_RADIX = -1
 ) (
   clk,
   loadInit,   // loads the initial values to the variables (regs)
@@ -69,6 +70,7 @@ module picaso_fsm_vars #(
   clrNetCaptureEn,    // clears the netCaptureEn flip-flop
   setPicasoPtrIncr,   // sets the picasoPtrIncr flip-flop
   clrPicasoPtrIncr,   // clears the picasoPtrIncr flip-flop
+  multNextPass,       // moves the pointers to the next multiplier bit (MULT)
   // fields from instruction word 
   opcode,
   addr,
@@ -96,6 +98,8 @@ module picaso_fsm_vars #(
   addrA,
   addrB,
   picasoPtrIncr,
+  extData,
+  multLastPass,       // current pass is for the last multiplier bit (MULT)
 
   // Debug probes
   dbg_clk_enable         // debug clock for stepping
@@ -120,6 +124,7 @@ module picaso_fsm_vars #(
   `AK_ASSERT2(PICASO_ID_WIDTH >= 0, PICASO_ID_WIDTH_not_set)
   `AK_ASSERT2(REG_BASE_WIDTH >= 0, REG_BASE_WIDTH_not_set)
   `AK_ASSERT2(PE_REG_WIDTH >= 0, PE_REG_WIDTH_not_set)
+  `AK_ASSERT2(BOOTH_RADIX >= 0, BOOTH_RADIX_not_set)
 
   // ensure the field widths meet the variable width requirements
   `AK_ASSERT2(INSTR_PARAM_WIDTH >= NET_LEVEL_WIDTH, INSTR_PARAM_WIDTH_not_big_enough)
@@ -141,6 +146,7 @@ module picaso_fsm_vars #(
   input                         clrNetCaptureEn;
   input                         setPicasoPtrIncr;
   input                         clrPicasoPtrIncr;
+  input                         multNextPass;
 
   input [OPCODE_WIDTH-1:0]      opcode;
   input [ADDR_WIDTH-1:0]        addr;
@@ -168,6 +174,8 @@ module picaso_fsm_vars #(
   output [OPMUX_CONF_WIDTH-1:0] opmuxConf;
   output [ADDR_WIDTH-1:0]       addrA;
   output [ADDR_WIDTH-1:0]       addrB;
+  output [DATA_WIDTH-1:0]       extData;
+  output                        multLastPass;
 
   // Debug probes
   input   dbg_clk_enable;
@@ -259,8 +267,9 @@ module picaso_fsm_vars #(
         init_aluConf = fncode_to_aluconf(fncode);
       end
 
-      PICASO_UPDATEPP: begin
+      PICASO_UPDATEPP, PICASO_MULT: begin
         // Update-pp basically adds 2 operands: partial-product (A) and multiplicand*mult-bit (B).
+        // MULT runs update-pp starting at the offset bit, so it starts with the same configuration.
         // however, for offset=0, it should use A=0 and thus use 0_op_B opmux configuration. 
         // This special case of offset=0 is used to avoid extra cycles needed
         // to zero out the destination register.
@@ -320,7 +329,7 @@ module picaso_fsm_vars #(
     // instruction-specific values
     (* full_case, parallel_case *)
     case(opcode)
-      PICASO_UPDATEPP: begin
+      PICASO_UPDATEPP, PICASO_MULT: begin
         // rs1: multiplier, rs2: multiplicand
         // alu-opcode is set using rs2[offset]
         // partial-product is updated starting at bit rd[offset]
@@ -337,6 +346,11 @@ module picaso_fsm_vars #(
         init_ptrB1 = rs2_base;          // pointer to write register, ptrB1 selected to reuse ALU_OP state-codes
       end
 
+      PICASO_SUPEROP: begin
+        // FILLREG writes the data field to the register rows using port-A
+        init_ptrA0 = rd_base;     // pointer to write register
+      end
+
       PICASO_ACCUM: case(fncode)
         // accumulate block requires 2 pointers, it uses the transition_stream states
         PICASO_FN_ACCUM_BLK: begin
@@ -361,6 +375,7 @@ module picaso_fsm_vars #(
   reg [NET_LEVEL_WIDTH-1:0]       netLevel_reg  = 0;
   reg [ALU_OP_WIDTH-1:0]          aluConf_reg   = 0;
   reg [OPMUX_CONF_WIDTH-1:0]      opmuxConf_reg = 0;
+  reg [DATA_WIDTH-1:0]            extData_reg   = 0;    // data field is saved as the next instruction may arrive before the algorithm ends
 
   always@(posedge clk) begin
     if(loadInit && local_ce) begin       // local_ce for debugging
@@ -368,14 +383,81 @@ module picaso_fsm_vars #(
       netLevel_reg  <= init_netLevel;
       aluConf_reg   <= init_aluConf;
       opmuxConf_reg <= init_opmuxConf;
+      extData_reg   <= data;
+    end else if(multNextPass && local_ce) begin
+      // the next passes of MULT add to the partial-product (offset > 0)
+      netLevel_reg  <= netLevel_reg;
+      aluConf_reg   <= aluConf_reg;
+      opmuxConf_reg <= OPMUX_A_OP_B;
+      extData_reg   <= extData_reg;
     end else begin
       // otherwise, hold the old values
       netLevel_reg  <= netLevel_reg;
       aluConf_reg   <= aluConf_reg;
       opmuxConf_reg <= opmuxConf_reg;
+      extData_reg   <= extData_reg;
+    end
+  end
+
+
+
+  // ---- Variables for the passes of MULT instruction
+  // MULT: [ opcode ] [ OFFSET, RD ] [ LAST, RS2, RS1 ], so LAST is in the upper bits of data.
+  // Each pass is an UPDATEPP on multiplier bit multOffset_reg. At the end of a
+  // pass, the pointers are reloaded for the next multiplier bit (multNextPass).
+  // With booth's radix-4, a pass consumes 2 multiplier bits (multOffset_reg and
+  // multOffset_reg+1), so the offset advances by 2.
+  localparam MULT_OFFSET_STEP = BOOTH_RADIX / 2;   // multiplier bits per pass
+  wire [OFFSET_WIDTH-1:0] multLast = data[DATA_WIDTH-1 -: OFFSET_WIDTH];
+  wire [OFFSET_WIDTH-1:0] multNextOffset;
+
+  reg [OFFSET_WIDTH-1:0]  multOffset_reg = 0;   // multiplier bit of the current pass
+  reg [OFFSET_WIDTH-1:0]  multLast_reg   = 0;   // multiplier bit of the last pass
+  reg [ADDR_WIDTH-1:0]    multPpBase_reg = 0;   // partial-product register base
+  reg [ADDR_WIDTH-1:0]    multMrBase_reg = 0;   // multiplier register base
+  reg [ADDR_WIDTH-1:0]    multMdBase_reg = 0;   // multiplicand register base
+
+  always@(posedge clk) begin
+    if(loadInit && local_ce) begin       // local_ce for debugging
+      multOffset_reg <= offset;
+      multLast_reg   <= multLast;
+      multPpBase_reg <= rd_base;
+      multMrBase_reg <= rs1_base;
+      multMdBase_reg <= rs2_base;
+    end else if(multNextPass && local_ce) begin
+      multOffset_reg <= multNextOffset;
+      multLast_reg   <= multLast_reg;
+      multPpBase_reg <= multPpBase_reg;
+      multMrBase_reg <= multMrBase_reg;
+      multMdBase_reg <= multMdBase_reg;
+    end else begin
+      // otherwise, hold the old values
+      multOffset_reg <= multOffset_reg;
+      multLast_reg   <= multLast_reg;
+      multPpBase_reg <= multPpBase_reg;
+      multMrBase_reg <= multMrBase_reg;
+      multMdBase_reg <= multMdBase_reg;
     end
   end
 
+  assign multNextOffset = multOffset_reg + MULT_OFFSET_STEP;
+
+  // AK-NOTE: LAST < OFFSET is not a valid MULT, the assemblers reject it. The
+  // last pass is found with a >= compare (also for radix-2), so such a MULT
+  // is clamped to a single pass on the OFFSET bit instead of running until
+  // the offset wraps around.
+  always@(posedge clk) begin
+    if(loadInit && local_ce && opcode == PICASO_MULT && multLast < offset)
+      $display("EROR: MULT with LAST (%0d) < OFFSET (%0d), clamped to a single pass (%s:%0d)  %0t",
+               multLast, offset, `__FILE__, `__LINE__, $time);
+  end
+
+  // pointer values for the next pass, same as UPDATEPP with the next offset
+  wire [ADDR_WIDTH-1:0] mult_ptrA0 = multPpBase_reg + multNextOffset;   // partial-product read
+  wire [ADDR_WIDTH-1:0] mult_ptrB0 = multMdBase_reg;                    // multiplicand read
+  wire [ADDR_WIDTH-1:0] mult_ptrB1 = multPpBase_reg + multNextOffset;   // partial-product write
+  wire [ADDR_WIDTH-1:0] mult_ptrA1 = multMrBase_reg + multNextOffset;   // next bit of multiplier
+
 
 
   // pointers for port-A
@@ -501,23 +583,23 @@ module picaso_fsm_vars #(
 
   // ---- Local interconnect
   // inputs of ptr_A0
-  assign ptr_A0_loadVal = init_ptrA0,
-         ptr_A0_loadEn  = loadInit,
+  assign ptr_A0_loadVal = multNextPass ? mult_ptrA0 : init_ptrA0,
+         ptr_A0_loadEn  = loadInit | multNextPass,
          ptr_A0_countEn = incPtrA0;
   
   // inputs of ptr_A1
-  assign ptr_A1_loadVal = init_ptrA1,
-         ptr_A1_loadEn  = loadInit,
+  assign ptr_A1_loadVal = multNextPass ? mult_ptrA1 : init_ptrA1,
+         ptr_A1_loadEn  = loadInit | multNextPass,
          ptr_A1_countEn = incPtrA1;
 
   // inputs of ptr_B0
-  assign ptr_B0_loadVal = init_ptrB0,
-         ptr_B0_loadEn  = loadInit,
+  assign ptr_B0_loadVal = multNextPass ? mult_ptrB0 : init_ptrB0,
+         ptr_B0_loadEn  = loadInit | multNextPass,
          ptr_B0_countEn = incPtrB0;
   
   // inputs of ptr_B1
-  assign ptr_B1_loadVal = init_ptrB1,
-         ptr_B1_loadEn  = loadInit,
+  assign ptr_B1_loadVal = multNextPass ? mult_ptrB1 : init_ptrB1,
+         ptr_B1_loadEn  = loadInit | multNextPass,
          ptr_B1_countEn = incPtrB1;
 
   // inputs of SR-FFs
@@ -531,7 +613,9 @@ module picaso_fsm_vars #(
          netCaptureEn  = netCaptureEn_ff_out,
          aluConf       = aluConf_reg,
          opmuxConf     = opmuxConf_reg,
-         picasoPtrIncr = picasoPtrIncr_ff_out;
+         picasoPtrIncr = picasoPtrIncr_ff_out,
+         extData       = extData_reg,
+         multLastPass  = (multOffset_reg + MULT_OFFSET_STEP - 1 >= multLast_reg);
 
   
   // selPort selects the pointer: sel = 0/1 selects A0/A1 and B0/B1
@@ -14,8 +14,8 @@ localparam PICASO_INSTR_OPCODE_WIDTH = 4,     // width of the OpCode field
 
 /* PiCaSO controller instruction word is made of 3 segments: [SEG2] [SEG1] [SEG0]
 *  The segments are used as follows,
-*    SEG0:  DATA, {RS2, RS1}, {xx, R}, {ROW-ID, COL-ID}
-*    SEG1:  ADDR, {OFFSET, RD}, {FN, RD}, {FN, xx}, {FN, PARAM}
+*    SEG0:  DATA, {RS2, RS1}, {xx, R}, {ROW-ID, COL-ID}, {LAST, RS2, RS1}
+*    SEG1:  ADDR, {OFFSET, RD}, {FN, RD}, {FN, xx}, {FN, PARAM}, {RD, S_CODE}
 *    SEG2:  OPCODE
 */
 `include "ak_macros.v"
@@ -24,6 +24,7 @@ localparam PICASO_INSTR_OPCODE_WIDTH = 4,     // width of the OpCode field
 `define SEG0_WIDTH  PICASO_INSTR_DATA_WIDTH                 // ensures DATA can fit in SEG0
 `AK_ASSERT(`SEG0_WIDTH >= (2*PICASO_INSTR_REG_BASE_WIDTH))   // ensures {RS2, RS1}, {xx, R} can fit in SEG0
 `AK_ASSERT(`SEG0_WIDTH >= (2*PICASO_INSTR_ID_WIDTH))         // ensures {ROW-ID, COL-ID} can fit in SEG0
+`AK_ASSERT(`SEG0_WIDTH >= (PICASO_INSTR_OFFSET_WIDTH + 2*PICASO_INSTR_REG_BASE_WIDTH))   // ensures {LAST, RS2, RS1} can fit in SEG0
 
 // determining the width of SEG1
 `define OFF_RD_WIDTH   (PICASO_INSTR_OFFSET_WIDTH + PICASO_INSTR_REG_BASE_WIDTH)
@@ -35,6 +36,7 @@ localparam PICASO_INSTR_OPCODE_WIDTH = 4,     // width of the OpCode field
 `define MAX1        `AK_MAX(`MAX0, `FN_RD_WIDTH)
 `define MAX2        `AK_MAX(`MAX1, `FN_PARAM_WIDTH)
 `define SEG1_WIDTH  `MAX2
+`AK_ASSERT(`SEG1_WIDTH >= (PICASO_INSTR_REG_BASE_WIDTH + PICASO_INSTR_SCODE_WIDTH))   // ensures {RD, S_CODE} can fit in SEG1
 
 // SEG2 is simply the opcode width
 `define SEG2_WIDTH PICASO_INSTR_OPCODE_WIDTH
@@ -66,13 +68,13 @@ localparam [PICASO_INSTR_OPCODE_WIDTH-1:0]
   PICASO_NOP      = 0,
   PICASO_WRITE    = 1,
   PICASO_READ     = 2,
-  //PICASO_MULT   = 3,    // will be implemented using UPDATEPP
   PICASO_UPDATEPP = 3,
   PICASO_ACCUM    = 4,      // functions: ACCUM_BLK, ACCUM_ROW
   PICASO_ALUOP    = 5,      // functions: ALU_ADD, ALU_SUB, ALU_CPX, ALU_CPY
   PICASO_SELECT   = 6,      // functions: selection modes, maps directly to picaso_ff.selMode
   PICASO_MOV      = 7,      // functions: offset-mov, ... (will be added as needed)
-  PICASO_SUPEROP  = 8;      // TODO: Change the opcode to PICASO_SELECT, and move SELECT under SUPEROP
+  PICASO_SUPEROP  = 8,      // TODO: Change the opcode to PICASO_SELECT, and move SELECT under SUPEROP
+  PICASO_MULT     = 9;      // runs UPDATEPP for the multiplier bits OFFSET to LAST (clears the prevMbit first)
 
 
 // codes for the "fn" field of the instruction register
@@ -91,7 +93,8 @@ localparam [PICASO_INSTR_FN_WIDTH-1:0]
 
 // codes for the S_CODE field of the SUPER_OP instruction
 localparam [PICASO_INSTR_SEG0_WIDTH-1:0]
-  PICASO_SCODE_CLRMBIT = 0;    // clears the prevMbit registers in ALU
+  PICASO_SCODE_CLRMBIT = 0,    // clears the prevMbit registers in ALU
+  PICASO_SCODE_FILLREG = 1;    // writes DATA to all rows of register RD in the selected blocks (multi-cycle)
 
 
 // Type codes of instructions
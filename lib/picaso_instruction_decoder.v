@@ -147,6 +147,7 @@ module picaso_instruction_decoder #(
   wire [REG_BASE_WIDTH-1:0] fld_rd, fld_rs1, fld_rs2;
   wire [ID_WIDTH-1:0]       fld_rowID, fld_colID;
   wire [SCODE_WIDTH-1:0]    fld_sCode;
+  wire [REG_BASE_WIDTH-1:0] fld_sRd;     // RD of the super-op instructions, it is placed after the super-code
   wire [PARAM_WIDTH-1:0]    fld_param;
 
 
@@ -163,6 +164,7 @@ module picaso_instruction_decoder #(
 
 
   // Decode instruction: [ opcode ] [ OFFSET, RD ] [ RS2, RS1 ]
+  //                     [ MULT   ] [ OFFSET, RD ] [ LAST, RS2, RS1 ]    (LAST is extracted from data by picaso_fsm_vars)
   assign fld_rs1    = segment0[0 +: REG_BASE_WIDTH];
   assign fld_rs2    = segment0[REG_BASE_WIDTH +: REG_BASE_WIDTH];
   assign fld_rd     = segment1[0 +: REG_BASE_WIDTH];
@@ -190,7 +192,9 @@ module picaso_instruction_decoder #(
 
 
   // Decode instruction: [ super-op ] [ super-code ] [ param(s) ]
+  //                     [ super-op ] [ RD, super-code ] [ DATA ]
   assign fld_sCode  = segment1[0 +: SCODE_WIDTH];
+  assign fld_sRd    = segment1[SCODE_WIDTH +: REG_BASE_WIDTH];
 
   always@(posedge clk) begin
     sCode <= fld_sCode;
@@ -229,7 +233,7 @@ module picaso_instruction_decoder #(
       _selectcode = 0;    // start with a default value
       (* full_case, parallel_case *)
       case(_opcode)
-        //PICASO_MULT : _instr_type = MULTI_CYCLE_TYPE;
+        PICASO_MULT:     _selectcode = ALGORITHM_MULT;
         PICASO_UPDATEPP: _selectcode = ALGORITHM_UPDATEPP;
         PICASO_ALUOP:    _selectcode = ALGORITHM_ALUOP;
 
@@ -251,6 +255,8 @@ module picaso_instruction_decoder #(
           endcase
         end
 
+        PICASO_SUPEROP:  _selectcode = ALGORITHM_FILLREG;    // FILLREG is the only multi-cycle super-op
+
         default: ;    // keep initial value
       endcase
       get_algoselection = _selectcode;   // return value
@@ -263,6 +269,7 @@ module picaso_instruction_decoder #(
   //          Answers the question: is this instruction a single-cycle or a multicycle instruction?
   function automatic [PICASO_INSTR_TYPE_CODE_WIDTH-1:0] get_instruction_type;
     input [OPCODE_WIDTH-1:0] _opcode;
+    input [SCODE_WIDTH-1:0]  _sCode;
 
     // internal variables
     reg [PICASO_INSTR_TYPE_CODE_WIDTH-1:0] _instr_type;
@@ -274,6 +281,8 @@ module picaso_instruction_decoder #(
         PICASO_ACCUM:     _instr_type = INSTR_TYPE_MULTI_CYCLE;
         PICASO_ALUOP:     _instr_type = INSTR_TYPE_MULTI_CYCLE;
         PICASO_MOV:       _instr_type = INSTR_TYPE_MULTI_CYCLE;
+        PICASO_MULT:      _instr_type = INSTR_TYPE_MULTI_CYCLE;
+        PICASO_SUPEROP:   _instr_type = (_sCode == PICASO_SCODE_FILLREG) ? INSTR_TYPE_MULTI_CYCLE : INSTR_TYPE_SINGLE_CYCLE;
         default:          _instr_type = INSTR_TYPE_SINGLE_CYCLE;    // every other instruction is single-cycle
       endcase
       get_instruction_type = _instr_type;   // return value
@@ -284,15 +293,16 @@ module picaso_instruction_decoder #(
   // set the pipelined decoded signal outputs
   always@(posedge clk) begin
     algoselCode <= get_algoselection(fld_opcode, fld_fncode);
-    instrType   <= get_instruction_type(fld_opcode);
+    instrType   <= get_instruction_type(fld_opcode, fld_sCode);
   end
 
 
   // AK-NOTE: Following addresses decoder logic was part of picaso_fsm_vars.v
+  //          The super-ops place RD after the super-code, rd_base takes it from there.
   always@(posedge clk) begin
     rs1_base = fld_rs1 * PE_REG_WIDTH;
     rs2_base = fld_rs2 * PE_REG_WIDTH;
-    rd_base  = fld_rd  * PE_REG_WIDTH;
+    rd_base  = (fld_opcode == PICASO_SUPEROP ? fld_sRd : fld_rd) * PE_REG_WIDTH;
 
     rd_with_offset  = fld_rd  * PE_REG_WIDTH + fld_offset;
     rs1_with_offset = fld_rs1 * PE_REG_WIDTH + fld_offset;
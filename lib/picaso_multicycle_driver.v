@@ -51,7 +51,8 @@ module picaso_multicycle_driver #(
   parameter INSTR_PARAM_WIDTH = -1,
   parameter NET_LEVEL_WIDTH = -1,
   parameter PE_REG_WIDTH = -1,
-  parameter PRECISION_WIDTH = -1
+  parameter PRECISION_WIDTH = -1,
+  parameter BOOTH_RADIX = -1
 ) (
   clk,
   enTransition,     // enables state transitions
@@ -136,6 +137,7 @@ module picaso_multicycle_driver #(
   `AK_ASSERT2(INSTR_PARAM_WIDTH >= 0, INSTR_PARAM_WIDTH_not_set)
   `AK_ASSERT2(NET_LEVEL_WIDTH >= 0, NET_LEVEL_WIDTH_not_set)
   `AK_ASSERT2(PE_REG_WIDTH >= 0, PE_REG_WIDTH_not_set)
+  `AK_ASSERT2(BOOTH_RADIX >= 0, BOOTH_RADIX_not_set)
 
 
   // IO Ports
@@ -216,6 +218,7 @@ module picaso_multicycle_driver #(
   wire                         algo_var_clrNetCaptureEn;
   wire                         algo_var_setPicasoPtrIncr;
   wire                         algo_var_clrPicasoPtrIncr;
+  wire                         algo_var_multNextPass;
 
   wire [OPCODE_WIDTH-1:0]      algo_var_opcode;
   wire [ADDR_WIDTH-1:0]        algo_var_addr;
@@ -236,6 +239,8 @@ module picaso_multicycle_driver #(
   wire [ADDR_WIDTH-1:0]        algo_var_addrA;
   wire [ADDR_WIDTH-1:0]        algo_var_addrB;
   wire                         algo_var_picasoPtrIncr;
+  wire [DATA_WIDTH-1:0]        algo_var_extData;
+  wire                         algo_var_multLastPass;
 
   picaso_fsm_vars #(
       .DEBUG(DEBUG),
@@ -248,7 +253,8 @@ module picaso_multicycle_driver #(
       .OPCODE_WIDTH(OPCODE_WIDTH),
       .PICASO_ID_WIDTH(PICASO_ID_WIDTH),
       .REG_BASE_WIDTH(REG_BASE_WIDTH),
-      .PE_REG_WIDTH(PE_REG_WIDTH) )
+      .PE_REG_WIDTH(PE_REG_WIDTH),
+      .BOOTH_RADIX(BOOTH_RADIX) )
     algo_var_man (
       .clk(clk),
       .loadInit(algo_var_loadInit),
@@ -262,6 +268,7 @@ module picaso_multicycle_driver #(
       .clrNetCaptureEn(algo_var_clrNetCaptureEn),
       .setPicasoPtrIncr(algo_var_setPicasoPtrIncr),
       .clrPicasoPtrIncr(algo_var_clrPicasoPtrIncr),
+      .multNextPass(algo_var_multNextPass),
 
       .opcode(algo_var_opcode),
       .addr(algo_var_addr),
@@ -293,6 +300,8 @@ module picaso_multicycle_driver #(
       .addrA(algo_var_addrA),
       .addrB(algo_var_addrB),
       .picasoPtrIncr(algo_var_picasoPtrIncr),
+      .extData(algo_var_extData),
+      .multLastPass(algo_var_multLastPass),
 
       // debug probes
       .dbg_clk_enable(dbg_clk_enable)   // pass the debug stepper clock
@@ -308,13 +317,17 @@ module picaso_multicycle_driver #(
   wire                                algo_fsm_clrNetCaptureEn;
   wire                                algo_fsm_setPicasoPtrIncr;
   wire                                algo_fsm_clrPicasoPtrIncr;
+  wire                                algo_fsm_multNextPass;
+  wire                                algo_fsm_multLastPass;
 
 
   picaso_algorithm_fsm #(
       .DEBUG(DEBUG),
       .PRECISION_WIDTH(PRECISION_WIDTH),
       .INSTR_PARAM_WIDTH(INSTR_PARAM_WIDTH),
-      .NET_LEVEL_WIDTH(NET_LEVEL_WIDTH) )
+      .NET_LEVEL_WIDTH(NET_LEVEL_WIDTH),
+      .PE_REG_WIDTH(PE_REG_WIDTH),
+      .BOOTH_RADIX(BOOTH_RADIX) )
     algo_fsm (
       .clk(clk),
       .precision(precision),
@@ -327,6 +340,8 @@ module picaso_multicycle_driver #(
       .clrNetCaptureEn(algo_fsm_clrNetCaptureEn),
       .setPicasoPtrIncr(algo_fsm_setPicasoPtrIncr),
       .clrPicasoPtrIncr(algo_fsm_clrPicasoPtrIncr),
+      .multNextPass(algo_fsm_multNextPass),
+      .multLastPass(algo_fsm_multLastPass),
 
       // debug probes
       .dbg_clk_enable(dbg_clk_enable)   // pass the debug stepper clock
@@ -407,7 +422,8 @@ module picaso_multicycle_driver #(
   // ---- Local Interconnect: Connecting Signals and Modules ----
   // inputs of algo_fsm
   assign algo_fsm_enTransition = enTransition,
-         algo_fsm_selAlgo      = selAlgo;
+         algo_fsm_selAlgo      = selAlgo,
+         algo_fsm_multLastPass = algo_var_multLastPass;
 
 
   // inputs of fsm variable manager 
@@ -436,7 +452,8 @@ module picaso_multicycle_driver #(
   assign algo_var_setNetCaptureEn  = algo_fsm_setNetCaptureEn,
          algo_var_clrNetCaptureEn  = algo_fsm_clrNetCaptureEn,
          algo_var_setPicasoPtrIncr = algo_fsm_setPicasoPtrIncr,
-         algo_var_clrPicasoPtrIncr = algo_fsm_clrPicasoPtrIncr;
+         algo_var_clrPicasoPtrIncr = algo_fsm_clrPicasoPtrIncr,
+         algo_var_multNextPass     = algo_fsm_multNextPass;
 
 
   // inputs of algorithm decoder
@@ -471,17 +488,18 @@ module picaso_multicycle_driver #(
          sigPtrIncr    = algo_var_picasoPtrIncr,
          sigPtrLoad    = algo_decoder_ptrLoad;
 
+  assign sigExtDataSave = algo_decoder_extDataSave,
+         sigExtDataIn   = algo_var_extData,
+         sigSelOp       = algo_decoder_extDataSave;    // external data is only saved into the selected blocks (like WRITE)
+
   assign algoDone = algo_fsm_algoDone;
 
 
   // following signals are not controlled by this driver
-  assign sigExtDataSave = 0,
-         sigExtDataIn = 0,
-         sigSelRow = 0,
+  assign sigSelRow = 0,
          sigSelCol = 0,
          sigSelMode = 0,
-         sigSelEn = 0,
-         sigSelOp = 0;
+         sigSelEn = 0;
 
 
 
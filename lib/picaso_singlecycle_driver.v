@@ -233,6 +233,7 @@ module picaso_singlecycle_driver #(
       (* full_case, parallel_case *)
       case(sCode)
         PICASO_SCODE_CLRMBIT: sigAluMbitReset = 1;
+        PICASO_SCODE_FILLREG: ;    // multi-cycle instruction, executed by the multi-cycle driver
         default: ;     // NOP
       endcase
     end
@@ -0,0 +1,240 @@
+/*********************************************************************************
+* Copyright (c) 2023, Computer Systems Design Lab, University of Arkansas        *
+*                                                                                *
+* All rights reserved.                                                           *
+*                                                                                *
+* Permission is hereby granted, free of charge, to any person obtaining a copy   *
+* of this software and associated documentation files (the "Software"), to deal  *
+* in the Software without restriction, including without limitation the rights   *
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      *
+* copies of the Software, and to permit persons to whom the Software is          *
+* furnished to do so, subject to the following conditions:                       *
+*                                                                                *
+* The above copyright notice and this permission notice shall be included in all *
+* copies or substantial portions of the Software.                                *
+*                                                                                *
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     *
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       *
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    *
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         *
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  *
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  *
+* SOFTWARE.                                                                      *
+**********************************************************************************
+
+==================================================================================
+
+  Version: v1.0
+
+  Description:
+  This module describes the transition table for MULT instruction. It is a
+  purely combinatorial module.
+
+  MULT executes the UPDATEPP passes for the multiplier bits OFFSET to LAST,
+  which replaces the CLRMBIT + UPDATEPP sequence of the mult macro. The
+  previous multiplier-bit storage is cleared once, then the UPDATEPP states
+  are reused for each pass. At the end of a pass, if it is not the last one,
+  the variable manager is asked to move the pointers to the next multiplier
+  bit (multNextPass), instead of going back to INIT. The variable manager
+  reports the last pass (multLastPass). With booth's radix-4, each pass
+  consumes 2 multiplier bits, using the radix-4 states of the UPDATEPP pass.
+
+
+       .------.      .------------.      .--------------------.
+  ---->| INIT |----->| aluMbitRst |----->| UPDATEPP pass      |<---.
+       '------'      '------------'      | (aluRst_opmxAopB_  |    |
+           ^                             |  multRead ...      |    | !multLastPass
+           |                             |  aluDis_bWrite_1)  |    | (multNextPass)
+           |                             '--------------------'    |
+           |                                   |        |          |
+           '-----------------------------------'        '----------'
+                      multLastPass
+
+================================================================================*/
+`timescale 1ns/100ps
+`include "ak_macros.v"
+
+
+
+module transition_mult #(
+  parameter DEBUG = 1,
+  parameter STATE_CODE_WIDTH = -1,
+  parameter COUNT0_VAL_WIDTH = -1,
+  parameter BOOTH_RADIX = 2       // booth's encoding used by the ALU: 2 or 4
+) (
+  cur_state,      // current state input
+  next_state,     // next state output
+  algo_done,      // signals that this is the last state, next state will be INIT
+
+  count0_val,      // value to load into counter
+  count0_load,     // enable signal to load
+  count0_en,       // enable counting
+  count0_done,     // counter expired
+
+  count1_valSelect, // selects counter1 load value
+  count1_load,      // enable signal to load
+  count1_en,        // enable counting
+  count1_done,      // counter expired
+
+  multNextPass,     // moves the pointers to the next multiplier bit
+  multLastPass      // current pass is for the last multiplier bit
+);
+
+  `include "picaso_algorithm_decoder.inc.v"
+  `include "picaso_algorithm_fsm.inc.v"
+
+  `AK_ASSERT(STATE_CODE_WIDTH == PICASO_ALGO_CODE_WIDTH)
+  `AK_ASSERT(BOOTH_RADIX == 2 || BOOTH_RADIX == 4)
+
+  localparam [STATE_CODE_WIDTH-1:0] INIT_STATE = PICASO_ALGO_NOP;   // all state-machines starts at PICASO_ALGO_NOP state
+
+  // booth's radix-4 pass reads 2 multiplier bits, and computes 2 sign-extension bits (check footnote [2] of picaso_algorithm_decoder.inc.v)
+  localparam RADIX4 = (BOOTH_RADIX == 4);
+  localparam [STATE_CODE_WIDTH-1:0] PASS_START_STATE = RADIX4 ? PICASO_ALGO_aluRst_opmxAopB_multReadInc : PICASO_ALGO_aluRst_opmxAopB_multRead;
+  localparam [STATE_CODE_WIDTH-1:0] OPMUX_LOAD_STATE = RADIX4 ? PICASO_ALGO_opmxLoadParam_mbitLoad_bRead : PICASO_ALGO_opmxLoadParam_bRead;
+
+
+  // IO Ports
+  input      [STATE_CODE_WIDTH-1:0] cur_state;
+  output reg [STATE_CODE_WIDTH-1:0] next_state;
+  output reg                        algo_done;
+
+  output reg [COUNT0_VAL_WIDTH-1:0]  count0_val;
+  output reg                         count0_load;
+  output reg                         count0_en;
+  input                              count0_done;
+
+  output reg [ALGORITHM_CTR1_SEL_WIDTH-1:0] count1_valSelect;
+  output reg                                count1_load;
+  output reg                                count1_en;
+  input                                     count1_done;
+
+  output reg                                multNextPass;
+  input                                     multLastPass;
+
+
+  // -- Task to set default values for the output ports to values equivalent of NOP
+  localparam COMMON_CNT0_VAL = 2;     // it is a common value for counter0
+  task all_nop;
+    begin
+      algo_done = 0;        // NOP
+      count0_load = 0;      // NOP
+      count0_en = 0;        // NOP
+      count1_load = 0;      // NOP
+      count1_en = 0;        // NOP
+      count1_valSelect = 0;
+      multNextPass = 0;     // NOP
+      count0_val = COMMON_CNT0_VAL;  // overlap with common cases reduces logic utilization
+    end
+  endtask
+
+
+
+  // state transition table:
+  //   - It computes the next state based on current state and counter states.
+  //   - It also generates the counter control signals
+  //   - States of a pass are the same as transition_updatepp, except the last one
+  always@* begin
+    all_nop;     // start with NOP
+    (* full_case, parallel_case *)
+    case(cur_state)
+      INIT_STATE: begin
+        // Load the counter1 to (precision >> 2) for iterations of the first pass
+        // Move to a state that clears the multiplier bit storage (CLRMBIT)
+        count1_valSelect = ALGORITHM_CTR1_SEL_2SHR;
+        count1_load = 1'b1;
+        next_state  = PICASO_ALGO_aluMbitRst;
+      end
+
+      PICASO_ALGO_aluMbitRst: begin
+        // Move to the first state of the UPDATEPP pass
+        next_state = PASS_START_STATE;
+      end
+
+      PICASO_ALGO_aluRst_opmxAopB_multRead: next_state = PICASO_ALGO_bRead_0;
+      PICASO_ALGO_bRead_0:                  next_state = OPMUX_LOAD_STATE;
+      PICASO_ALGO_opmxLoadParam_bRead:      next_state = PICASO_ALGO_aluLoadParam_bRead;
+      PICASO_ALGO_aluLoadParam_bRead:       next_state = PICASO_ALGO_aluEn_bRead;
+
+      // radix-4 only states
+      PICASO_ALGO_aluRst_opmxAopB_multReadInc:  next_state = PICASO_ALGO_multRead_1;
+      PICASO_ALGO_multRead_1:                   next_state = PICASO_ALGO_bRead_0;
+      PICASO_ALGO_opmxLoadParam_mbitLoad_bRead: next_state = PICASO_ALGO_aluLoadParam_bRead;
+
+      PICASO_ALGO_aluEn_bRead: begin
+        // Decrement the iteration coutner (counter1), doing so here makes it possible to use val0 as the counter-done signal.
+        // Set counter0 to 2, to stay in the next state for 3 cycles.
+        count1_en = 1'b1;
+        count0_val = 2;
+        count0_load = 1'b1;
+        next_state = PICASO_ALGO_bWrite;
+      end
+
+      PICASO_ALGO_bWrite: begin
+        // Stay in this state until counter0 expires.
+        // (radix-4) compute the sign-extension bits for 2 cycles at the end of the pass
+        count0_en = 1;
+        if(!count0_done) begin
+          next_state = PICASO_ALGO_bWrite;
+        end else if(RADIX4 && count1_done) begin
+          count0_val = 1;
+          count0_load = 1;
+          next_state = PICASO_ALGO_aluExt_bWrite;
+        end else begin
+          next_state = PICASO_ALGO_aluDis_bWrite;
+        end
+      end
+
+      PICASO_ALGO_aluExt_bWrite: begin
+        // (radix-4) Stay in this state until counter0 expires, then write the last bit.
+        count0_en = 1;
+        if(!count0_done) next_state = PICASO_ALGO_aluExt_bWrite;
+        else             next_state = PICASO_ALGO_aluDis_bWrite_1;
+      end
+
+      PICASO_ALGO_aluDis_bWrite: begin
+        // Check if counter1 expired.
+        // if no: read the next bits, stay there for 3 cycles
+        // if yes: write the last bit again (sign extension)
+        if(!count1_done) begin
+          count0_val = 2;
+          count0_load = 1;
+          next_state = PICASO_ALGO_bRead_1;
+        end else begin
+          next_state = PICASO_ALGO_aluDis_bWrite_1;
+        end
+      end
+
+      PICASO_ALGO_bRead_1: begin
+        // Stay in this state until counter0 expires.
+        count0_en = 1;
+        if(!count0_done) next_state = PICASO_ALGO_bRead_1;
+        else             next_state = PICASO_ALGO_aluEn_bRead;
+      end
+
+      PICASO_ALGO_aluDis_bWrite_1: begin
+        // Check if this is the last pass.
+        // if no:
+        //   - move the pointers to the next multiplier bit
+        //   - reload counter1 for the iterations of the next pass
+        //   - start the next pass
+        // if yes:
+        //   - assert the done signal
+        //   - go back to initial state
+        if(!multLastPass) begin
+          multNextPass = 1;
+          count1_valSelect = ALGORITHM_CTR1_SEL_2SHR;
+          count1_load = 1'b1;
+          next_state = PASS_START_STATE;
+        end else begin
+          algo_done = 1;
+          next_state = INIT_STATE;
+        end
+      end
+
+      default: next_state = INIT_STATE;    // NOP and go back to initial state
+    endcase
+  end
+
+
+endmodule
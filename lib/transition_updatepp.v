@@ -57,6 +57,12 @@
                              |
                           count1_done
 
+  With booth's radix-4 (BOOTH_RADIX = 4), the pass reads 2 multiplier bits
+  (aluRst_opmxAopB_multReadInc, multRead_1) before bRead_0, and
+  opmxLoadParam_bRead is replaced by opmxLoadParam_mbitLoad_bRead. In the
+  last iteration, bWrite moves to 2 cycles of aluExt_bWrite (instead of
+  aluDis_bWrite) to compute the 2 sign-extension bits.
+
 ================================================================================*/
 `timescale 1ns/100ps
 `include "ak_macros.v"
@@ -66,7 +72,8 @@
 module transition_updatepp #(
   parameter DEBUG = 1,
   parameter STATE_CODE_WIDTH = -1,
-  parameter COUNT0_VAL_WIDTH = -1
+  parameter COUNT0_VAL_WIDTH = -1,
+  parameter BOOTH_RADIX = 2       // booth's encoding used by the ALU: 2 or 4
 ) (
   cur_state,      // current state input
   next_state,     // next state output
@@ -87,10 +94,16 @@ module transition_updatepp #(
   `include "picaso_algorithm_fsm.inc.v"
 
   `AK_ASSERT(STATE_CODE_WIDTH == PICASO_ALGO_CODE_WIDTH)
+  `AK_ASSERT(BOOTH_RADIX == 2 || BOOTH_RADIX == 4)
   //`AK_TOP_WARN("Add state diagram for transition_updatepp AFTER testing")    // simulation-time warning (uncomment this if implementation is changed)
 
   localparam [STATE_CODE_WIDTH-1:0] INIT_STATE = PICASO_ALGO_NOP;   // all state-machines starts at PICASO_ALGO_NOP state
 
+  // booth's radix-4 pass reads 2 multiplier bits, and computes 2 sign-extension bits (check footnote [2] of picaso_algorithm_decoder.inc.v)
+  localparam RADIX4 = (BOOTH_RADIX == 4);
+  localparam [STATE_CODE_WIDTH-1:0] PASS_START_STATE = RADIX4 ? PICASO_ALGO_aluRst_opmxAopB_multReadInc : PICASO_ALGO_aluRst_opmxAopB_multRead;
+  localparam [STATE_CODE_WIDTH-1:0] OPMUX_LOAD_STATE = RADIX4 ? PICASO_ALGO_opmxLoadParam_mbitLoad_bRead : PICASO_ALGO_opmxLoadParam_bRead;
+
 
   // IO Ports
   input      [STATE_CODE_WIDTH-1:0] cur_state;
@@ -139,7 +152,7 @@ module transition_updatepp #(
         //   - reads multiplier bits from the BRAM
         count1_valSelect = ALGORITHM_CTR1_SEL_2SHR;
         count1_load = 1'b1;
-        next_state  = PICASO_ALGO_aluRst_opmxAopB_multRead;
+        next_state  = PASS_START_STATE;
       end
 
       PICASO_ALGO_aluRst_opmxAopB_multRead: begin
@@ -148,11 +161,29 @@ module transition_updatepp #(
         next_state = PICASO_ALGO_bRead_0;
       end
 
+      PICASO_ALGO_aluRst_opmxAopB_multReadInc: begin
+        // (radix-4) Move to a state that
+        //   - reads the next multiplier bit
+        next_state = PICASO_ALGO_multRead_1;
+      end
+
+      PICASO_ALGO_multRead_1: begin
+        // (radix-4) Move to a state that
+        //   - Reads the partial-product and multiplicand bits, and increments their pointers
+        next_state = PICASO_ALGO_bRead_0;
+      end
+
       PICASO_ALGO_bRead_0: begin
         // Move to a state that
         //   - loads opmux configuration from instruction field
+        //   - (radix-4) saves the first multiplier bit in ALU
         //   - Reads the partial-product and multiplicand bits, and increments their pointers
-        next_state = PICASO_ALGO_opmxLoadParam_bRead;
+        next_state = OPMUX_LOAD_STATE;
+      end
+
+      PICASO_ALGO_opmxLoadParam_mbitLoad_bRead: begin
+        // (radix-4) same as PICASO_ALGO_opmxLoadParam_bRead
+        next_state = PICASO_ALGO_aluLoadParam_bRead;
       end
 
       PICASO_ALGO_opmxLoadParam_bRead: begin
@@ -187,9 +218,25 @@ module transition_updatepp #(
         // Then, move to a state that
         //   - writes to BRAM and increments pointer
         //   - disables ALU
+        //   - (radix-4) computes the sign-extension bits if counter1 expired, stays there for 2 cycles
+        count0_en = 1;
+        if(!count0_done) begin
+          next_state = PICASO_ALGO_bWrite;
+        end else if(RADIX4 && count1_done) begin
+          count0_val = 1;
+          count0_load = 1;
+          next_state = PICASO_ALGO_aluExt_bWrite;
+        end else begin
+          next_state = PICASO_ALGO_aluDis_bWrite;
+        end
+      end
+
+      PICASO_ALGO_aluExt_bWrite: begin
+        // (radix-4) Stay in this state until counter0 expires.
+        // Then, move to a state that writes the last sign-extension bit
         count0_en = 1;
-        if(!count0_done) next_state = PICASO_ALGO_bWrite;
-        else             next_state = PICASO_ALGO_aluDis_bWrite;
+        if(!count0_done) next_state = PICASO_ALGO_aluExt_bWrite;
+        else             next_state = PICASO_ALGO_aluDis_bWrite_1;
       end
 
       PICASO_ALGO_aluDis_bWrite: begin
@@ -15,6 +15,7 @@ dataFile   = 'ex01_data.npz'
 progHeader = 'out/imagine_prog.h'
 loaderCout = 'out/ex01_loader.c'
 kernelCout = 'out/ex01_kernel.c'
+modelBin   = 'out/ex01_model.bin'     # loader and kernel in a binary container
 
 
 # ---- Load weights and biases from external file
@@ -43,9 +44,13 @@ mv_LOADVEC_COL(reg=regB, vector=B); as_addComment('Finished writing vector B as
 mv_LOADVEC_ROW(reg=regV, vector=V); as_addComment('Finished writing vector V as rows\n')
 
 
-# Export the loader program then reset for the kernel program
+# Export the loader program then reset for the kernel program.
+# The kernel runs on the weights left by the loader, so the register
+# annotations are kept. With pruneMult, the multiplications skip the NOP
+# passes of these weights, then the host must not replace them at runtime.
 imagine_as.export_CprogHex('ex01_loader', loaderCout)
-imagine_as.reset()
+imagine_as.export_binary('ex01_loader', modelBin, kind='loader')
+imagine_as.reset(keepRegs=True)
 
 
 # Perform A@V + B
@@ -61,5 +66,6 @@ vv_parallelEn()
 
 # Export the kernel program and the program header
 imagine_as.export_CprogHex('ex01_kernel', kernelCout)
+imagine_as.export_binary('ex01_kernel', modelBin, append=True)
 imagine_as.export_CprogHeader(progHeader)
 
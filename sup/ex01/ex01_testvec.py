@@ -10,6 +10,7 @@ dataFile   = 'ex01_data.npz'
 # ---- Load weights and biases from external file
 npData = np.load(dataFile)
 Vfxp = npData['Vfxp']
+Afxp = npData['Afxp']       # fixed-point matrix of MV_LOADMAT, golden data for the host tests of img_mv_LOADMAT()
 expOut = npData['expOut']   # expected output of A@V+B in fixed-point for testing
 
 
@@ -31,7 +32,9 @@ header = '#include <stdint.h>'
 with open(testCout, 'w') as fexp:
     testVec = makeCarray(Vfxp, 'ex01_testInp', 'int16_t')
     testOut = makeCarray(expOut, 'ex01_testOut', 'int16_t')
-    fexp.write('\n\n\n'.join([header, testVec, testOut]))
+    testMat = makeCarray(Afxp.flatten(), 'ex01_testMat', 'int16_t')     # row-major
+    testMat += f'\nint ex01_testMat_cols = {Afxp.shape[1]};'
+    fexp.write('\n\n\n'.join([header, testVec, testOut, testMat]))
 print(f'INFO: Expected outputs C-array written to {testCout}')
 
 
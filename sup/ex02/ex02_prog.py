@@ -15,6 +15,7 @@ dataFile   = 'ex02_data.npz'
 progHeader = 'out/imagine_prog.h'
 loaderCout = 'out/ex02_loader.c'
 kernelCout = 'out/ex02_kernel.c'
+modelBin   = 'out/ex02_model.bin'     # loader and kernel in a binary container
 
 
 # This example shows how to perform the GEMV operations involved
@@ -120,9 +121,13 @@ mv_LOADVEC_ROW(regHp, Hp)
 as_addComment('Finished writing input vector\n')
 
 
-# Export the loader program then reset for the kernel program
+# Export the loader program then reset for the kernel program.
+# The kernel runs on the weights left by the loader, so the register
+# annotations are kept. With pruneMult, the multiplications skip the NOP
+# passes of these weights, then the host must not replace them at runtime.
 imagine_as.export_CprogHex('ex02_loader', loaderCout)
-imagine_as.reset()
+imagine_as.export_binary('ex02_loader', modelBin, kind='loader')
+imagine_as.reset(keepRegs=True)
 
 
 # Convenience macro to compute LST gate output before activation.
@@ -169,5 +174,6 @@ vv_SYNC()
 
 # Export the kernel program and the program header
 imagine_as.export_CprogHex('ex02_kernel', kernelCout)
+imagine_as.export_binary('ex02_kernel', modelBin, append=True)
 imagine_as.export_CprogHeader(progHeader)
 
@@ -18,6 +18,32 @@ C_a_fxp = npData['C_a_fxp']
 expOut = npData['expOut']   # expected output in fixed-point for testing
 
 
+# ---- Record a sequence of LSTM steps for the host tests of the driver.
+# The float LSTM cell runs on a slowly varying sensor signal, starting from
+# Xt/Hp; the fixed-point inputs of each step (Xt, Hp) are the vectors the
+# firmware reloads into the registers at every step.
+seqSteps = 64
+def sigmoid(x): return 1 / (1 + np.exp(-x))
+def recordSequence(steps):
+    fxp = lambda v: (v * (1 << int(npData['fracWidth']))).astype(int)
+    rng = np.random.default_rng(2)
+    phase = rng.uniform(0, 2*np.pi, len(npData['Xt']))
+    Xt, Ht, Ct = npData['Xt'], npData['Hp'], np.zeros(len(npData['Hp']))
+    seqXt, seqHt = [], []
+    for t in range(steps):
+        seqXt.append(fxp(Xt))
+        seqHt.append(fxp(Ht))
+        It = sigmoid(npData['Wxi'] @ Xt + npData['Whi'] @ Ht + npData['bi'])
+        Ft = sigmoid(npData['Wxf'] @ Xt + npData['Whf'] @ Ht + npData['bf'])
+        Ot = sigmoid(npData['Wxo'] @ Xt + npData['Who'] @ Ht + npData['bo'])
+        C_t = np.tanh(npData['Wxc'] @ Xt + npData['Whc'] @ Ht + npData['bc'])
+        Ct = Ft * Ct + It * C_t
+        Ht = Ot * np.tanh(Ct)
+        Xt = npData['Xt'] + 0.05*np.sin(0.1*(t+1) + phase)    # next sensor reading
+    return np.array(seqXt), np.array(seqHt)
+seqXt, seqHt = recordSequence(seqSteps)
+
+
 # Returns a C-array representation string of the given
 # array arr, with varName as the variable name and
 # typeName as the data type.
@@ -40,7 +66,10 @@ with open(testCout, 'w') as fexp:
     Fa = makeCarray(Fa_fxp, 'ex02_FaFxp', 'int16_t')
     Oa = makeCarray(Oa_fxp, 'ex02_OaFxp', 'int16_t')
     Ca = makeCarray(C_a_fxp, 'ex02_CaFxp', 'int16_t')
-    fexp.write('\n\n\n'.join([header, testXt, testHp, Ia, Fa, Oa, Ca]))
+    seqX = makeCarray(seqXt.flatten(), 'ex02_seqXt', 'int16_t')     # seqSteps vectors, one after the other
+    seqH = makeCarray(seqHt.flatten(), 'ex02_seqHt', 'int16_t')
+    seqX += f'\nint ex02_seqSteps = {seqSteps};'
+    fexp.write('\n\n\n'.join([header, testXt, testHp, Ia, Fa, Oa, Ca, seqX, seqH]))
 print(f'INFO: Test vectors C-array written to {testCout}')
 
 
@@ -15,6 +15,7 @@ dataFile   = 'ex03_data.npz'
 progHeader = 'out/imagine_prog.h'
 loaderCout = 'out/ex03_loader.c'
 kernelCout = 'out/ex03_kernel.c'
+modelBin   = 'out/ex03_model.bin'     # loader and kernel in a binary container
 
 
 # This example shows how to perform the GEMV operations involved
@@ -128,9 +129,13 @@ mv_LOADVEC_COL(regbb, bb); as_addComment('Finished writing biases\n')
 mv_LOADVEC_ROW(regXH, XH); as_addComment('Finished writing test input vector\n')
 
 
-# Export the loader program then reset for the kernel program
+# Export the loader program then reset for the kernel program.
+# The kernel runs on the weights left by the loader, so the register
+# annotations are kept. With pruneMult, the multiplications skip the NOP
+# passes of these weights, then the host must not replace them at runtime.
 imagine_as.export_CprogHex('ex03_loader', loaderCout)
-imagine_as.reset()
+imagine_as.export_binary('ex03_loader', modelBin, kind='loader')
+imagine_as.reset(keepRegs=True)
 
 
 # Compute W @ XH + bb
@@ -144,5 +149,6 @@ vv_parallelEn()     # start parallel shifting output vector
 
 # Export the kernel program and the program header
 imagine_as.export_CprogHex('ex03_kernel', kernelCout)
+imagine_as.export_binary('ex03_kernel', modelBin, append=True)
 imagine_as.export_CprogHeader(progHeader)
 
@@ -39,6 +39,8 @@
 #================================================================================#
 
 import math
+import struct
+import zlib
 import numpy as np
 import yaml
 from string import Template
@@ -92,6 +94,19 @@ IMAGine_Prog $progname = {{
 ''')
 
 
+# Binary program container (see imagine_binprog.h of the driver), little-endian:
+#   [header] [section table] [instruction words of the sections]
+# The checksum is the CRC-32 of the file after the checksum field.
+bin_magic      = 0x42474D49     # "IMGB"
+bin_version    = 1
+bin_header     = struct.Struct('<IHHII4B2H8x')  # magic, version, sectCount, fileSize, checksum,
+                                                # fracWidth, regWidth, idWidth, peCount, mvMaxRow, mvMaxCol
+bin_name_len   = 20                             # section names are NUL padded
+bin_section    = struct.Struct(f'<{bin_name_len}sIII')  # name, type, offset (bytes), size (words)
+bin_sect_types = {'loader' : 1, 'kernel' : 2}
+bin_sect_compressed = 0x100                      # type flag: the section holds WRUNs
+
+
 # IR3 instruction format:
 # [sub-module-code] [sub-module-instruction] 
 # [2-bit]           [30-bit]
@@ -118,14 +133,22 @@ class IMAGineAsm:
     tbl_submCode = {
         'mv' : 0,
         'vv' : 1,
+        'rp' : 3,   # REPEAT, consumed by the IMAGine interface (only emitted within macros)
         'as' : -1,  # a dummy submodule for the assembler itself
     }
 
     tbl_field_width = {
         'submCode'  : 2,    # width of the submodule-code field
         'submInstr' : 30,   # width of the submodule-instruction field
+        'rptCount'  : 8,    # width of the COUNT field of REPEAT
+        'rptShift'  : 5,    # width of the SHIFT field of REPEAT
+        'rptStride' : 16,   # width of the STRIDE field of REPEAT (1 reserved bit above it)
+        'wrunBase'  : 10,   # width of the BASE field of WRUN
+        'wrunMask'  : 16,   # width of the MASK field of WRUN
     }
 
+    wrunMinRows = 4     # shorter WRITE runs are not compressed, they would not get smaller
+
     tbl_vecshift_opcode = {
        'idle'        : 0,
        'serial_en'   : 1,
@@ -141,6 +164,8 @@ class IMAGineAsm:
     def __init__(self):
         self.instructions = []        # will contain internal representation of each instruction
         self.isAssembled = False      # state flag, set to True after assemble
+        self.regBits = {}             # precision annotations {reg: bits} of registers holding narrow values (see mv_LOADMAT)
+        self.regValues = {}           # distinct (fixed-point) values {reg: ndarray} of registers holding a known constant image
         self.picaso_as = self.PiCaSOAsm()  # PiCaSO assembler instance
         self.setupParams()            # setup default parameter values
 
@@ -162,6 +187,8 @@ class IMAGineAsm:
         print(f'{indent}mvMaxCol   : {self.mvMaxCol}')
         print(f'{indent}resvRegCnt : {self.resvRegCnt}')
         print(f'{indent}resvRegBase: {self.resvRegBase}')
+        print(f'{indent}useRepeat  : {self.useRepeat}')
+        print(f'{indent}pruneMult  : {self.pruneMult}')
         print(f'{indent}PiCaSOAsm Params:')
         self.picaso_as.printParams(indent=indent+'  ')
 
@@ -215,6 +242,81 @@ class IMAGineAsm:
         return [(segDict['seg2'], w_seg2), (segDict['seg1'], w_seg1), (segDict['seg0'], w_seg0)]
 
 
+    # Returns the word of a REPEAT instruction for a macro word list.
+    # The next word of the list is dispatched count times, adding stride to the
+    # field starting at bit shift of the IR3 word after each dispatch.
+    # REPEAT is not a GEMV array instruction, so the word carries its own submodule code
+    # (see wordSegments()).
+    def repeat_genWord(self, count, shift, stride):
+        w_count  = self.tbl_field_width['rptCount']
+        w_shift  = self.tbl_field_width['rptShift']
+        w_stride = self.tbl_field_width['rptStride']
+        assert 0 < count < 2**w_count, f'Invalid REPEAT count: {count}'
+        assert 0 <= shift < 2**w_shift, f'Invalid REPEAT shift: {shift}'
+        assert 0 <= stride < 2**w_stride, f'Invalid REPEAT stride: {stride}'
+        segList = [(count, w_count), (shift, w_shift), (0, 1), (stride, w_stride)]
+        return {'submCode' : self.tbl_submCode['rp'], 'segments' : segList}
+
+
+    # Returns the WRUN words that replace a list of WRITE words (see compressWords()).
+    # WRUN is a REPEAT word with the reserved bit set, it is expanded by the IMAGine
+    # interface. The header is followed by the data of the rows, two per word:
+    #   [rp:2] [BASE:10] [000] [1] [MASK:16]  [DATA(row 1):16] [DATA(row 0):16] ...
+    def wrun_genWords(self, writes):
+        w_data = self.picaso_as.tbl_field_width['seg0']
+        w_addr = self.picaso_as.tbl_field_width['seg1']
+        w_base = self.tbl_field_width['wrunBase']
+        w_mask = self.tbl_field_width['wrunMask']
+        addrs = [(word >> w_data) & (2**w_addr-1) for word in writes]
+        data  = [word & (2**w_data-1) for word in writes]
+        base  = addrs[0]
+        mask  = 0
+        for addr in addrs:
+            assert 0 <= addr-base < w_mask, f'WRITE address {addr} is out of the WRUN window at {base}'
+            mask |= 1 << (addr-base)
+        header = (self.tbl_submCode['rp'] << (w_base+4+w_mask)) | (base << (4+w_mask)) | (1 << w_mask) | mask
+        if len(data) % 2: data.append(0)   # upper half of the last word is ignored
+        return [header] + [(data[i+1] << w_data) | data[i] for i in range(0, len(data), 2)]
+
+
+    # Returns a compressed copy of an instruction word list, where the runs of
+    # WRITEs to increasing addresses within a WRUN window are replaced by WRUNs.
+    # Runs shorter than wrunMinRows are kept as-is. The WRITE following a REPEAT
+    # is never compressed, the REPEAT must apply to it.
+    def compressWords(self, words):
+        w_data   = self.picaso_as.tbl_field_width['seg0']
+        w_addr   = self.picaso_as.tbl_field_width['seg1']
+        w_instr  = self.tbl_field_width['submInstr']
+        w_mask   = self.tbl_field_width['wrunMask']
+        opWrite  = (self.tbl_submCode['mv'] << self.picaso_as.tbl_field_width['seg2']) | self.picaso_as.tbl_opcode['write']
+        isWrite  = lambda word: (word >> (w_addr+w_data)) == opWrite
+        isRepeat = lambda word: (word >> w_instr) == self.tbl_submCode['rp']
+        addrOf   = lambda word: (word >> w_data) & (2**w_addr-1)
+        compressed = []
+        i = 0
+        while i < len(words):
+            # longest run starting at words[i]
+            end = i
+            if isWrite(words[i]) and not (i > 0 and isRepeat(words[i-1])):
+                end = i+1
+                while (end < len(words) and isWrite(words[end])
+                       and addrOf(words[end-1]) < addrOf(words[end]) < addrOf(words[i]) + w_mask): end += 1
+            if end-i >= self.wrunMinRows:
+                compressed += self.wrun_genWords(words[i:end])
+                i = end
+            else:
+                compressed.append(words[i])
+                i += 1
+        return compressed
+
+
+    # Given a word of a macro word list and the submodule code of the macro,
+    # returns (submodule code, list of segments) of the word
+    def wordSegments(self, word, submcode):
+        if isinstance(word, dict): return word['submCode'], word['segments']   # word of another submodule (e.g. REPEAT)
+        return submcode, word
+
+
     # Given an instruction dictionary (internal representation) of a macro
     # instruction, returns a list of submSegments (definition in genMachineCode())
     def gemv_genMacro(self, instrDict):
@@ -229,22 +331,26 @@ class IMAGineAsm:
             llSegment.append(segList)
             llSegment.append(segList)
         elif macroName == 'mult':
-            # multiplication works as follows,
-            #  - clearmbit: clear the multiplier bit storage in booth's ALU
-            #  - execute updatepp for all bits of multiplier, lsb to msb
-            picaso_clearmbit = {'opcode' : 'superop', 'scode' : 'clrmbit'}
-            picaso_updatepp  = {'opcode' : 'updatepp', 'offset' : None, 
-                                'rd'  : instrDict['rd'], 
-                                'rs1' : instrDict['multiplier'], 
-                                'rs2' : instrDict['multiplicand']}
-            # push clearmbit instruction
-            segList = self.gemv_seg2list( self.picaso_as.genMachineCode(picaso_clearmbit) )
+            # multiplication is a single MULT instruction, the controller
+            #  - clears the multiplier bit storage in booth's ALU (clearmbit)
+            #  - executes updatepp for the needed bits of multiplier (firstBit to lastBit), lsb to msb
+            #    (one pass per bit with booth radix-2, per 2 bits with radix-4)
+            # if the low bits are skipped, the partial-product is cleared first
+            # (as clearReg, it selects all blocks), because the pass of bit 0 initializes it.
+            if instrDict['firstBit'] > 0:
+                picaso_selectAll = self.picaso_as.instSelectAll()
+                llSegment.append( self.gemv_seg2list(self.picaso_as.genMachineCode(picaso_selectAll)) )
+                for reg in (instrDict['rd'], instrDict['rd']+1):
+                    picaso_fillreg = {'opcode' : 'superop', 'scode' : 'fillreg', 'rd' : reg, 'data' : 0}
+                    llSegment.append( self.gemv_seg2list(self.picaso_as.genMachineCode(picaso_fillreg)) )
+            picaso_mult = {'opcode' : 'mult',
+                           'offset' : instrDict['firstBit'],
+                           'last'   : instrDict['lastBit'],
+                           'rd'  : instrDict['rd'],
+                           'rs1' : instrDict['multiplier'],
+                           'rs2' : instrDict['multiplicand']}
+            segList = self.gemv_seg2list( self.picaso_as.genMachineCode(picaso_mult) )
             llSegment.append(segList)
-            # push updatepp instruction for all multiplier bits
-            for bitNo in range(self.picaso_as.regWidth):
-                picaso_updatepp['offset'] = bitNo
-                segList = self.gemv_seg2list( self.picaso_as.genMachineCode(picaso_updatepp) )
-                llSegment.append(segList)
         elif macroName == 'blockAccum':
             # block-level accumulation works as follows,
             #  - apply fold=1 from source reg to destination reg
@@ -259,131 +365,137 @@ class IMAGineAsm:
             llSegment.append(segList)
             # push rest of the folds on destination reg
             picaso_accumblk['rs1'] = instrDict['rd']
-            for f in range(2, self.picaso_as.maxFold+1):
+            restFolds = self.picaso_as.maxFold - 1
+            if self.useRepeat and restFolds > 2:     # REPEAT + 1 word, pays off from 3 folds
+                # the fold (param) field is the lsb of SEG1, REPEAT increments it
+                llSegment.append( self.repeat_genWord(count=restFolds, shift=self.picaso_as.tbl_field_width['seg0'], stride=1) )
+                restFolds = 1
+            for f in range(2, 2+restFolds):
                 picaso_accumblk['param'] = f
                 segList = self.gemv_seg2list( self.picaso_as.genMachineCode(picaso_accumblk) )
                 llSegment.append(segList)
         elif macroName == 'clearReg':
             # clearReg works as follows,
             #  - select all blocks
-            #  - write zeros to all rows of the specified register
+            #  - fill all rows of the specified register with zeros (FILLREG super-op)
             # get/build picaso IR to generate machine codes
             picaso_selectAll = self.picaso_as.instSelectAll()   # get the picaso-ir
-            picaso_write = {'opcode' : 'write', 'addr' : None, 'data' : None}
+            picaso_fillreg = {'opcode' : 'superop', 'scode' : 'fillreg', 'rd' : instrDict['reg'], 'data' : 0}
             # push the selectAll() instruction
             segList = self.gemv_seg2list( self.picaso_as.genMachineCode(picaso_selectAll) )
             llSegment.append(segList)
-            # push the write instructions
-            ptrReg = self.picaso_as.makeRegAddr(instrDict['reg'])   # get the register base address
-            for i in range(self.picaso_as.regWidth):
-                picaso_write['addr'] = ptrReg
-                picaso_write['data'] = 0
-                segList = self.gemv_seg2list( self.picaso_as.genMachineCode(picaso_write) )
-                llSegment.append(segList)
-                ptrReg += 1     # point to the next bit of the register
+            # push the fill instruction
+            segList = self.gemv_seg2list( self.picaso_as.genMachineCode(picaso_fillreg) )
+            llSegment.append(segList)
         elif macroName == 'loadMat':
             # write block images corresponding to the given matrix
             #   - select a block using row-col ID, 
             #   - write all wordlines corresponding to the given register
             # generate block images
             bramArr = imagine_as.makePe2BramMat(instrDict['matrix'])
-            # build picaso IR to generate machine codes
-            picaso_selblk = {'opcode' : 'select', 'fncode' : 'sel_block',
-                             'rowID' : None, 'colID' : None}
-            picaso_write = {'opcode' : 'write', 'addr' : None, 'data' : None}
-            # generate write instructions per BRAM block
-            for r, bramRow in enumerate(bramArr):
-                for c, bram in enumerate(bramRow): 
-                    # Select the block
-                    picaso_selblk['rowID'] = r
-                    picaso_selblk['colID'] = c
-                    selectSegList = self.gemv_seg2list( self.picaso_as.genMachineCode(picaso_selblk) )
-                    # selection instruction is compiled but will not be queued until a valid write is found: llSegment.append(selectSegList)
-                    # Write data to the given register
-                    isFirstWrite = True
-                    ptrReg = self.picaso_as.makeRegAddr(instrDict['reg'])   # get the register base address
-                    assert len(bram) == self.picaso_as.regWidth, f'BRAM image for loadMat contains unexpected no. of rows: {len(bram)} != {self.picaso_as.regWidth}'
-                    for data in bram:
-                        # Write the data if non-zero (this optimizaiton assumes the register has been already cleared calling mv_macroClearReg)
-                        if data != 0:
-                            # Select the block if a non-zero data is found for the first time
-                            if isFirstWrite: 
-                                llSegment.append(selectSegList)
-                                isFirstWrite = False
-                            picaso_write['addr'] = ptrReg
-                            picaso_write['data'] = data
-                            segList = self.gemv_seg2list( self.picaso_as.genMachineCode(picaso_write) )
-                            llSegment.append(segList)
-                        ptrReg += 1     # point to the next bit of the register
+            rowCnt = len(bramArr)
+            colCnt = max(len(bramRow) for bramRow in bramArr)
+            if self.mvMaxRow:       # all blocks are known, unused blocks have zero images
+                rowCnt = self.mvMaxRow
+                colCnt = self.mvMaxCol // self.picaso_as.peCount
+            units = []
+            for r in range(rowCnt):
+                for c in range(colCnt):
+                    picaso_selblk = {'opcode' : 'select', 'fncode' : 'sel_block', 'rowID' : r, 'colID' : c}
+                    units.append((picaso_selblk, self.getBramImage(bramArr, r, c)))
+            llSegment += self.gemv_genLoadImages(instrDict['reg'], units, allUnits=bool(self.mvMaxRow))
         elif macroName == 'loadVecRow':
             # write block images corresponding to the given vector
             #   - select a column of picaso-blocks using colID
             #   - write all wordlines corresponding to the given register
             # generate block images
             bramRow = imagine_as.makePe2BramVec(instrDict['vector'])
-            # build picaso IR to generate machine codes
-            picaso_selcol = {'opcode' : 'select', 'fncode' : 'sel_col',
-                             'rowID' : 0, 'colID' : None}
-            picaso_write = {'opcode' : 'write', 'addr' : None, 'data' : None}
-            # generate write instructions per BRAM column
-            for c, bram in enumerate(bramRow): 
-                # Select the column
-                picaso_selcol['colID'] = c
-                selectSegList = self.gemv_seg2list( self.picaso_as.genMachineCode(picaso_selcol) )
-                # selection instruction is compiled but will not be queued until a valid write is found: llSegment.append(selectSegList)
-                # Write data to the given register
-                isFirstWrite = True
-                ptrReg = self.picaso_as.makeRegAddr(instrDict['reg'])   # get the register base address
-                assert len(bram) == self.picaso_as.regWidth, f'BRAM image for loadVecRow contains unexpected no. of rows: {len(bram)} != {self.picaso_as.regWidth}'
-                for data in bram:
-                    # Write the data if non-zero (this optimizaiton assumes the register has been already cleared calling mv_macroClearReg)
-                    if data != 0:
-                        # Select the column if a non-zero data is found for the first time
-                        if isFirstWrite: 
-                            llSegment.append(selectSegList)
-                            isFirstWrite = False
-                        picaso_write['addr'] = ptrReg
-                        picaso_write['data'] = data
-                        segList = self.gemv_seg2list( self.picaso_as.genMachineCode(picaso_write) )
-                        llSegment.append(segList)
-                    ptrReg += 1     # point to the next bit of the register
+            colCnt = len(bramRow)
+            if self.mvMaxCol: colCnt = self.mvMaxCol // self.picaso_as.peCount     # unused columns have zero images
+            units = []
+            for c in range(colCnt):
+                picaso_selcol = {'opcode' : 'select', 'fncode' : 'sel_col', 'rowID' : 0, 'colID' : c}
+                units.append((picaso_selcol, self.getBramImage([bramRow], 0, c)))
+            llSegment += self.gemv_genLoadImages(instrDict['reg'], units, allUnits=bool(self.mvMaxCol))
         elif macroName == 'loadVecCol':
             # write block images corresponding to the given vector
             #   - select a row of picaso-blocks using rowID
             #   - write all wordlines corresponding to the given register
             # generate block images for the column vector
             bramCol = imagine_as.makePe2BramColVec(instrDict['vector'])
-            # build picaso IR to generate machine codes
-            picaso_selrow = {'opcode' : 'select', 'fncode' : 'sel_row',
-                             'rowID' : None, 'colID' : 0}
-            picaso_write = {'opcode' : 'write', 'addr' : None, 'data' : None}
-            # generate write instructions per BRAM column
-            for r, bram in enumerate(bramCol): 
-                # Select the column
-                picaso_selrow['rowID'] = r
-                selectSegList = self.gemv_seg2list( self.picaso_as.genMachineCode(picaso_selrow) )
-                # selection instruction is compiled but will not be queued until a valid write is found: llSegment.append(selectSegList)
-                # Write data to the given register
-                isFirstWrite = True
-                ptrReg = self.picaso_as.makeRegAddr(instrDict['reg'])   # get the register base address
-                assert len(bram) == self.picaso_as.regWidth, f'BRAM image for loadVecCol contains unexpected no. of rows: {len(bram)} != {self.picaso_as.regWidth}'
-                for data in bram:
-                    # Write the data if non-zero (this optimizaiton assumes the register has been already cleared calling mv_macroClearReg)
-                    if data != 0:
-                        # Select the row if a non-zero data is found for the first time
-                        if isFirstWrite: 
-                            llSegment.append(selectSegList)
-                            isFirstWrite = False
-                        picaso_write['addr'] = ptrReg
-                        picaso_write['data'] = data
-                        segList = self.gemv_seg2list( self.picaso_as.genMachineCode(picaso_write) )
-                        llSegment.append(segList)
-                    ptrReg += 1     # point to the next bit of the register
+            rowCnt = len(bramCol)
+            if self.mvMaxRow: rowCnt = self.mvMaxRow     # unused rows have zero images
+            units = []
+            for r in range(rowCnt):
+                picaso_selrow = {'opcode' : 'select', 'fncode' : 'sel_row', 'rowID' : r, 'colID' : 0}
+                units.append((picaso_selrow, self.getBramImage([[bram] for bram in bramCol], r, 0)))
+            llSegment += self.gemv_genLoadImages(instrDict['reg'], units, allUnits=bool(self.mvMaxRow))
         else:
             assert 0, f'GEMV-array submodule does not implement a macro named: {macroName}'
         return llSegment
 
 
+    # Returns the BRAM image of block (r, c) from a 2D array of BRAM images,
+    # zero image if the block is not covered by the array.
+    def getBramImage(self, bramArr, r, c):
+        if r < len(bramArr) and c < len(bramArr[r]): return bramArr[r][c]
+        return [0] * self.picaso_as.regWidth
+
+
+    # Given the BRAM images of the selectable units (block columns, block rows,
+    # or blocks) of a cleared register, returns the list of submSegments writing them.
+    #   units   : list of (picaso select-IR, BRAM image), in the order of writing
+    #   allUnits: True if the units cover all PiCaSO blocks. Then the wordline values
+    #             shared by most units are written once using SELECT_ALL, and only the
+    #             units that differ are fixed, if that takes fewer instructions.
+    def gemv_genLoadImages(self, reg, units, allUnits):
+        regWidth = self.picaso_as.regWidth
+        # broadcast image: most common value of each wordline (ties: the smaller value)
+        bcast = [0] * regWidth
+        if allUnits and units:
+            for w in range(regWidth):
+                counts = {}
+                for _, bram in units: counts[bram[w]] = counts.get(bram[w], 0) + 1
+                bcast[w] = max(counts, key=lambda v: (counts[v], -v))
+        # instruction counts with and without the broadcast
+        def writeCount(base):
+            count = 0
+            for _, bram in units:
+                diff = sum(1 for w in range(regWidth) if bram[w] != base[w])
+                if diff: count += 1 + diff      # select + writes
+            return count
+        zeroImage = [0] * regWidth
+        nzBcast = sum(1 for data in bcast if data != 0)
+        if nzBcast == 0 or 1 + nzBcast + writeCount(bcast) >= writeCount(zeroImage):
+            bcast = zeroImage   # broadcast does not pay off
+        # generate the instructions
+        llSegment = []
+        picaso_write = {'opcode' : 'write', 'addr' : None, 'data' : None}
+        ptrBase = self.picaso_as.makeRegAddr(reg)   # get the register base address
+        if bcast is not zeroImage:
+            picaso_selall = {'opcode' : 'select', 'fncode' : 'sel_enc', 'rowID' : 0, 'colID' : 0}
+            llSegment.append( self.gemv_seg2list(self.picaso_as.genMachineCode(picaso_selall)) )
+            for w, data in enumerate(bcast):
+                if data != 0:
+                    picaso_write['addr'] = ptrBase + w
+                    picaso_write['data'] = data
+                    llSegment.append( self.gemv_seg2list(self.picaso_as.genMachineCode(picaso_write)) )
+        for picaso_sel, bram in units:
+            assert len(bram) == regWidth, f'BRAM image contains unexpected no. of rows: {len(bram)} != {regWidth}'
+            isFirstWrite = True
+            for w, data in enumerate(bram):
+                # Write the data if it differs from the current content (this optimizaiton assumes the register has been already cleared calling mv_macroClearReg)
+                if data != bcast[w]:
+                    # Select the unit if a write is found for the first time
+                    if isFirstWrite:
+                        llSegment.append( self.gemv_seg2list(self.picaso_as.genMachineCode(picaso_sel)) )
+                        isFirstWrite = False
+                    picaso_write['addr'] = ptrBase + w
+                    picaso_write['data'] = data
+                    llSegment.append( self.gemv_seg2list(self.picaso_as.genMachineCode(picaso_write)) )
+        return llSegment
+
+
     # Given an instruction dictionary (internal representation), Returns the
     # machine code as a dictionary of instruction-word segments (assembly)
     # The format of assembly: {
@@ -458,10 +570,10 @@ class IMAGineAsm:
     # Parameters:
     #   word_suffix: string to put after hex-word (usually comma required for C-arrays)
     #   indent     : string to put before hex-word (usually a few spaces as indent)
-    def makeExportHexText(self, instr, addCmt, addSrc, word_suffix='', indent=''):
+    def makeExportHexText(self, instr, addCmt, addSrc, word_suffix='', indent='', compress=False):
         assert 'assembly' in instr, f'Instruction is not assembled: {instr}'
         # build the binary machine code for the instruction
-        hexwords = self.makeHexWord(instr['assembly'], suffix=word_suffix, indent=indent)
+        hexwords = self.makeHexWord(instr['assembly'], suffix=word_suffix, indent=indent, compress=compress)
         # build inline comment
         inlnCmt = self.makeInstrMetaInfo(instr, addCmt, addSrc)
         # build the return text
@@ -521,8 +633,9 @@ class IMAGineAsm:
         # build a list of binary encoding strings of the macro instruction
         elif instrType == 'macro':
             macro_words = []
-            for seglist in assembly['submWordList']:
-                binword = [f'{submcode:0{w_submcode}b}']
+            for word in assembly['submWordList']:
+                wordcode, seglist = self.wordSegments(word, submcode)
+                binword = [f'{wordcode:0{w_submcode}b}']
                 for code, w_code in seglist:
                     binword.append(f'{code:0{w_code}b}')
                 macro_words.append(sep.join(binword))
@@ -531,34 +644,41 @@ class IMAGineAsm:
             assert 0, f'Invalid assembly type: {assembly["type"]}'
 
 
-    # Given an instruction assembly, returns a list of hex encoding strings
-    # with optional indent and suffix
-    def makeHexWord(self, assembly, suffix='', indent=''):
+    # Given an instruction assembly, returns a list of instruction words.
+    # If compress is true, the WRITE runs are replaced by WRUNs (see compressWords()).
+    def makeWords(self, assembly, compress=False):
         instrType   = assembly['type']
         submcode    = assembly['submCode']
-        w_submcode  = self.tbl_field_width['submCode']
-        w_subminstr = self.tbl_field_width['submInstr']
-        w_totinstr  = w_submcode + w_subminstr
-        w_hexinstr  = int(math.ceil(w_totinstr/4))  # width of the hex instruction string
-        # build the binary encoding string
+        # build the instruction words
         if instrType == 'builtin':
             word = submcode
             for code, w_code in assembly['submSegments']:
                 word = (word << w_code) | code
-            return [f'{indent}0x{word:0{w_hexinstr}X}{suffix}']    # returns a list of single string
-        # build a list of binary encoding strings of the macro instruction
+            return [word]    # returns a list of single word
+        # build a list of instruction words of the macro instruction
         elif instrType == 'macro':
             macro_words = []
-            for seglist in assembly['submWordList']:
-                word = submcode
+            for macroword in assembly['submWordList']:
+                word, seglist = self.wordSegments(macroword, submcode)
                 for code, w_code in seglist:
                     word = (word << w_code) | code
-                macro_words.append(f'{indent}0x{word:0{w_hexinstr}X}{suffix}')
-            return macro_words  # returns a list of strings
+                macro_words.append(word)
+            if compress: macro_words = self.compressWords(macro_words)
+            return macro_words  # returns a list of words
         else:
             assert 0, f'Invalid assembly type: {assembly["type"]}'
 
 
+    # Given an instruction assembly, returns a list of hex encoding strings
+    # with optional indent and suffix
+    def makeHexWord(self, assembly, suffix='', indent='', compress=False):
+        w_submcode  = self.tbl_field_width['submCode']
+        w_subminstr = self.tbl_field_width['submInstr']
+        w_totinstr  = w_submcode + w_subminstr
+        w_hexinstr  = int(math.ceil(w_totinstr/4))  # width of the hex instruction string
+        return [f'{indent}0x{word:0{w_hexinstr}X}{suffix}' for word in self.makeWords(assembly, compress)]
+
+
     # Given an array of numbers <= to the no. of PEs in a block,
     # returns a bit-level transposed array (columnal layout).
     def makePe2BramBlock(self, block):
@@ -611,6 +731,54 @@ class IMAGineAsm:
 
 
 
+    # ---- Register annotations
+    # A register loaded with narrow values (e.g. 8-bit or 4-bit quantized
+    # weights) is annotated with its precision, so that the multiplications
+    # using it as the multiplier run only the necessary passes. Similarly, the
+    # values of a register loaded with a constant matrix are recorded, so that
+    # the passes which are NOPs in all PEs can be skipped. The annotations are
+    # dropped when the register is written by any other instruction.
+
+    # Drops the annotations of the given registers
+    def _dropRegInfo(self, *regs):
+        for reg in regs:
+            self.regBits.pop(reg, None)
+            self.regValues.pop(reg, None)
+
+
+    # Returns the multiplier bits (firstBit, lastBit) needed for multiplying with
+    # the given multiplier register, so that the low outBits bits of the product are valid.
+    # Booth's encoding of bit i is a NOP in a PE if bit i equals bit i-1 (bit -1 is 0).
+    #   - The bits above the annotated precision are NOPs; their passes only
+    #     extend the sign of the partial-product.
+    #   - If the values of the register are known (pruneMult), the precision is
+    #     computed from the values. The low bits that are NOPs in all PEs are
+    #     skipped if it pays off, because the partial-product needs to be cleared
+    #     then (only the pass of bit 0 initializes it).
+    #   - The NOP bits in between cannot be skipped, each pass writes the sign
+    #     extension of the partial-product read by the next pass.
+    def multBitRange(self, multiplier, outBits):
+        regWidth = self.picaso_as.regWidth
+        step = self.picaso_as.boothRadix // 2           # multiplier bits per pass
+        bits = self.regBits.get(multiplier, regWidth)   # full precision if not annotated
+        firstBit = 0
+        values = self.regValues.get(multiplier) if self.pruneMult else None
+        if values is not None:
+            # bit i of diff is set if the encoding of bit i is not a NOP in some PE
+            diff = int(np.bitwise_or.reduce(values ^ (values << 1), initial=0)) & ((1 << regWidth) - 1)
+            bits = min(bits, max(diff.bit_length(), 1))
+            if diff:
+                lowNops = (diff & -diff).bit_length() - 1     # the low NOP bits are zeros in all PEs
+                lowNops -= lowNops % step
+                if lowNops // step >= 2: firstBit = lowNops   # clearing {rd, rd+1} costs about a pass
+        lastBit = min(max(bits, outBits - regWidth), regWidth) - 1
+        if self.picaso_as.boothRadix == 4 and lastBit % 2 == 0:
+            lastBit += 1        # radix-4 passes consume 2 bits
+        return firstBit, lastBit
+
+
+
+
     # ---- Assembler directives
 
     # Sets up assembler parameters
@@ -619,7 +787,13 @@ class IMAGineAsm:
     #   mvBlockDim: (BLK_ROW_CNT, BLK_COL_CNT), these are parameters of IMAGine-instance.
     #               if set to None, matrix/vector bound checking will be disabled.
     #   resvRegCnt: Registers (regCnt, regCnt+resvReg-1) are reserved to be freely used by the assembler.
-    def setupParams(self, regCnt=16, regWidth=16, maxLevel=3, maxFold=4, idWidth=8, fracWidth=0, mvBlockDim=None, resvRegCnt=0):
+    #   useRepeat : if True, macros use the REPEAT instruction for strided instruction sequences.
+    #   boothRadix: booth's encoding of the PiCaSO ALU (BOOTH_RADIX of gemvtile), 2 or 4.
+    #   pruneMult : if True, multiplications skip the passes that are NOPs for the
+    #               known values of the multiplier register (see multBitRange).
+    #               The program is then only valid for these values, the weights
+    #               must not be replaced at runtime (e.g. img_mv_LOADMAT).
+    def setupParams(self, regCnt=16, regWidth=16, maxLevel=3, maxFold=4, idWidth=8, fracWidth=0, mvBlockDim=None, resvRegCnt=0, useRepeat=False, boothRadix=2, pruneMult=False):
         # setup picaso instruction parameters
         assert regCnt   <= 60, "This initial version only supports upto 60 16-bit user registers"   # TODO: Adjust these assertion
         assert regWidth == 16, "This initial version only supports 16-bit registers"                # when more precisions are supported
@@ -630,7 +804,7 @@ class IMAGineAsm:
         # forward PiCaSOAsm parameters
         self.picaso_as.setupParams(regCnt=regCnt, regWidth=regWidth,  
                                    maxLevel=maxLevel, maxFold=maxFold,
-                                   idWidth=idWidth)
+                                   idWidth=idWidth, boothRadix=boothRadix)
         # check and set IMAGine parameters
         assert fracWidth >= 0 and fracWidth <= regWidth, "Fixed-point fracWidth must be >= 0 and <= regWidth ({regWidth})"
         self.fracWidth = fracWidth
@@ -649,6 +823,8 @@ class IMAGineAsm:
         else:
             self.resvRegBase = None     # no reserved registers
             self.resvRegCnt  = 0
+        self.useRepeat = useRepeat
+        self.pruneMult = pruneMult
 
 
     # Sets up assembler parameters from a YAML file
@@ -665,9 +841,15 @@ class IMAGineAsm:
 
 
     # Resets the internal state for a fresh new program, preserving the assembler parameters
-    def reset(self):
+    #   keepRegs: if True, the register annotations are kept for the next program,
+    #             which runs on the registers left by this one (e.g. a kernel after
+    #             its loader). The host must not overwrite those registers in between.
+    def reset(self, keepRegs=False):
         self.instructions = []     # clear instruction cache
         self.isAssembled = False   # unset assemble flag
+        if not keepRegs:
+            self.regBits = {}      # clear register annotations
+            self.regValues = {}
         self.picaso_as.reset()     # reset PiCaSO assembler instance
 
 
@@ -719,7 +901,8 @@ class IMAGineAsm:
     #    filename : path of the output file, prints to stdout if None
     #    comment  : if true, appends user-comments as inline comment
     #    source   : if true, appends the source instruction mnemonics as inline comment
-    def export_CprogHex(self, progname, filename=None, comment=True, source=True):
+    #    compress : if true, the WRITE runs of the macros are exported as WRUNs (see compressWords())
+    def export_CprogHex(self, progname, filename=None, comment=True, source=True, compress=False):
         # Run assembler if not already
         if not self.isAssembled:
             print("WARN: Export invoked before the code is assembled")
@@ -731,7 +914,7 @@ class IMAGineAsm:
             if instr['assembly']['type'] == 'pseudo':
                 outxt = self.makeExportPseudoText(instr, addCmt=comment, addSrc=source)
             else:
-                outxt = self.makeExportHexText(instr, addCmt=comment, addSrc=source, word_suffix=', ', indent=' '*4)  # build the instruction text
+                outxt = self.makeExportHexText(instr, addCmt=comment, addSrc=source, word_suffix=', ', indent=' '*4, compress=compress)  # build the instruction text
             if outxt: instructions.append(outxt)   # save the instruction text for writing
         instructions = '\n'.join(instructions)
         cprog = c_prog_template.substitute(instructions=instructions, progname=progname,
@@ -749,6 +932,61 @@ class IMAGineAsm:
             print("---- End of Program ----")
 
 
+    # Exports the compiled instructions as a section of a binary program container,
+    # which is loaded at runtime by the driver (see imagine_binprog.h).
+    # Options:
+    #    progname : name of the section (max bin_name_len-1 characters)
+    #    filename : path of the container file
+    #    kind     : 'loader' or 'kernel'
+    #    append   : if true, the section is added to the existing container,
+    #               which must have the same target configuration
+    #    compress : if true, the WRITE runs of the macros are exported as WRUNs (see compressWords())
+    def export_binary(self, progname, filename, kind='kernel', append=False, compress=False):
+        assert kind in bin_sect_types, f"Invalid section kind: {kind}, must be one of {list(bin_sect_types)}"
+        name = progname.encode()
+        assert len(name) < bin_name_len, f"Section name too long: {progname}"
+        assert self.mvMaxRow, "Binary container requires mvBlockDim to be set"
+        # Run assembler if not already
+        if not self.isAssembled:
+            print("WARN: Export invoked before the code is assembled")
+            print("INFO: Running assembler ...")
+            self.assemble()
+        words = []
+        for instr in self.instructions:
+            if instr['assembly']['type'] == 'pseudo': continue
+            words += self.makeWords(instr['assembly'], compress)
+        config = (self.fracWidth, self.picaso_as.regWidth, self.picaso_as.idWidth, self.picaso_as.peCount,
+                  self.mvMaxRow, self.mvMaxCol)
+        # collect the sections of the existing container
+        sections = []   # (name, type, words)
+        if append:
+            with open(filename, 'rb') as fin:
+                image = fin.read()
+            magic, version, sectCount, fileSize, checksum, *oldConfig = bin_header.unpack_from(image)
+            assert magic == bin_magic and version == bin_version, f"{filename} is not a binary container (version {bin_version})"
+            assert fileSize == len(image) and checksum == zlib.crc32(image[16:]), f"{filename} is corrupted"
+            assert tuple(oldConfig) == config, f"Target configuration of {filename} does not match the assembler parameters"
+            for i in range(sectCount):
+                oldName, oldType, offset, size = bin_section.unpack_from(image, bin_header.size + i*bin_section.size)
+                assert oldName.rstrip(b'\0') != name, f"Section {progname} already exists in {filename}"
+                sections.append((oldName, oldType, image[offset:offset+4*size]))
+        sectType = bin_sect_types[kind] | (bin_sect_compressed if compress else 0)
+        sections.append((name, sectType, struct.pack(f'<{len(words)}I', *words)))
+        # build the container
+        offset = bin_header.size + len(sections)*bin_section.size
+        table, payload = b'', b''
+        for sectName, sectType, sectWords in sections:
+            table += bin_section.pack(sectName, sectType, offset + len(payload), len(sectWords)//4)
+            payload += sectWords
+        body = table + payload
+        fileSize = bin_header.size + len(body)
+        header = bin_header.pack(bin_magic, bin_version, len(sections), fileSize, 0, *config)
+        checksum = zlib.crc32(header[16:] + body)
+        with open(filename, 'wb') as fout:
+            fout.write(header[:12] + struct.pack('<I', checksum) + header[16:] + body)
+        print(f"INFO: {kind} {progname} ({len(words)} words) written to {filename}")
+
+
     # Exports the header for C-programs
     def export_CprogHeader(self, filename=None):
         if filename:
@@ -831,6 +1069,22 @@ class IMAGineAsm:
             'submodule' : 'mv', 'ir' : picaso_ir,
             'comment' : comment, 'src' : src
         }
+        self._dropRegInfo(addr // self.picaso_as.regWidth)   # register is overwritten
+        self.instructions.append(instr)
+        self.isAssembled = False        # un-assembled instruction added
+        return instr
+
+
+    def mv_instFillReg(self, reg, data, *, comment=None):
+        # argument validation and submodule instruction generation
+        picaso_ir = self.picaso_as.instFillReg(reg, data)
+        # Ecoding
+        src = f'MV_FILLREG reg={reg}, data=0x{data:X}'
+        instr = {
+            'submodule' : 'mv', 'ir' : picaso_ir,
+            'comment' : comment, 'src' : src
+        }
+        self._dropRegInfo(reg)
         self.instructions.append(instr)
         self.isAssembled = False        # un-assembled instruction added
         return instr
@@ -845,6 +1099,22 @@ class IMAGineAsm:
             'submodule' : 'mv', 'ir' : picaso_ir,
             'comment' : comment, 'src' : src
         }
+        self._dropRegInfo(ppreg, ppreg+1)
+        self.instructions.append(instr)
+        self.isAssembled = False        # un-assembled instruction added
+        return instr
+
+
+    def mv_instMult(self, ppreg, multiplicand, multiplier, firstBit=0, lastBit=None, *, comment=None):
+        # argument validation and submodule instruction generation
+        picaso_ir = self.picaso_as.instMult(ppreg, multiplicand, multiplier, firstBit, lastBit)
+        # Ecoding
+        src = f'MV_MULT_BITS ppreg={{{ppreg}, {ppreg+1}}}, multiplicand={multiplicand}, multiplier={multiplier}, bits={picaso_ir["offset"]}..{picaso_ir["last"]}'
+        instr = {
+            'submodule' : 'mv', 'ir' : picaso_ir,
+            'comment' : comment, 'src' : src
+        }
+        self._dropRegInfo(ppreg, ppreg+1)
         self.instructions.append(instr)
         self.isAssembled = False        # un-assembled instruction added
         return instr
@@ -859,6 +1129,7 @@ class IMAGineAsm:
             'submodule' : 'mv', 'ir' : picaso_ir,
             'comment' : comment, 'src' : src
         }
+        self._dropRegInfo(rd)
         self.instructions.append(instr)
         self.isAssembled = False        # un-assembled instruction added
         return instr
@@ -873,6 +1144,7 @@ class IMAGineAsm:
             'submodule' : 'mv', 'ir' : picaso_ir,
             'comment' : comment, 'src' : src
         }
+        self._dropRegInfo(rd)
         self.instructions.append(instr)
         self.isAssembled = False        # un-assembled instruction added
         return instr
@@ -887,6 +1159,7 @@ class IMAGineAsm:
             'submodule' : 'mv', 'ir' : picaso_ir,
             'comment' : comment, 'src' : src
         }
+        self._dropRegInfo(rd)
         self.instructions.append(instr)
         self.isAssembled = False        # un-assembled instruction added
         return instr
@@ -901,6 +1174,7 @@ class IMAGineAsm:
             'submodule' : 'mv', 'ir' : picaso_ir,
             'comment' : comment, 'src' : src
         }
+        self._dropRegInfo(reg)
         self.instructions.append(instr)
         self.isAssembled = False        # un-assembled instruction added
         return instr
@@ -929,6 +1203,7 @@ class IMAGineAsm:
             'submodule' : 'mv', 'ir' : picaso_ir,
             'comment' : comment, 'src' : src
         }
+        self._dropRegInfo(rd)
         self.instructions.append(instr)
         self.isAssembled = False        # un-assembled instruction added
         return instr
@@ -943,6 +1218,7 @@ class IMAGineAsm:
             'submodule' : 'mv', 'ir' : picaso_ir,
             'comment' : comment, 'src' : src
         }
+        self._dropRegInfo(rd)
         self.instructions.append(instr)
         self.isAssembled = False        # un-assembled instruction added
         return instr
@@ -1020,7 +1296,10 @@ class IMAGineAsm:
 
     # ---- Macro instructions built on top of submodule instructions
 
-    def mv_macroMult(self, rd, multiplicand, multiplier, *, comment=None, skipChecks=False):
+    # outBits: no. of low bits of the product {rd, rd+1} that must be valid (defaults to all).
+    #          If the multiplier register has a precision annotation or a known
+    #          constant image, only the passes needed for these bits are executed.
+    def mv_macroMult(self, rd, multiplicand, multiplier, *, outBits=None, comment=None, skipChecks=False):
         # argument validation needs to be performed here to generate error at the instruction invocation line
         if not skipChecks:      # WARNING: skipChecks should only be set True by internal macros which already validates user inputs
             self.picaso_as.validateReg(rd)
@@ -1029,13 +1308,19 @@ class IMAGineAsm:
             self.picaso_as.validateReg(multiplier)
             assert multiplicand != rd and multiplicand != rd+1, f'multiplicand cannot overlap with dest registers {rd, rd+1}'
             assert multiplier != rd and multiplier != rd+1, f'multiplier cannot overlap with dest registers {rd, rd+1}'
+        if outBits==None: outBits = 2*self.picaso_as.regWidth
+        firstBit, lastBit = self.multBitRange(multiplier, outBits)
+        assert firstBit <= lastBit, f'precision annotation of the multiplier (reg {multiplier}) contradicts its values, bits={firstBit}..{lastBit}'
         # Create a macro IR
         src = f'MV_MULT rd={rd}, multiplicand={multiplicand}, multiplier={multiplier}'
+        if firstBit > 0 or lastBit < self.picaso_as.regWidth - 1: src += f', bits={firstBit}..{lastBit}'
         instr = {
             'submodule' : 'mv', 'macro' : 'mult',
             'rd' : rd, 'multiplier' : multiplier, 'multiplicand' : multiplicand,
+            'firstBit' : firstBit, 'lastBit' : lastBit,
             'comment' : comment, 'src' : src
         }
+        self._dropRegInfo(rd, rd+1)
         self.instructions.append(instr)
         self.isAssembled = False        # un-assembled instruction added
         return instr
@@ -1053,6 +1338,7 @@ class IMAGineAsm:
         src = f'MV_MULTFPX rd={rd}, multiplicand={multiplicand}, multiplier={multiplier}'
         if comment==None: comment = ''
         instr0 = self.mv_macroMult(self.resvRegBase, multiplicand, multiplier,         # perform integer multiplication and store the result in reserved registers.
+                                   outBits=self.fracWidth+self.picaso_as.regWidth,     # only the bits read by movOffset need to be valid.
                                    comment=f'From macro call: {src}; {comment}',   # append the original comment with the macro call note.
                                    skipChecks=True)                                    # inputs are already validated.
         instr1 = self.mv_instMovOffset(self.fracWidth, rd=rd, rs=self.resvRegBase,         # store the fixed-point mult output into the original destination register, rd.
@@ -1072,6 +1358,7 @@ class IMAGineAsm:
             'rd' : rd, 'rs' : rs,
             'comment' : comment, 'src' : src
         }
+        self._dropRegInfo(rd)
         self.instructions.append(instr)
         self.isAssembled = False        # un-assembled instruction added
         return instr
@@ -1150,9 +1437,14 @@ class IMAGineAsm:
     # specified register. The array elements can be integers or floats, which
     # will be converted to fixed-points based on the assembler parameters. The
     # conversion is done at the macro invocation step, not at the assemble step.
-    def mv_macroLoadMat(self, reg, matrix, *, comment=None):
+    # bits: if set, all values (in fixed-point) must fit in bits-bit signed integers.
+    #       The register is annotated with this precision, which shortens the
+    #       multiplications using it as the multiplier (see multBitRange).
+    # The values are also recorded as the constant image of the register.
+    def mv_macroLoadMat(self, reg, matrix, *, bits=None, comment=None):
         # Validate parameters
         self.picaso_as.validateReg(reg)
+        if bits: assert bits > 0 and bits <= self.picaso_as.regWidth, f'invalid precision bits={bits}, range (1, {self.picaso_as.regWidth})'
         matRowCnt = len(matrix)
         matColCnt = -1
         if self.mvMaxRow: assert matRowCnt <= self.mvMaxRow, f'Row count ({matRowCnt}) of the given matrix is too big (>{self.mvMaxRow})'
@@ -1164,15 +1456,21 @@ class IMAGineAsm:
         scaleFact = 1 << self.fracWidth
         matrix = np.array(matrix)    # create a deepcopy as numpy array
         matrix = (matrix*scaleFact).astype(int)   # convert to integer representation of fixed-point
+        if bits:
+            minVal, maxVal = -(1 << (bits-1)), (1 << (bits-1)) - 1
+            assert matrix.min() >= minVal and matrix.max() <= maxVal, f'matrix values (fixed-point) do not fit in {bits} bits, range ({minVal}, {maxVal})'
         # Add dependencies
         self.mv_macroClearReg(reg, comment='dependency of MV_LOADMAT')
         # Create a macro IR
         src = f'MV_LOADMAT Mat({matRowCnt}, {matColCnt})'
+        if bits: src += f', bits={bits}'
         instr = {
             'submodule' : 'mv', 'macro' : 'loadMat',
             'reg' : reg, 'matrix' : matrix,     # save the fixed-point matrix for assemble() phase
             'comment' : comment, 'src' : src
         }
+        if bits: self.regBits[reg] = bits      # annotate after the clearReg dependency
+        self.regValues[reg] = np.unique(matrix)
         self.instructions.append(instr)
         self.isAssembled = False        # un-assembled instruction added
         return instr
@@ -1236,6 +1534,7 @@ class IMAGineAsm:
             'reg' : reg,
             'comment' : comment, 'src' : src
         }
+        self._dropRegInfo(reg)
         self.instructions.append(instr)
         self.isAssembled = False        # un-assembled instruction added
         return instr
@@ -1267,6 +1566,7 @@ imagine_as = IMAGineAsm()
 # instructions and macros exposed as callable objects.
 # Note: Macros are all caps, while built-in instructions are in camelCase.
 mv_write = imagine_as.mv_instWrite
+mv_fillReg = imagine_as.mv_instFillReg
 mv_nop   = imagine_as.mv_instNop
 mv_mov   = imagine_as.mv_instMov
 mv_add   = imagine_as.mv_instAdd
@@ -1278,6 +1578,7 @@ mv_selectCol = imagine_as.mv_instSelectCol
 mv_selectAll = imagine_as.mv_instSelectAll
 mv_accumRow  = imagine_as.mv_instAccumrow
 mv_updatepp  = imagine_as.mv_instUpdatepp
+mv_mult      = imagine_as.mv_instMult
 mv_blockFold = imagine_as.mv_instBlockFold
 
 vv_nop  = imagine_as.vv_instNop
@@ -66,7 +66,8 @@ class PiCaSOAsm:
         'aluop'    : 5,
         'select'   : 6,     # TODO: Move it under super-op
         'mov'      : 7,
-        'superop'  : 8      # TODO: Change opcode to select
+        'superop'  : 8,     # TODO: Change opcode to select
+        'mult'     : 9
     }
 
     tbl_fncode = {
@@ -84,7 +85,8 @@ class PiCaSOAsm:
     }
 
     tbl_super_code = {
-        'clrmbit' : 0
+        'clrmbit' : 0,
+        'fillreg' : 1
     }
     
     tbl_field_width = {
@@ -95,7 +97,8 @@ class PiCaSOAsm:
         'offset' : 4,   # width of the offset field (needed for UPDATE-PP instruction)
         'reg'    : 6,   # width of the register base addresses
         'param'  : 4,   # width of param field, used as net-level, opmux-Conf, alu-Conf, etc.
-        'id'     : 8    # width of PiCaSO block row/column IDs
+        'id'     : 8,   # width of PiCaSO block row/column IDs
+        'scode'  : 3    # width of the S_CODE field of SUPER-OP
     }
     # composite field widths
     tbl_field_width['seg2'] = tbl_field_width['opcode']
@@ -133,6 +136,7 @@ class PiCaSOAsm:
         print(f'{indent}maxLevel: {self.maxLevel}')
         print(f'{indent}maxFold : {self.maxFold}')
         print(f'{indent}idWidth : {self.idWidth}')
+        print(f'{indent}boothRadix: {self.boothRadix}')
         print(f'{indent}peCount : {self.peCount}')
 
 
@@ -220,6 +224,15 @@ class PiCaSOAsm:
             seg2 = opnum
             seg1 = (offset  << w_reg) | rd
             seg0 = (rs2 << w_reg) | rs1
+        elif opcode == 'mult':
+            # [ opcode ] [ OFFSET, RD ] [ LAST, RS2, RS1 ]
+            offset, last = instrDict['offset'], instrDict['last']
+            # the controller stops at the pass of LAST, it has no pass to stop at if LAST < OFFSET
+            assert offset <= last, f'MULT: LAST ({last}) cannot be smaller than OFFSET ({offset})'
+            rd, rs1, rs2 = instrDict['rd'], instrDict['rs1'], instrDict['rs2']
+            seg2 = opnum
+            seg1 = (offset << w_reg) | rd
+            seg0 = (last << (2*w_reg)) | (rs2 << w_reg) | rs1
         elif opcode == 'select':
             # [ opcode ] [ Fn, xx ] [ Row, Col ]
             fn = self.tbl_fncode[instrDict['fncode']]
@@ -267,6 +280,10 @@ class PiCaSOAsm:
         if scode == 'clrmbit':
             seg1 = self.tbl_super_code['clrmbit']
             seg0 = 0
+        elif scode == 'fillreg':
+            # [ super-op ] [ RD, S_CODE ] [ DATA ]
+            seg1 = (instrDict['rd'] << self.tbl_field_width['scode']) | self.tbl_super_code['fillreg']
+            seg0 = instrDict['data']
         else: assert 0, f"Invalid scode: {scode}"
         return seg1, seg0
 
@@ -310,15 +327,19 @@ class PiCaSOAsm:
     # ---- Assembler directives
 
     # Sets up assembler parameters
-    def setupParams(self, regCnt=16, regWidth=16,  maxLevel=3, maxFold=4, idWidth=8):
+    #   boothRadix: booth's encoding of the PiCaSO ALU (BOOTH_RADIX of the hardware), 2 or 4.
+    #               With radix-4, each UPDATEPP pass consumes 2 multiplier bits.
+    def setupParams(self, regCnt=16, regWidth=16,  maxLevel=3, maxFold=4, idWidth=8, boothRadix=2):
         self.regCnt   = regCnt     # maximum no. of registers
         self.regWidth = regWidth   # width of PE registers
         self.maxLevel = maxLevel   # maximum allowed level for accum-row
         self.maxFold  = maxFold    # maximum allowed level for accum-row
         self.idWidth  = idWidth    # width of row/col IDs
+        self.boothRadix = boothRadix   # booth's encoding used by the ALU
         self.peCount  = 16         # no. of PEs in a block (fixed for now)
         self.pimDepth = 1024       # no. of rows in the PIM (BRAM) block, (fixed for now)
         assert regCnt <= self.pimDepth//regWidth, f"Register count is not consistent with regWidth ({regWidth}) and pimDepth ({self.pimDepth})"
+        assert boothRadix in (2, 4), f"boothRadix must be 2 or 4, got {boothRadix}"
 
 
     # Compiles the instructions into machine code for exporting
@@ -421,6 +442,8 @@ class PiCaSOAsm:
         self.validateReg(multiplicand)
         self.validateReg(multiplier)
         self.validateOffset(bitNo, msg=f'invalid bitNo: {bitNo}')
+        if self.boothRadix == 4:    # a pass consumes bits bitNo and bitNo+1
+            assert bitNo % 2 == 0, f'bitNo ({bitNo}) must be even for booth radix-4'
         assert multiplicand != ppreg and multiplicand != ppreg+1, f'multiplicand cannot overlap with dest registers {ppreg, ppreg+1}'
         assert multiplier != ppreg and multiplier != ppreg+1, f'multiplier cannot overlap with dest registers {ppreg, ppreg+1}'
         # Ecoding
@@ -435,6 +458,35 @@ class PiCaSOAsm:
         return instr
 
 
+    # ppreg = multiplicand * multiplier, using UPDATEPP for the bits firstBit to lastBit of multiplier.
+    # The prevMbit register is cleared first, so it replaces CLRMBIT + UPDATEPP(firstBit ... lastBit).
+    def instMult(self, ppreg, multiplicand, multiplier, firstBit=0, lastBit=None, *, comment=None):
+        if lastBit==None: lastBit = self.regWidth - 1
+        # argument validation
+        self.validateReg(ppreg)
+        self.validateReg(ppreg+1, f'{ppreg+1} not be valid (ppreg spans 2 pe-registers)')
+        self.validateReg(multiplicand)
+        self.validateReg(multiplier)
+        self.validateOffset(firstBit, msg=f'invalid firstBit: {firstBit}')
+        self.validateOffset(lastBit, msg=f'invalid lastBit: {lastBit}')
+        assert firstBit <= lastBit, f'firstBit ({firstBit}) cannot be larger than lastBit ({lastBit})'
+        if self.boothRadix == 4:    # each pass consumes 2 multiplier bits
+            assert firstBit % 2 == 0, f'firstBit ({firstBit}) must be even for booth radix-4'
+            assert (lastBit - firstBit) % 2 == 1, f'bits {firstBit}..{lastBit} must be an even count for booth radix-4'
+        assert multiplicand != ppreg and multiplicand != ppreg+1, f'multiplicand cannot overlap with dest registers {ppreg, ppreg+1}'
+        assert multiplier != ppreg and multiplier != ppreg+1, f'multiplier cannot overlap with dest registers {ppreg, ppreg+1}'
+        # Ecoding
+        src = f'MULT ppreg={{{ppreg}, {ppreg+1}}}, multiplicand={multiplicand}, multiplier={multiplier}, bits={firstBit}..{lastBit}'
+        instr = {
+            'opcode' : 'mult', 'offset' : firstBit, 'last' : lastBit,
+            'rd' : ppreg, 'rs1' : multiplier, 'rs2' : multiplicand,
+            'comment' : comment, 'src' : src
+        }
+        self.instructions.append(instr)
+        self.isAssembled = False        # un-assembled instruction added
+        return instr
+
+
     # rd = rs + folded(rs, fold)
     def instAccumblk(self, fold, rd, rs, *, comment=None):
         # argument validation
@@ -494,6 +546,23 @@ class PiCaSOAsm:
         return instr
 
 
+    # writes data to all rows of a register in the selected blocks
+    def instFillReg(self, reg, data, *, comment=None):
+        # argument validation
+        self.validateReg(reg)
+        self.validateData(data)
+        # Ecoding
+        src = f'SUPER-OP FILLREG reg={reg}, data=0x{data:X}'
+        instr = {
+            'opcode' : 'superop', 'scode' : 'fillreg',
+            'rd' : reg, 'data' : data,
+            'comment': comment, 'src' : src
+        }
+        self.instructions.append(instr)
+        self.isAssembled = False        # un-assembled instruction added
+        return instr
+
+
     def instSelectBlock(self, rowID, colID, *, comment=None):
         # TODO: reimplement this instruction if it is moved under super-instruction
         # argument validation
@@ -641,9 +710,11 @@ add = picaso_as.instAdd
 sub = picaso_as.instSub
 nop = picaso_as.instNop
 updatepp  = picaso_as.instUpdatepp
+mult      = picaso_as.instMult
 accumblk  = picaso_as.instAccumblk
 accumrow  = picaso_as.instAccumrow
 clearmbit = picaso_as.instClearmbit
+fillreg   = picaso_as.instFillReg
 
 selectBlk = picaso_as.instSelectBlock
 selectRow = picaso_as.instSelectRow
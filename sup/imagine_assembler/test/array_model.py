@@ -0,0 +1,205 @@
+#===================================================================================#
+#   Copyright (c) 2024, Computer Systems Design Lab, University of Arkansas         #
+#                                                                                   #
+#   All rights reserved.                                                            #
+#                                                                                   #
+#   Permission is hereby granted, free of charge, to any person obtaining a copy    #
+#   of this software and associated documentation files (the "Software"), to deal   #
+#   in the Software without restriction, including without limitation the rights    #
+#   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       #
+#   copies of the Software, and to permit persons to whom the Software is           #
+#   furnished to do so, subject to the following conditions:                        #
+#                                                                                   #
+#   The above copyright notice and this permission notice shall be included in all  #
+#   copies or substantial portions of the Software.                                 #
+#                                                                                   #
+#   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      #
+#   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        #
+#   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     #
+#   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          #
+#   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   #
+#   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   #
+#   SOFTWARE.                                                                       #
+#===================================================================================#
+
+#================================================================================#
+#                                                                                #
+#   Description:                                                                 #
+#   Functional model of the PiCaSO array for the assembler tests. It executes    #
+#   the IR3 words exported by IMAGineAsm: the REPEAT/WRUN front-end of the       #
+#   interface, then SELECT, WRITE, FILLREG, UPDATEPP and MULT on a plain copy    #
+#   of the BRAM of every block. The other instructions are counted as errors.    #
+#   Python counterpart of array_model.c of the driver tests.                     #
+#                                                                                #
+#================================================================================#
+
+import numpy as np
+
+
+BRAM_DEPTH = 1024       # rows of a BRAM block, 10-bit addresses
+PE_COUNT   = 16         # PEs per block, one per bit of a BRAM row
+REG_WIDTH  = 16         # rows per PE register
+PP_WIDTH   = 2*REG_WIDTH    # the partial-product spans {rd, rd+1}
+
+# Instruction fields (see imagine_assembler.py, picaso_assembler.py)
+SUBM_MV  = 0
+SUBM_VV  = 1
+SUBM_RPT = 3
+OPCODE_NOP      = 0
+OPCODE_WRITE    = 1
+OPCODE_UPDATEPP = 3
+OPCODE_SELECT   = 6
+OPCODE_SUPEROP  = 8
+OPCODE_MULT     = 9
+SCODE_CLRMBIT = 0
+SCODE_FILLREG = 1
+SELECT_COL   = 0
+SELECT_BLOCK = 1
+SELECT_ROW   = 2
+SELECT_ALL   = 3
+
+
+class ArrayModel:
+    # blkRowCnt, blkColCnt: PiCaSO blocks of the array (mvBlockDim)
+    # boothRadix: booth's encoding of the ALU, 2 or 4
+    # randomFill: random BRAM contents at power-on, to catch missing clears
+    def __init__(self, blkRowCnt, blkColCnt, boothRadix=2, randomFill=True, seed=1):
+        assert boothRadix in (2, 4), f'Invalid booth radix: {boothRadix}'
+        shape = (blkRowCnt, blkColCnt, BRAM_DEPTH)
+        if randomFill: self.bram = np.random.default_rng(seed).integers(0, 1 << 16, size=shape, dtype=np.uint16)
+        else: self.bram = np.zeros(shape, dtype=np.uint16)
+        self.boothRadix = boothRadix
+        self.selected = np.zeros((blkRowCnt, blkColCnt), dtype=bool)
+        self.prevMbit = np.zeros((blkRowCnt, blkColCnt*PE_COUNT), dtype=np.int64)   # booth's ALU of each PE
+        self.rptCount = 0           # pending REPEAT of the next word
+        self.rptIncrement = 0
+        self.wrunBase = 0           # WRITE run being decoded
+        self.wrunMask = 0           # rows of the run not written yet
+        self.dispatched = []        # words dispatched to the array, REPEATs and WRUNs expanded
+        self.errors = 0             # words the model could not execute
+
+
+    # Executes a list of IR3 words (the words of the macros may be numpy integers)
+    def run(self, words):
+        for word in words: self.frontEnd(int(word))
+
+
+    # Executes a word in the REPEAT/WRUN front-end of the interface
+    def frontEnd(self, word):
+        if self.wrunMask:
+            # data word of a WRITE run, low halfword first
+            for half in range(2):
+                if not self.wrunMask: break
+                i = (self.wrunMask & -self.wrunMask).bit_length() - 1
+                self.wrunMask &= self.wrunMask - 1
+                self.dispatch((OPCODE_WRITE << 26) | ((self.wrunBase + i) << 16) | ((word >> 16*half) & 0xFFFF))
+            return
+        if self.rptCount > 0:
+            count, self.rptCount = self.rptCount, 0
+            for i in range(count): self.dispatch((word + i*self.rptIncrement) & 0xFFFFFFFF)
+            return
+        if word >> 30 == SUBM_RPT and word & (1 << 16):
+            self.wrunBase = (word >> 20) & 0x3FF        # [BASE:10] [xxx] [1] [MASK:16]
+            self.wrunMask = word & 0xFFFF
+        elif word >> 30 == SUBM_RPT:
+            self.rptCount = (word >> 22) & 0xFF         # [COUNT:8] [SHIFT:5] [0] [STRIDE:16]
+            self.rptIncrement = (word & 0xFFFF) << ((word >> 17) & 0x1F)
+        else:
+            self.dispatch(word)
+
+
+    # Executes a word of the GEMV array or the vector-shift register
+    def dispatch(self, word):
+        self.dispatched.append(word)
+        submCode = word >> 30
+        opcode = (word >> 26) & 0xF
+        seg1   = (word >> 16) & 0x3FF
+        seg0   = word & 0xFFFF
+        if submCode == SUBM_VV: return      # does not touch the BRAMs
+        if submCode != SUBM_MV:
+            self.errors += 1
+        elif opcode == OPCODE_NOP:
+            pass
+        elif opcode == OPCODE_SELECT:
+            fn = seg1 >> 6
+            row, col = seg0 >> 8, seg0 & 0xFF
+            rows, cols = np.indices(self.selected.shape)
+            self.selected = ((fn == SELECT_ALL) | ((fn == SELECT_COL) & (cols == col))
+                             | ((fn == SELECT_ROW) & (rows == row))
+                             | ((fn == SELECT_BLOCK) & (rows == row) & (cols == col)))
+        elif opcode == OPCODE_WRITE:
+            self.bram[self.selected, seg1] = seg0
+        elif opcode == OPCODE_SUPEROP and seg1 & 0x7 == SCODE_FILLREG:
+            base = (seg1 >> 3) * REG_WIDTH      # [RD, S_CODE], fills all rows of RD
+            self.bram[self.selected, base:base+REG_WIDTH] = seg0
+        elif opcode == OPCODE_SUPEROP and seg1 & 0x7 == SCODE_CLRMBIT:
+            self.prevMbit[:] = 0
+        elif opcode == OPCODE_UPDATEPP:
+            # [ opcode ] [ OFFSET, RD ] [ RS2, RS1 ]
+            self.updatepp(seg1 & 0x3F, seg0 >> 6, seg0 & 0x3F, seg1 >> 6)
+        elif opcode == OPCODE_MULT:
+            # [ opcode ] [ OFFSET, RD ] [ LAST, RS2, RS1 ]
+            rd, offset = seg1 & 0x3F, seg1 >> 6
+            rs1, rs2, last = seg0 & 0x3F, (seg0 >> 6) & 0x3F, seg0 >> 12
+            step = self.boothRadix // 2
+            self.prevMbit[:] = 0
+            bitNo = offset
+            while True:     # like the controller, a LAST below OFFSET runs a single pass
+                self.updatepp(rd, rs2, rs1, bitNo)
+                if bitNo + step - 1 >= last: break
+                bitNo += step
+        else:
+            self.errors += 1
+
+
+    # One UPDATEPP pass of all PEs (compute instructions ignore the selection).
+    # Radix-2: ppreg[bitNo +: N] += multiplicand * booth(m[bitNo], m[bitNo-1]),
+    #          then ppreg[bitNo+N] = ppreg[bitNo+N-1].
+    # Radix-4: the window is updated with 0, +-md or +-2md, the 2 bits above it
+    #          receive the exact sign extension.
+    # The pass of bit 0 initializes the partial-product.
+    def updatepp(self, ppreg, multiplicand, multiplier, bitNo):
+        md = self.peReg(multiplicand).astype(np.int64)
+        m  = self.peReg(multiplier).astype(np.int64) & 0xFFFF
+        pp = self.peReg(ppreg).astype(np.int64) & 0xFFFF
+        pp |= (self.peReg(ppreg+1).astype(np.int64) & 0xFFFF) << REG_WIDTH
+        window = np.zeros_like(pp) if bitNo == 0 else (pp >> bitNo) & 0xFFFF
+        mbit = (m >> bitNo) & 1
+        if self.boothRadix == 2:
+            window = (window + (self.prevMbit - mbit)*md) & 0xFFFF
+            window |= (window >> (REG_WIDTH-1)) << REG_WIDTH
+            width = REG_WIDTH + 1
+            self.prevMbit = mbit
+        else:
+            mnext = (m >> (bitNo+1)) & 1
+            window -= (window & 0x8000) << 1       # signed window
+            window = (window + (self.prevMbit + mbit - 2*mnext)*md) & ((1 << (REG_WIDTH+2)) - 1)
+            width = REG_WIDTH + 2
+            self.prevMbit = mnext
+        mask = (((1 << width) - 1) << bitNo) & ((1 << PP_WIDTH) - 1)
+        pp = (pp & ~mask) | ((window << bitNo) & mask)
+        self.setPeReg(ppreg, pp & 0xFFFF)
+        self.setPeReg(ppreg+1, pp >> REG_WIDTH)
+
+
+    # Returns a PE register of all PEs as an int16 array [block row][PE column],
+    # read back from the BRAM rows (bit b of the register is bit pe of row b)
+    def peReg(self, reg):
+        rows = self.bram[:, :, reg*REG_WIDTH:(reg+1)*REG_WIDTH].astype(np.int64)
+        bits = (rows[:, :, :, None] >> np.arange(PE_COUNT)) & 1                   # [r][c][bit][pe]
+        value = (bits << np.arange(REG_WIDTH)[:, None]).sum(axis=2)                # [r][c][pe]
+        return value.reshape(len(rows), -1).astype(np.uint16).view(np.int16)
+
+
+    # Writes a PE register of all PEs from an array [block row][PE column]
+    def setPeReg(self, reg, values):
+        value = (np.asarray(values).astype(np.int64) & 0xFFFF).reshape(*self.bram.shape[:2], PE_COUNT)
+        bits = (value[:, :, None, :] >> np.arange(REG_WIDTH)[:, None]) & 1        # [r][c][bit][pe]
+        self.bram[:, :, reg*REG_WIDTH:(reg+1)*REG_WIDTH] = (bits << np.arange(PE_COUNT)).sum(axis=3)
+
+
+    # Returns the partial-product {ppreg, ppreg+1} of all PEs as an int64 array
+    def ppReg(self, ppreg):
+        low  = self.peReg(ppreg).astype(np.int64) & 0xFFFF
+        high = self.peReg(ppreg+1).astype(np.int64)
+        return (high << REG_WIDTH) | low
@@ -0,0 +1,304 @@
+#===================================================================================#
+#   Copyright (c) 2024, Computer Systems Design Lab, University of Arkansas         #
+#                                                                                   #
+#   All rights reserved.                                                            #
+#                                                                                   #
+#   Permission is hereby granted, free of charge, to any person obtaining a copy    #
+#   of this software and associated documentation files (the "Software"), to deal   #
+#   in the Software without restriction, including without limitation the rights    #
+#   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell       #
+#   copies of the Software, and to permit persons to whom the Software is           #
+#   furnished to do so, subject to the following conditions:                        #
+#                                                                                   #
+#   The above copyright notice and this permission notice shall be included in all  #
+#   copies or substantial portions of the Software.                                 #
+#                                                                                   #
+#   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR      #
+#   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,        #
+#   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE     #
+#   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER          #
+#   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,   #
+#   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE   #
+#   SOFTWARE.                                                                       #
+#===================================================================================#
+
+#================================================================================#
+#                                                                                #
+#   Description:                                                                 #
+#   Tests of the IMAGineAsm macros. The programs are assembled into IR3 words    #
+#   and executed on the functional model of the array (array_model.py), the      #
+#   registers are compared with the results computed by numpy.                   #
+#   Usage: python3 test_asm.py [name-prefix]                                     #
+#                                                                                #
+#================================================================================#
+
+import contextlib
+import io
+import os
+import sys
+import numpy as np
+
+from imagine_assembler import *
+from array_model import ArrayModel
+
+
+# Assembler parameters of the examples (sup/exNN/imagine_64x64_params.yml)
+exParams = {
+    'mvBlockDim' : [64, 4],
+    'regWidth'   : 16,
+    'fracWidth'  : 8,
+    'regCnt'     : 60,
+    'resvRegCnt' : 4,
+    'maxLevel'   : 1,
+    'maxFold'    : 4,
+    'idWidth'    : 8,
+    'useRepeat'  : True,
+}
+
+
+class TestFailure(Exception):
+    pass
+
+
+def check(cond, msg):
+    if not cond: raise TestFailure(msg)
+
+
+# Sets up the assembler for a fresh program, the example parameters are
+# overridden by the given ones
+def setupAsm(**params):
+    imagine_as.setupParams(**{**exParams, **params})
+    imagine_as.reset()
+
+
+# Assembles the program and returns its IR3 words
+def assembleWords(compress=False):
+    with contextlib.redirect_stdout(io.StringIO()):     # drops the assembler INFO lines
+        imagine_as.assemble()
+    words = []
+    for instr in imagine_as.instructions:
+        if instr['assembly']['type'] == 'pseudo': continue
+        words += imagine_as.makeWords(instr['assembly'], compress)
+    return words
+
+
+# Returns a model of the array of the assembler parameters
+def newModel(**kwargs):
+    return ArrayModel(imagine_as.mvMaxRow, imagine_as.mvMaxCol // imagine_as.picaso_as.peCount,
+                      boothRadix=imagine_as.picaso_as.boothRadix, **kwargs)
+
+
+# Returns the (OFFSET, LAST) fields of the MULT words
+def multBits(words):
+    opMult = imagine_as.picaso_as.tbl_opcode['mult']
+    return [((w >> 22) & 0xF, (w >> 12) & 0xF) for w in words if w >> 30 == 0 and (w >> 26) & 0xF == opMult]
+
+
+# Returns the words of a C program exported by export_CprogHex()
+def cprogWords(filename):
+    with open(filename) as fin:
+        return [int(line.split(',')[0], 16) for line in fin if line.strip().startswith('0x')]
+
+
+# Random multiplicands, the radix-2 ALU overflows for -32768 (see the ISA doc)
+def randMultiplicands(rng, shape):
+    low = -32768 if imagine_as.picaso_as.boothRadix == 4 else -32767
+    return rng.integers(low, 32768, size=shape)
+
+
+
+
+# ---- Tests
+
+# int8 and int4 weights loaded with a precision annotation (bits=): mv_MULT
+# runs only the passes of the annotated bits, the low 16+bits bits of
+# {rd, rd+1} must be the exact products.
+def test_multAnnotated():
+    rng = np.random.default_rng(20)
+    for radix in (2, 4):
+        for bits in (8, 4):
+            setupAsm(fracWidth=0, boothRadix=radix, pruneMult=False)
+            mvMaxRow, mvMaxCol = imagine_as.mvMaxRow, imagine_as.mvMaxCol
+            x = randMultiplicands(rng, (mvMaxRow, mvMaxCol))
+            w = rng.integers(-(1 << (bits-1)), 1 << (bits-1), size=(mvMaxRow, mvMaxCol))
+            mv_LOADMAT(1, x)
+            mv_LOADMAT(2, w, bits=bits)
+            outBits = 16 + bits
+            mv_MULT(4, 1, 2, outBits=outBits)
+            words = assembleWords()
+            check(multBits(words) == [(0, bits-1)], f'radix-{radix}, int{bits}: MULT bits {multBits(words)}, expected [(0, {bits-1})]')
+            model = newModel()
+            model.run(words)
+            check(model.errors == 0, f'radix-{radix}, int{bits}: {model.errors} words not executed')
+            mask = (1 << outBits) - 1
+            misCount = np.count_nonzero((model.ppReg(4) & mask) != ((x*w) & mask))
+            check(misCount == 0, f'radix-{radix}, int{bits}: {misCount} products differ from numpy')
+
+
+# Constant weights (multiples of 16 in 10 bits) with pruneMult: the kernel
+# skips the low passes, clearing {rd, rd+1} first, and the top passes. By
+# default (no pruneMult) the kernel runs all passes, and it stays exact when
+# the host loads other weights at runtime, unlike the pruned one.
+def test_multPruned():
+    rng = np.random.default_rng(21)
+    outBits = 24
+    mask = (1 << outBits) - 1
+    for radix in (2, 4):
+        for prune in (True, False):
+            params = {'pruneMult' : True} if prune else {}
+            setupAsm(fracWidth=0, boothRadix=radix, **params)
+            check(imagine_as.pruneMult == prune, f'pruneMult is {imagine_as.pruneMult}, expected {prune}')
+            mvMaxRow, mvMaxCol = imagine_as.mvMaxRow, imagine_as.mvMaxCol
+            x = randMultiplicands(rng, (mvMaxRow, mvMaxCol))
+            w = rng.integers(-32, 32, size=(mvMaxRow, mvMaxCol)) * 16
+            mv_LOADMAT(1, x)
+            mv_LOADMAT(2, w)
+            loader = assembleWords()
+            imagine_as.reset(keepRegs=True)
+            mv_MULT(4, 1, 2, outBits=outBits)
+            kernel = assembleWords()
+            expected = (4, 9) if prune else (0, 15)
+            check(multBits(kernel) == [expected], f'radix-{radix}, pruneMult={prune}: MULT bits {multBits(kernel)}, expected [{expected}]')
+            model = newModel()
+            model.run(loader + kernel)
+            check(model.errors == 0, f'radix-{radix}, pruneMult={prune}: {model.errors} words not executed')
+            misCount = np.count_nonzero((model.ppReg(4) & mask) != ((x*w) & mask))
+            check(misCount == 0, f'radix-{radix}, pruneMult={prune}: {misCount} products differ from numpy')
+            # other weights loaded at runtime (e.g. img_mv_LOADMAT), the kernel is not reassembled
+            setupAsm(fracWidth=0, boothRadix=radix)
+            w = randMultiplicands(rng, (mvMaxRow, mvMaxCol))
+            mv_LOADMAT(2, w)
+            model.run(assembleWords() + kernel)
+            misCount = np.count_nonzero((model.ppReg(4) & mask) != ((x*w) & mask))
+            if prune: check(misCount > 0, f'radix-{radix}: the pruned kernel is exact for other weights')
+            else: check(misCount == 0, f'radix-{radix}: {misCount} products differ after reloading the weights')
+
+
+# Expands the load macros without the broadcast image, i.e. each unit
+# (block, block row or block column) is selected and written on its own
+@contextlib.contextmanager
+def noBroadcast():
+    genLoadImages = IMAGineAsm.gemv_genLoadImages
+    imagine_as.gemv_genLoadImages = lambda reg, units, allUnits: genLoadImages(imagine_as, reg, units, False)
+    try:
+        yield
+    finally:
+        del imagine_as.gemv_genLoadImages
+
+
+# No. of SELECT words selecting all blocks
+def selectAllCount(words):
+    return sum(1 for w in words if w >> 30 == 0 and (w >> 26) & 0xF == 6 and (w >> 22) & 0x3 == 3)
+
+
+# Loads with most blocks sharing their rows: the broadcast load must leave
+# the same BRAMs as the plain per-unit load, starting from the same random
+# contents, and the register must hold the numpy image of the operand.
+def test_loadBroadcast():
+    rng = np.random.default_rng(14)
+    setupAsm()
+    mvMaxRow, mvMaxCol = imagine_as.mvMaxRow, imagine_as.mvMaxCol
+    scale = 1 << imagine_as.fracWidth
+    # a few values differ from the shared one (fixed-point exact)
+    shared = lambda shape: np.where(rng.random(shape) < 0.1, rng.integers(-1024, 1024, size=shape), 128) / scale
+    mat = shared((mvMaxRow-4, mvMaxCol-14))     # blocks outside the matrix are zero
+    rowVec = np.full(mvMaxCol, -3.5)
+    colVec = shared(mvMaxRow)
+    image = np.zeros((mvMaxRow, mvMaxCol), dtype=np.int64)
+    image[:mat.shape[0], :mat.shape[1]] = mat*scale
+    cases = [
+        ('LOADMAT',        lambda: mv_LOADMAT(3, mat),          image),
+        ('LOADVEC_ROW',    lambda: mv_LOADVEC_ROW(3, rowVec),   np.tile(rowVec*scale, (mvMaxRow, 1))),
+        ('LOADVEC_COL',    lambda: mv_LOADVEC_COL(3, colVec),   np.tile(colVec[:, None]*scale, (1, mvMaxCol))),
+    ]
+    for name, load, expected in cases:
+        setupAsm()
+        load()
+        with noBroadcast(): plain = assembleWords()
+        bcast = assembleWords()
+        check(selectAllCount(bcast) == selectAllCount(plain) + 1, f'{name}: the broadcast is not used')
+        check(len(bcast) < len(plain), f'{name}: the broadcast load ({len(bcast)} words) is not shorter than {len(plain)}')
+        plainModel = newModel(seed=14)
+        plainModel.run(plain)
+        for compress in (False, True):
+            setupAsm()
+            load()
+            model = newModel(seed=14)
+            model.run(assembleWords(compress))
+            check(model.errors == 0, f'{name}: {model.errors} words not executed')
+            check(np.array_equal(model.bram, plainModel.bram), f'{name}, compress={compress}: the BRAMs differ from the plain load')
+        misCount = np.count_nonzero(model.peReg(3) != expected.astype(np.int16))
+        check(misCount == 0, f'{name}: {misCount} PEs differ from numpy')
+
+
+# The accumulation macros and the kernel of ex02 (computeGate() of
+# ex02_prog.py) with useRepeat: the words dispatched by the front-end, REPEATs
+# expanded as in _imagineIntf_repeatUnit, must be the unrolled program
+# assembled without useRepeat. The kernel is the one exported into the app.
+def test_repeatUnrolled():
+    ex02File = os.path.join(os.path.dirname(__file__), '../../proj-zcu104/imagine_appEx02/ex02_kernel.c')
+    def ex02Kernel():
+        for g in range(4):
+            vv_serialEn()
+            mv_MULTFXP(22, 20, g)
+            mv_ALLACCUM(23, 22)
+            mv_MULTFXP(22, 21, 4+g)
+            mv_ALLACCUM(24, 22)
+            mv_add(30+g, 23, 24)
+            mv_add(30+g, 30+g, 8+g)
+            mv_SYNC()
+            vv_parallelEn()
+            vv_SYNC()
+    cases = [
+        ('BLOCKACCUM', {},             lambda: mv_BLOCKACCUM(5, 3)),
+        ('ALLACCUM',   {},             lambda: mv_ALLACCUM(5, 3)),
+        ('RNGACCUM',   {},             lambda: mv_RNGACCUM(32, 5, 3)),
+        ('BLOCKACCUM', {'maxFold': 5}, lambda: mv_BLOCKACCUM(5, 3)),
+        ('ex02 kernel', {},            ex02Kernel),
+    ]
+    rptCode = imagine_as.tbl_submCode['rp']
+    for name, params, prog in cases:
+        expanded = {}
+        for useRepeat in (True, False):
+            setupAsm(useRepeat=useRepeat, **params)
+            prog()
+            words = assembleWords()
+            if prog is ex02Kernel and useRepeat:
+                check(words == cprogWords(ex02File), f'{name}: the words differ from {os.path.basename(ex02File)}')
+            rptCount = sum(1 for w in words if w >> 30 == rptCode)
+            check((rptCount > 0) == useRepeat, f'{name}, useRepeat={useRepeat}: {rptCount} REPEAT words')
+            model = newModel()
+            model.run(words)
+            expanded[useRepeat] = model.dispatched
+        check(expanded[True] == expanded[False], f'{name}: the expanded REPEATs differ from the unrolled program')
+
+
+
+
+tests = [
+    ('mult: int8/int4 annotated', test_multAnnotated),
+    ('mult: pruned constant weights', test_multPruned),
+    ('load: broadcast image', test_loadBroadcast),
+    ('repeat: unrolled macros', test_repeatUnrolled),
+]
+
+
+# Runs the tests whose name starts with the filter
+# Usage: python3 test_asm.py [name-prefix]
+def main():
+    prefix = sys.argv[1] if len(sys.argv) > 1 else ''
+    failed = 0
+    for name, func in tests:
+        if not name.startswith(prefix): continue
+        try:
+            func()
+            print(f'PASS  {name}')
+        except TestFailure as err:
+            print(f'    {err}')
+            print(f'FAIL  {name}')
+            failed += 1
+    return 1 if failed else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
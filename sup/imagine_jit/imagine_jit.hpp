@@ -0,0 +1,729 @@
+#ifndef IMAGINE_JIT_HPP
+#define IMAGINE_JIT_HPP
+
+// Header-only JIT assembler of IMAGine, the C++ counterpart of IMAGineAsm
+// (sup/imagine_assembler). It encodes the IR3 instructions and the macros into
+// a caller-provided buffer without any heap allocation, so that the kernels
+// can be generated or specialized at runtime on the embedded side.
+// For the same program and assembler parameters, the emitted words are the
+// same as the instruction array exported by IMAGineAsm.export_CprogHex().
+//
+// Usage:
+//   uint32_t buff[256];
+//   img::AsmParams params;             // same fields as IMAGineAsm.setupParams()
+//   params.fracWidth = 8;
+//   ...
+//   img::Asm as(buff, 256, params);
+//   as.vv_serialEn();
+//   as.mv_MULTFXP(3, 2, 0);
+//   as.mv_ALLACCUM(4, 3);
+//   if(as.error()) ...                 // as.size() words are in buff
+//
+// Each instruction returns the no. of words emitted, -ve value is error code.
+// Errors are sticky: the words of the failing instruction are discarded and
+// the following instructions are ignored until reset().
+// Requires C++17; the encoders and the assembler are constexpr.
+
+#include <cstdint>
+#include <type_traits>
+
+
+namespace img {
+
+
+// Field widths of the IR3 word (tbl_field_width of the assemblers)
+constexpr int SUBMCODE_WIDTH = 2;     // width of the submodule-code field
+constexpr int OPCODE_WIDTH   = 4;     // width of the OpCode field (SEG2)
+constexpr int ADDR_WIDTH     = 10;    // width of the ADDR field (SEG1)
+constexpr int DATA_WIDTH     = 16;    // width of the DATA field (SEG0)
+constexpr int OFFSET_WIDTH   = 4;     // width of the offset field of UPDATEPP/MULT
+constexpr int REG_WIDTH      = 6;     // width of the register base addresses
+constexpr int ID_WIDTH       = 8;     // width of PiCaSO block row/column IDs
+constexpr int SCODE_WIDTH    = 3;     // width of the S_CODE field of SUPER-OP
+constexpr int RPT_COUNT_WIDTH  = 8;   // width of the COUNT field of REPEAT
+constexpr int RPT_SHIFT_WIDTH  = 5;   // width of the SHIFT field of REPEAT
+constexpr int RPT_STRIDE_WIDTH = 16;  // width of the STRIDE field of REPEAT (1 reserved bit above it)
+
+// Fixed parameters of PiCaSO blocks
+constexpr int PE_COUNT  = 16;         // no. of PEs in a block
+constexpr int PIM_DEPTH = 1024;       // no. of rows in the PIM (BRAM) block
+
+// Submodule codes
+enum : uint32_t {
+	SUBM_MV = 0,     // GEMV array
+	SUBM_VV = 1,     // column-shift-register (vecshift)
+	SUBM_RP = 3,     // REPEAT, consumed by the IMAGine interface
+};
+
+// PiCaSO opcodes
+enum : uint32_t {
+	OP_NOP = 0, OP_WRITE = 1, OP_READ = 2, OP_UPDATEPP = 3, OP_ACCUM = 4,
+	OP_ALUOP = 5, OP_SELECT = 6, OP_MOV = 7, OP_SUPEROP = 8, OP_MULT = 9,
+};
+
+// PiCaSO function codes
+enum : uint32_t {
+	FN_ACCUM_BLK = 0, FN_ACCUM_ROW = 1,
+	FN_ALU_ADD = 0, FN_ALU_CPX = 1, FN_ALU_CPY = 2, FN_ALU_SUB = 3,
+	FN_MOV_OFFSET = 0,
+	FN_SEL_COL = 0, FN_SEL_BLOCK = 1, FN_SEL_ROW = 2, FN_SEL_ENC = 3,
+};
+
+// S_CODE of SUPER-OP
+enum : uint32_t { SCODE_CLRMBIT = 0, SCODE_FILLREG = 1 };
+
+// vecshift opcodes
+enum : uint32_t { VV_IDLE = 0, VV_SERIAL_EN = 1, VV_PARALLEL_EN = 2, VV_DISABLE = 3 };
+
+
+
+// ---- Instruction encoders: return the IR3 word, arguments are not validated
+namespace enc {
+
+// [subm-code:2] [SEG2:4] [SEG1:10] [SEG0:16]
+constexpr uint32_t word(uint32_t subm, uint32_t seg2, uint32_t seg1, uint32_t seg0) {
+	return (subm << (OPCODE_WIDTH+ADDR_WIDTH+DATA_WIDTH)) | (seg2 << (ADDR_WIDTH+DATA_WIDTH)) | (seg1 << DATA_WIDTH) | seg0;
+}
+
+constexpr uint32_t mvNop() {
+	return word(SUBM_MV, OP_NOP, 0, 0);
+}
+
+// [ opcode ] [ ADDR ] [ DATA ]
+constexpr uint32_t mvWrite(uint32_t addr, uint32_t data) {
+	return word(SUBM_MV, OP_WRITE, addr, data);
+}
+
+// [ opcode ] [ OFFSET, RD ] [ RS2, RS1 ], rs1: multiplier, rs2: multiplicand
+constexpr uint32_t mvUpdatepp(uint32_t offset, uint32_t rd, uint32_t rs1, uint32_t rs2) {
+	return word(SUBM_MV, OP_UPDATEPP, (offset << REG_WIDTH) | rd, (rs2 << REG_WIDTH) | rs1);
+}
+
+// [ opcode ] [ OFFSET, RD ] [ LAST, RS2, RS1 ], rs1: multiplier, rs2: multiplicand
+constexpr uint32_t mvMult(uint32_t offset, uint32_t last, uint32_t rd, uint32_t rs1, uint32_t rs2) {
+	return word(SUBM_MV, OP_MULT, (offset << REG_WIDTH) | rd, (last << (2*REG_WIDTH)) | (rs2 << REG_WIDTH) | rs1);
+}
+
+// [ opcode ] [ Fn, Param ] [ R2, R1 ], the destination is encoded in R2
+constexpr uint32_t mvAccumBlk(uint32_t fold, uint32_t rd, uint32_t rs) {
+	return word(SUBM_MV, OP_ACCUM, (FN_ACCUM_BLK << REG_WIDTH) | fold, (rd << REG_WIDTH) | rs);
+}
+
+constexpr uint32_t mvAccumRow(uint32_t level, uint32_t reg) {
+	return word(SUBM_MV, OP_ACCUM, (FN_ACCUM_ROW << REG_WIDTH) | level, reg);
+}
+
+// [ opcode ] [ Fn, RD ] [ RS2, RS1 ]
+constexpr uint32_t mvAluop(uint32_t fn, uint32_t rd, uint32_t rs1, uint32_t rs2) {
+	return word(SUBM_MV, OP_ALUOP, (fn << REG_WIDTH) | rd, (rs2 << REG_WIDTH) | rs1);
+}
+
+// [ opcode ] [ Fn, Param ] [ R2, R1 ], the destination is encoded in R2
+constexpr uint32_t mvMovOffset(uint32_t offset, uint32_t rd, uint32_t rs) {
+	return word(SUBM_MV, OP_MOV, (FN_MOV_OFFSET << REG_WIDTH) | offset, (rd << REG_WIDTH) | rs);
+}
+
+// [ opcode ] [ Fn, xx ] [ Row, Col ]
+constexpr uint32_t mvSelect(uint32_t fn, uint32_t rowID, uint32_t colID) {
+	return word(SUBM_MV, OP_SELECT, fn << REG_WIDTH, (rowID << ID_WIDTH) | colID);
+}
+
+constexpr uint32_t mvClrMbit() {
+	return word(SUBM_MV, OP_SUPEROP, SCODE_CLRMBIT, 0);
+}
+
+// [ super-op ] [ RD, S_CODE ] [ DATA ]
+constexpr uint32_t mvFillReg(uint32_t reg, uint32_t data) {
+	return word(SUBM_MV, OP_SUPEROP, (reg << SCODE_WIDTH) | SCODE_FILLREG, data);
+}
+
+// vecshift opcode in SEG2, the rest is unused
+constexpr uint32_t vv(uint32_t opcode) {
+	return word(SUBM_VV, opcode, 0, 0);
+}
+
+// [subm-code:2] [COUNT:8] [SHIFT:5] [x] [STRIDE:16]
+// The next word is dispatched count times, adding stride to the field starting at bit shift.
+constexpr uint32_t repeat(uint32_t count, uint32_t shift, uint32_t stride) {
+	return (SUBM_RP << 30) | (count << (RPT_SHIFT_WIDTH+1+RPT_STRIDE_WIDTH)) | (shift << (1+RPT_STRIDE_WIDTH)) | stride;
+}
+
+}  // namespace enc
+
+
+
+// Assembler parameters, same as IMAGineAsm.setupParams()
+struct AsmParams {
+	int  regCnt     = 16;
+	int  regWidth   = 16;
+	int  maxLevel   = 3;
+	int  maxFold    = 4;
+	int  idWidth    = 8;
+	int  fracWidth  = 0;
+	int  blkRowCnt  = 0;       // mvBlockDim, 0 if not known (bound checking disabled)
+	int  blkColCnt  = 0;
+	int  resvRegCnt = 0;
+	bool useRepeat  = false;
+	int  boothRadix = 2;
+	bool pruneMult  = false;
+};
+
+
+// Max. no. of selectable units (blocks) of a LOADMAT/LOADVEC, bounds the
+// stack used to find the broadcast image (see genLoadImages())
+#ifndef IMG_JIT_MAXUNITS
+#define IMG_JIT_MAXUNITS 256
+#endif
+
+
+
+class Asm {
+public:
+	// Error codes
+	enum : int {
+		ERR_ARG  = -1,     // invalid argument or assembler parameter
+		ERR_FULL = -2,     // instruction buffer is full
+	};
+
+	// @param buff     [out]  Instruction buffer.
+	// @param capacity [in]   Size of the instruction buffer.
+	// @param params   [in]   Assembler parameters.
+	constexpr Asm(uint32_t *buff, int capacity, const AsmParams &params = AsmParams())
+		: buff_(buff), capacity_(capacity), p_(params)
+	{
+		const int avlReg = p_.regWidth > 0 ? PIM_DEPTH / p_.regWidth : 0;    // total available registers in PiCaSO
+		bool ok = p_.regCnt > 0 && p_.regCnt <= 60 && p_.regWidth == 16
+		          && p_.fracWidth >= 0 && p_.fracWidth <= p_.regWidth
+		          && p_.resvRegCnt >= 0 && p_.regCnt + p_.resvRegCnt <= avlReg
+		          && (p_.boothRadix == 2 || p_.boothRadix == 4)
+		          && (p_.blkRowCnt == 0) == (p_.blkColCnt == 0);
+		if(p_.blkColCnt) ok = ok && ceilLog2(p_.blkColCnt) - 1 <= p_.maxLevel;   // recommended maxLevel
+		paramsOk_ = ok;
+		err_ = ok ? 0 : ERR_ARG;
+		resvRegBase_ = p_.regCnt;
+	}
+
+	// Starts a new program at the beginning of the buffer, preserving the parameters.
+	// @param keepRegs [in]  Keep the register annotations for a program that runs
+	//                       on the registers left by this one (e.g. a kernel after its loader).
+	constexpr void reset(bool keepRegs = false) {
+		size_ = 0;
+		err_ = paramsOk_ ? 0 : ERR_ARG;     // clears the sticky error
+		if(!keepRegs) {
+			for(int r=0; r<MAX_REGS; ++r) {
+				regBits_[r] = 0;
+				regKnown_[r] = false;
+				regDiff_[r] = 0;
+			}
+		}
+	}
+
+	constexpr int size() const { return size_; }
+	constexpr int error() const { return err_; }
+	constexpr const uint32_t *data() const { return buff_; }
+	constexpr const AsmParams &params() const { return p_; }
+
+
+	// ---- Built-in instructions
+
+	constexpr int mv_selectBlk(int rowID, int colID) {
+		const int start = size_;
+		if(!validID(rowID) || !validID(colID)) return fail(start, ERR_ARG);
+		emit(enc::mvSelect(FN_SEL_BLOCK, rowID, colID));
+		return done(start);
+	}
+
+	constexpr int mv_selectRow(int rowID) {
+		const int start = size_;
+		if(!validID(rowID)) return fail(start, ERR_ARG);
+		emit(enc::mvSelect(FN_SEL_ROW, rowID, 0));
+		return done(start);
+	}
+
+	constexpr int mv_selectCol(int colID) {
+		const int start = size_;
+		if(!validID(colID)) return fail(start, ERR_ARG);
+		emit(enc::mvSelect(FN_SEL_COL, 0, colID));
+		return done(start);
+	}
+
+	constexpr int mv_selectAll() {
+		const int start = size_;
+		emit(enc::mvSelect(FN_SEL_ENC, 0, 0));
+		return done(start);
+	}
+
+	constexpr int mv_write(int addr, int data) {
+		const int start = size_;
+		if(addr < 0 || addr >= (1 << ADDR_WIDTH) || !validData(data)) return fail(start, ERR_ARG);
+		emit(enc::mvWrite(addr, data));
+		dropRegInfo(addr / p_.regWidth);    // register is overwritten
+		return done(start);
+	}
+
+	constexpr int mv_fillReg(int reg, int data) {
+		const int start = size_;
+		if(!validReg(reg) || !validData(data)) return fail(start, ERR_ARG);
+		emit(enc::mvFillReg(reg, data));
+		dropRegInfo(reg);
+		return done(start);
+	}
+
+	constexpr int mv_updatepp(int ppreg, int multiplicand, int multiplier, int bitNo) {
+		const int start = size_;
+		if(!validMultRegs(ppreg, multiplicand, multiplier) || !validOffset(bitNo)) return fail(start, ERR_ARG);
+		if(p_.boothRadix == 4 && bitNo % 2 != 0) return fail(start, ERR_ARG);    // a pass consumes bits bitNo and bitNo+1
+		emit(enc::mvUpdatepp(bitNo, ppreg, multiplier, multiplicand));
+		dropRegInfo(ppreg, ppreg+1);
+		return done(start);
+	}
+
+	// @param lastBit [in]  -1 for the msb of the multiplier.
+	constexpr int mv_mult(int ppreg, int multiplicand, int multiplier, int firstBit = 0, int lastBit = -1) {
+		const int start = size_;
+		if(lastBit == -1) lastBit = p_.regWidth - 1;
+		if(!validMultRegs(ppreg, multiplicand, multiplier) || !validOffset(firstBit) || !validOffset(lastBit)
+		   || firstBit > lastBit) return fail(start, ERR_ARG);
+		if(p_.boothRadix == 4 && (firstBit % 2 != 0 || (lastBit - firstBit) % 2 != 1))
+			return fail(start, ERR_ARG);    // each pass consumes 2 multiplier bits
+		emit(enc::mvMult(firstBit, lastBit, ppreg, multiplier, multiplicand));
+		dropRegInfo(ppreg, ppreg+1);
+		return done(start);
+	}
+
+	constexpr int mv_add(int rd, int rs1, int rs2) { return aluop(FN_ALU_ADD, rd, rs1, rs2); }
+	constexpr int mv_sub(int rd, int rs1, int rs2) { return aluop(FN_ALU_SUB, rd, rs1, rs2); }
+
+	constexpr int mv_blockFold(int fold, int rd, int rs) {
+		const int start = size_;
+		if(!validFold(fold) || !validReg(rd) || !validReg(rs)) return fail(start, ERR_ARG);
+		emit(enc::mvAccumBlk(fold, rd, rs));
+		dropRegInfo(rd);
+		return done(start);
+	}
+
+	constexpr int mv_accumRow(int level, int reg) {
+		const int start = size_;
+		if(level < 0 || level > p_.maxLevel || !validReg(reg)) return fail(start, ERR_ARG);
+		emit(enc::mvAccumRow(level, reg));
+		dropRegInfo(reg);
+		return done(start);
+	}
+
+	constexpr int mv_nop() {
+		const int start = size_;
+		emit(enc::mvNop());
+		return done(start);
+	}
+
+	constexpr int mv_mov(int rd, int rs) { return mv_movOffset(0, rd, rs); }
+
+	constexpr int mv_movOffset(int offset, int rd, int rs) {
+		const int start = size_;
+		if(!validOffset(offset) || !validReg(rd) || !validReg(rs)) return fail(start, ERR_ARG);
+		emit(enc::mvMovOffset(offset, rd, rs));
+		dropRegInfo(rd);
+		return done(start);
+	}
+
+	constexpr int vv_nop()        { return vecshift(VV_IDLE); }
+	constexpr int vv_shiftOff()   { return vecshift(VV_DISABLE); }
+	constexpr int vv_serialEn()   { return vecshift(VV_SERIAL_EN); }
+	constexpr int vv_parallelEn() { return vecshift(VV_PARALLEL_EN); }
+
+
+	// ---- Macro instructions
+
+	// {rd, rd+1} = multiplicand * multiplier
+	// @param outBits [in]  No. of low bits of the product that must be valid, 0 for all.
+	constexpr int mv_MULT(int rd, int multiplicand, int multiplier, int outBits = 0) {
+		const int start = size_;
+		if(!validMultRegs(rd, multiplicand, multiplier)) return fail(start, ERR_ARG);
+		genMult(rd, multiplicand, multiplier, outBits ? outBits : 2*p_.regWidth);
+		return done(start);
+	}
+
+	// rd = fixed-point multiplicand * multiplier, uses the reserved registers
+	constexpr int mv_MULTFXP(int rd, int multiplicand, int multiplier) {
+		const int start = size_;
+		if(p_.resvRegCnt < 2 || !validReg(rd) || !validReg(multiplicand) || !validReg(multiplier)
+		   || multiplicand == rd || multiplier == rd) return fail(start, ERR_ARG);
+		genMult(resvRegBase_, multiplicand, multiplier, p_.fracWidth + p_.regWidth);   // only the bits read by movOffset need to be valid
+		emit(enc::mvMovOffset(p_.fracWidth, rd, resvRegBase_));
+		dropRegInfo(rd);
+		return done(start);
+	}
+
+	constexpr int mv_BLOCKACCUM(int rd, int rs) {
+		const int start = size_;
+		if(!validReg(rd) || !validReg(rs)) return fail(start, ERR_ARG);
+		genBlockAccum(rd, rs);
+		return done(start);
+	}
+
+	// Accumulates the rs register of PE columns (0 : colCnt-1) into rd register
+	constexpr int mv_RNGACCUM(int colCnt, int rd, int rs) {
+		const int start = size_;
+		bool validCnt = false;     // 1 block: accum_blk, 2 blocks: level=0, ...
+		for(int i=0; i<p_.maxLevel+2; ++i) validCnt = validCnt || colCnt == (PE_COUNT << i);
+		if(!validCnt || !validReg(rd) || !validReg(rs)) return fail(start, ERR_ARG);
+		genBlockAccum(rd, rs);
+		const int blkCols = colCnt / PE_COUNT;    // no. of PiCaSO blocks to accumulate
+		if(blkCols > 1) {
+			const int upLevel = ceilLog2(blkCols) - 1;   // maximum level need to be applied
+			for(int l=0; l<=upLevel; ++l) emit(enc::mvAccumRow(l, rd));
+		}
+		return done(start);
+	}
+
+	// Accumulates the rs register of all PE columns into rd register
+	constexpr int mv_ALLACCUM(int rd, int rs) {
+		const int start = size_;
+		if(!validReg(rd) || !validReg(rs)) return fail(start, ERR_ARG);
+		genBlockAccum(rd, rs);
+		for(int l=0; l<=p_.maxLevel; ++l) emit(enc::mvAccumRow(l, rd));
+		return done(start);
+	}
+
+	constexpr int mv_SYNC() {
+		const int start = size_;
+		emit(enc::mvNop());     // 2 NOPs are needed to create a synchronization barrier
+		emit(enc::mvNop());
+		return done(start);
+	}
+
+	constexpr int vv_SYNC() {
+		const int start = size_;
+		emit(enc::vv(VV_IDLE));
+		return done(start);
+	}
+
+	constexpr int mv_CLRREG(int reg) {
+		const int start = size_;
+		if(!validReg(reg)) return fail(start, ERR_ARG);
+		genClearReg(reg);
+		return done(start);
+	}
+
+	// Loads a row-major matrix (rows x cols) into the register, values are
+	// converted to fixed-point using fracWidth.
+	// @param bits [in]  If not 0, the values (fixed-point) must fit in bits-bit
+	//                   signed integers; the register is annotated with this precision.
+	template<class T>
+	constexpr int mv_LOADMAT(int reg, const T *mat, int rows, int cols, int bits = 0) {
+		const int start = size_;
+		if(!validReg(reg) || rows < 0 || cols < 0 || bits < 0 || bits > p_.regWidth) return fail(start, ERR_ARG);
+		if(p_.blkRowCnt && (rows > p_.blkRowCnt || cols > p_.blkColCnt*PE_COUNT)) return fail(start, ERR_ARG);
+		uint32_t diff = 0;
+		for(int i=0; i<rows*cols; ++i) {
+			const int64_t v = toFxp(mat[i]);
+			if(bits && (v < -(int64_t(1) << (bits-1)) || v >= (int64_t(1) << (bits-1)))) return fail(start, ERR_ARG);
+			diff |= uint32_t(v) ^ (uint32_t(v) << 1);
+		}
+		genClearReg(reg);
+		const MatSource<T> src{this, mat, rows, cols};
+		const int unitRows = p_.blkRowCnt ? p_.blkRowCnt : rows;
+		const int unitCols = p_.blkColCnt ? p_.blkColCnt : (cols + PE_COUNT-1) / PE_COUNT;
+		if(!genLoadImages(reg, src, unitRows*unitCols, unitCols)) return fail(start, ERR_ARG);
+		regBits_[reg]  = bits;
+		regKnown_[reg] = true;     // constant image of the register
+		regDiff_[reg]  = diff & lowMask(p_.regWidth);
+		return done(start);
+	}
+
+	// Loads a vector into the register of all PE rows
+	template<class T>
+	constexpr int mv_LOADVEC_ROW(int reg, const T *vec, int size) {
+		const int start = size_;
+		if(!validReg(reg) || size < 0 || (p_.blkColCnt && size > p_.blkColCnt*PE_COUNT)) return fail(start, ERR_ARG);
+		genClearReg(reg);
+		const VecRowSource<T> src{this, vec, size};
+		const int units = p_.blkColCnt ? p_.blkColCnt : (size + PE_COUNT-1) / PE_COUNT;
+		if(!genLoadImages(reg, src, units, 0)) return fail(start, ERR_ARG);
+		return done(start);
+	}
+
+	// Loads a vector into the register of all PE columns
+	template<class T>
+	constexpr int mv_LOADVEC_COL(int reg, const T *vec, int size) {
+		const int start = size_;
+		if(!validReg(reg) || size < 0 || (p_.blkRowCnt && size > p_.blkRowCnt)) return fail(start, ERR_ARG);
+		genClearReg(reg);
+		const VecColSource<T> src{this, vec, size};
+		const int units = p_.blkRowCnt ? p_.blkRowCnt : size;
+		if(!genLoadImages(reg, src, units, 0)) return fail(start, ERR_ARG);
+		return done(start);
+	}
+
+	// Annotates a register that is written outside this program (e.g. by a
+	// loader generated at runtime) with the precision of its values, same as the
+	// bits of mv_LOADMAT without the constant image. Emits no instruction.
+	constexpr int annotateReg(int reg, int bits) {
+		const int start = size_;
+		if(!validReg(reg) || bits < 0 || bits > p_.regWidth) return fail(start, ERR_ARG);
+		regBits_[reg]  = bits;
+		regKnown_[reg] = false;
+		return done(start);
+	}
+
+
+	// Returns the multiplier bits (firstBit, lastBit) of a multiplication,
+	// same as IMAGineAsm.multBitRange().
+	constexpr void multBitRange(int multiplier, int outBits, int &firstBit, int &lastBit) const {
+		const int regWidth = p_.regWidth;
+		const int step = p_.boothRadix / 2;    // multiplier bits per pass
+		int bits = regBits_[multiplier] ? regBits_[multiplier] : regWidth;   // full precision if not annotated
+		firstBit = 0;
+		if(p_.pruneMult && regKnown_[multiplier]) {
+			const uint32_t diff = regDiff_[multiplier];    // bit i is set if the encoding of bit i is not a NOP in some PE
+			bits = min(bits, max(bitLength(diff), 1));
+			if(diff) {
+				int lowNops = bitLength(diff & (~diff + 1)) - 1;     // the low NOP bits are zeros in all PEs
+				lowNops -= lowNops % step;
+				if(lowNops / step >= 2) firstBit = lowNops;          // clearing {rd, rd+1} costs about a pass
+			}
+		}
+		lastBit = min(max(bits, outBits - regWidth), regWidth) - 1;
+		if(p_.boothRadix == 4 && lastBit % 2 == 0) lastBit += 1;     // radix-4 passes consume 2 bits
+	}
+
+
+
+private:
+	static constexpr int MAX_REGS = PIM_DEPTH / 16;
+
+	uint32_t *buff_;
+	int       capacity_;
+	int       size_ = 0;
+	int       err_  = 0;
+	AsmParams p_;
+	bool      paramsOk_ = false;
+	int       resvRegBase_ = 0;
+	// register annotations (see IMAGineAsm)
+	int      regBits_[MAX_REGS]  = {};   // precision, 0 if not annotated
+	bool     regKnown_[MAX_REGS] = {};   // true if the register holds a known constant image
+	uint32_t regDiff_[MAX_REGS]  = {};   // OR of v ^ (v << 1) over the values of the image
+
+
+	// -- Utilities
+	static constexpr int min(int a, int b) { return a < b ? a : b; }
+	static constexpr int max(int a, int b) { return a > b ? a : b; }
+	static constexpr uint32_t lowMask(int n) { return (uint32_t(1) << n) - 1; }
+	static constexpr int bitLength(uint32_t v) {
+		int n = 0;
+		for(; v; v >>= 1) ++n;
+		return n;
+	}
+	static constexpr int ceilLog2(int v) { return bitLength(uint32_t(v-1)); }
+
+	template<class T>
+	constexpr int64_t toFxp(T v) const {
+		if constexpr (std::is_floating_point<T>::value) return int64_t(v * T(1 << p_.fracWidth));   // truncates like numpy astype(int)
+		else return int64_t(v) * (int64_t(1) << p_.fracWidth);
+	}
+
+	constexpr bool validReg(int reg) const { return reg >= 0 && reg < p_.regCnt; }
+	constexpr bool validOffset(int off) const { return off >= 0 && off < p_.regWidth; }
+	constexpr bool validFold(int fold) const { return fold >= 1 && fold <= p_.maxFold; }
+	constexpr bool validID(int id) const { return id >= 0 && id < (1 << p_.idWidth); }
+	constexpr bool validData(int data) const { return data >= 0 && data < (1 << DATA_WIDTH); }
+	constexpr bool validMultRegs(int rd, int multiplicand, int multiplier) const {
+		return validReg(rd) && validReg(rd+1) && validReg(multiplicand) && validReg(multiplier)
+		       && multiplicand != rd && multiplicand != rd+1 && multiplier != rd && multiplier != rd+1;
+	}
+
+	constexpr void dropRegInfo(int reg) {
+		if(reg < 0 || reg >= MAX_REGS) return;
+		regBits_[reg] = 0;
+		regKnown_[reg] = false;
+	}
+	constexpr void dropRegInfo(int reg0, int reg1) {
+		dropRegInfo(reg0);
+		dropRegInfo(reg1);
+	}
+
+	// -- Emission: words are written while there is space, the overflow is
+	// reported by done() so that the instruction is discarded as a whole.
+	constexpr void emit(uint32_t word) {
+		if(size_ < capacity_) buff_[size_] = word;
+		++size_;
+	}
+
+	constexpr int fail(int start, int code) {
+		size_ = start;
+		if(!err_) err_ = code;
+		return err_;
+	}
+
+	constexpr int done(int start) {
+		if(err_) return fail(start, err_);    // sticky error
+		if(size_ > capacity_) return fail(start, ERR_FULL);
+		return size_ - start;
+	}
+
+	constexpr int aluop(uint32_t fn, int rd, int rs1, int rs2) {
+		const int start = size_;
+		if(!validReg(rd) || !validReg(rs1) || !validReg(rs2)) return fail(start, ERR_ARG);
+		emit(enc::mvAluop(fn, rd, rs1, rs2));
+		dropRegInfo(rd);
+		return done(start);
+	}
+
+	constexpr int vecshift(uint32_t opcode) {
+		const int start = size_;
+		emit(enc::vv(opcode));
+		return done(start);
+	}
+
+
+	// -- Macro generators (gemv_genMacro() of IMAGineAsm), arguments are validated by the callers
+
+	constexpr void genMult(int rd, int multiplicand, int multiplier, int outBits) {
+		int firstBit = 0, lastBit = 0;
+		multBitRange(multiplier, outBits, firstBit, lastBit);
+		if(firstBit > lastBit) {    // the annotation contradicts the values, no valid MULT
+			if(!err_) err_ = ERR_ARG;
+			return;
+		}
+		// if the low bits are skipped, the partial-product is cleared first,
+		// because the pass of bit 0 initializes it.
+		if(firstBit > 0) {
+			emit(enc::mvSelect(FN_SEL_ENC, 0, 0));
+			emit(enc::mvFillReg(rd, 0));
+			emit(enc::mvFillReg(rd+1, 0));
+		}
+		emit(enc::mvMult(firstBit, lastBit, rd, multiplier, multiplicand));
+		dropRegInfo(rd, rd+1);
+	}
+
+	constexpr void genBlockAccum(int rd, int rs) {
+		emit(enc::mvAccumBlk(1, rd, rs));      // first fold from rs to rd
+		int restFolds = p_.maxFold - 1;        // rest of the folds on rd
+		if(p_.useRepeat && restFolds > 2) {    // REPEAT + 1 word, pays off from 3 folds
+			emit(enc::repeat(restFolds, DATA_WIDTH, 1));   // the fold (param) field is the lsb of SEG1
+			restFolds = 1;
+		}
+		for(int f=2; f<2+restFolds; ++f) emit(enc::mvAccumBlk(f, rd, rd));
+		dropRegInfo(rd);
+	}
+
+	constexpr void genClearReg(int reg) {
+		emit(enc::mvSelect(FN_SEL_ENC, 0, 0));
+		emit(enc::mvFillReg(reg, 0));
+		dropRegInfo(reg);
+	}
+
+
+	// -- Sources of BRAM images for genLoadImages(). A unit is a selectable
+	// group of blocks; image(u, w) returns wordline w of the BRAM image of unit u.
+	template<class T>
+	struct MatSource {     // units are blocks, row-major
+		const Asm *as; const T *mat; int rows, cols;
+		constexpr uint32_t select(int u, int unitCols) const { return enc::mvSelect(FN_SEL_BLOCK, u / unitCols, u % unitCols); }
+		constexpr uint32_t image(int u, int w, int unitCols) const {
+			const int r = u / unitCols, c0 = (u % unitCols) * PE_COUNT;
+			uint32_t row = 0;
+			if(r >= rows) return 0;
+			for(int p=0; p<PE_COUNT && c0+p < cols; ++p)
+				row |= ((uint32_t(as->toFxp(mat[r*cols + c0+p])) >> w) & 1) << p;
+			return row;
+		}
+	};
+
+	template<class T>
+	struct VecRowSource {  // units are block columns
+		const Asm *as; const T *vec; int size;
+		constexpr uint32_t select(int u, int) const { return enc::mvSelect(FN_SEL_COL, 0, u); }
+		constexpr uint32_t image(int u, int w, int) const {
+			uint32_t row = 0;
+			for(int p=0; p<PE_COUNT && u*PE_COUNT+p < size; ++p)
+				row |= ((uint32_t(as->toFxp(vec[u*PE_COUNT+p])) >> w) & 1) << p;
+			return row;
+		}
+	};
+
+	template<class T>
+	struct VecColSource {  // units are block rows, each element is copied into all PEs of the row
+		const Asm *as; const T *vec; int size;
+		constexpr uint32_t select(int u, int) const { return enc::mvSelect(FN_SEL_ROW, u, 0); }
+		constexpr uint32_t image(int u, int w, int) const {
+			if(u >= size) return 0;
+			return ((uint32_t(as->toFxp(vec[u])) >> w) & 1) ? lowMask(PE_COUNT) : 0;
+		}
+	};
+
+
+	// Emits the writes of the BRAM images of the units of a cleared register,
+	// same as IMAGineAsm.gemv_genLoadImages(). If the units cover all blocks
+	// (mvBlockDim is known), the wordline values shared by most units are written
+	// once using SELECT_ALL, and only the units that differ are fixed, if that
+	// takes fewer instructions.
+	// @return false if there are too many units (IMG_JIT_MAXUNITS).
+	template<class Source>
+	constexpr bool genLoadImages(int reg, const Source &src, int unitCnt, int unitCols) {
+		const int regWidth = p_.regWidth;
+		const bool allUnits = p_.blkRowCnt != 0;
+		uint32_t bcast[16] = {};    // (regWidth is 16) broadcast image: most common value of each wordline (ties: the smaller value)
+		if(allUnits && unitCnt > 0) {
+			if(unitCnt > IMG_JIT_MAXUNITS) return false;
+			uint16_t values[IMG_JIT_MAXUNITS] = {};
+			for(int w=0; w<regWidth; ++w) {
+				for(int u=0; u<unitCnt; ++u) {     // insertion sort of the wordline values
+					const uint16_t v = src.image(u, w, unitCols);
+					int i = u;
+					for(; i > 0 && values[i-1] > v; --i) values[i] = values[i-1];
+					values[i] = v;
+				}
+				int bestCount = 0;
+				for(int u=0, runLen=1; u<unitCnt; ++u, ++runLen) {
+					if(u+1 < unitCnt && values[u+1] == values[u]) continue;
+					if(runLen > bestCount) {
+						bestCount = runLen;
+						bcast[w] = values[u];
+					}
+					runLen = 0;
+				}
+			}
+		}
+		// instruction counts with and without the broadcast
+		int nzBcast = 0, bcastCount = 0, plainCount = 0;
+		for(int w=0; w<regWidth; ++w) if(bcast[w]) ++nzBcast;
+		for(int u=0; u<unitCnt; ++u) {
+			int nzCount = 0, diffCount = 0;
+			for(int w=0; w<regWidth; ++w) {
+				const uint32_t v = src.image(u, w, unitCols);
+				if(v != 0) ++nzCount;
+				if(v != bcast[w]) ++diffCount;
+			}
+			if(nzCount) plainCount += 1 + nzCount;       // select + writes
+			if(diffCount) bcastCount += 1 + diffCount;
+		}
+		const bool useBcast = nzBcast != 0 && 1 + nzBcast + bcastCount < plainCount;
+		if(!useBcast) for(int w=0; w<regWidth; ++w) bcast[w] = 0;    // broadcast does not pay off
+		// generate the instructions
+		const int base = reg * regWidth;    // register base address
+		if(useBcast) {
+			emit(enc::mvSelect(FN_SEL_ENC, 0, 0));
+			for(int w=0; w<regWidth; ++w) if(bcast[w]) emit(enc::mvWrite(base+w, bcast[w]));
+		}
+		for(int u=0; u<unitCnt; ++u) {
+			bool isFirstWrite = true;
+			for(int w=0; w<regWidth; ++w) {
+				const uint32_t v = src.image(u, w, unitCols);
+				if(v == bcast[w]) continue;    // the register has been cleared (or broadcast) already
+				if(isFirstWrite) {             // select the unit if a write is found for the first time
+					emit(src.select(u, unitCols));
+					isFirstWrite = false;
+				}
+				emit(enc::mvWrite(base+w, v));
+			}
+		}
+		return true;
+	}
+};
+
+
+}  // namespace img
+
+
+#endif  // IMAGINE_JIT_HPP
@@ -0,0 +1,329 @@
+#ifndef IMAGINE_KERNEL_HPP
+#define IMAGINE_KERNEL_HPP
+
+// Compile-time kernel front-end of IMAGine (C++20). A kernel is written as a
+// captureless lambda on an img::Kernel, where the GEMV operations are C++
+// expressions of register operands, and img::compile() assembles it during the
+// compilation into a constexpr std::array of instruction words along with the
+// IMAGine_Prog metadata. Invalid registers, reserved registers, operands
+// larger than mvMaxRow/mvMaxCol and mismatching shapes fail the compilation.
+//
+// Usage (ex03, Ra = W @ XH + bb):
+//   constexpr img::AsmParams params = { ... };     // same as the YAML file of the assembler
+//   static constexpr auto ex03 = img::compile<params, [](img::Kernel &k) {
+//       const img::Mat    W {0, 64, 64, 10};        // register, rows, cols, precision (bits)
+//       const img::ColVec bb{1, 64};
+//       const img::RowVec XH{2, 64};
+//       const img::ColVec Ra{10, 64};
+//       k.temps(5, 6);                             // temporary registers of the expressions
+//       k.vv_serialEn();
+//       k.assign(Ra, W*XH + bb);
+//       k.mv_SYNC();
+//       k.vv_parallelEn();
+//   }>();
+//   IMAGine_Prog ex03_kernel = ex03.prog<IMAGine_Prog>();
+//
+// The kernel can use all instructions and macros of img::Asm as well. The
+// precision of a Mat operand annotates the multiplier register (see
+// Asm::annotateReg()), so the multiplications skip the passes of its unused bits.
+
+#include <array>
+#include <cstdint>
+#include "imagine_jit.hpp"
+
+
+namespace img {
+
+
+// Max. no. of terms in a kernel expression
+#ifndef IMG_KERNEL_MAXTERMS
+#define IMG_KERNEL_MAXTERMS 16
+#endif
+
+
+// ---- Register operands: the sizes are checked against the block dimensions
+// and the other operands, 0 if not known (not checked).
+
+// Matrix in a register, the element (r, c) is in the PE of row r and column c
+struct Mat    { int reg; int rows = 0; int cols = 0; int bits = 0; };
+// Vector in the register of all PE rows (mv_LOADVEC_ROW), the multiplicand of a GEMV
+struct RowVec { int reg; int size = 0; };
+// Vector in the register of all PE columns (mv_LOADVEC_COL), the result of a GEMV
+struct ColVec { int reg; int size = 0; };
+
+
+// W*X: matrix-vector multiplication (mv_MULTFXP + mv_ALLACCUM)
+struct Gemv { Mat w; RowVec x; };
+
+constexpr Gemv operator*(const Mat &w, const RowVec &x) { return {w, x}; }
+
+
+// Sum of GEMVs and column vectors, evaluated from left to right
+struct Term {
+	bool   isGemv = false;
+	bool   neg    = false;
+	Gemv   gemv   = {};
+	ColVec vec    = {};
+};
+
+struct Sum {
+	Term term[IMG_KERNEL_MAXTERMS] = {};
+	int  n        = 0;
+	bool overflow = false;     // more than IMG_KERNEL_MAXTERMS terms
+
+	constexpr void append(const Term &t) {
+		if(n < IMG_KERNEL_MAXTERMS) term[n++] = t;
+		else overflow = true;
+	}
+};
+
+constexpr Sum toSum(const Sum &s) { return s; }
+constexpr Sum toSum(const Gemv &g) {
+	Sum s;
+	s.append({true, false, g, {}});
+	return s;
+}
+constexpr Sum toSum(const ColVec &v) {
+	Sum s;
+	s.append({false, false, {}, v});
+	return s;
+}
+
+template<class T>
+concept SumOperand = requires(const T &t) { toSum(t); };
+
+constexpr Sum sumOf(const Sum &lhs, const Sum &rhs, bool negRhs) {
+	Sum s = lhs;
+	for(int i=0; i<rhs.n; ++i) {
+		Term t = rhs.term[i];
+		t.neg = t.neg != negRhs;
+		s.append(t);
+	}
+	s.overflow = s.overflow || rhs.overflow;
+	return s;
+}
+
+template<SumOperand L, SumOperand R>
+constexpr Sum operator+(const L &lhs, const R &rhs) { return sumOf(toSum(lhs), toSum(rhs), false); }
+
+template<SumOperand L, SumOperand R>
+constexpr Sum operator-(const L &lhs, const R &rhs) { return sumOf(toSum(lhs), toSum(rhs), true); }
+
+
+
+// Kernel builder: img::Asm with register checks and expression evaluation
+class Kernel : public Asm {
+public:
+	// Faults, the first one is reported by compile()
+	enum : int {
+		FAULT_NONE = 0,
+		FAULT_REG,        // register out of range
+		FAULT_RESV,       // register reserved for the macros
+		FAULT_SHAPE,      // operand is larger than mvMaxRow x mvMaxCol
+		FAULT_DIM,        // operand shapes do not match
+		FAULT_TEMP,       // not enough temporary registers, or a temporary is an operand
+		FAULT_EXPR,       // unsupported expression
+		FAULT_ASM,        // instruction failed (invalid argument)
+		FAULT_FULL,       // program is larger than the capacity of compile()
+	};
+
+	constexpr Kernel(uint32_t *buff, int capacity, const AsmParams &params)
+		: Asm(buff, capacity, params) {}
+
+	constexpr int fault() const { return fault_; }
+
+	// Sets the temporary registers of the expressions. A sum of n GEMVs needs
+	// n+1 temporaries (the product, and the result of each GEMV); a single GEMV
+	// needs one.
+	template<class... R>
+	constexpr void temps(R... regs) {
+		tempCnt_ = 0;
+		(addTemp(int(regs)), ...);
+	}
+
+	// dst = expr
+	constexpr int assign(const ColVec &dst, const Gemv &expr) { return assign(dst, toSum(expr)); }
+	constexpr int assign(const ColVec &dst, const ColVec &expr) { return assign(dst, toSum(expr)); }
+
+	constexpr int assign(const ColVec &dst, const Sum &expr) {
+		const int start = size();
+		if(!checkSum(dst, expr)) return -1;
+		const int gemvCnt = countGemv(expr);
+		const int needTemps = expr.n == 1 ? gemvCnt : (gemvCnt ? gemvCnt+1 : 0);
+		if(tempCnt_ < needTemps) return setFault(FAULT_TEMP), -1;
+		// the GEMVs first, the result of the GEMV i is in its own temporary
+		int val[IMG_KERNEL_MAXTERMS] = {};
+		for(int i=0, g=0; i<expr.n; ++i) {
+			const Term &t = expr.term[i];
+			if(!t.isGemv) {
+				val[i] = t.vec.reg;
+				continue;
+			}
+			val[i] = expr.n == 1 ? dst.reg : temp_[1 + g++];
+			if(t.gemv.w.bits) annotateReg(t.gemv.w.reg, t.gemv.w.bits);
+			mv_MULTFXP(temp_[0], t.gemv.x.reg, t.gemv.w.reg);
+			mv_ALLACCUM(val[i], temp_[0]);
+		}
+		// then the additions, accumulated in dst
+		if(expr.n == 1 && !expr.term[0].isGemv) mv_mov(dst.reg, val[0]);
+		for(int i=1; i<expr.n; ++i) {
+			const int lhs = i == 1 ? val[0] : dst.reg;
+			if(expr.term[i].neg) mv_sub(dst.reg, lhs, val[i]);
+			else                 mv_add(dst.reg, lhs, val[i]);
+		}
+		if(error()) return setFault(error() == ERR_FULL ? FAULT_FULL : FAULT_ASM), -1;
+		return size() - start;
+	}
+
+
+private:
+	int fault_   = FAULT_NONE;
+	int temp_[IMG_KERNEL_MAXTERMS+1] = {};
+	int tempCnt_ = 0;
+
+	constexpr void setFault(int f) {
+		if(!fault_) fault_ = f;
+	}
+
+	constexpr void addTemp(int reg) {
+		if(!checkReg(reg)) return;
+		if(tempCnt_ == IMG_KERNEL_MAXTERMS+1) return setFault(FAULT_TEMP);
+		temp_[tempCnt_++] = reg;
+	}
+
+	constexpr int mvMaxRow() const { return params().blkRowCnt; }
+	constexpr int mvMaxCol() const { return params().blkColCnt * PE_COUNT; }
+
+	constexpr bool checkReg(int reg) {
+		const AsmParams &p = params();
+		if(reg >= p.regCnt && reg < p.regCnt + p.resvRegCnt) return setFault(FAULT_RESV), false;
+		if(reg < 0 || reg >= p.regCnt) return setFault(FAULT_REG), false;
+		return true;
+	}
+
+	// checks the size against the limit and the expected size, 0 if not known
+	constexpr bool checkSize(int size, int limit, int expected) {
+		if(size < 0 || (limit && size > limit)) return setFault(FAULT_SHAPE), false;
+		if(size && expected && size != expected) return setFault(FAULT_DIM), false;
+		return true;
+	}
+
+	constexpr bool isTemp(int reg) const {
+		for(int i=0; i<tempCnt_; ++i) if(temp_[i] == reg) return true;
+		return false;
+	}
+
+	static constexpr int countGemv(const Sum &expr) {
+		int n = 0;
+		for(int i=0; i<expr.n; ++i) n += expr.term[i].isGemv;
+		return n;
+	}
+
+	constexpr bool checkSum(const ColVec &dst, const Sum &expr) {
+		if(expr.overflow || expr.n == 0 || expr.term[0].neg) return setFault(FAULT_EXPR), false;
+		if(!checkReg(dst.reg) || !checkSize(dst.size, mvMaxRow(), 0)) return false;
+		if(isTemp(dst.reg)) return setFault(FAULT_TEMP), false;
+		int rows = dst.size;    // all terms have the same no. of rows
+		for(int i=0; i<expr.n; ++i) {
+			const Term &t = expr.term[i];
+			int regs[2] = {t.vec.reg, t.vec.reg};
+			if(t.isGemv) {
+				const Mat &w = t.gemv.w;
+				const RowVec &x = t.gemv.x;
+				if(!checkReg(w.reg) || !checkReg(x.reg)) return false;
+				if(w.bits < 0 || w.bits > params().regWidth) return setFault(FAULT_EXPR), false;
+				if(!checkSize(w.rows, mvMaxRow(), rows) || !checkSize(w.cols, mvMaxCol(), 0)
+				   || !checkSize(x.size, mvMaxCol(), w.cols)) return false;
+				if(w.rows) rows = w.rows;
+				regs[0] = w.reg;
+				regs[1] = x.reg;
+			} else {
+				if(!checkReg(t.vec.reg) || !checkSize(t.vec.size, mvMaxRow(), rows)) return false;
+				if(t.vec.size) rows = t.vec.size;
+			}
+			for(const int reg : regs) {
+				if(isTemp(reg)) return setFault(FAULT_TEMP), false;
+				if(i >= 2 && reg == dst.reg) return setFault(FAULT_EXPR), false;   // dst is overwritten by the first addition
+			}
+		}
+		return true;
+	}
+};
+
+
+
+// Compiled program: the instruction words and the IMAGine_Prog metadata
+template<int N>
+struct Program {
+	std::array<uint32_t, N> words;
+	int fracWidth;
+	int mvMaxRow;
+	int mvMaxCol;
+	int regWidth;
+	int idWidth;
+	int peCount;
+
+	static constexpr int size = N;
+
+	// Returns the program descriptor of the C driver, e.g. prog<IMAGine_Prog>()
+	// (the program must have static storage duration).
+	template<class ProgT>
+	constexpr ProgT prog() const {
+		return ProgT{words.data(), N, fracWidth, mvMaxRow, mvMaxCol, regWidth, idWidth, peCount};
+	}
+};
+
+
+namespace detail {
+
+template<int Capacity>
+struct KernelRun {
+	std::array<uint32_t, Capacity> words = {};
+	int size  = 0;
+	int fault = Kernel::FAULT_NONE;
+};
+
+template<AsmParams P, auto Fn, int Capacity>
+constexpr KernelRun<Capacity> runKernel() {
+	KernelRun<Capacity> r;
+	Kernel k(r.words.data(), Capacity, P);
+	Fn(k);
+	r.size = k.size();
+	r.fault = k.fault();
+	if(!r.fault && k.error()) r.fault = k.error() == Asm::ERR_FULL ? Kernel::FAULT_FULL : Kernel::FAULT_ASM;
+	return r;
+}
+
+}  // namespace detail
+
+
+// Assembles the kernel Fn (void(img::Kernel &)) for the parameters P at compile time.
+// @param Capacity  Max. no. of words of the kernel.
+template<AsmParams P, auto Fn, int Capacity = 4096>
+consteval auto compile() {
+	static_assert(P.blkRowCnt > 0 && P.blkColCnt > 0, "mvBlockDim (blkRowCnt, blkColCnt) is needed for the program metadata");
+	constexpr detail::KernelRun<Capacity> r = detail::runKernel<P, Fn, Capacity>();
+	static_assert(r.fault != Kernel::FAULT_REG,   "register out of range (regCnt)");
+	static_assert(r.fault != Kernel::FAULT_RESV,  "register is reserved for the macros (resvRegCnt)");
+	static_assert(r.fault != Kernel::FAULT_SHAPE, "operand is larger than mvMaxRow x mvMaxCol");
+	static_assert(r.fault != Kernel::FAULT_DIM,   "operand shapes do not match");
+	static_assert(r.fault != Kernel::FAULT_TEMP,  "not enough temporary registers, or a temporary is used as an operand");
+	static_assert(r.fault != Kernel::FAULT_EXPR,  "unsupported expression");
+	static_assert(r.fault != Kernel::FAULT_ASM,   "invalid instruction argument or assembler parameter");
+	static_assert(r.fault != Kernel::FAULT_FULL,  "kernel is larger than Capacity");
+	Program<r.size> prog = {};
+	for(int i=0; i<r.size; ++i) prog.words[i] = r.words[i];
+	prog.fracWidth = P.fracWidth;
+	prog.mvMaxRow  = P.blkRowCnt;          // PiCaSO has 1 PE row per block row
+	prog.mvMaxCol  = P.blkColCnt * PE_COUNT;
+	prog.regWidth  = P.regWidth;
+	prog.idWidth   = P.idWidth;
+	prog.peCount   = PE_COUNT;
+	return prog;
+}
+
+
+}  // namespace img
+
+
+#endif  // IMAGINE_KERNEL_HPP
@@ -0,0 +1,87 @@
+#ifndef IMAGINE_JIT_TEST_HPP
+#define IMAGINE_JIT_TEST_HPP
+
+// AK-NOTE: Host tests of the C++ assemblers (see Makefile). The golden
+// programs are the exNN_loader.c/exNN_kernel.c arrays of the example apps,
+// exported by IMAGineAsm from the same weights (build/ex_data.hpp). Each test
+// returns 0 on success; the checks print the failing condition and return -1
+// from the test.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include "imagine_jit.hpp"
+
+extern "C" {
+#include "imagine_prog.h"
+}
+
+
+#define TEST_CHECK(cond)  do { \
+		if(!(cond)) { \
+			printf("    %s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+			return -1; \
+		} \
+	} while(0)
+
+
+namespace imgtest {
+
+// Assembler parameters of the examples (sup/exNN/imagine_64x64_params.yml)
+constexpr img::AsmParams exParams() {
+	img::AsmParams p;
+	p.regCnt     = 60;
+	p.regWidth   = 16;
+	p.fracWidth  = 8;
+	p.resvRegCnt = 4;
+	p.maxLevel   = 1;
+	p.maxFold    = 4;
+	p.idWidth    = 8;
+	p.blkRowCnt  = 64;
+	p.blkColCnt  = 4;
+	p.useRepeat  = true;
+	return p;
+}
+
+
+// Compares the words of an assembled program with a golden program, the
+// first mismatch is printed.
+// @return  true if the words are the same.
+inline bool sameWords(const uint32_t *words, int size, const IMAGine_Prog &golden, const char *name) {
+	if(size != golden.size) {
+		printf("    %s: %d words, golden %d\n", name, size, golden.size);
+		return false;
+	}
+	for(int i=0; i<size; ++i) {
+		if(words[i] != golden.instruction[i]) {
+			printf("    %s: word %d is %08X, golden %08X\n", name, i, (unsigned)words[i], (unsigned)golden.instruction[i]);
+			return false;
+		}
+	}
+	return true;
+}
+
+
+struct Test {
+	const char *name;
+	int (*func)();
+};
+
+// Runs the tests in order.
+// @return  No. of failed tests.
+template<int N>
+int runTests(const Test (&tests)[N]) {
+	int failed = 0;
+	for(const Test &t : tests) {
+		const int err = t.func();
+		printf("%s  %s\n", err ? "FAIL" : "PASS", t.name);
+		if(err) ++failed;
+	}
+	if(failed) printf("%d test(s) failed\n", failed);
+	return failed;
+}
+
+}  // namespace imgtest
+
+
+#endif  // IMAGINE_JIT_TEST_HPP
@@ -0,0 +1,40 @@
+# Exports the weights and inputs of the examples (sup/exNN/exNN_data.npz) as a
+# C++ header for the golden tests, the arrays are the ones the exNN_prog.py
+# scripts load. The values are printed with repr(), so they convert back to
+# the same doubles.
+# Usage: python3 mkdata.py <output header>
+import sys
+import numpy as np
+
+
+exDir = '../..'
+exData = {
+    'ex01': ['A', 'B', 'V'],
+    'ex02': ['Wxi', 'Wxf', 'Wxo', 'Wxc', 'Whi', 'Whf', 'Who', 'Whc', 'bi', 'bf', 'bo', 'bc', 'Xt', 'Hp'],
+    'ex03': ['Wxi', 'Wxf', 'Wxo', 'Wxc', 'Whi', 'Whf', 'Who', 'Whc', 'bi', 'bf', 'bo', 'bc', 'Xt', 'Hp'],
+}
+
+
+def cArray(name, arr):
+    arr = np.asarray(arr, dtype=float)
+    rows, cols = (arr.shape[0], arr.shape[1]) if arr.ndim == 2 else (1, arr.shape[0])
+    values = ', '.join(repr(float(v)) for v in arr.flatten())
+    return (f'constexpr int {name}_rows = {rows}, {name}_cols = {cols};\n'
+            f'constexpr double {name}[] = {{{values}}};\n')
+
+
+text = '// Generated by mkdata.py from sup/exNN/exNN_data.npz, do not edit\n#pragma once\n\n'
+for ex, keys in exData.items():
+    npData = np.load(f'{exDir}/{ex}/{ex}_data.npz')
+    for k in keys: text += cArray(f'{ex}_{k}', npData[k])
+    if ex == 'ex03':
+        # concatenated operands, as in ex03_prog.py
+        Wx = np.concatenate([npData[k] for k in ('Wxi', 'Wxf', 'Wxo', 'Wxc')], axis=0)
+        Wh = np.concatenate([npData[k] for k in ('Whi', 'Whf', 'Who', 'Whc')], axis=0)
+        text += cArray('ex03_W', np.concatenate((Wx, Wh), axis=1))
+        text += cArray('ex03_bb', np.concatenate([npData[k] for k in ('bi', 'bf', 'bo', 'bc')]))
+        text += cArray('ex03_XH', np.concatenate((npData['Xt'], npData['Hp'])))
+    text += '\n'
+
+with open(sys.argv[1], 'w') as fout:
+    fout.write(text)
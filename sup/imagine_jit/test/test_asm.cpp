@@ -0,0 +1,145 @@
+// Golden tests of img::Asm (imagine_jit.hpp): the examples assembled with the
+// C++ assembler must match the programs exported by IMAGineAsm word for word.
+
+#include "jit_test.hpp"
+#include "ex_data.hpp"      // generated by mkdata.py
+
+extern "C" {
+extern IMAGine_Prog ex01_loader, ex01_kernel;    // defined in imagine_appEx01
+extern IMAGine_Prog ex02_loader, ex02_kernel;    // defined in imagine_appEx02
+extern IMAGine_Prog ex03_loader, ex03_kernel;    // defined in imagine_appEx03
+}
+
+using imgtest::sameWords;
+
+static uint32_t buff[4096];
+
+
+// ex01_prog.py: A @ V + B
+static
+int test_ex01() {
+	img::Asm as(buff, 4096, imgtest::exParams());
+	as.mv_LOADMAT(0, ex01_A, ex01_A_rows, ex01_A_cols);
+	as.mv_LOADVEC_COL(1, ex01_B, ex01_B_cols);
+	as.mv_LOADVEC_ROW(2, ex01_V, ex01_V_cols);
+	TEST_CHECK(as.error() == 0 && sameWords(as.data(), as.size(), ex01_loader, "ex01_loader"));
+	as.reset(true);     // the kernel runs on the weights of the loader
+	as.vv_serialEn();
+	as.mv_MULTFXP(3, 2, 0);
+	as.mv_ALLACCUM(4, 3);
+	as.mv_add(5, 4, 1);
+	as.mv_SYNC();
+	as.vv_parallelEn();
+	TEST_CHECK(as.error() == 0 && sameWords(as.data(), as.size(), ex01_kernel, "ex01_kernel"));
+	return 0;
+}
+
+
+// ex02_prog.py: the four gates of an LSTM cell, one GEMV pair each
+static
+int test_ex02() {
+	const double *wx[4] = {ex02_Wxi, ex02_Wxf, ex02_Wxo, ex02_Wxc};
+	const double *wh[4] = {ex02_Whi, ex02_Whf, ex02_Who, ex02_Whc};
+	const double *b[4]  = {ex02_bi, ex02_bf, ex02_bo, ex02_bc};
+	img::Asm as(buff, 4096, imgtest::exParams());
+	for(int g=0; g<4; ++g) as.mv_LOADMAT(g, wx[g], ex02_Wxi_rows, ex02_Wxi_cols);
+	for(int g=0; g<4; ++g) as.mv_LOADMAT(4+g, wh[g], ex02_Whi_rows, ex02_Whi_cols);
+	for(int g=0; g<4; ++g) as.mv_LOADVEC_COL(8+g, b[g], ex02_bi_cols);
+	as.mv_LOADVEC_ROW(20, ex02_Xt, ex02_Xt_cols);
+	as.mv_LOADVEC_ROW(21, ex02_Hp, ex02_Hp_cols);
+	TEST_CHECK(as.error() == 0 && sameWords(as.data(), as.size(), ex02_loader, "ex02_loader"));
+	as.reset(true);
+	for(int g=0; g<4; ++g) {     // computeGate() of the script
+		as.vv_serialEn();
+		as.mv_MULTFXP(22, 20, g);
+		as.mv_ALLACCUM(23, 22);
+		as.mv_MULTFXP(22, 21, 4+g);
+		as.mv_ALLACCUM(24, 22);
+		as.mv_add(30+g, 23, 24);
+		as.mv_add(30+g, 30+g, 8+g);
+		as.mv_SYNC();
+		as.vv_parallelEn();
+		as.vv_SYNC();
+	}
+	TEST_CHECK(as.error() == 0 && sameWords(as.data(), as.size(), ex02_kernel, "ex02_kernel"));
+	return 0;
+}
+
+
+// ex03_prog.py: the LSTM gates as a single GEMV on concatenated operands
+static
+int test_ex03() {
+	img::Asm as(buff, 4096, imgtest::exParams());
+	as.mv_LOADMAT(0, ex03_W, ex03_W_rows, ex03_W_cols);
+	as.mv_LOADVEC_COL(1, ex03_bb, ex03_bb_cols);
+	as.mv_LOADVEC_ROW(2, ex03_XH, ex03_XH_cols);
+	TEST_CHECK(as.error() == 0 && sameWords(as.data(), as.size(), ex03_loader, "ex03_loader"));
+	as.reset(true);
+	as.vv_serialEn();
+	as.mv_MULTFXP(5, 2, 0);
+	as.mv_ALLACCUM(6, 5);
+	as.mv_add(10, 6, 1);
+	as.mv_SYNC();
+	as.vv_parallelEn();
+	TEST_CHECK(as.error() == 0 && sameWords(as.data(), as.size(), ex03_kernel, "ex03_kernel"));
+	return 0;
+}
+
+
+// Errors are sticky, discard the words of the failing instruction, and are
+// cleared by reset(); a full buffer keeps the instructions that fit
+static
+int test_errors() {
+	img::Asm as(buff, 8, imgtest::exParams());
+	TEST_CHECK(as.mv_add(5, 4, 1) == 1);
+	TEST_CHECK(as.mv_add(60, 4, 1) == img::Asm::ERR_ARG);     // reserved register
+	TEST_CHECK(as.vv_serialEn() == img::Asm::ERR_ARG && as.size() == 1);
+	as.reset();
+	TEST_CHECK(as.error() == 0 && as.size() == 0);
+	TEST_CHECK(as.mv_SYNC() == 2);
+	TEST_CHECK(as.mv_LOADVEC_ROW(2, ex01_V, ex01_V_cols) == img::Asm::ERR_FULL);
+	TEST_CHECK(as.size() == 2 && as.error() == img::Asm::ERR_FULL);
+	as.reset();
+	TEST_CHECK(as.mv_LOADMAT(0, ex01_A, 65, 1) == img::Asm::ERR_ARG);       // more rows than mvMaxRow
+	as.reset();
+	TEST_CHECK(as.mv_LOADMAT(0, ex01_A, 2, 2, 4) == img::Asm::ERR_ARG);     // the values need more than 4 bits
+	as.reset();
+	TEST_CHECK(as.mv_mult(6, 2, 0, 5, 2) == img::Asm::ERR_ARG);     // LAST < OFFSET, no last pass to stop at
+	img::AsmParams radix4 = imgtest::exParams();
+	radix4.boothRadix = 4;
+	img::Asm as4(buff, 8, radix4);
+	TEST_CHECK(as4.mv_mult(6, 2, 0, 1) == img::Asm::ERR_ARG);    // radix-4 passes start at even bits
+	img::AsmParams bad = imgtest::exParams();
+	bad.regCnt = 62;     // no room for the reserved registers
+	const img::Asm asBad(buff, 8, bad);
+	TEST_CHECK(asBad.error() == img::Asm::ERR_ARG);
+	return 0;
+}
+
+
+// The encoders and the assembler are usable in constant expressions
+static
+int test_constexpr() {
+	static_assert(img::enc::mvWrite(3, 0x1234) == 0x04031234);
+	static_assert(img::enc::mvFillReg(20, 0) == 0x20A10000);
+	constexpr auto sync = [] {
+		uint32_t words[2] = {};
+		img::Asm as(words, 2);
+		as.mv_SYNC();
+		return words[0] == 0 && words[1] == 0 && as.size() == 2;
+	}();
+	static_assert(sync);
+	return 0;
+}
+
+
+int main() {
+	static const imgtest::Test tests[] = {
+		{"asm: ex01 golden",        test_ex01},
+		{"asm: ex02 golden",        test_ex02},
+		{"asm: ex03 golden",        test_ex03},
+		{"asm: errors",             test_errors},
+		{"asm: constant evaluation", test_constexpr},
+	};
+	return imgtest::runTests(tests) ? 1 : 0;
+}
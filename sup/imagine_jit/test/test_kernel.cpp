@@ -0,0 +1,207 @@
+// Tests of the compile-time kernel front-end (imagine_kernel.hpp): the
+// example kernels written as img::Kernel expressions are checked against
+// img::Asm during the compilation (static_assert), and against the kernels
+// exported by IMAGineAsm at runtime, word for word.
+
+#include "jit_test.hpp"
+#include "imagine_kernel.hpp"
+
+extern "C" {
+extern IMAGine_Prog ex01_kernel;    // defined in imagine_appEx01
+extern IMAGine_Prog ex02_kernel;    // defined in imagine_appEx02
+extern IMAGine_Prog ex03_kernel;    // defined in imagine_appEx03
+}
+
+using imgtest::sameWords;
+
+constexpr img::AsmParams params = imgtest::exParams();
+
+// AK-NOTE: The examples load their weights without a precision annotation
+// and IMAGineAsm does not prune the multiplications by default (pruneMult),
+// so the exported kernels run full multiplications. The annotated operands
+// are checked against img::Asm on an int8 variant of ex03.
+constexpr int WEIGHT_BITS = 8;
+
+
+// ---- ex01: A @ V + B
+static constexpr auto ex01 = img::compile<params, [](img::Kernel &k) {
+	const img::Mat    A{0, 16, 32};
+	const img::ColVec B{1, 16};
+	const img::RowVec V{2, 32};
+	const img::ColVec BSum{5, 16};
+	k.temps(3, 4);
+	k.vv_serialEn();
+	k.assign(BSum, A*V + B);
+	k.mv_SYNC();
+	k.vv_parallelEn();
+}>();
+
+// the same kernel with the assembler calls of ex01_prog.py
+constexpr auto ex01Asm = [] {
+	std::array<uint32_t, ex01.size> words = {};
+	img::Asm as(words.data(), ex01.size, params);
+	as.vv_serialEn();
+	as.mv_MULTFXP(3, 2, 0);
+	as.mv_ALLACCUM(4, 3);
+	as.mv_add(5, 4, 1);
+	as.mv_SYNC();
+	as.vv_parallelEn();
+	return as.size() == ex01.size && as.error() == 0 ? words : std::array<uint32_t, ex01.size>{};
+}();
+
+static_assert(ex01.words == ex01Asm, "ex01 kernel differs from img::Asm");
+static_assert(ex01.mvMaxRow == 64 && ex01.mvMaxCol == 64 && ex01.fracWidth == 8 && ex01.peCount == 16);
+
+
+// ---- ex02: the four gates of an LSTM cell
+static constexpr auto ex02 = img::compile<params, [](img::Kernel &k) {
+	const img::RowVec Xt{20, 20};
+	const img::RowVec Hp{21, 16};
+	k.temps(22, 23, 24);
+	for(int g=0; g<4; ++g) {
+		const img::Mat    Wx{g, 16, 20};
+		const img::Mat    Wh{4+g, 16, 16};
+		const img::ColVec b{8+g, 16};
+		const img::ColVec gate{30+g, 16};
+		k.vv_serialEn();
+		k.assign(gate, Wx*Xt + Wh*Hp + b);
+		k.mv_SYNC();
+		k.vv_parallelEn();
+		k.vv_SYNC();
+	}
+}>();
+
+constexpr auto ex02Asm = [] {
+	std::array<uint32_t, ex02.size> words = {};
+	img::Asm as(words.data(), ex02.size, params);
+	for(int g=0; g<4; ++g) {     // computeGate() of ex02_prog.py
+		as.vv_serialEn();
+		as.mv_MULTFXP(22, 20, g);
+		as.mv_ALLACCUM(23, 22);
+		as.mv_MULTFXP(22, 21, 4+g);
+		as.mv_ALLACCUM(24, 22);
+		as.mv_add(30+g, 23, 24);
+		as.mv_add(30+g, 30+g, 8+g);
+		as.mv_SYNC();
+		as.vv_parallelEn();
+		as.vv_SYNC();
+	}
+	return as.size() == ex02.size && as.error() == 0 ? words : std::array<uint32_t, ex02.size>{};
+}();
+
+static_assert(ex02.words == ex02Asm, "ex02 kernel differs from img::Asm");
+
+
+// ---- ex03: Ra = W @ XH + bb
+static constexpr auto ex03 = img::compile<params, [](img::Kernel &k) {
+	const img::Mat    W {0, 64, 36};
+	const img::ColVec bb{1, 64};
+	const img::RowVec XH{2, 36};
+	const img::ColVec Ra{10, 64};
+	k.temps(5, 6);
+	k.vv_serialEn();
+	k.assign(Ra, W*XH + bb);
+	k.mv_SYNC();
+	k.vv_parallelEn();
+}>();
+
+constexpr auto ex03Asm = [] {
+	std::array<uint32_t, ex03.size> words = {};
+	img::Asm as(words.data(), ex03.size, params);
+	as.vv_serialEn();
+	as.mv_MULTFXP(5, 2, 0);
+	as.mv_ALLACCUM(6, 5);
+	as.mv_add(10, 6, 1);
+	as.mv_SYNC();
+	as.vv_parallelEn();
+	return as.size() == ex03.size && as.error() == 0 ? words : std::array<uint32_t, ex03.size>{};
+}();
+
+static_assert(ex03.words == ex03Asm, "ex03 kernel differs from img::Asm");
+
+
+// ---- ex03 with int8 weights: the annotated multiplications are shortened
+static constexpr auto ex03Int8 = img::compile<params, [](img::Kernel &k) {
+	const img::Mat    W {0, 64, 36, WEIGHT_BITS};
+	const img::ColVec bb{1, 64};
+	const img::RowVec XH{2, 36};
+	const img::ColVec Ra{10, 64};
+	k.temps(5, 6);
+	k.vv_serialEn();
+	k.assign(Ra, W*XH + bb);
+	k.mv_SYNC();
+	k.vv_parallelEn();
+}>();
+
+constexpr auto ex03Int8Asm = [] {
+	std::array<uint32_t, ex03Int8.size> words = {};
+	img::Asm as(words.data(), ex03Int8.size, params);
+	as.annotateReg(0, WEIGHT_BITS);
+	as.vv_serialEn();
+	as.mv_MULTFXP(5, 2, 0);
+	as.mv_ALLACCUM(6, 5);
+	as.mv_add(10, 6, 1);
+	as.mv_SYNC();
+	as.vv_parallelEn();
+	return as.size() == ex03Int8.size && as.error() == 0 ? words : std::array<uint32_t, ex03Int8.size>{};
+}();
+
+static_assert(ex03Int8.words == ex03Int8Asm, "int8 ex03 kernel differs from img::Asm");
+static_assert(ex03Int8.words != ex03.words, "int8 ex03 kernel is not shortened");
+
+
+// The compiled kernels are the exported ones, and the program descriptor
+// points to the compiled words
+static
+int test_golden() {
+	TEST_CHECK(sameWords(ex01.words.data(), ex01.size, ex01_kernel, "ex01_kernel"));
+	TEST_CHECK(sameWords(ex02.words.data(), ex02.size, ex02_kernel, "ex02_kernel"));
+	TEST_CHECK(sameWords(ex03.words.data(), ex03.size, ex03_kernel, "ex03_kernel"));
+	const IMAGine_Prog prog = ex03.prog<IMAGine_Prog>();
+	TEST_CHECK(prog.instruction == ex03.words.data() && prog.size == ex03_kernel.size);
+	TEST_CHECK(prog.fracWidth == ex03_kernel.fracWidth && prog.mvMaxRow == ex03_kernel.mvMaxRow
+	           && prog.mvMaxCol == ex03_kernel.mvMaxCol && prog.regWidth == ex03_kernel.regWidth
+	           && prog.idWidth == ex03_kernel.idWidth && prog.peCount == ex03_kernel.peCount);
+	return 0;
+}
+
+
+// The faults of a kernel are reported by the builder, compile() turns them
+// into static assertions (see test_kernel_faults.cpp)
+static
+int test_faults() {
+	uint32_t words[64];
+	const img::Mat    W{0, 64, 36};
+	const img::RowVec XH{2, 36};
+	const img::ColVec Ra{10, 64};
+	struct {
+		int fault;
+		void (*build)(img::Kernel &k, const img::Mat &W, const img::RowVec &XH, const img::ColVec &Ra);
+	} cases[] = {
+		{img::Kernel::FAULT_REG,   [](img::Kernel &k, auto &W, auto &XH, auto&) { k.temps(5, 6); k.assign(img::ColVec{64}, W*XH); }},
+		{img::Kernel::FAULT_RESV,  [](img::Kernel &k, auto &W, auto &XH, auto&) { k.temps(5, 6); k.assign(img::ColVec{61}, W*XH); }},
+		{img::Kernel::FAULT_SHAPE, [](img::Kernel &k, auto&, auto &XH, auto &Ra) { k.temps(5, 6); k.assign(Ra, img::Mat{0, 65, 36}*XH); }},
+		{img::Kernel::FAULT_DIM,   [](img::Kernel &k, auto &W, auto&, auto &Ra) { k.temps(5, 6); k.assign(Ra, W*img::RowVec{2, 20}); }},
+		{img::Kernel::FAULT_TEMP,  [](img::Kernel &k, auto &W, auto &XH, auto &Ra) { k.temps(5); k.assign(Ra, W*XH + W*XH); }},
+		{img::Kernel::FAULT_EXPR,  [](img::Kernel &k, auto&, auto&, auto &Ra) { k.temps(5, 6); k.assign(Ra, img::Sum{}); }},
+		{img::Kernel::FAULT_FULL,  [](img::Kernel &k, auto &W, auto &XH, auto &Ra) { k.temps(5, 6); for(int i=0; i<16; ++i) k.assign(Ra, W*XH); }},
+	};
+	for(const auto &c : cases) {
+		img::Kernel k(words, 64, params);
+		c.build(k, W, XH, Ra);
+		TEST_CHECK(k.fault() == c.fault);
+	}
+	img::Kernel k(words, 64, params);
+	k.temps(5, 6);
+	TEST_CHECK(k.assign(Ra, W*XH) > 0 && k.fault() == img::Kernel::FAULT_NONE);
+	return 0;
+}
+
+
+int main() {
+	static const imgtest::Test tests[] = {
+		{"kernel: ex01-ex03 golden", test_golden},
+		{"kernel: faults",           test_faults},
+	};
+	return imgtest::runTests(tests) ? 1 : 0;
+}
@@ -0,0 +1,45 @@
+// Compile-fail tests of img::compile(): built once per KERNEL_FAULT, each
+// kernel must stop the compilation with the static assertion of its fault
+// (see the test-faults target of the Makefile). KERNEL_FAULT=0 is a valid
+// kernel that must compile.
+
+#include "jit_test.hpp"
+#include "imagine_kernel.hpp"
+
+#ifndef KERNEL_FAULT
+#define KERNEL_FAULT 0
+#endif
+
+constexpr img::AsmParams params = imgtest::exParams();
+
+static constexpr auto kernel = img::compile<params, [](img::Kernel &k) {
+	const img::Mat    W {0, 64, 36};
+	const img::ColVec bb{1, 64};
+	const img::RowVec XH{2, 36};
+	const img::ColVec Ra{10, 64};
+	k.temps(5, 6);
+#if KERNEL_FAULT == 0
+	k.assign(Ra, W*XH + bb);
+#elif KERNEL_FAULT == 1     // register out of range
+	k.assign(img::ColVec{64}, W*XH);
+#elif KERNEL_FAULT == 2     // reserved register
+	k.assign(img::ColVec{60}, W*XH);
+#elif KERNEL_FAULT == 3     // more rows than mvMaxRow
+	k.assign(Ra, img::Mat{0, 65, 36}*XH);
+#elif KERNEL_FAULT == 4     // the vector does not match the matrix
+	k.assign(Ra, W*img::RowVec{2, 20});
+#elif KERNEL_FAULT == 5     // a temporary is an operand
+	k.assign(Ra, W*img::RowVec{5, 36});
+#elif KERNEL_FAULT == 6     // empty expression
+	k.assign(Ra, img::Sum{});
+#elif KERNEL_FAULT == 7     // invalid instruction argument
+	k.mv_accumRow(2, 10);
+#elif KERNEL_FAULT == 8     // larger than the capacity
+	for(int i=0; i<16; ++i) k.assign(Ra, W*XH);
+#endif
+}, 64>();
+
+
+int main() {
+	return kernel.size > 0 ? 0 : 1;
+}
@@ -104,4 +104,522 @@ int16_t ex01_testOut[] = {
   0,
   0,
 };
-int ex01_testOut_size = sizeof(ex01_testOut)/sizeof(ex01_testOut[0]);
\ No newline at end of file
+int ex01_testOut_size = sizeof(ex01_testOut)/sizeof(ex01_testOut[0]);
+
+
+int16_t ex01_testMat[] = {
+  223,
+  13,
+  281,
+  222,
+  215,
+  169,
+  104,
+  317,
+  153,
+  136,
+  318,
+  270,
+  68,
+  262,
+  94,
+  402,
+  437,
+  253,
+  433,
+  40,
+  258,
+  33,
+  219,
+  49,
+  65,
+  305,
+  115,
+  54,
+  112,
+  179,
+  239,
+  103,
+  327,
+  247,
+  258,
+  198,
+  406,
+  296,
+  83,
+  358,
+  493,
+  256,
+  455,
+  174,
+  290,
+  218,
+  223,
+  397,
+  274,
+  488,
+  278,
+  42,
+  187,
+  435,
+  208,
+  13,
+  126,
+  34,
+  508,
+  496,
+  409,
+  308,
+  391,
+  86,
+  150,
+  268,
+  182,
+  23,
+  503,
+  225,
+  258,
+  165,
+  132,
+  198,
+  425,
+  377,
+  194,
+  6,
+  408,
+  137,
+  298,
+  13,
+  339,
+  198,
+  254,
+  212,
+  179,
+  282,
+  498,
+  57,
+  160,
+  21,
+  378,
+  336,
+  109,
+  213,
+  329,
+  338,
+  87,
+  451,
+  398,
+  68,
+  444,
+  383,
+  408,
+  278,
+  113,
+  470,
+  303,
+  177,
+  135,
+  467,
+  214,
+  276,
+  311,
+  423,
+  319,
+  90,
+  302,
+  250,
+  280,
+  358,
+  125,
+  95,
+  56,
+  140,
+  5,
+  322,
+  151,
+  95,
+  48,
+  145,
+  110,
+  146,
+  241,
+  281,
+  432,
+  506,
+  25,
+  118,
+  329,
+  82,
+  445,
+  111,
+  379,
+  334,
+  409,
+  15,
+  117,
+  360,
+  44,
+  15,
+  182,
+  301,
+  26,
+  33,
+  22,
+  202,
+  342,
+  101,
+  448,
+  221,
+  317,
+  148,
+  315,
+  488,
+  229,
+  106,
+  217,
+  227,
+  259,
+  269,
+  21,
+  84,
+  230,
+  362,
+  398,
+  397,
+  257,
+  489,
+  169,
+  246,
+  383,
+  439,
+  212,
+  434,
+  227,
+  366,
+  4,
+  12,
+  481,
+  52,
+  338,
+  145,
+  102,
+  198,
+  474,
+  291,
+  469,
+  359,
+  256,
+  259,
+  112,
+  2,
+  213,
+  288,
+  448,
+  346,
+  431,
+  474,
+  481,
+  417,
+  67,
+  177,
+  106,
+  444,
+  405,
+  178,
+  291,
+  412,
+  426,
+  105,
+  374,
+  411,
+  22,
+  54,
+  222,
+  113,
+  450,
+  368,
+  365,
+  394,
+  169,
+  117,
+  320,
+  212,
+  479,
+  328,
+  198,
+  437,
+  194,
+  91,
+  400,
+  241,
+  132,
+  354,
+  502,
+  126,
+  404,
+  390,
+  61,
+  429,
+  236,
+  64,
+  274,
+  151,
+  89,
+  40,
+  101,
+  219,
+  328,
+  44,
+  366,
+  52,
+  89,
+  365,
+  453,
+  503,
+  334,
+  244,
+  44,
+  286,
+  92,
+  263,
+  311,
+  426,
+  165,
+  506,
+  509,
+  422,
+  355,
+  375,
+  448,
+  487,
+  436,
+  328,
+  37,
+  319,
+  180,
+  84,
+  457,
+  422,
+  269,
+  237,
+  250,
+  133,
+  206,
+  223,
+  7,
+  457,
+  14,
+  190,
+  49,
+  100,
+  482,
+  190,
+  373,
+  64,
+  128,
+  451,
+  462,
+  147,
+  495,
+  342,
+  257,
+  193,
+  172,
+  487,
+  354,
+  273,
+  22,
+  126,
+  482,
+  285,
+  183,
+  4,
+  129,
+  130,
+  87,
+  176,
+  103,
+  32,
+  50,
+  254,
+  35,
+  478,
+  105,
+  237,
+  212,
+  149,
+  165,
+  108,
+  143,
+  59,
+  352,
+  329,
+  159,
+  450,
+  197,
+  312,
+  267,
+  166,
+  476,
+  434,
+  430,
+  488,
+  1,
+  251,
+  480,
+  68,
+  125,
+  258,
+  347,
+  170,
+  156,
+  397,
+  16,
+  402,
+  219,
+  322,
+  361,
+  50,
+  462,
+  421,
+  192,
+  99,
+  32,
+  158,
+  365,
+  416,
+  167,
+  112,
+  167,
+  493,
+  49,
+  83,
+  355,
+  71,
+  136,
+  411,
+  153,
+  305,
+  293,
+  135,
+  127,
+  148,
+  448,
+  9,
+  46,
+  174,
+  112,
+  288,
+  276,
+  253,
+  153,
+  261,
+  402,
+  416,
+  272,
+  412,
+  17,
+  78,
+  383,
+  197,
+  162,
+  292,
+  190,
+  465,
+  198,
+  428,
+  308,
+  466,
+  247,
+  490,
+  295,
+  14,
+  378,
+  441,
+  50,
+  493,
+  288,
+  379,
+  114,
+  481,
+  329,
+  278,
+  492,
+  285,
+  272,
+  22,
+  279,
+  381,
+  188,
+  347,
+  288,
+  106,
+  279,
+  243,
+  172,
+  339,
+  31,
+  190,
+  222,
+  498,
+  357,
+  320,
+  79,
+  222,
+  190,
+  481,
+  231,
+  437,
+  334,
+  450,
+  1,
+  473,
+  487,
+  79,
+  33,
+  162,
+  299,
+  268,
+  222,
+  467,
+  291,
+  478,
+  294,
+  94,
+  502,
+  511,
+  228,
+  390,
+  325,
+  94,
+  296,
+  334,
+  303,
+  277,
+  303,
+  363,
+  394,
+  45,
+  467,
+  230,
+  356,
+  198,
+  26,
+  339,
+  187,
+  283,
+  136,
+  104,
+  151,
+  431,
+  473,
+  501,
+  212,
+  395,
+  86,
+  381,
+  217,
+  432,
+};
+int ex01_testMat_size = sizeof(ex01_testMat)/sizeof(ex01_testMat[0]);
+int ex01_testMat_cols = 32;
\ No newline at end of file
@@ -0,0 +1,82 @@
+#ifndef IMAGINE_BINPROG_H
+#define IMAGINE_BINPROG_H
+
+
+#include <stddef.h>
+#include <stdint.h>
+#include "imagine_prog.h"     // This header needs to be supplied by the compiled program
+
+
+// AK-NOTE: Binary program container, exported by IMAGineAsm.export_binary().
+// It holds the programs of a model (loaders and kernels) along with their
+// target configuration, so the model can be changed without rebuilding the
+// firmware. The container is little-endian:
+//
+//   [header: 32 bytes] [section table: sectCount x 32 bytes] [instruction words]
+//
+// The checksum is the CRC-32 (same as zlib.crc32) of the file after the
+// checksum field. The sections are used in place, the instructions are pushed
+// from the container image without copying.
+
+#define IMG_BIN_MAGIC    0x42474D49u	// "IMGB"
+#define IMG_BIN_VERSION  1
+#define IMG_BIN_NAMELEN  20				// section names are NUL padded
+
+// Section types
+#define IMG_BIN_LOADER   1
+#define IMG_BIN_KERNEL   2
+#define IMG_BIN_TYPEMASK   0xFFu
+#define IMG_BIN_COMPRESSED 0x100u	// flag: WRITE runs are exported as WRUNs (needs the WRUN decoder of the IP)
+
+// Error codes
+#define IMG_BIN_EIO        -1	// the file could not be read
+#define IMG_BIN_EFORMAT    -2	// not a container, unsupported version, or malformed
+#define IMG_BIN_ECHECKSUM  -3	// checksum mismatch
+#define IMG_BIN_ECONFIG    -4	// target configuration does not match the IP
+#define IMG_BIN_ENOSECT    -5	// section not found
+
+
+typedef struct {
+	uint32_t magic;
+	uint16_t version;
+	uint16_t sectCount;
+	uint32_t fileSize;		// bytes
+	uint32_t checksum;
+	// target IMAGine configuration of the programs
+	uint8_t  fracWidth;
+	uint8_t  regWidth;
+	uint8_t  idWidth;
+	uint8_t  peCount;
+	uint16_t mvMaxRow;
+	uint16_t mvMaxCol;
+	uint32_t reserved[2];
+} IMAGine_BinHeader;
+
+typedef struct {
+	char     name[IMG_BIN_NAMELEN];
+	uint32_t type;			// IMG_BIN_LOADER or IMG_BIN_KERNEL, | IMG_BIN_COMPRESSED
+	uint32_t offset;		// byte offset of the instructions in the file
+	uint32_t size;			// no. of instruction words
+} IMAGine_BinSection;
+
+// An opened container
+typedef struct {
+	const IMAGine_BinHeader  *header;
+	const IMAGine_BinSection *sections;
+	const uint8_t *image;	// container image
+	size_t  imageSize;
+	int     source;			// where the image comes from, see img_closeBinProgram()
+} IMAGine_BinProg;
+
+
+// Binary program API functions
+int  img_openBinProgram(IMAGine_BinProg *bin, const void *image, const size_t size);
+int  img_loadBinFile(IMAGine_BinProg *bin, const char *path);
+void img_closeBinProgram(IMAGine_BinProg *bin);
+int  img_findBinSection(const IMAGine_BinProg *bin, const char *name);
+IMAGine_Prog img_binSectionProg(const IMAGine_BinProg *bin, const int sect);
+int  img_pushBinSection(const IMAGine_BinProg *bin, const int sect);
+int  img_pushBinLoaders(const IMAGine_BinProg *bin);
+
+
+#endif  // IMAGINE_BINPROG_H
@@ -1,11 +1,64 @@
-#include <xparameters.h>
-#include <imagine_gemv.h>
-#include <xil_printf.h>
+#include <stdlib.h>
+#include "imagine_platform.h"
+#include "imagine_backend.h"
 #include "imagine_driver.h"
 
-
-// Alias for base address and register offsets
-#define IMG_BASEADDR  XPAR_IMAGINE_GEMV_0_S00_AXI_BASEADDR
+// AXI DMA feeding the IP's instruction stream port (optional)
+#ifdef XPAR_XAXIDMA_NUM_INSTANCES
+#include <xaxidma.h>
+#include <xil_cache.h>
+#define IMG_HAS_DMA
+#endif
+
+// Clock of the timeouts (see img_nowUs())
+#if IMG_REG_TARGET == IMG_BACKEND_MMIO
+#include <xtime_l.h>
+#else
+#include <time.h>
+#endif
+
+// EOV interrupt: UIO device under Linux, GIC on bare-metal (optional)
+#if defined(IMG_USE_UIO)
+#include <errno.h>
+#include <poll.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#elif defined(XPAR_FABRIC_IMAGINE_GEMV_0_EOV_IRQ_INTR)
+#include <xscugic.h>
+#include <xil_exception.h>
+#define IMG_HAS_EOVIRQ
+#endif
+
+// SIMD kernels of the 16x16 bit-transpose (see img_transpose16x16()).
+// The kernel follows the target; a build can select one with -DIMG_SIMD_NEON,
+// -DIMG_SIMD_AVX2, -DIMG_SIMD_SSE2, or the scalar loop with -DIMG_SIMD_NONE.
+#if IMAGINE_PEPERBLOCK == 16 && IMAGINE_PEREGWIDTH == 16
+#if !defined(IMG_SIMD_NONE) && !defined(IMG_SIMD_NEON) && !defined(IMG_SIMD_AVX2) && !defined(IMG_SIMD_SSE2)
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define IMG_SIMD_NEON
+#elif defined(__AVX2__)
+#define IMG_SIMD_AVX2
+#elif defined(__SSE2__)
+#define IMG_SIMD_SSE2
+#endif
+#endif
+#if defined(IMG_SIMD_NEON)
+#include <arm_neon.h>
+#elif defined(IMG_SIMD_AVX2)
+#include <immintrin.h>
+#elif defined(IMG_SIMD_SSE2)
+#include <emmintrin.h>
+#endif
+#else
+#undef IMG_SIMD_NEON		// the kernels are written for 16x16 blocks
+#undef IMG_SIMD_AVX2
+#undef IMG_SIMD_SSE2
+#endif
+
+
+// Alias for register offsets (register accesses come from imagine_backend.h)
 #define REG0  IMAGINE_GEMV_S00_AXI_SLV_REG0_OFFSET
 #define REG1  IMAGINE_GEMV_S00_AXI_SLV_REG1_OFFSET
 #define REG2  IMAGINE_GEMV_S00_AXI_SLV_REG2_OFFSET
@@ -29,19 +82,32 @@
 #define BIT_FIFO_RST   (1u << 0)
 #define BIT_FINP_WR    (1u << 1)
 #define BIT_FOUT_RD    (1u << 2)
+#define BIT_FINP_AUTOWR (1u << 3)
+#define BIT_FOUT_AUTORD (1u << 4)
+#define BIT_FOUT_PACK   (1u << 5)
 // slv_reg2 (IMAGine control register)
 #define BIT_IMG_CLREOV (1u << 0)
+#define BIT_IMG_EOVIE  (1u << 1)
 // slv_reg9 (FIFO status register)
 #define BIT_FINP_FULL  (1u << 0)
 #define BIT_FOUT_VALID (1u << 1)
 // slv_reg10 (IMAGine status register)
 #define BIT_IMG_EOVINT (1u << 0)
 
+// Max. reads of reg10 waiting for a cleared EOV flag (see img_clearEOV())
+#define IMG_EOV_CLEAR_POLLS  16
+
 
 // Pre-compiled instruction template functions
 #define INSTR_ADDR_WIDTH  10   // width of the ADDR field
 #define INSTR_DATA_WIDTH  16   // width of the DATA field
 #define INSTR_ID_WIDTH    8    // width of PiCaSO block row/column IDs
+#define INSTR_REG_WIDTH   6    // width of the register fields
+#define INSTR_SCODE_WIDTH 3    // width of the S_CODE field of SUPER-OP
+
+// Kernel cache of the IP (see imagine_interface.svh)
+#define KCACHE_ADDR_WIDTH 10   // width of the BASE field
+#define KCACHE_DEPTH      (1 << KCACHE_ADDR_WIDTH)	// no. of instructions the cache can hold
 
 
 
@@ -56,33 +122,41 @@ uint32_t img_genMV_WRITE(img_bramaddr_t addr, img_bramrow_t data) {
 	return 0x04000000 | (addr << INSTR_DATA_WIDTH) | data;
 }
 
+static inline
+uint32_t img_genMV_FILLREG(int reg, img_bramrow_t data) {
+	// [subm-code:2 = 00b] [opcode:4 = 1000b] [RD, S_CODE = 001b] [data]
+	return 0x20010000 | (reg << (INSTR_DATA_WIDTH + INSTR_SCODE_WIDTH)) | data;
+}
+
 static inline
 uint32_t img_genMV_SELECT_COL(img_bramid_t colID) {
 	// [subm-code:2 = 00b] [opcode:4 = 0110] [Fn, xx] [Row, Col]
 	return 0x18000000 | colID;
 }
 
+static inline
+uint32_t img_genMV_SELECT_BLOCK(img_bramid_t rowID, img_bramid_t colID) {
+	// [subm-code:2 = 00b] [opcode:4 = 0110] [Fn = 01b, xx] [Row, Col]
+	return 0x18400000 | (rowID << INSTR_ID_WIDTH) | colID;
+}
 
-// Utility macros, only pass variables, not statements
-#define MIN(a, b)  ((a) < (b) ? (a) : (b))
-#define MAX(a, b)  ((a) > (b) ? (a) : (b))
-
-
-// Register read-write utilities
 static inline
-uint32_t readImgReg(uintptr_t regOffset)
-{
-	return *(volatile uint32_t *) (IMG_BASEADDR + regOffset);
+uint32_t img_genKC_KLOAD(int kernelID, int length, int base) {
+	// [subm-code:2 = 10b] [opcode:4 = 0001b] [ID:4] [x] [length:11] [base:10]
+	return 0x84000000 | (kernelID << 22) | (length << KCACHE_ADDR_WIDTH) | base;
 }
 
 static inline
-void writeImgReg(uintptr_t regOffset, uint32_t data)
-{
-	volatile uint32_t *addr = (volatile uint32_t *)(IMG_BASEADDR + regOffset);
-	*addr = data;
+uint32_t img_genKC_KRUN(int kernelID) {
+	// [subm-code:2 = 10b] [opcode:4 = 0010b] [ID:4] [xx]
+	return 0x88000000 | (kernelID << 22);
 }
 
 
+// Utility macros, only pass variables, not statements
+#define MIN(a, b)  ((a) < (b) ? (a) : (b))
+#define MAX(a, b)  ((a) > (b) ? (a) : (b))
+
 
 // AK-NOTE: Following register map is taken from the IP verilog
 // imagine-ip input register map:
@@ -95,7 +169,10 @@ void writeImgReg(uintptr_t regOffset, uint32_t data)
 // fout-data output      : reg8
 // fifo-status reg       : reg9
 // imagine-status reg    : reg10
-// reserved readonly regs: reg 11-15
+// finp-free-slots reg   : reg11
+// fout-fill-level reg   : reg12
+// fifo-depth reg        : reg13
+// magic-number regs     : reg 14-15
 
 
 // writes to FIFO-in data register
@@ -105,19 +182,39 @@ void img_writeFinpData(uint32_t data) {
 }
 
 
+// Shadow copy of the FIFO control register (reg1).
+// AK-NOTE: The driver is the only writer of reg1 and the pulse-gen bits are
+// always cleared after use. So, the register content is known and we don't
+// need to read it back before every pulse. The register keeps its content
+// across a restart of the firmware/process, so img_openDevice() and
+// img_test() write the shadow into it before the first pulse.
+static uint32_t fifoCtrlShadow = 0;
+
+
+// Writes the shadow copy into the FIFO control register
+static inline
+void img_syncFifoCtrl() {
+	writeImgReg(REG1, fifoCtrlShadow);
+}
+
+
 // generates FIFO-in write pulse
+// (not needed in auto-strobe mode, writing reg0 pushes the data)
 static inline
 void img_genFinpWrPulse() {
-	uint32_t ctrl = readImgReg(REG1);		// read current register content
+	const uint32_t ctrl = fifoCtrlShadow;	// current register content
+	if(ctrl & BIT_FINP_AUTOWR) return;
 	writeImgReg(REG1, ctrl | BIT_FINP_WR);	// set the pulse-gen bit
 	writeImgReg(REG1, ctrl & ~BIT_FINP_WR);	// clear the pulse-gen bit
 }
 
 
 // generates FIFO-out read pulse
+// (not needed in auto-strobe mode, reading reg8 pops the data)
 static inline
 void img_genFoutRdPulse() {
-	uint32_t ctrl = readImgReg(REG1);		// read current register content
+	const uint32_t ctrl = fifoCtrlShadow;	// current register content
+	if(ctrl & BIT_FOUT_AUTORD) return;
 	writeImgReg(REG1, ctrl | BIT_FOUT_RD);	// set the pulse-gen bit
 	writeImgReg(REG1, ctrl & ~BIT_FOUT_RD);	// clear the pulse-gen bit
 }
@@ -151,6 +248,24 @@ bool img_isFinpFull() {
 }
 
 
+// Returns the no. of FIFO-in slots that are guaranteed to be free.
+// AK-NOTE: The IP reports a conservative count, so these many words
+// can be written without checking the full flag.
+static inline
+int img_getFinpFreeSlots() {
+	return (int)readImgReg(REG11);
+}
+
+
+// Returns the no. of FIFO-out words that are guaranteed to be valid.
+// AK-NOTE: The IP reports a conservative count, so these many words
+// can be read without checking the valid flag.
+static inline
+int img_getFoutFillLevel() {
+	return (int)readImgReg(REG12);
+}
+
+
 // returns true if FIFO-out data is valid
 static inline
 bool img_isFoutValid() {
@@ -165,12 +280,340 @@ bool img_isEovSet() {
 }
 
 
+// Shadow copy of the IMAGine control register (reg2), same as fifoCtrlShadow.
+// AK-NOTE: On bare-metal, the EOV ISR writes reg2 too (masks EOVIE), so the
+// main thread changes reg2 with the interrupts masked; otherwise, the ISR
+// could run between the two writes of the main thread, and the second one
+// would restore the old EOVIE.
+static volatile uint32_t imgCtrlShadow = 0;
+
+#if defined(IMG_HAS_EOVIRQ)
+#define IMG_IRQ_LOCK()    Xil_ExceptionDisable()
+#define IMG_IRQ_UNLOCK()  Xil_ExceptionEnable()
+#else
+#define IMG_IRQ_LOCK()
+#define IMG_IRQ_UNLOCK()
+#endif
+
+
 // Clears the eovInterrupt flag
 static inline
 void img_clearEovFlag() {
-	uint32_t ctrl = readImgReg(REG2);	    	// read current register content
+	IMG_IRQ_LOCK();
+	const uint32_t ctrl = imgCtrlShadow;		// current register content
 	writeImgReg(REG2, ctrl | BIT_IMG_CLREOV);	// set the pulse-gen bit
-	writeImgReg(REG2, ctrl & ~BIT_IMG_CLREOV);	// clear the pulse-gen bit
+	writeImgReg(REG2, ctrl);					// clear the pulse-gen bit
+	IMG_IRQ_UNLOCK();
+}
+
+
+
+
+// ---- Device
+#ifdef IMG_USE_UIO
+volatile uint8_t *img_regWindow = NULL;		// mapped register window
+static int        devFd = -1;				// device file of the register window
+#endif
+
+
+// Opens the IMAGine device. Must be called before any other API function.
+// On Linux (IMG_USE_UIO), maps the register window of the IP from
+// IMG_UIO_DEVICE into the process. Then puts the FIFO control register
+// in the default mode (pulse-gen strobes, unpacked output).
+// @return  0 on success, -1 on failure.
+int img_openDevice() {
+#ifdef IMG_USE_UIO
+	if(img_regWindow) return 0;		// already open
+	devFd = open(IMG_UIO_DEVICE, O_RDWR | O_SYNC);
+	if(devFd < 0) {
+		print("img_openDevice: could not open " IMG_UIO_DEVICE "\n");
+		return -1;
+	}
+	void *win = mmap(NULL, IMG_REGWIN_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED,
+			         devFd, IMG_REGWIN_OFFSET);
+	if(win == MAP_FAILED) {
+		print("img_openDevice: could not map the register window\n");
+		close(devFd);
+		devFd = -1;
+		return -1;
+	}
+	img_regWindow = (volatile uint8_t *)win;
+#endif
+	img_syncFifoCtrl();		// drop the modes left by a previous session
+	writeImgReg(REG2, imgCtrlShadow);	// EOV interrupt stays off until img_initEOVInterrupt()
+	return 0;
+}
+
+
+// Closes the IMAGine device opened by img_openDevice().
+void img_closeDevice() {
+#ifdef IMG_USE_UIO
+	if(img_regWindow) munmap((void *)img_regWindow, IMG_REGWIN_SIZE);
+	if(devFd >= 0) close(devFd);
+	img_regWindow = NULL;
+	devFd = -1;
+#endif
+}
+
+
+
+
+// ---- Register images
+// AK-NOTE: The driver tracks the state of each register: zero, known image
+// (loaded with img_mv_LOADVEC_ROW()) or unknown. A zero register is not
+// cleared again, and reloading a known image only writes the rows that
+// changed, without clearing the register first. The state is only known
+// while the driver sees all writes to the register: the instructions pushed
+// through the user APIs are decoded, and the registers they may write become
+// unknown. Call img_invalidateRegImage() if the registers change behind the
+// driver (e.g. the IP is reset). All registers start as unknown, see
+// img_markRegsZero().
+#define IMG_REGCOUNT  ((1 << INSTR_ADDR_WIDTH) / IMAGINE_PEREGWIDTH)
+
+// PiCaSO submodule codes and opcodes (see imagine_assembler.py, picaso_assembler.py)
+#define SUBM_MV          0
+#define SUBM_VV          1
+#define SUBM_KC          2		// kernel cache, KLOAD/KRUN
+#define SUBM_RPT         3		// REPEAT of the next instruction
+#define RPT_WRUN_BIT     (1u << 16)		// REPEAT word is a WRITE run
+#define OPCODE_NOP       0
+#define OPCODE_WRITE     1
+#define OPCODE_READ      2
+#define OPCODE_UPDATEPP  3
+#define OPCODE_ACCUM     4
+#define OPCODE_ALUOP     5
+#define OPCODE_SELECT    6
+#define OPCODE_MOV       7
+#define OPCODE_SUPEROP   8
+#define OPCODE_MULT      9
+#define FNCODE_ACCUM_BLK 0
+#define FNCODE_ACCUM_ROW 1
+#define SCODE_CLRMBIT    0
+#define SCODE_FILLREG    1
+
+// Register states
+#define REGSTATE_UNKNOWN  0
+#define REGSTATE_ZERO     1		// all rows are 0
+#define REGSTATE_IMAGE    2		// content is in IMAGine_RegImage.row
+
+typedef struct {
+	int           state;
+	img_bramrow_t row[IMAGINE_BLKCOLCNT][IMAGINE_PEREGWIDTH];	// same in all blocks of a column
+} IMAGine_RegImage;
+
+static IMAGine_RegImage regImage[IMG_REGCOUNT];
+
+
+// Invalidates the image of a register, so that the next load clears it.
+// @param reg [in]  Register number, IMG_ALLREGS for all registers.
+void img_invalidateRegImage(int reg) {
+	if(reg == IMG_ALLREGS) {
+		for(int i=0; i<IMG_REGCOUNT; ++i) regImage[i].state = REGSTATE_UNKNOWN;
+	} else if(reg >= 0 && reg < IMG_REGCOUNT) {
+		regImage[reg].state = REGSTATE_UNKNOWN;
+	}
+}
+
+
+// Tells the driver that all registers are zero, so the next loads skip
+// the clear. Only call it when that is guaranteed, e.g. right after the
+// bitstream is loaded (the BRAMs are initialized to 0).
+void img_markRegsZero() {
+	for(int i=0; i<IMG_REGCOUNT; ++i) regImage[i].state = REGSTATE_ZERO;
+}
+
+
+// Invalidates the images of the registers an instruction may write.
+// Unknown instructions invalidate all the images. The instruction following
+// a REPEAT is tracked once for each of its dispatches. The data words of a
+// WRITE run are skipped.
+static
+void img_trackInstruction(uint32_t instr) {
+	static int      rptCount = 0;		// pending REPEAT for the next instruction
+	static uint32_t rptIncrement = 0;
+	static int      wrunWords = 0;		// data words of a WRITE run left to skip
+	if(wrunWords > 0) {
+		--wrunWords;
+		return;
+	}
+	if(rptCount > 0) {
+		const int count = rptCount;
+		rptCount = 0;
+		for(int i=0; i<count; ++i) img_trackInstruction(instr + i*rptIncrement);
+		return;
+	}
+	const uint32_t submCode = instr >> 30;
+	const uint32_t opcode   = (instr >> 26) & 0xF;
+	const uint32_t seg1     = (instr >> INSTR_DATA_WIDTH) & ((1u << INSTR_ADDR_WIDTH) - 1);
+	const uint32_t fncode   = seg1 >> INSTR_REG_WIDTH;
+	const int rd  = seg1 & ((1u << INSTR_REG_WIDTH) - 1);
+	const int rs1 = instr & ((1u << INSTR_REG_WIDTH) - 1);
+	const int rs2 = (instr >> INSTR_REG_WIDTH) & ((1u << INSTR_REG_WIDTH) - 1);
+	if(submCode == SUBM_VV) return;		// vector shift-register, no register access
+	if(submCode == SUBM_RPT && (instr & RPT_WRUN_BIT)) {
+		// [BASE:10] [xxx] [1] [MASK:16], a WRITE to BASE+i for each set bit i of MASK
+		const uint32_t base = (instr >> 20) & ((1u << INSTR_ADDR_WIDTH) - 1);
+		int rows = 0;
+		for(int i=0; i<16; ++i) {
+			if(!(instr & (1u << i))) continue;
+			img_invalidateRegImage((base + i) / IMAGINE_PEREGWIDTH);
+			++rows;
+		}
+		wrunWords = (rows + 1) / 2;		// two rows per data word
+		return;
+	}
+	if(submCode == SUBM_RPT) {
+		// [COUNT:8] [SHIFT:5] [x] [STRIDE:16]
+		rptCount = (instr >> 22) & 0xFF;
+		rptIncrement = (instr & 0xFFFF) << ((instr >> 17) & 0x1F);
+		return;
+	}
+	if(submCode != SUBM_MV) {
+		img_invalidateRegImage(IMG_ALLREGS);
+		return;
+	}
+	switch(opcode) {
+	case OPCODE_NOP:
+	case OPCODE_READ:
+	case OPCODE_SELECT:
+		break;
+	case OPCODE_WRITE:
+		img_invalidateRegImage(seg1 / IMAGINE_PEREGWIDTH);
+		break;
+	case OPCODE_ALUOP:
+		img_invalidateRegImage(rd);
+		break;
+	case OPCODE_UPDATEPP:
+	case OPCODE_MULT:
+		img_invalidateRegImage(rd);		// ppreg spans 2 registers
+		img_invalidateRegImage(rd+1);
+		break;
+	case OPCODE_ACCUM:
+		if(fncode == FNCODE_ACCUM_BLK) img_invalidateRegImage(rs2);		// destination in rs2
+		else if(fncode == FNCODE_ACCUM_ROW) img_invalidateRegImage(rs1);
+		else img_invalidateRegImage(IMG_ALLREGS);
+		break;
+	case OPCODE_MOV:
+		img_invalidateRegImage(rs2);	// destination in rs2
+		break;
+	case OPCODE_SUPEROP:
+		if((seg1 & ((1u << INSTR_SCODE_WIDTH) - 1)) == SCODE_FILLREG)
+			img_invalidateRegImage(seg1 >> INSTR_SCODE_WIDTH);	// [RD, S_CODE]
+		else if(seg1 != SCODE_CLRMBIT) img_invalidateRegImage(IMG_ALLREGS);
+		break;
+	default:
+		img_invalidateRegImage(IMG_ALLREGS);
+		break;
+	}
+}
+
+
+// Applies img_trackInstruction() to an array of instructions
+static
+void img_trackInstructions(const uint32_t *instr, const int size) {
+	for(int i=0; i<size; ++i) img_trackInstruction(instr[i]);
+}
+
+
+
+
+// ---- DMA instruction stream
+// AK-NOTE: The DMA engine (simple mode, MM2S) streams instructions into the
+// AXI-Stream port of the IP, which shares FIFO-in with the register path.
+// A DMA transfer must finish before instructions are pushed through the
+// registers, otherwise the two streams interleave. So, the register-path
+// push functions wait for any pending DMA transfer (see img_waitDMA()).
+static int img_pushInstrBurst(const uint32_t *instr, const int size);	// fallback of the DMA push
+
+#ifdef IMG_HAS_DMA
+static XAxiDma   dmaInst;
+static bool      dmaReady = false;			// DMA engine initialized
+static const uint32_t *dmaNextWord = NULL;	// start of the next chunk to send
+static int       dmaRemaining = 0;			// words not yet handed to the DMA
+static bool      dmaPending = false;		// a transfer is in flight or queued
+
+
+// Hands the next chunk of the pending instruction array to the DMA engine.
+// The buffer length register of the DMA limits the size of one transfer.
+static
+void img_startDMAChunk() {
+	const int maxWords = (int)(dmaInst.TxBdRing.MaxTransferLen / sizeof(uint32_t));
+	const int chunkLen = MIN(dmaRemaining, maxWords);
+	XAxiDma_SimpleTransfer(&dmaInst, (UINTPTR)dmaNextWord,
+			               chunkLen*sizeof(uint32_t), XAXIDMA_DMA_TO_DEVICE);
+	dmaNextWord  += chunkLen;
+	dmaRemaining -= chunkLen;
+}
+#endif
+
+
+// Initializes the DMA engine of the instruction stream.
+// @return  0 on success, -1 if the DMA is not available.
+int img_initDMA() {
+#ifdef IMG_HAS_DMA
+	XAxiDma_Config *cfg = XAxiDma_LookupConfig(XPAR_AXIDMA_0_DEVICE_ID);
+	if(!cfg || XAxiDma_CfgInitialize(&dmaInst, cfg) != XST_SUCCESS) {
+		print("img_initDMA: DMA initialization failed\n");
+		return -1;
+	}
+	if(XAxiDma_HasSg(&dmaInst)) {
+		print("img_initDMA: DMA must be configured in simple mode\n");
+		return -1;
+	}
+	// completion is polled, not interrupt driven
+	XAxiDma_IntrDisable(&dmaInst, XAXIDMA_IRQ_ALL_MASK, XAXIDMA_DMA_TO_DEVICE);
+	dmaReady = true;
+	return 0;
+#else
+	return -1;
+#endif
+}
+
+
+// Returns true if a DMA instruction transfer is still in progress.
+// Also advances a transfer that needs more than one DMA chunk, so this
+// should be polled while waiting for a long program.
+bool img_isDMABusy() {
+#ifdef IMG_HAS_DMA
+	if(!dmaPending) return false;
+	if(XAxiDma_Busy(&dmaInst, XAXIDMA_DMA_TO_DEVICE)) return true;
+	if(dmaRemaining > 0) {
+		img_startDMAChunk();
+		return true;
+	}
+	dmaPending = false;
+#endif
+	return false;
+}
+
+
+// Waits until the pending DMA instruction transfer completes.
+void img_waitDMA() {
+	while(img_isDMABusy());
+}
+
+
+// Hands an instruction array to the DMA engine and returns without waiting.
+// The array must stay valid and unmodified until img_isDMABusy() returns false.
+// Falls back to img_pushInstructions() (blocking) if the DMA is not available.
+// @param instr [in]  Array of instructions to push.
+// @param size  [in]  No. of instructions in the array.
+// @return  Number of instructions submitted.
+int img_pushInstructionsDMA(const uint32_t *instr, const int size) {
+	img_trackInstructions(instr, size);
+#ifdef IMG_HAS_DMA
+	if(dmaReady && size > 0) {
+		img_waitDMA();		// only one transfer in flight
+		// DMA reads from memory, make sure the array is not held in the cache
+		Xil_DCacheFlushRange((UINTPTR)instr, size*sizeof(uint32_t));
+		dmaNextWord  = instr;
+		dmaRemaining = size;
+		dmaPending   = true;
+		img_startDMAChunk();
+		return size;
+	}
+#endif
+	return img_pushInstrBurst(instr, size);
 }
 
 
@@ -179,6 +622,8 @@ void img_clearEovFlag() {
 // ---- User APIs
 // Pushes an instruction into the FIFO-in (waits if full)
 void img_pushInstruction(uint32_t instr) {
+	img_trackInstruction(instr);
+	img_waitDMA();	// keep the instruction order with DMA transfers
 	// wait if FIFO-in full
 	while(img_isFinpFull()) print("img_pushInstruction: FIFO-in full, waiting ...\n");
 	// write to FIFO-in data register
@@ -188,15 +633,388 @@ void img_pushInstruction(uint32_t instr) {
 }
 
 
+// Pushes a burst of instructions into the FIFO-in (waits if full).
+// The FIFO status is checked once per group of words that are
+// guaranteed to fit, then the group is written without further checks.
+// Used by the loaders of the driver, which keep the register images
+// up to date themselves.
+// @param instr [in]  Array of instructions to push.
+// @param size  [in]  No. of instructions in the array.
+// @return  Number of instructions pushed.
+static
+int img_pushInstrBurst(const uint32_t *instr, const int size) {
+	img_waitDMA();	// keep the instruction order with DMA transfers
+	int pushed = 0;
+	while(pushed < size) {
+		// wait until FIFO-in has some free space
+		int freeSlots = img_getFinpFreeSlots();
+		while(freeSlots == 0) {
+			print("img_pushInstructions: FIFO-in full, waiting ...\n");
+			freeSlots = img_getFinpFreeSlots();
+		}
+		// write the words that fit without checking the status again
+		const int burstLen = MIN(freeSlots, size-pushed);
+		for(int i=0; i<burstLen; ++i) {
+			img_writeFinpData(instr[pushed++]);
+			img_genFinpWrPulse();
+		}
+	}
+	return pushed;
+}
+
+
+// Pushes a burst of instructions into the FIFO-in (waits if full).
+// @param instr [in]  Array of instructions to push.
+// @param size  [in]  No. of instructions in the array.
+// @return  Number of instructions pushed.
+int img_pushInstructions(const uint32_t *instr, const int size) {
+	img_trackInstructions(instr, size);
+	return img_pushInstrBurst(instr, size);
+}
+
+
+// Pushes as many instructions as FIFO-in can take right now, without waiting.
+// @param instr [in]  Array of instructions to push.
+// @param size  [in]  No. of instructions in the array.
+// @return  Number of instructions pushed (can be 0).
+int img_tryPushInstructions(const uint32_t *instr, const int size) {
+	if(img_isDMABusy()) return 0;	// keep the instruction order with DMA transfers
+	const int freeSlots = img_getFinpFreeSlots();	// MIN() evaluates its arguments twice
+	const int burstLen = MIN(freeSlots, size);
+	img_trackInstructions(instr, burstLen);
+	for(int i=0; i<burstLen; ++i) {
+		img_writeFinpData(instr[i]);
+		img_genFinpWrPulse();
+	}
+	return burstLen;
+}
+
+
+
+
+
+// ---- Kernel cache
+// AK-NOTE: The IP keeps an instruction memory in front of the dispatch unit.
+// A kernel is pushed once with a KLOAD instruction and launched later with a
+// single KRUN instruction, which saves the FIFO-in traffic of repeated
+// kernels. The driver allocates the cache space sequentially; the cache can
+// only be emptied as a whole with img_clearCache(). The driver keeps a
+// reference to the cached instructions to keep the register images up to
+// date on each run, so the array must stay valid while the kernel is cached.
+typedef struct {
+	const uint32_t *instr;
+	int size;
+	int base;
+} IMAGine_CachedKernel;
+
+static IMAGine_CachedKernel cachedKernel[IMG_KCACHE_MAXKERNELS];
+static int cachedKernelCount = 0;
+static int kcacheUsed = 0;		// no. of cache entries taken
+
+
+// Stores a kernel in the kernel cache of the IP.
+// The kernel must not contain kernel cache instructions. The data words of
+// a WRITE run are not instructions, they may hold any value.
+// @param instr [in]  Array of instructions of the kernel.
+// @param size  [in]  No. of instructions in the array.
+// @return  ID of the cached kernel (used with img_runCached()),
+//          -1 if the kernel does not fit in the cache.
+int img_cacheInstructions(const uint32_t *instr, const int size) {
+	if(size <= 0 || cachedKernelCount >= IMG_KCACHE_MAXKERNELS
+	   || kcacheUsed + size > KCACHE_DEPTH) {
+		print("img_cacheInstructions: kernel cache full\n");
+		return -1;
+	}
+	for(int i=0; i<size; ++i) {
+		if((instr[i] >> 30) == SUBM_RPT && (instr[i] & RPT_WRUN_BIT)) {
+			i += (__builtin_popcount(instr[i] & 0xFFFF) + 1) / 2;	// skip the data words
+		} else if((instr[i] >> 30) == SUBM_KC) {
+			print("img_cacheInstructions: kernel cache instructions can't be cached\n");
+			return -1;
+		}
+	}
+	const int kernelID = cachedKernelCount++;
+	cachedKernel[kernelID].instr = instr;
+	cachedKernel[kernelID].size  = size;
+	cachedKernel[kernelID].base  = kcacheUsed;
+	kcacheUsed += size;
+	// the instructions are only stored, the register images don't change
+	const uint32_t kload = img_genKC_KLOAD(kernelID, size, cachedKernel[kernelID].base);
+	img_pushInstrBurst(&kload, 1);
+	img_pushInstrBurst(instr, size);
+	return kernelID;
+}
+
+
+// Launches a cached kernel with a single instruction (waits if FIFO-in full).
+// @param kernelID [in]  ID returned by img_cacheInstructions().
+// @return  0 on success, -1 if the ID is not a cached kernel.
+int img_runCached(int kernelID) {
+	if(kernelID < 0 || kernelID >= cachedKernelCount) return -1;
+	img_trackInstructions(cachedKernel[kernelID].instr, cachedKernel[kernelID].size);
+	const uint32_t krun = img_genKC_KRUN(kernelID);
+	img_pushInstrBurst(&krun, 1);
+	return 0;
+}
+
+
+// Forgets all cached kernels; the next img_cacheInstructions() starts
+// from an empty cache. The IP needs no instruction for it, the old
+// kernels are overwritten by the next loads.
+void img_clearCache() {
+	cachedKernelCount = 0;
+	kcacheUsed = 0;
+}
+
+
+
+
+// Enables/disables the FIFO auto-strobe mode of the IP.
+// In auto-strobe mode, a write to the FIFO-in data register pushes the
+// word into FIFO-in, and a read of the FIFO-out data register pops the
+// word from FIFO-out. So, no separate pulse generation is needed.
+// @param enable [in]  true: enable auto-strobe, false: use pulse generators.
+void img_setAutoStrobe(bool enable) {
+	const uint32_t modeBits = BIT_FINP_AUTOWR | BIT_FOUT_AUTORD;
+	if(enable) fifoCtrlShadow |= modeBits;
+	else       fifoCtrlShadow &= ~modeBits;
+	img_syncFifoCtrl();
+}
+
+
+// Enables/disables the packed FIFO-out mode of the IP.
+// In packed mode, each FIFO-out word holds two consecutive data, {second, first},
+// and carries no attribute bits. An unpaired last datum of a vector is padded
+// with 0 in the upper half. Only change the mode while no output is pending.
+// @param enable [in]  true: two data per word, false: one datum and attributes per word.
+void img_setPackedOutput(bool enable) {
+	if(enable) fifoCtrlShadow |= BIT_FOUT_PACK;
+	else       fifoCtrlShadow &= ~BIT_FOUT_PACK;
+	img_syncFifoCtrl();
+}
+
+
 // Returns true if IMAGine eovInterrupt is set (Alias to img_EovSet())
 bool img_isEOV() {
 	return img_isEovSet();
 }
 
 
-// Clears the eovInterrupt flag
+// Enables/disables the EOV interrupt request line of the IP.
+// Called from the ISR; the main thread must hold IMG_IRQ_LOCK().
+static inline
+void img_setEovIrqEnable(bool enable) {
+	if(enable) imgCtrlShadow |= BIT_IMG_EOVIE;
+	else       imgCtrlShadow &= ~BIT_IMG_EOVIE;
+	writeImgReg(REG2, imgCtrlShadow);
+}
+
+
+// ---- EOV interrupt
+// AK-NOTE: The IRQ line is level-sensitive and stays high until the EOV flag
+// is cleared. On bare-metal, the ISR masks the line in the IP (reg2 EOVIE)
+// and img_clearEOV() unmasks it. Under UIO, the kernel masks the line and
+// img_clearEOV() unmasks it by writing to the UIO fd.
+static img_eovCallback_t eovCallback = NULL;
+static void             *eovCallbackArg = NULL;
+static volatile bool     eovNotified = false;	// set by the ISR
+static bool              eovIrqReady = false;	// interrupt path initialized
+
+#if defined(IMG_USE_UIO)
+// Unmasks the interrupt of the UIO device (re-arms it for the next event)
+static
+int img_uioUnmask() {
+	const uint32_t unmask = 1;
+	return write(devFd, &unmask, sizeof(unmask)) == sizeof(unmask) ? 0 : -1;
+}
+
+
+// Consumes the pending event of the UIO device, if any, without waiting
+static
+void img_uioDrain() {
+	struct pollfd pfd = { .fd = devFd, .events = POLLIN };
+	uint32_t irqCount;
+	if(poll(&pfd, 1, 0) > 0 && read(devFd, &irqCount, sizeof(irqCount)) != sizeof(irqCount))
+		print("img_clearEOV: could not read the UIO event\n");
+}
+#endif
+
+
+// Returns the time of a monotonic clock in microseconds, for the timeouts
+static
+uint64_t img_nowUs() {
+#if IMG_REG_TARGET == IMG_BACKEND_MMIO
+	XTime now;
+	XTime_GetTime(&now);
+	return now / (COUNTS_PER_SECOND / 1000000);
+#else
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (uint64_t)now.tv_sec*1000000u + now.tv_nsec/1000;
+#endif
+}
+
+
+#if defined(IMG_HAS_EOVIRQ)
+static XScuGic gicInst;
+
+
+// EOV interrupt service routine
+static
+void img_eovIsr(void *arg) {
+	(void)arg;
+	img_setEovIrqEnable(false);		// level interrupt, mask until cleared
+	eovNotified = true;
+	if(eovCallback) eovCallback(eovCallbackArg);
+}
+#endif
+
+
+// Initializes the EOV interrupt path.
+// @return  0 on success, -1 if the interrupt is not available.
+//          img_waitEOV() falls back to polling in that case.
+int img_initEOVInterrupt() {
+#if defined(IMG_USE_UIO)
+	// only a UIO device delivers interrupts; writing to /dev/mem or a
+	// fake register window would corrupt it, so those keep polling
+	if(devFd < 0 || strncmp(IMG_UIO_DEVICE, "/dev/uio", 8) != 0) return -1;
+	if(img_uioUnmask() != 0) {
+		print("img_initEOVInterrupt: could not unmask the UIO interrupt\n");
+		return -1;
+	}
+	img_setEovIrqEnable(true);
+	eovIrqReady = true;
+	return 0;
+#elif defined(IMG_HAS_EOVIRQ)
+	XScuGic_Config *cfg = XScuGic_LookupConfig(XPAR_SCUGIC_SINGLE_DEVICE_ID);
+	if(!cfg || XScuGic_CfgInitialize(&gicInst, cfg, cfg->CpuBaseAddress) != XST_SUCCESS) {
+		print("img_initEOVInterrupt: GIC initialization failed\n");
+		return -1;
+	}
+	Xil_ExceptionRegisterHandler(XIL_EXCEPTION_ID_INT,
+			(Xil_ExceptionHandler)XScuGic_InterruptHandler, &gicInst);
+	const uint32_t intrId = XPAR_FABRIC_IMAGINE_GEMV_0_EOV_IRQ_INTR;
+	XScuGic_SetPriorityTriggerType(&gicInst, intrId, 0xA0, 0x1);	// level, active high
+	XScuGic_Connect(&gicInst, intrId, (Xil_InterruptHandler)img_eovIsr, NULL);
+	XScuGic_Enable(&gicInst, intrId);
+	IMG_IRQ_LOCK();
+	img_setEovIrqEnable(true);
+	IMG_IRQ_UNLOCK();		// also enables the exceptions
+	eovIrqReady = true;
+	return 0;
+#else
+	return -1;
+#endif
+}
+
+
+// Registers a function to be called when the EOV interrupt fires.
+// On bare-metal, the callback runs in the interrupt context, so keep it short.
+// Under UIO, it runs from img_waitEOV() once the interrupt is received.
+// @param callback [in]  Function to call, NULL to unregister.
+// @param arg      [in]  Argument passed to the callback.
+void img_setEOVCallback(img_eovCallback_t callback, void *arg) {
+	eovCallback = callback;
+	eovCallbackArg = arg;
+}
+
+
+// Waits until the eovInterrupt flag is set, or the timeout expires.
+// Sleeps the core while waiting if the interrupt path is initialized
+// (see img_initEOVInterrupt()), otherwise polls the status register.
+// AK-NOTE: On bare-metal, only IMG_WAIT_FOREVER sleeps with WFI, because no
+// timer interrupt is set up to wake the core. With a finite timeout the
+// core spins on the ISR flag, which does not generate bus traffic.
+// @param timeoutUs [in]  Timeout in microseconds, or IMG_WAIT_FOREVER.
+// @return  0 if EOV is set, -1 on timeout.
+int img_waitEOV(uint32_t timeoutUs) {
+	if(img_isEovSet()) return 0;
+	if(!eovIrqReady) {
+		// no interrupt path, poll the status register
+		const uint64_t start = img_nowUs();
+		do {
+			if(img_isEovSet()) return 0;
+		} while(timeoutUs == IMG_WAIT_FOREVER || img_nowUs() - start < timeoutUs);
+		return img_isEovSet() ? 0 : -1;
+	}
+#if defined(IMG_USE_UIO)
+	// AK-NOTE: An event only completes the wait if the flag is set. An event
+	// without the flag (e.g. raised for an EOV that was cleared in the
+	// meantime) is consumed, the interrupt is re-armed and the wait goes on
+	// for the remaining time.
+	const uint64_t start = img_nowUs();
+	for(;;) {
+		int timeoutMs = -1;
+		if(timeoutUs != IMG_WAIT_FOREVER) {
+			const uint64_t elapsedUs = img_nowUs() - start;
+			if(elapsedUs >= timeoutUs) return img_isEovSet() ? 0 : -1;
+			timeoutMs = (int)((timeoutUs - elapsedUs + 999) / 1000);
+		}
+		struct pollfd pfd = { .fd = devFd, .events = POLLIN };
+		const int ready = poll(&pfd, 1, timeoutMs);
+		if(ready < 0 && errno != EINTR) return img_isEovSet() ? 0 : -1;
+		if(ready <= 0) continue;	// timeout or signal, checked above
+		uint32_t irqCount;
+		if(read(devFd, &irqCount, sizeof(irqCount)) != sizeof(irqCount))	// acknowledge the event
+			return img_isEovSet() ? 0 : -1;
+		if(img_isEovSet()) {
+			if(eovCallback) eovCallback(eovCallbackArg);
+			return 0;
+		}
+		if(img_uioUnmask() != 0) return -1;
+	}
+#elif defined(IMG_HAS_EOVIRQ)
+	if(timeoutUs == IMG_WAIT_FOREVER) {
+		// Check and sleep with the interrupts masked, so an interrupt between
+		// the check and WFI is not missed; a pending interrupt still wakes WFI.
+		for(;;) {
+			Xil_ExceptionDisable();
+			if(eovNotified) break;
+			__asm__ volatile("wfi");
+			Xil_ExceptionEnable();
+		}
+		Xil_ExceptionEnable();
+		return 0;
+	}
+	XTime start, now;
+	XTime_GetTime(&start);
+	const XTime timeoutTicks = (XTime)timeoutUs * (COUNTS_PER_SECOND / 1000000);
+	do {
+		if(eovNotified) return 0;
+		XTime_GetTime(&now);
+	} while(now - start < timeoutTicks);
+	return eovNotified ? 0 : -1;
+#else
+	return -1;
+#endif
+}
+
+
+// Clears the eovInterrupt flag, and returns once the status register reads
+// it clear, so a following img_isEOV() does not see the old flag.
+// With the interrupt path, also re-arms the interrupt for the next vector.
+// Under UIO, the event of the cleared EOV is consumed if it was not waited
+// for (e.g. the flag was seen by img_isEOV()), so it can't end the next wait.
+// AK-NOTE: The IP brings the flag to the AXI clock through a 2-flop
+// synchronizer, so it reads set for a few AXI clocks after the clear. The
+// wait is bounded: a flag still set after IMG_EOV_CLEAR_POLLS reads is the
+// EOV of a new vector. The interrupt is re-armed after the wait, so the old
+// flag can't raise it again.
 void img_clearEOV() {
 	img_clearEovFlag();
+	for(int i=0; i<IMG_EOV_CLEAR_POLLS && img_isEovSet(); ++i);
+	if(eovIrqReady) {
+		eovNotified = false;
+#if defined(IMG_USE_UIO)
+		img_uioDrain();		// after the clear, no new event for the old EOV
+		if(img_uioUnmask() != 0)
+			print("img_clearEOV: could not unmask the UIO interrupt\n");
+#else
+		IMG_IRQ_LOCK();
+		img_setEovIrqEnable(true);
+		IMG_IRQ_UNLOCK();
+#endif
+	}
 }
 
 
@@ -220,12 +1038,39 @@ IMAGine_Dout img_popData() {
 }
 
 
+// Pops up to size data from the FIFO-out into buff.
+// The FIFO fill-level is read once per group of words that are
+// guaranteed to be valid, then the group is read without further status checks.
+// @param buff [out]  Output buffer.
+// @param size [in]   Max no. of data to pop.
+// @return  Number of data popped.
+int img_popDataBurst(img_vecval_t *buff, const int size) {
+	int popped = 0;
+	while(popped < size) {
+		int fillLevel = img_getFoutFillLevel();
+		if(fillLevel == 0) {
+			// fill-level lags behind the valid flag by a few cycles
+			if(!img_isFoutValid()) break;
+			fillLevel = 1;
+		}
+		const int burstLen = MIN(fillLevel, size-popped);
+		for(int i=0; i<burstLen; ++i) {
+			uint32_t foutData = img_readFoutData();
+			img_genFoutRdPulse();
+			buff[popped++] = (int16_t)(foutData & 0xFFFF);	 // only lower 16-bits hold the data
+		}
+	}
+	return popped;
+}
+
+
 // Performs a basic test on IMAGine based on magic number.
 // @return  -ve on failure.
 int img_test() {
 	// This test reads the 64-bit magic number from reg14, reg15.
 	// When printed as ASCII string, this should say "IMAGine".
 	print("INFO: Running Magic Number test.\n");
+	img_syncFifoCtrl();		// first access on bare-metal, see fifoCtrlShadow
 	uint32_t magic[3] = {0};	  // space for one extra character for null-termination
 	magic[0] = readImgReg(REG14);
 	magic[1] = readImgReg(REG15);
@@ -247,22 +1092,241 @@ int img_test() {
 }
 
 
+// Generates the instructions to clear a GEMV register.
+// @param instr [out]  Instruction buffer, IMG_CLRREG_INSTRCOUNT words.
+// @param reg   [in]   Register number.
+// @return  Number of instructions generated.
+#define IMG_CLRREG_INSTRCOUNT  2
+static
+int img_genClrReg(uint32_t *instr, int reg) {
+	instr[0] = img_genMV_SELECT_ALL();			// Select all Blocks
+	instr[1] = img_genMV_FILLREG(reg, 0);		// write zeros to all register rows
+	return IMG_CLRREG_INSTRCOUNT;
+}
+
+
+// Generates the instructions to write one slice (one BRAM image) of a vector
+// or matrix into a cleared GEMV register. Only the non-zero rows are written,
+// the select instruction is only emitted if there is a non-zero row.
+// @param instr     [out]  Instruction buffer, IMAGINE_PEREGWIDTH+1 words.
+// @param selInstr  [in]   Instruction selecting the BRAM block(s) of the slice.
+// @param base      [in]   Base address of the register.
+// @param slice     [in]   Vector slice.
+// @param sliceLen  [in]   Slice length, <= IMAGINE_PEPERBLOCK.
+// @return  Number of instructions generated. -ve value is error code.
+static
+int img_genLoadSlice(uint32_t *instr,
+					 const uint32_t selInstr,
+					 const img_bramaddr_t base,
+					 const img_vecval_t *slice,
+					 const int sliceLen)
+{
+	img_bramrow_t bramImage[IMAGINE_PEREGWIDTH];	// BRAM image of the slice
+	const int nzCount = img_makePe2BramBlock(bramImage, slice, sliceLen);
+	if(nzCount <= 0) return nzCount;	// error, or nothing to write
+	int instCount = 0;
+	instr[instCount++] = selInstr;		// select the BRAM block(s)
+	for(int r=0; r<IMAGINE_PEREGWIDTH; ++r) {
+		if(bramImage[r] != 0) instr[instCount++] = img_genMV_WRITE(base+r, bramImage[r]);
+	}
+	return instCount;
+}
+
+
+// Generates the instructions to turn one BRAM image into another. Only the
+// rows that differ are written, the select instruction is only emitted if
+// there is such a row.
+// @param instr    [out]  Instruction buffer, IMAGINE_PEREGWIDTH+1 words.
+// @param selInstr [in]   Instruction selecting the BRAM block(s) of the image.
+// @param base     [in]   Base address of the register.
+// @param newImage [in]   BRAM image to write.
+// @param oldImage [in]   Current BRAM image.
+// @return  Number of instructions generated.
+static
+int img_genWriteDelta(uint32_t *instr,
+					  const uint32_t selInstr,
+					  const img_bramaddr_t base,
+					  const img_bramrow_t *newImage,
+					  const img_bramrow_t *oldImage)
+{
+	int instCount = 0;
+	for(int r=0; r<IMAGINE_PEREGWIDTH; ++r) {
+		if(newImage[r] == oldImage[r]) continue;
+		if(instCount == 0) instr[instCount++] = selInstr;	// select the BRAM block(s)
+		instr[instCount++] = img_genMV_WRITE(base+r, newImage[r]);
+	}
+	return instCount;
+}
+
+
+// qsort() comparator of BRAM rows
+static
+int img_cmpBramRow(const void *a, const void *b) {
+	return (int)*(const img_bramrow_t *)a - (int)*(const img_bramrow_t *)b;
+}
+
+
+// Pushes the instructions writing the BRAM images of the selectable units
+// (block columns or blocks) of a cleared register. The value shared by most
+// units in each row is written once to all blocks using SELECT_ALL, then
+// only the units that differ are written, if that takes fewer instructions.
+// Same as gemv_genLoadImages() of the assembler.
+// @param base      [in]  Base address of the register.
+// @param images    [in]  BRAM images of all units of the PiCaSO array.
+// @param unitCount [in]  No. of units, <= IMAGINE_BLKROWCNT*IMAGINE_BLKCOLCNT.
+// @param byBlock   [in]  true: units are blocks (row-major), false: block columns.
+// @return  Number of instructions pushed.
+static
+int img_loadImages(const img_bramaddr_t base,
+				   const img_bramrow_t (*images)[IMAGINE_PEREGWIDTH],
+				   const int unitCount,
+				   const bool byBlock)
+{
+	static img_bramrow_t values[IMAGINE_BLKROWCNT*IMAGINE_BLKCOLCNT];	// one row of all units
+	img_bramrow_t bcast[IMAGINE_PEREGWIDTH];	// broadcast image
+	uint32_t instrBuff[IMAGINE_PEREGWIDTH+1];	// instructions of one unit, pushed as a burst
+	int bcastCount = 1;		// SELECT_ALL + writes of the broadcast image
+	int plainCount = 0;		// instructions without the broadcast
+	int fixCount   = 0;		// instructions fixing the units after the broadcast
+	// broadcast image: most common value of each row (ties: the smaller value)
+	for(int r=0; r<IMAGINE_PEREGWIDTH; ++r) {
+		for(int u=0; u<unitCount; ++u) values[u] = images[u][r];
+		qsort(values, unitCount, sizeof(values[0]), img_cmpBramRow);
+		int bestCount = 0;
+		for(int u=0, runLen=1; u<unitCount; ++u, ++runLen) {
+			if(u+1 < unitCount && values[u+1] == values[u]) continue;
+			if(runLen > bestCount) {
+				bestCount = runLen;
+				bcast[r] = values[u];
+			}
+			runLen = 0;
+		}
+		if(bcast[r] != 0) ++bcastCount;
+	}
+	for(int u=0; u<unitCount; ++u) {
+		int nzCount = 0, diffCount = 0;
+		for(int r=0; r<IMAGINE_PEREGWIDTH; ++r) {
+			if(images[u][r] != 0) ++nzCount;
+			if(images[u][r] != bcast[r]) ++diffCount;
+		}
+		if(nzCount > 0) plainCount += 1 + nzCount;
+		if(diffCount > 0) fixCount += 1 + diffCount;
+	}
+	static const img_bramrow_t zeroImage[IMAGINE_PEREGWIDTH] = {0};
+	const img_bramrow_t *baseImage = zeroImage;
+	int instCount = 0;
+	if(bcastCount > 1 && bcastCount + fixCount < plainCount) {
+		int n = img_genWriteDelta(instrBuff, img_genMV_SELECT_ALL(), base, bcast, zeroImage);
+		instCount += img_pushInstrBurst(instrBuff, n);
+		baseImage = bcast;
+	}
+	for(int u=0; u<unitCount; ++u) {
+		const uint32_t selInstr = byBlock ? img_genMV_SELECT_BLOCK(u / IMAGINE_BLKCOLCNT, u % IMAGINE_BLKCOLCNT)
+										  : img_genMV_SELECT_COL(u);
+		int n = img_genWriteDelta(instrBuff, selInstr, base, images[u], baseImage);
+		instCount += img_pushInstrBurst(instrBuff, n);
+	}
+	return instCount;
+}
+
+
+// Generates the instructions of img_mv_LOADVEC_ROW() into a buffer
+// instead of pushing them into FIFO-in.
+// @param instr  [out]  Instruction buffer.
+// @param maxLen [in]   Size of the instruction buffer, see IMG_LOADVEC_MAXINSTR().
+// @param reg    [in]   Destination register.
+// @param vector [in]   Vector to load.
+// @param size   [in]   Vector size.
+// @return  Number of instructions generated. -ve value is error code.
+int img_genMV_LOADVEC_ROW(uint32_t *instr, const int maxLen,
+						  const int reg,
+						  const img_vecval_t *vector,
+						  const int size)
+{
+	static const int peCount = IMAGINE_PEPERBLOCK;		// PE column per BRAM block
+	const img_bramaddr_t base = reg*IMAGINE_PEREGWIDTH;	// PE register base address
+	if(maxLen < IMG_CLRREG_INSTRCOUNT) return -1;
+	int instCount = img_genClrReg(instr, reg);			// clear the register
+	int bramIndex = 0;
+	for(int i=0; i<size; i+=peCount, ++bramIndex) {
+		if(maxLen - instCount < IMAGINE_PEREGWIDTH+1) return -1;	// buffer too small
+		const int sliceLen = MIN(peCount, size-i);		// MIN() required for the last slice
+		const int n = img_genLoadSlice(&instr[instCount], img_genMV_SELECT_COL(bramIndex),
+									   base, &vector[i], sliceLen);
+		if(n < 0) return -1;	// bramImage generation error
+		instCount += n;
+	}
+	return instCount;
+}
+
+
 // Clears the specified GEMV register.
+// Nothing is pushed if the register is known to be zero.
 // @param reg [in]  Register number.
 // @return  Number of instructions pushed.
 //          -ve return value on error.
 int img_mv_CLRREG(int reg) {
-	img_bramaddr_t base = reg*IMAGINE_PEREGWIDTH; 	// PE register base address
-	img_pushInstruction(img_genMV_SELECT_ALL());	// Select all Blocks
-	for(int i=0; i<IMAGINE_PEREGWIDTH; ++i) {
-		img_pushInstruction(img_genMV_WRITE(base++, 0));  // write zeros to all register rows
+	uint32_t instrBuff[IMG_CLRREG_INSTRCOUNT];		// instructions are pushed as a single burst
+	if(reg < 0 || reg >= IMG_REGCOUNT) return -1;
+	if(regImage[reg].state == REGSTATE_ZERO) return 0;	// nothing to clear
+	const int instCount = img_genClrReg(instrBuff, reg);
+	regImage[reg].state = REGSTATE_ZERO;
+	return img_pushInstrBurst(instrBuff, instCount);	// no. of instructions pushed
+}
+
+
+#if defined(IMG_SIMD_NEON) || defined(IMG_SIMD_AVX2) || defined(IMG_SIMD_SSE2)
+// Transposes a 16x16 bit-matrix: bit b of peArr[p] goes to bit p of outArr[b].
+// @param outArr [out]  16 BRAM rows.
+// @param peArr  [in]   16 PE registers.
+static inline
+void img_transpose16x16(img_bramrow_t *outArr, const img_vecval_t *peArr) {
+#if defined(IMG_SIMD_NEON)
+	// Test bit b in all lanes, weight each lane by its PE bit and add them up.
+	static const uint16_t laneBit[8] = {1, 2, 4, 8, 16, 32, 64, 128};
+	const uint16x8_t weight = vld1q_u16(laneBit);
+	const uint16x8_t peLo = vld1q_u16((const uint16_t *)peArr);		// PE 0-7
+	const uint16x8_t peHi = vld1q_u16((const uint16_t *)peArr + 8);	// PE 8-15
+	for(int bitNo=0; bitNo<16; ++bitNo) {
+		const uint16x8_t bitMask = vdupq_n_u16((uint16_t)(1u << bitNo));
+		const uint16_t rowLo = vaddvq_u16(vandq_u16(vtstq_u16(peLo, bitMask), weight));
+		const uint16_t rowHi = vaddvq_u16(vandq_u16(vtstq_u16(peHi, bitMask), weight));
+		outArr[bitNo] = rowLo | (rowHi << 8);
+	}
+#else
+	// Split the PE registers into a low-byte plane and a high-byte plane, then
+	// collect the MSB of every byte with movemask, one bit position at a time.
+	// AK-NOTE: Shifting 16-bit lanes left moves the bits of each byte towards
+	// its MSB without mixing the bytes at the MSB positions.
+	const __m128i peLo = _mm_loadu_si128((const __m128i *)peArr);			// PE 0-7
+	const __m128i peHi = _mm_loadu_si128((const __m128i *)(peArr + 8));	// PE 8-15
+	const __m128i lowByte = _mm_set1_epi16(0x00FF);
+	__m128i planeLo = _mm_packus_epi16(_mm_and_si128(peLo, lowByte), _mm_and_si128(peHi, lowByte));
+	__m128i planeHi = _mm_packus_epi16(_mm_srli_epi16(peLo, 8), _mm_srli_epi16(peHi, 8));
+#if defined(IMG_SIMD_AVX2)
+	__m256i planes = _mm256_inserti128_si256(_mm256_castsi128_si256(planeLo), planeHi, 1);
+	for(int bitNo=7; bitNo>=0; --bitNo) {
+		const uint32_t msbs = (uint32_t)_mm256_movemask_epi8(planes);
+		outArr[bitNo]   = (img_bramrow_t)(msbs & 0xFFFF);	// from the low-byte plane
+		outArr[bitNo+8] = (img_bramrow_t)(msbs >> 16);		// from the high-byte plane
+		planes = _mm256_slli_epi16(planes, 1);
 	}
-	return IMAGINE_PEREGWIDTH+1;	// no. of instructions pushed
+#else
+	for(int bitNo=7; bitNo>=0; --bitNo) {
+		outArr[bitNo]   = (img_bramrow_t)_mm_movemask_epi8(planeLo);
+		outArr[bitNo+8] = (img_bramrow_t)_mm_movemask_epi8(planeHi);
+		planeLo = _mm_slli_epi16(planeLo, 1);
+		planeHi = _mm_slli_epi16(planeHi, 1);
+	}
+#endif
+#endif
 }
+#endif
 
 
 // Given an array size <= to the no. of PEs in a block,
 // returns a bit-level transposed array (columnar layout).
+// Uses a SIMD kernel for 16x16 blocks when the target has one.
 // @param outArr [out]  output buffer to put BRAM rows.
 // @param peArr  [in]   input array of PE registers.
 // @param size   [in]   size of peArr.
@@ -276,6 +1340,18 @@ int img_makePe2BramBlock(
     static const int regWidth = IMAGINE_PEREGWIDTH;      // PE register width
     if(size > peCount) return -1;
     int nzCount = 0;        // no. of non-zero rows
+#if defined(IMG_SIMD_NEON) || defined(IMG_SIMD_AVX2) || defined(IMG_SIMD_SSE2)
+    img_vecval_t padded[IMAGINE_PEPERBLOCK];
+    if(size < peCount) {
+    	// the kernel always reads a full block, pad the missing PEs with 0s
+    	for(int peNo=0; peNo<peCount; ++peNo) padded[peNo] = peNo < size ? peArr[peNo] : 0;
+    	peArr = padded;
+    }
+    img_transpose16x16(outArr, peArr);
+    for(int bitNo=0; bitNo<regWidth; ++bitNo) {
+    	if(outArr[bitNo] != 0) ++nzCount;   // count non-zero rows
+    }
+#else
     for(int bitNo=0; bitNo<regWidth; ++bitNo) {
     	img_bramrow_t row = 0;
         for(int peNo=0; peNo<size; ++peNo) {
@@ -285,11 +1361,16 @@ int img_makePe2BramBlock(
         outArr[bitNo] = row;      // put the row into the output array
         if(row != 0) ++nzCount;   // count non-zero rows
     }
+#endif
     return nzCount;
 }
 
 
 // Loads a row vector into IMAGine GEMV register.
+// If the driver knows the current content of the register (see
+// img_invalidateRegImage()), only the BRAM rows that change are written.
+// Otherwise, the register is cleared and the non-zero rows are written;
+// rows shared by most block columns are written once to all of them.
 // @param reg    [in]  Destination register no.
 // @param vector [in]  Pointer to the row vector to load into
 //                     the register.
@@ -301,27 +1382,55 @@ int img_mv_LOADVEC_ROW(const int reg,
 					   const int size)
 {
     static const int peCount  = IMAGINE_PEPERBLOCK;      // PE column per BRAM block
-    static const int regWidth = IMAGINE_PEREGWIDTH;      // PE register width
     const img_bramaddr_t base = reg*IMAGINE_PEREGWIDTH;  // PE register base address
-    img_bramrow_t bramImage[IMAGINE_PEREGWIDTH];		 // buffer to hold BRAM image of one register
+    const int colCount = (size+peCount-1)/peCount;       // BRAM columns of the vector
+    img_bramrow_t bramImage[IMAGINE_BLKCOLCNT][IMAGINE_PEREGWIDTH];	 // new image, unused columns are 0
+    uint32_t instrBuff[IMAGINE_PEREGWIDTH+1];			 // instructions of one slice, pushed as a burst
+    if(reg < 0 || reg >= IMG_REGCOUNT) return -1;
+    IMAGine_RegImage *image = &regImage[reg];
     // Steps:
-    //	 - clear the register
+    //	 - clear the register, unless its content is known
     //   - go through each set of peCount of the array
     //   - get the BRAM image
-    //   - write the BRAM rows of the destination register
-    int bramIndex = 0;
+    //   - write the BRAM rows that differ from the current content
     int instCount = 0;	// No. of instructions pushed
-    instCount = img_mv_CLRREG(reg);		// clear the register
-    for(int i=0; i<size; i+=peCount, ++bramIndex) {
-      int sliceLen = MIN(peCount, size-i);	// MIN() required for the last slice
-    	int nzCount = img_makePe2BramBlock(bramImage, &vector[i], sliceLen);  // get BRAM image
-    	if(nzCount < 0) return -1;	// bramImage generation error
-    	if(nzCount > 0) {
-    		img_pushInstruction(img_genMV_SELECT_COL(bramIndex));  // select the BRAM column
-    		++instCount;
-    		instCount += img_writeBramNZrows(base, bramImage, regWidth);
+    if(image->state == REGSTATE_UNKNOWN || colCount > IMAGINE_BLKCOLCNT)
+    	instCount = img_mv_CLRREG(reg);		// clear the register, it is all zeros
+    if(colCount > IMAGINE_BLKCOLCNT) {
+    	// wider than the register images, write the slices without tracking
+    	int bramIndex = 0;
+    	for(int i=0; i<size; i+=peCount, ++bramIndex) {
+    		int sliceLen = MIN(peCount, size-i);	// MIN() required for the last slice
+    		int n = img_genLoadSlice(instrBuff, img_genMV_SELECT_COL(bramIndex), base, &vector[i], sliceLen);
+    		if(n < 0) return -1;	// bramImage generation error
+    		instCount += img_pushInstrBurst(instrBuff, n);
+    	}
+    	image->state = REGSTATE_UNKNOWN;
+    	return instCount;
+    }
+    int nzCount = 0;	// No. of non-zero rows in the new image
+    for(int bramIndex=0; bramIndex<IMAGINE_BLKCOLCNT; ++bramIndex) {
+    	const int i = bramIndex*peCount;
+    	int sliceLen = MAX(0, MIN(peCount, size-i));	// 0 for the unused columns
+    	const img_vecval_t *slice = sliceLen > 0 ? &vector[i] : vector;
+    	int n = img_makePe2BramBlock(bramImage[bramIndex], slice, sliceLen);
+    	if(n < 0) return -1;	// bramImage generation error
+    	nzCount += n;
+    }
+    if(image->state == REGSTATE_ZERO) {
+    	instCount += img_loadImages(base, (const img_bramrow_t (*)[IMAGINE_PEREGWIDTH])bramImage,
+    								IMAGINE_BLKCOLCNT, false);
+    } else {
+    	for(int bramIndex=0; bramIndex<IMAGINE_BLKCOLCNT; ++bramIndex) {
+    		int n = img_genWriteDelta(instrBuff, img_genMV_SELECT_COL(bramIndex), base,
+    								  bramImage[bramIndex], image->row[bramIndex]);
+    		instCount += img_pushInstrBurst(instrBuff, n);
     	}
     }
+    for(int bramIndex=0; bramIndex<IMAGINE_BLKCOLCNT; ++bramIndex) {
+    	for(int r=0; r<IMAGINE_PEREGWIDTH; ++r) image->row[bramIndex][r] = bramImage[bramIndex][r];
+    }
+    image->state = nzCount > 0 ? REGSTATE_IMAGE : REGSTATE_ZERO;
     return instCount;
 }
 
@@ -367,3 +1476,78 @@ int img_mv_selectCol(img_bramid_t colID) {
 	img_pushInstruction(img_genMV_SELECT_COL(colID));  // select the BRAM column
 	return 1;
 }
+
+
+// Pops up to size data from the FIFO-out into buff in packed mode
+// (see img_setPackedOutput()). Each FIFO-out word yields two data.
+// If size is odd, the upper half of the last word read is dropped.
+// @param buff [out]  Output buffer.
+// @param size [in]   Max no. of data to pop.
+// @return  Number of data popped (including the pad of an odd-length vector).
+int img_popDataBurstPacked(img_vecval_t *buff, const int size) {
+	int popped = 0;
+	while(popped < size) {
+		int fillLevel = img_getFoutFillLevel();
+		if(fillLevel == 0) {
+			// fill-level lags behind the valid flag by a few cycles
+			if(!img_isFoutValid()) break;
+			fillLevel = 1;
+		}
+		const int burstLen = MIN(fillLevel, (size-popped+1)/2);
+		for(int i=0; i<burstLen; ++i) {
+			uint32_t foutData = img_readFoutData();
+			img_genFoutRdPulse();
+			buff[popped++] = (int16_t)(foutData & 0xFFFF);		// first datum
+			if(popped < size)
+				buff[popped++] = (int16_t)(foutData >> 16);		// second datum
+		}
+	}
+	return popped;
+}
+
+
+// Loads a matrix into the specified GEMV register of all PEs. Row r of the
+// matrix goes to PiCaSO block row r, sliced into block columns of
+// IMAGINE_PEPERBLOCK elements (same layout as the assembler's MV_LOADMAT).
+// The register is cleared first, then only the blocks with non-zero
+// rows are selected and written; rows shared by most blocks are written
+// once to all of them.
+// AK-NOTE: A kernel assembled with a precision annotation (MV_LOADMAT bits=)
+// or with pruneMult only runs the MULT passes of the weights its loader
+// wrote. Loading other weights with this function does not update the
+// kernel: values wider than the annotation, or with Booth's digits in the
+// pruned passes, give wrong products without any error. Such a kernel must
+// be reassembled for the new weights.
+// @param reg  [in]  Destination register.
+// @param mat  [in]  Matrix in row-major order (fixed-point values).
+// @param rows [in]  No. of matrix rows, <= IMAGINE_BLKROWCNT.
+// @param cols [in]  No. of matrix columns, <= IMAGINE_BLKCOLCNT*IMAGINE_PEPERBLOCK.
+// @return  Number of instructions pushed.
+//          -ve return value on error.
+int img_mv_LOADMAT(const int reg,
+				   const img_vecval_t *mat,
+				   const int rows,
+				   const int cols)
+{
+    static const int peCount  = IMAGINE_PEPERBLOCK;      // PE column per BRAM block
+    static img_bramrow_t bramImage[IMAGINE_BLKROWCNT*IMAGINE_BLKCOLCNT][IMAGINE_PEREGWIDTH];	// images of all blocks
+    const img_bramaddr_t base = reg*IMAGINE_PEREGWIDTH;  // PE register base address
+    if(reg < 0 || reg >= IMG_REGCOUNT) return -1;
+    if(rows > IMAGINE_BLKROWCNT || cols > IMAGINE_BLKCOLCNT*peCount) return -1;
+    int nzCount = 0;	// No. of non-zero rows in the matrix image
+    for(int r=0; r<IMAGINE_BLKROWCNT; ++r) {
+    	for(int bramIndex=0; bramIndex<IMAGINE_BLKCOLCNT; ++bramIndex) {
+    		const int i = bramIndex*peCount;
+    		int sliceLen = r < rows ? MAX(0, MIN(peCount, cols-i)) : 0;	// 0 for the unused blocks
+    		const img_vecval_t *slice = sliceLen > 0 ? &mat[r*cols + i] : mat;
+    		int n = img_makePe2BramBlock(bramImage[r*IMAGINE_BLKCOLCNT + bramIndex], slice, sliceLen);
+    		if(n < 0) return -1;	// bramImage generation error
+    		nzCount += n;
+    	}
+    }
+    int instCount = img_mv_CLRREG(reg);		// clear the register
+    instCount += img_loadImages(base, (const img_bramrow_t (*)[IMAGINE_PEREGWIDTH])bramImage,
+    							IMAGINE_BLKROWCNT*IMAGINE_BLKCOLCNT, true);
+    if(nzCount > 0) regImage[reg].state = REGSTATE_UNKNOWN;		// the blocks of a column differ, not tracked
+    return instCount;
+}
@@ -0,0 +1,141 @@
+#include <stddef.h>
+#include "imagine_driver.h"
+#include "imagine_prog.h"
+#include "imagine_queue.h"
+
+
+// AK-NOTE: Jobs go through FIFO-in in submission order, so their outputs
+// come out of FIFO-out in the same order. The queue keeps three running
+// counts: submitted, pushed (all instructions in FIFO-in) and collected
+// (all outputs popped). A job is complete once it is collected.
+// The counts wrap around; only their differences are used.
+static IMAGine_Job jobRing[IMG_QUEUE_LENGTH];
+static uint32_t    submitCount  = 0;
+static uint32_t    pushCount    = 0;
+static uint32_t    collectCount = 0;
+
+// Push state of the job at pushCount
+#define STAGE_LOADVEC 0
+#define STAGE_PROGRAM 1
+static int  pushStage  = STAGE_LOADVEC;
+static int  pushOffset = 0;			// instructions of the current stage already pushed
+static bool stageReady = false;		// stageBuff holds the load-vector instructions
+static int  stageLen   = 0;
+static uint32_t stageBuff[IMG_LOADVEC_MAXINSTR(IMG_QUEUE_MAXVECTOR)];
+
+// Collect state of the job at collectCount
+static int outCount = 0;			// data already popped
+
+
+#define RING_SLOT(count)  (&jobRing[(count) % IMG_QUEUE_LENGTH])
+
+
+// Pushes the instructions of the queued jobs while FIFO-in has space.
+static
+void img_qDrainFinp() {
+	while(pushCount != submitCount) {
+		const IMAGine_Job *job = RING_SLOT(pushCount);
+		const uint32_t *instr = NULL;
+		int len = 0;
+		if(pushStage == STAGE_LOADVEC) {
+			if(job->vector && !stageReady) {
+				// generate the load-vector instructions once per job
+				stageLen = img_genMV_LOADVEC_ROW(stageBuff, IMG_LOADVEC_MAXINSTR(IMG_QUEUE_MAXVECTOR),
+												 job->reg, job->vector, job->vectorSize);
+				if(stageLen < 0) stageLen = 0;	// rejected by img_qSubmit(), should not happen
+				stageReady = true;
+			}
+			instr = stageBuff;
+			len = job->vector ? stageLen : 0;
+		} else if(job->prog) {
+			instr = job->prog->instruction;
+			len = job->prog->size;
+		}
+		if(pushOffset < len) {
+			pushOffset += img_tryPushInstructions(instr + pushOffset, len - pushOffset);
+			if(pushOffset < len) return;	// FIFO-in is full
+		}
+		// current stage is done, move on to the next one
+		pushOffset = 0;
+		if(pushStage == STAGE_LOADVEC) {
+			pushStage = STAGE_PROGRAM;
+		} else {
+			pushStage  = STAGE_LOADVEC;
+			stageReady = false;
+			++pushCount;
+		}
+	}
+}
+
+
+// Pops the available outputs into the buffers of the queued jobs.
+// The EOV flag is cleared once the output of a job is collected.
+static
+void img_qCollectFout() {
+	// AK-NOTE: The job being pushed can already produce output, so it is
+	// collected too; otherwise, a full FIFO-out could stall its program.
+	// The last output of a job sets the EOV flag, which is acknowledged once
+	// the output is collected, so the flag (and the EOV interrupt) is clear
+	// when the queue goes idle. It may also drop the EOV of the next job if
+	// that job has already ended; completion is decided by the output count,
+	// not by the flag.
+	while(collectCount != submitCount && (int32_t)(collectCount - pushCount) <= 0) {
+		const IMAGine_Job *job = RING_SLOT(collectCount);
+		if(job->outBuff && outCount < job->outSize) {
+			outCount += img_popDataBurst(job->outBuff + outCount, job->outSize - outCount);
+			if(outCount < job->outSize) return;	// FIFO-out is empty
+			img_clearEOV();		// EOV of this job
+		}
+		if(collectCount == pushCount) return;	// completes once fully pushed
+		outCount = 0;
+		++collectCount;
+	}
+}
+
+
+// Moves the queued jobs forward as far as possible without waiting:
+// pushes instructions while FIFO-in has space, and pops the outputs
+// that are available in FIFO-out. Call it whenever the CPU is free.
+// @return  No. of jobs not yet complete.
+int img_qProgress() {
+	img_qDrainFinp();
+	img_qCollectFout();
+	return img_qPending();
+}
+
+
+// Enqueues a job and starts pushing it; returns without waiting.
+// @param job [in]   Job to enqueue; copied into the ring, the buffers it
+//                   points to must stay valid until the job completes.
+// @param id  [out]  Completion handle of the job (can be NULL).
+// @return  0 on success, -1 if the ring is full or the job is invalid.
+int img_qSubmit(const IMAGine_Job *job, img_jobid_t *id) {
+	if(job->vector && job->vectorSize > IMG_QUEUE_MAXVECTOR) return -1;
+	if(submitCount - collectCount >= IMG_QUEUE_LENGTH) {
+		img_qProgress();	// try to free a slot
+		if(submitCount - collectCount >= IMG_QUEUE_LENGTH) return -1;
+	}
+	*RING_SLOT(submitCount) = *job;
+	if(id) *id = submitCount;
+	++submitCount;
+	img_qProgress();
+	return 0;
+}
+
+
+// Returns true if the job has completed (all outputs are in its buffer).
+bool img_qIsDone(img_jobid_t id) {
+	return (int32_t)(id - collectCount) < 0;
+}
+
+
+// Waits until the job completes, moving the queue forward meanwhile.
+void img_qWait(img_jobid_t id) {
+	while(!img_qIsDone(id)) img_qProgress();
+}
+
+
+// Returns the no. of jobs not yet complete.
+int img_qPending() {
+	return (int)(submitCount - collectCount);
+}
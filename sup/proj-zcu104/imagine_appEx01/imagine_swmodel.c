@@ -0,0 +1,222 @@
+#include "imagine_platform.h"
+
+#if IMG_REG_TARGET == IMG_BACKEND_SWMODEL
+
+#include <stddef.h>
+#include "imagine_swmodel.h"
+
+
+// AK-NOTE: Following the register map of the IP verilog;
+// the bit masks must match with the ones in imagine_driver.c.
+// slv_reg1 (FIFO control register)
+#define BIT_FIFO_RST    (1u << 0)
+#define BIT_FINP_WR     (1u << 1)
+#define BIT_FOUT_RD     (1u << 2)
+#define BIT_FINP_AUTOWR (1u << 3)
+#define BIT_FOUT_AUTORD (1u << 4)
+#define BIT_FOUT_PACK   (1u << 5)
+// slv_reg2 (IMAGine control register)
+#define BIT_IMG_CLREOV  (1u << 0)
+// slv_reg9 (FIFO status register)
+#define BIT_FINP_FULL   (1u << 0)
+#define BIT_FOUT_VALID  (1u << 1)
+// slv_reg10 (IMAGine status register)
+#define BIT_IMG_EOVINT  (1u << 0)
+// FIFO-out data attributes (unpacked mode)
+#define ATTRIB_ISDATA   (1u << 24)
+#define ATTRIB_ISLAST   (1u << 25)
+
+#define REG_COUNT   16
+#define FIFO_DEPTH  IMG_SWM_FIFO_DEPTH
+
+
+typedef struct {
+	uint32_t word[FIFO_DEPTH];
+	int      head;
+	int      count;
+} SwmFifo;
+
+
+static uint32_t slvReg[REG_COUNT];		// R/W registers, reg0-7
+static SwmFifo  fifoIn, fifoOut;
+static bool     eovFlag = false;
+static int      eovClearLag = 0;		// reads of reg10 that still see a cleared flag
+static int      eovStaleReads = 0;
+static bool     packHeld = false;		// packed mode: first datum of the pair is held
+static uint16_t packFirst = 0;
+static img_swmInstrHandler_t instrHandler = NULL;
+static void                 *instrHandlerArg = NULL;
+static img_swmAccessHook_t   accessHook = NULL;
+static void                 *accessHookArg = NULL;
+
+
+static
+bool fifoPush(SwmFifo *fifo, uint32_t word) {
+	if(fifo->count == FIFO_DEPTH) return false;		// dropped, like the IP
+	fifo->word[(fifo->head + fifo->count) % FIFO_DEPTH] = word;
+	++fifo->count;
+	return true;
+}
+
+
+static
+bool fifoPop(SwmFifo *fifo, uint32_t *word) {
+	if(fifo->count == 0) return false;
+	if(word) *word = fifo->word[fifo->head];
+	fifo->head = (fifo->head + 1) % FIFO_DEPTH;
+	--fifo->count;
+	return true;
+}
+
+
+// Pushes an instruction into FIFO-in, or hands it to the instruction handler
+static
+void pushInstruction(uint32_t instr) {
+	if(instrHandler) instrHandler(instr, instrHandlerArg);
+	else fifoPush(&fifoIn, instr);
+}
+
+
+// Returns the content of a register
+uint32_t img_swmReadReg(uintptr_t regOffset) {
+	const int regNo = (int)(regOffset / sizeof(uint32_t)) % REG_COUNT;
+	if(accessHook) accessHook(accessHookArg);
+	switch(regNo) {
+	case 8: {
+		const uint32_t word = fifoOut.count ? fifoOut.word[fifoOut.head] : 0;
+		if(slvReg[1] & BIT_FOUT_AUTORD) fifoPop(&fifoOut, NULL);	// auto-strobe pop
+		return word;
+	}
+	case 9:
+		return (fifoIn.count == FIFO_DEPTH ? BIT_FINP_FULL : 0)
+		     | (fifoOut.count > 0 ? BIT_FOUT_VALID : 0);
+	case 10:
+		if(eovStaleReads > 0) {		// old flag, still in the synchronizer
+			--eovStaleReads;
+			return BIT_IMG_EOVINT;
+		}
+		return eovFlag ? BIT_IMG_EOVINT : 0;
+	case 11: return FIFO_DEPTH - fifoIn.count;
+	case 12: return fifoOut.count;
+	case 13: return FIFO_DEPTH;
+	case 14: return 0x47414D49;		// "IMAGine" magic number
+	case 15: return 0x00656E69;
+	default: return slvReg[regNo];
+	}
+}
+
+
+// Writes a register and models its side effects
+void img_swmWriteReg(uintptr_t regOffset, uint32_t data) {
+	const int regNo = (int)(regOffset / sizeof(uint32_t)) % REG_COUNT;
+	if(accessHook) accessHook(accessHookArg);
+	if(regNo >= 8) return;		// read-only registers
+	const uint32_t rising = data & ~slvReg[regNo];	// pulse-gen bits trigger on rising edges
+	slvReg[regNo] = data;
+	switch(regNo) {
+	case 0:
+		if(slvReg[1] & BIT_FINP_AUTOWR) pushInstruction(data);	// auto-strobe push
+		break;
+	case 1:
+		// AK-NOTE: the IP only resets FIFO-in, fifoout_srst is tied to 0 in imagine_ip.sv
+		if(data & BIT_FIFO_RST) fifoIn.head = fifoIn.count = 0;
+		if(rising & BIT_FINP_WR) pushInstruction(slvReg[0]);
+		if(rising & BIT_FOUT_RD) fifoPop(&fifoOut, NULL);
+		if(!(data & BIT_FOUT_PACK)) packHeld = false;
+		break;
+	case 2:
+		if((rising & BIT_IMG_CLREOV) && eovFlag) {
+			eovFlag = false;
+			eovStaleReads = eovClearLag;
+		}
+		break;
+	}
+}
+
+
+// Resets the model: registers, FIFOs, the instruction handler and the access hook
+void img_swmReset() {
+	for(int i=0; i<REG_COUNT; ++i) slvReg[i] = 0;
+	fifoIn.head  = fifoIn.count  = 0;
+	fifoOut.head = fifoOut.count = 0;
+	eovFlag  = false;
+	eovClearLag = eovStaleReads = 0;
+	packHeld = false;
+	instrHandler = NULL;
+	instrHandlerArg = NULL;
+	accessHook = NULL;
+	accessHookArg = NULL;
+}
+
+
+// Sets the instruction handler; NULL keeps the instructions in FIFO-in.
+void img_swmSetInstrHandler(img_swmInstrHandler_t handler, void *arg) {
+	instrHandler = handler;
+	instrHandlerArg = arg;
+}
+
+
+// Sets the hook called before every register access; NULL removes it.
+// The hook may use the device-side API (e.g. pop instructions, emit data).
+void img_swmSetAccessHook(img_swmAccessHook_t hook, void *arg) {
+	accessHook = hook;
+	accessHookArg = arg;
+}
+
+
+// Sets the no. of reg10 reads that still see the EOV flag after it is
+// cleared. The IP brings the flag to the AXI clock through a synchronizer,
+// so a read right after the clear can return the old flag.
+void img_swmSetEovClearLag(int reads) {
+	eovClearLag = reads;
+}
+
+
+// Returns the no. of instructions waiting in FIFO-in
+int img_swmInstructionCount() {
+	return fifoIn.count;
+}
+
+
+// Pops an instruction from FIFO-in, as the IP would.
+// @return  false if FIFO-in is empty.
+bool img_swmPopInstruction(uint32_t *instr) {
+	return fifoPop(&fifoIn, instr);
+}
+
+
+// Emits one output datum into FIFO-out, following the packed mode
+// of the IP. The last datum of a vector sets the eovInterrupt.
+// @return  false if FIFO-out is full (the datum is dropped).
+bool img_swmEmitData(int16_t data, bool isLast) {
+	bool pushed = true;
+	if(slvReg[1] & BIT_FOUT_PACK) {
+		if(packHeld) {
+			pushed = fifoPush(&fifoOut, ((uint32_t)(uint16_t)data << 16) | packFirst);
+			packHeld = false;
+		} else if(isLast) {
+			pushed = fifoPush(&fifoOut, (uint16_t)data);	// unpaired, upper half is 0
+		} else {
+			packFirst = (uint16_t)data;
+			packHeld  = true;
+		}
+	} else {
+		pushed = fifoPush(&fifoOut, (uint16_t)data | ATTRIB_ISDATA | (isLast ? ATTRIB_ISLAST : 0));
+	}
+	if(isLast) eovFlag = true;
+	return pushed;
+}
+
+
+// Emits a vector into FIFO-out.
+// @return  No. of data emitted without being dropped.
+int img_swmEmitVector(const int16_t *vector, const int size) {
+	int emitted = 0;
+	for(int i=0; i<size; ++i) {
+		if(img_swmEmitData(vector[i], i == size-1)) ++emitted;
+	}
+	return emitted;
+}
+
+
+#endif  // IMG_REG_TARGET == IMG_BACKEND_SWMODEL
@@ -1,7 +1,7 @@
+#include "imagine_platform.h"
 #include "imagine_driver.h"
 #include "imagine_prog.h"
 #include "imagine_util.h"
-#include "xil_printf.h"
 
 
 // Utility macros, only pass variables, not statements
@@ -14,32 +14,55 @@
 // @param [in] prog  The program to push into FIFO-in
 // @return  Error code. 0 means success.
 int img_pushProgram(const IMAGine_Prog *prog) {
-	// Push the instructions using the driver API
-	for(int i=0; i<prog->size; ++i) {
-		img_pushInstruction(prog->instruction[i]);
-	}
+	// Push the instructions as a burst using the driver API
+	img_pushInstructions(prog->instruction, prog->size);
+	return 0;
+}
+
+
+// Given an IMAGine_Prog reference, hands all instructions to the
+// DMA engine and returns without waiting for the transfer to complete.
+// The program must stay valid until img_isDMABusy() returns false.
+// Falls back to img_pushProgram() if the DMA is not available.
+// @param [in] prog  The program to push into FIFO-in
+// @return  Error code. 0 means success.
+int img_submitProgramDMA(const IMAGine_Prog *prog) {
+	img_pushInstructionsDMA(prog->instruction, prog->size);
 	return 0;
 }
 
 
+// Given an IMAGine_Prog reference, stores the program in the kernel cache
+// of the IP. Launch it with img_runCached(). The program must stay valid
+// while it is cached.
+// @param [in] prog  The program to cache
+// @return  ID of the cached program, -1 if it does not fit in the cache.
+int img_cacheProgram(const IMAGine_Prog *prog) {
+	return img_cacheInstructions(prog->instruction, prog->size);
+}
+
+
 // Pops the output vector from the FIFO-out into buff.
 // @param [out] buff  Output buffer.
 // @param [int] size  Max size of the output buffer.
 //                    At max these many data will be popped.
 // @return  Number of data popped from FIFO-out.
 int img_popVector(img_vecval_t * const buff, const int size) {
-	IMAGine_Dout dout;
-	int buffIndex = 0;
-	while(buffIndex<size) {
-		dout = img_popData();
-		if(dout.status == IMAGINE_DOUT_VALID) {
-			buff[buffIndex++] = dout.data;
-		} else {
-			break;
-		}
-	}
-	// buffIndex = no. of data read
-	return buffIndex;
+	// Pop the data as bursts using the driver API
+	return img_popDataBurst(buff, size);
+}
+
+
+// Pops the output vector from the FIFO-out into buff using the packed mode,
+// which halves the no. of FIFO-out reads compared to img_popVector().
+// The IP must be put in packed mode (see img_setPackedOutput()) before
+// pushing the program that generates the vector.
+// @param [out] buff  Output buffer.
+// @param [int] size  Max size of the output buffer.
+//                    At max these many data will be popped.
+// @return  Number of data popped from FIFO-out.
+int img_popVectorPacked(img_vecval_t * const buff, const int size) {
+	return img_popDataBurstPacked(buff, size);
 }
 
 
@@ -116,9 +139,10 @@ void img_printFloat(double val) {
 }
 
 
-// Polls IMAGine EOV signal
+// Waits for IMAGine EOV signal
+// (sleeps on the EOV interrupt if initialized, otherwise polls)
 void img_pollEOV() {
-	while(!img_isEOV());
+	img_waitEOV(IMG_WAIT_FOREVER);
 }
 
 
@@ -133,6 +157,8 @@ void img_pollEOVmsg() {
 
 
 // Loads a row vector of floats into IMAGine GEMV register.
+// Vectors that fit the register images of the driver are loaded with
+// img_mv_LOADVEC_ROW(), so the clear is skipped when possible.
 // @param reg    [in]  Destination register no.
 // @param vector [in]  Pointer to the row vector of floats
 //                     to load into the register.
@@ -150,6 +176,11 @@ int img_loadVectorf_row(const int reg,
     const img_bramaddr_t base = reg*IMAGINE_PEREGWIDTH;  // PE register base address
     img_bramrow_t bramImage[IMAGINE_PEREGWIDTH];		 // buffer to hold BRAM image of one register
     img_vecval_t  fxpSlice[IMAGINE_PEPERBLOCK]; 		 // buffer to hold float2fxp output
+    if(size <= IMAGINE_BLKCOLCNT*IMAGINE_PEPERBLOCK) {
+    	img_vecval_t fxpVector[IMAGINE_BLKCOLCNT*IMAGINE_PEPERBLOCK];
+    	img_float2fxp(fxpVector, vector, size, fracWidth);	// convert float to fxp
+    	return img_mv_LOADVEC_ROW(reg, fxpVector, size);
+    }
     // Steps:
     //	 - clear the register
     //   - go through each set of peCount of the array
@@ -182,6 +182,7 @@ int main()
 
     
     // Perform initialization and tests
+    img_openDevice();	// maps the IP registers (Linux), resets the FIFO modes
     img_test();			// Tests if IMAGine is set up correctly
     load_ex01_params();	// Load the model parameter
     int misCount = test_ex01_kernel();	// Test using test-vectors
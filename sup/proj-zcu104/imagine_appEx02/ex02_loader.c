@@ -4,22 +4,7 @@
 static const uint32_t word_arr[] = {
     // ---- MACRO: MV_CLRREG reg=0; dependency of MV_LOADMAT
     0x18C00000, 
-    0x04000000, 
-    0x04010000, 
-    0x04020000, 
-    0x04030000, 
-    0x04040000, 
-    0x04050000, 
-    0x04060000, 
-    0x04070000, 
-    0x04080000, 
-    0x04090000, 
-    0x040A0000, 
-    0x040B0000, 
-    0x040C0000, 
-    0x040D0000, 
-    0x040E0000, 
-    0x040F0000, 
+    0x20010000, 
     // ---- End of MACRO
     // ---- MACRO: MV_LOADMAT Mat(16, 20)
     0x18400000, 
@@ -328,22 +313,7 @@ static const uint32_t word_arr[] = {
     // ---- End of MACRO
     // ---- MACRO: MV_CLRREG reg=1; dependency of MV_LOADMAT
     0x18C00000, 
-    0x04100000, 
-    0x04110000, 
-    0x04120000, 
-    0x04130000, 
-    0x04140000, 
-    0x04150000, 
-    0x04160000, 
-    0x04170000, 
-    0x04180000, 
-    0x04190000, 
-    0x041A0000, 
-    0x041B0000, 
-    0x041C0000, 
-    0x041D0000, 
-    0x041E0000, 
-    0x041F0000, 
+    0x20090000, 
     // ---- End of MACRO
     // ---- MACRO: MV_LOADMAT Mat(16, 20)
     0x18400000, 
@@ -660,22 +630,7 @@ static const uint32_t word_arr[] = {
     // ---- End of MACRO
     // ---- MACRO: MV_CLRREG reg=2; dependency of MV_LOADMAT
     0x18C00000, 
-    0x04200000, 
-    0x04210000, 
-    0x04220000, 
-    0x04230000, 
-    0x04240000, 
-    0x04250000, 
-    0x04260000, 
-    0x04270000, 
-    0x04280000, 
-    0x04290000, 
-    0x042A0000, 
-    0x042B0000, 
-    0x042C0000, 
-    0x042D0000, 
-    0x042E0000, 
-    0x042F0000, 
+    0x20110000, 
     // ---- End of MACRO
     // ---- MACRO: MV_LOADMAT Mat(16, 20)
     0x18400000, 
@@ -994,22 +949,7 @@ static const uint32_t word_arr[] = {
     // ---- End of MACRO
     // ---- MACRO: MV_CLRREG reg=3; dependency of MV_LOADMAT
     0x18C00000, 
-    0x04300000, 
-    0x04310000, 
-    0x04320000, 
-    0x04330000, 
-    0x04340000, 
-    0x04350000, 
-    0x04360000, 
-    0x04370000, 
-    0x04380000, 
-    0x04390000, 
-    0x043A0000, 
-    0x043B0000, 
-    0x043C0000, 
-    0x043D0000, 
-    0x043E0000, 
-    0x043F0000, 
+    0x20190000, 
     // ---- End of MACRO
     // ---- MACRO: MV_LOADMAT Mat(16, 20)
     0x18400000, 
@@ -1321,22 +1261,7 @@ static const uint32_t word_arr[] = {
     // ---- End of MACRO
     // ---- MACRO: MV_CLRREG reg=4; dependency of MV_LOADMAT
     0x18C00000, 
-    0x04400000, 
-    0x04410000, 
-    0x04420000, 
-    0x04430000, 
-    0x04440000, 
-    0x04450000, 
-    0x04460000, 
-    0x04470000, 
-    0x04480000, 
-    0x04490000, 
-    0x044A0000, 
-    0x044B0000, 
-    0x044C0000, 
-    0x044D0000, 
-    0x044E0000, 
-    0x044F0000, 
+    0x20210000, 
     // ---- End of MACRO
     // ---- MACRO: MV_LOADMAT Mat(16, 16)
     0x18400000, 
@@ -1502,22 +1427,7 @@ static const uint32_t word_arr[] = {
     // ---- End of MACRO
     // ---- MACRO: MV_CLRREG reg=5; dependency of MV_LOADMAT
     0x18C00000, 
-    0x04500000, 
-    0x04510000, 
-    0x04520000, 
-    0x04530000, 
-    0x04540000, 
-    0x04550000, 
-    0x04560000, 
-    0x04570000, 
-    0x04580000, 
-    0x04590000, 
-    0x045A0000, 
-    0x045B0000, 
-    0x045C0000, 
-    0x045D0000, 
-    0x045E0000, 
-    0x045F0000, 
+    0x20290000, 
     // ---- End of MACRO
     // ---- MACRO: MV_LOADMAT Mat(16, 16)
     0x18400000, 
@@ -1683,22 +1593,7 @@ static const uint32_t word_arr[] = {
     // ---- End of MACRO
     // ---- MACRO: MV_CLRREG reg=6; dependency of MV_LOADMAT
     0x18C00000, 
-    0x04600000, 
-    0x04610000, 
-    0x04620000, 
-    0x04630000, 
-    0x04640000, 
-    0x04650000, 
-    0x04660000, 
-    0x04670000, 
-    0x04680000, 
-    0x04690000, 
-    0x046A0000, 
-    0x046B0000, 
-    0x046C0000, 
-    0x046D0000, 
-    0x046E0000, 
-    0x046F0000, 
+    0x20310000, 
     // ---- End of MACRO
     // ---- MACRO: MV_LOADMAT Mat(16, 16)
     0x18400000, 
@@ -1864,22 +1759,7 @@ static const uint32_t word_arr[] = {
     // ---- End of MACRO
     // ---- MACRO: MV_CLRREG reg=7; dependency of MV_LOADMAT
     0x18C00000, 
-    0x04700000, 
-    0x04710000, 
-    0x04720000, 
-    0x04730000, 
-    0x04740000, 
-    0x04750000, 
-    0x04760000, 
-    0x04770000, 
-    0x04780000, 
-    0x04790000, 
-    0x047A0000, 
-    0x047B0000, 
-    0x047C0000, 
-    0x047D0000, 
-    0x047E0000, 
-    0x047F0000, 
+    0x20390000, 
     // ---- End of MACRO
     // ---- MACRO: MV_LOADMAT Mat(16, 16)
     0x18400000, 
@@ -2047,22 +1927,7 @@ static const uint32_t word_arr[] = {
 
     // ---- MACRO: MV_CLRREG reg=8; dependency of MV_LOADVEC_COL
     0x18C00000, 
-    0x04800000, 
-    0x04810000, 
-    0x04820000, 
-    0x04830000, 
-    0x04840000, 
-    0x04850000, 
-    0x04860000, 
-    0x04870000, 
-    0x04880000, 
-    0x04890000, 
-    0x048A0000, 
-    0x048B0000, 
-    0x048C0000, 
-    0x048D0000, 
-    0x048E0000, 
-    0x048F0000, 
+    0x20410000, 
     // ---- End of MACRO
     // ---- MACRO: MV_LOADVEC_COL Vec(16)
     0x18800000, 
@@ -2163,22 +2028,7 @@ static const uint32_t word_arr[] = {
     // ---- End of MACRO
     // ---- MACRO: MV_CLRREG reg=9; dependency of MV_LOADVEC_COL
     0x18C00000, 
-    0x04900000, 
-    0x04910000, 
-    0x04920000, 
-    0x04930000, 
-    0x04940000, 
-    0x04950000, 
-    0x04960000, 
-    0x04970000, 
-    0x04980000, 
-    0x04990000, 
-    0x049A0000, 
-    0x049B0000, 
-    0x049C0000, 
-    0x049D0000, 
-    0x049E0000, 
-    0x049F0000, 
+    0x20490000, 
     // ---- End of MACRO
     // ---- MACRO: MV_LOADVEC_COL Vec(16)
     0x18800000, 
@@ -2282,22 +2132,7 @@ static const uint32_t word_arr[] = {
     // ---- End of MACRO
     // ---- MACRO: MV_CLRREG reg=10; dependency of MV_LOADVEC_COL
     0x18C00000, 
-    0x04A00000, 
-    0x04A10000, 
-    0x04A20000, 
-    0x04A30000, 
-    0x04A40000, 
-    0x04A50000, 
-    0x04A60000, 
-    0x04A70000, 
-    0x04A80000, 
-    0x04A90000, 
-    0x04AA0000, 
-    0x04AB0000, 
-    0x04AC0000, 
-    0x04AD0000, 
-    0x04AE0000, 
-    0x04AF0000, 
+    0x20510000, 
     // ---- End of MACRO
     // ---- MACRO: MV_LOADVEC_COL Vec(16)
     0x18800000, 
@@ -2397,22 +2232,7 @@ static const uint32_t word_arr[] = {
     // ---- End of MACRO
     // ---- MACRO: MV_CLRREG reg=11; dependency of MV_LOADVEC_COL
     0x18C00000, 
-    0x04B00000, 
-    0x04B10000, 
-    0x04B20000, 
-    0x04B30000, 
-    0x04B40000, 
-    0x04B50000, 
-    0x04B60000, 
-    0x04B70000, 
-    0x04B80000, 
-    0x04B90000, 
-    0x04BA0000, 
-    0x04BB0000, 
-    0x04BC0000, 
-    0x04BD0000, 
-    0x04BE0000, 
-    0x04BF0000, 
+    0x20590000, 
     // ---- End of MACRO
     // ---- MACRO: MV_LOADVEC_COL Vec(16)
     0x18800000, 
@@ -2516,22 +2336,7 @@ static const uint32_t word_arr[] = {
 
     // ---- MACRO: MV_CLRREG reg=20; dependency of MV_LOADVEC_ROW
     0x18C00000, 
-    0x05400000, 
-    0x05410000, 
-    0x05420000, 
-    0x05430000, 
-    0x05440000, 
-    0x05450000, 
-    0x05460000, 
-    0x05470000, 
-    0x05480000, 
-    0x05490000, 
-    0x054A0000, 
-    0x054B0000, 
-    0x054C0000, 
-    0x054D0000, 
-    0x054E0000, 
-    0x054F0000, 
+    0x20A10000, 
     // ---- End of MACRO
     // ---- MACRO: MV_LOADVEC_ROW Vec(20)
     0x18000000, 
@@ -2555,22 +2360,7 @@ static const uint32_t word_arr[] = {
     // ---- End of MACRO
     // ---- MACRO: MV_CLRREG reg=21; dependency of MV_LOADVEC_ROW
     0x18C00000, 
-    0x05500000, 
-    0x05510000, 
-    0x05520000, 
-    0x05530000, 
-    0x05540000, 
-    0x05550000, 
-    0x05560000, 
-    0x05570000, 
-    0x05580000, 
-    0x05590000, 
-    0x055A0000, 
-    0x055B0000, 
-    0x055C0000, 
-    0x055D0000, 
-    0x055E0000, 
-    0x055F0000, 
+    0x20A90000, 
     // ---- End of MACRO
     // ---- MACRO: MV_LOADVEC_ROW Vec(16)
     0x18000000, 
@@ -128,4 +128,2319 @@ int16_t ex02_CaFxp[] = {
   4760,
   5888,
 };
-int ex02_CaFxp_size = sizeof(ex02_CaFxp)/sizeof(ex02_CaFxp[0]);
\ No newline at end of file
+int ex02_CaFxp_size = sizeof(ex02_CaFxp)/sizeof(ex02_CaFxp[0]);
+
+
+int16_t ex02_seqXt[] = {
+  35,
+  27,
+  104,
+  100,
+  77,
+  64,
+  225,
+  104,
+  79,
+  201,
+  216,
+  179,
+  246,
+  31,
+  114,
+  207,
+  249,
+  50,
+  190,
+  54,
+  48,
+  39,
+  93,
+  108,
+  68,
+  52,
+  237,
+  110,
+  91,
+  190,
+  210,
+  190,
+  250,
+  19,
+  119,
+  197,
+  248,
+  38,
+  197,
+  66,
+  48,
+  38,
+  94,
+  109,
+  67,
+  52,
+  237,
+  111,
+  91,
+  189,
+  209,
+  191,
+  249,
+  19,
+  118,
+  196,
+  249,
+  38,
+  196,
+  66,
+  47,
+  37,
+  95,
+  110,
+  67,
+  52,
+  238,
+  112,
+  90,
+  189,
+  208,
+  191,
+  248,
+  18,
+  116,
+  196,
+  250,
+  38,
+  195,
+  66,
+  47,
+  37,
+  96,
+  111,
+  66,
+  52,
+  238,
+  113,
+  89,
+  188,
+  207,
+  191,
+  247,
+  18,
+  115,
+  195,
+  251,
+  37,
+  193,
+  66,
+  46,
+  36,
+  97,
+  112,
+  65,
+  53,
+  238,
+  114,
+  89,
+  188,
+  206,
+  192,
+  245,
+  18,
+  114,
+  195,
+  253,
+  37,
+  192,
+  66,
+  45,
+  35,
+  98,
+  112,
+  65,
+  53,
+  237,
+  115,
+  88,
+  188,
+  205,
+  192,
+  244,
+  18,
+  113,
+  194,
+  254,
+  38,
+  191,
+  66,
+  45,
+  34,
+  99,
+  113,
+  64,
+  54,
+  237,
+  115,
+  87,
+  188,
+  205,
+  192,
+  243,
+  18,
+  111,
+  194,
+  255,
+  38,
+  190,
+  66,
+  44,
+  33,
+  100,
+  113,
+  64,
+  54,
+  237,
+  116,
+  86,
+  188,
+  204,
+  192,
+  242,
+  19,
+  110,
+  194,
+  256,
+  38,
+  188,
+  65,
+  43,
+  31,
+  101,
+  113,
+  64,
+  55,
+  236,
+  117,
+  85,
+  189,
+  204,
+  191,
+  240,
+  19,
+  109,
+  195,
+  257,
+  39,
+  187,
+  65,
+  42,
+  30,
+  102,
+  113,
+  64,
+  56,
+  235,
+  117,
+  84,
+  189,
+  203,
+  191,
+  239,
+  20,
+  108,
+  195,
+  258,
+  40,
+  186,
+  64,
+  40,
+  29,
+  104,
+  113,
+  64,
+  57,
+  235,
+  117,
+  83,
+  190,
+  203,
+  190,
+  238,
+  20,
+  107,
+  195,
+  259,
+  40,
+  185,
+  63,
+  39,
+  28,
+  105,
+  113,
+  65,
+  58,
+  234,
+  117,
+  81,
+  191,
+  203,
+  190,
+  237,
+  21,
+  106,
+  196,
+  260,
+  41,
+  184,
+  62,
+  38,
+  26,
+  106,
+  113,
+  65,
+  59,
+  233,
+  117,
+  80,
+  191,
+  203,
+  189,
+  237,
+  22,
+  105,
+  196,
+  260,
+  42,
+  182,
+  62,
+  37,
+  25,
+  107,
+  112,
+  65,
+  61,
+  232,
+  117,
+  79,
+  192,
+  204,
+  188,
+  236,
+  23,
+  104,
+  197,
+  261,
+  43,
+  181,
+  60,
+  35,
+  24,
+  109,
+  112,
+  66,
+  62,
+  231,
+  117,
+  77,
+  193,
+  204,
+  187,
+  235,
+  24,
+  103,
+  198,
+  261,
+  44,
+  181,
+  59,
+  34,
+  23,
+  110,
+  111,
+  67,
+  63,
+  229,
+  116,
+  76,
+  194,
+  204,
+  186,
+  235,
+  25,
+  103,
+  199,
+  261,
+  45,
+  180,
+  58,
+  33,
+  22,
+  111,
+  110,
+  68,
+  64,
+  228,
+  116,
+  75,
+  195,
+  205,
+  185,
+  234,
+  26,
+  102,
+  200,
+  262,
+  47,
+  179,
+  57,
+  32,
+  20,
+  112,
+  109,
+  69,
+  66,
+  227,
+  115,
+  74,
+  197,
+  206,
+  184,
+  234,
+  27,
+  102,
+  201,
+  262,
+  48,
+  178,
+  56,
+  30,
+  19,
+  113,
+  108,
+  70,
+  67,
+  226,
+  114,
+  73,
+  198,
+  206,
+  183,
+  234,
+  29,
+  101,
+  202,
+  262,
+  49,
+  178,
+  54,
+  29,
+  18,
+  114,
+  107,
+  71,
+  68,
+  224,
+  114,
+  72,
+  199,
+  207,
+  181,
+  234,
+  30,
+  101,
+  203,
+  261,
+  50,
+  177,
+  53,
+  28,
+  17,
+  115,
+  106,
+  72,
+  69,
+  223,
+  113,
+  70,
+  200,
+  208,
+  180,
+  234,
+  31,
+  101,
+  205,
+  261,
+  52,
+  177,
+  52,
+  27,
+  17,
+  115,
+  105,
+  73,
+  71,
+  222,
+  112,
+  70,
+  202,
+  209,
+  179,
+  234,
+  33,
+  101,
+  206,
+  261,
+  53,
+  177,
+  51,
+  26,
+  16,
+  116,
+  104,
+  74,
+  72,
+  221,
+  110,
+  69,
+  203,
+  210,
+  178,
+  234,
+  34,
+  102,
+  207,
+  260,
+  54,
+  177,
+  49,
+  25,
+  15,
+  117,
+  102,
+  75,
+  73,
+  219,
+  109,
+  68,
+  204,
+  212,
+  176,
+  235,
+  35,
+  102,
+  208,
+  259,
+  55,
+  177,
+  48,
+  25,
+  15,
+  117,
+  101,
+  77,
+  74,
+  218,
+  108,
+  67,
+  205,
+  213,
+  175,
+  235,
+  36,
+  103,
+  210,
+  258,
+  56,
+  177,
+  47,
+  24,
+  14,
+  117,
+  100,
+  78,
+  74,
+  217,
+  107,
+  67,
+  206,
+  214,
+  174,
+  236,
+  37,
+  103,
+  211,
+  258,
+  58,
+  178,
+  46,
+  24,
+  14,
+  117,
+  99,
+  79,
+  75,
+  216,
+  106,
+  66,
+  208,
+  215,
+  173,
+  237,
+  38,
+  104,
+  212,
+  257,
+  59,
+  178,
+  45,
+  23,
+  14,
+  117,
+  97,
+  81,
+  76,
+  215,
+  104,
+  66,
+  209,
+  217,
+  172,
+  237,
+  39,
+  105,
+  213,
+  256,
+  59,
+  179,
+  44,
+  23,
+  14,
+  117,
+  96,
+  82,
+  76,
+  215,
+  103,
+  66,
+  210,
+  218,
+  171,
+  238,
+  40,
+  106,
+  214,
+  254,
+  60,
+  180,
+  43,
+  23,
+  14,
+  117,
+  95,
+  83,
+  77,
+  214,
+  102,
+  66,
+  211,
+  219,
+  170,
+  239,
+  41,
+  107,
+  215,
+  253,
+  61,
+  181,
+  43,
+  23,
+  15,
+  116,
+  94,
+  84,
+  77,
+  213,
+  101,
+  66,
+  211,
+  220,
+  169,
+  241,
+  42,
+  108,
+  216,
+  252,
+  62,
+  181,
+  42,
+  23,
+  15,
+  116,
+  93,
+  85,
+  77,
+  213,
+  99,
+  66,
+  212,
+  222,
+  168,
+  242,
+  42,
+  109,
+  217,
+  251,
+  62,
+  182,
+  42,
+  23,
+  15,
+  115,
+  92,
+  86,
+  77,
+  212,
+  98,
+  66,
+  213,
+  223,
+  168,
+  243,
+  43,
+  110,
+  218,
+  249,
+  63,
+  184,
+  41,
+  23,
+  16,
+  115,
+  91,
+  87,
+  77,
+  212,
+  97,
+  67,
+  213,
+  224,
+  167,
+  244,
+  43,
+  111,
+  219,
+  248,
+  63,
+  185,
+  41,
+  24,
+  17,
+  114,
+  90,
+  88,
+  77,
+  212,
+  96,
+  67,
+  213,
+  225,
+  167,
+  246,
+  44,
+  113,
+  219,
+  247,
+  63,
+  186,
+  41,
+  24,
+  18,
+  113,
+  89,
+  88,
+  77,
+  212,
+  95,
+  68,
+  214,
+  226,
+  166,
+  247,
+  44,
+  114,
+  219,
+  246,
+  63,
+  187,
+  41,
+  25,
+  19,
+  112,
+  89,
+  89,
+  76,
+  212,
+  94,
+  69,
+  214,
+  226,
+  166,
+  248,
+  44,
+  115,
+  220,
+  244,
+  63,
+  188,
+  41,
+  26,
+  20,
+  111,
+  88,
+  89,
+  76,
+  213,
+  94,
+  70,
+  214,
+  227,
+  166,
+  249,
+  44,
+  116,
+  220,
+  243,
+  63,
+  190,
+  41,
+  27,
+  21,
+  110,
+  88,
+  89,
+  75,
+  213,
+  93,
+  71,
+  214,
+  228,
+  166,
+  251,
+  43,
+  118,
+  220,
+  242,
+  62,
+  191,
+  42,
+  28,
+  22,
+  108,
+  88,
+  90,
+  74,
+  213,
+  92,
+  72,
+  213,
+  228,
+  166,
+  252,
+  43,
+  119,
+  220,
+  241,
+  62,
+  192,
+  42,
+  29,
+  23,
+  107,
+  88,
+  90,
+  73,
+  214,
+  92,
+  73,
+  213,
+  229,
+  167,
+  253,
+  42,
+  120,
+  220,
+  240,
+  61,
+  193,
+  43,
+  30,
+  24,
+  106,
+  88,
+  90,
+  72,
+  215,
+  92,
+  74,
+  212,
+  229,
+  167,
+  254,
+  42,
+  121,
+  219,
+  239,
+  61,
+  195,
+  44,
+  31,
+  26,
+  105,
+  88,
+  89,
+  71,
+  216,
+  92,
+  75,
+  212,
+  229,
+  168,
+  255,
+  41,
+  122,
+  219,
+  238,
+  60,
+  196,
+  44,
+  32,
+  27,
+  103,
+  88,
+  89,
+  70,
+  217,
+  92,
+  77,
+  211,
+  229,
+  169,
+  256,
+  40,
+  123,
+  218,
+  238,
+  59,
+  197,
+  45,
+  34,
+  28,
+  102,
+  88,
+  89,
+  69,
+  218,
+  92,
+  78,
+  210,
+  229,
+  169,
+  257,
+  39,
+  124,
+  218,
+  237,
+  58,
+  198,
+  46,
+  35,
+  29,
+  101,
+  89,
+  88,
+  68,
+  219,
+  92,
+  79,
+  209,
+  228,
+  170,
+  257,
+  38,
+  125,
+  217,
+  237,
+  57,
+  199,
+  47,
+  36,
+  31,
+  100,
+  90,
+  87,
+  66,
+  220,
+  92,
+  80,
+  208,
+  228,
+  171,
+  258,
+  37,
+  125,
+  216,
+  236,
+  56,
+  200,
+  49,
+  37,
+  32,
+  98,
+  90,
+  87,
+  65,
+  221,
+  93,
+  82,
+  207,
+  227,
+  172,
+  258,
+  36,
+  126,
+  215,
+  236,
+  54,
+  201,
+  50,
+  39,
+  33,
+  97,
+  91,
+  86,
+  64,
+  222,
+  93,
+  83,
+  206,
+  227,
+  173,
+  259,
+  35,
+  126,
+  214,
+  236,
+  53,
+  201,
+  51,
+  40,
+  34,
+  96,
+  92,
+  85,
+  63,
+  224,
+  94,
+  84,
+  205,
+  226,
+  175,
+  259,
+  34,
+  127,
+  213,
+  236,
+  52,
+  202,
+  52,
+  41,
+  35,
+  95,
+  93,
+  84,
+  61,
+  225,
+  95,
+  85,
+  203,
+  225,
+  176,
+  259,
+  32,
+  127,
+  211,
+  236,
+  51,
+  202,
+  54,
+  42,
+  36,
+  95,
+  94,
+  83,
+  60,
+  226,
+  96,
+  86,
+  202,
+  224,
+  177,
+  259,
+  31,
+  127,
+  210,
+  237,
+  49,
+  202,
+  55,
+  43,
+  37,
+  94,
+  95,
+  81,
+  59,
+  227,
+  97,
+  87,
+  201,
+  223,
+  178,
+  259,
+  30,
+  127,
+  209,
+  237,
+  48,
+  203,
+  56,
+  44,
+  38,
+  93,
+  96,
+  80,
+  58,
+  229,
+  98,
+  88,
+  200,
+  222,
+  180,
+  259,
+  29,
+  127,
+  208,
+  238,
+  47,
+  203,
+  57,
+  45,
+  38,
+  93,
+  98,
+  79,
+  57,
+  230,
+  99,
+  89,
+  198,
+  221,
+  181,
+  258,
+  27,
+  126,
+  206,
+  238,
+  46,
+  203,
+  59,
+  46,
+  39,
+  92,
+  99,
+  78,
+  56,
+  231,
+  100,
+  90,
+  197,
+  220,
+  182,
+  258,
+  26,
+  126,
+  205,
+  239,
+  44,
+  202,
+  60,
+  47,
+  39,
+  92,
+  100,
+  76,
+  55,
+  232,
+  101,
+  90,
+  196,
+  219,
+  183,
+  257,
+  25,
+  125,
+  204,
+  240,
+  43,
+  202,
+  61,
+  47,
+  40,
+  92,
+  102,
+  75,
+  54,
+  233,
+  103,
+  91,
+  195,
+  217,
+  185,
+  256,
+  24,
+  125,
+  203,
+  241,
+  42,
+  202,
+  62,
+  48,
+  40,
+  92,
+  103,
+  74,
+  53,
+  234,
+  104,
+  91,
+  194,
+  216,
+  186,
+  256,
+  23,
+  124,
+  202,
+  242,
+  41,
+  201,
+  63,
+  48,
+  40,
+  92,
+  104,
+  73,
+  53,
+  235,
+  105,
+  91,
+  193,
+  215,
+  187,
+  255,
+  22,
+  123,
+  200,
+  243,
+  40,
+  200,
+  64,
+  48,
+  40,
+  92,
+  105,
+  71,
+  52,
+  236,
+  106,
+  91,
+  192,
+  213,
+  188,
+  254,
+  21,
+  122,
+  199,
+  244,
+  40,
+  200,
+  64,
+  48,
+  39,
+  92,
+  106,
+  70,
+  52,
+  236,
+  108,
+  91,
+  191,
+  212,
+  189,
+  253,
+  20,
+  121,
+  198,
+  245,
+  39,
+  199,
+  65,
+  48,
+  39,
+  93,
+  108,
+  69,
+  52,
+  237,
+  109,
+  91,
+  190,
+  211,
+  189,
+  251,
+  20,
+  120,
+  197,
+  247,
+  38,
+  198,
+  66,
+};
+int ex02_seqXt_size = sizeof(ex02_seqXt)/sizeof(ex02_seqXt[0]);
+int ex02_seqSteps = 64;
+
+
+int16_t ex02_seqHt[] = {
+  101,
+  192,
+  197,
+  14,
+  65,
+  246,
+  145,
+  148,
+  65,
+  115,
+  69,
+  35,
+  72,
+  142,
+  134,
+  134,
+  194,
+  194,
+  194,
+  194,
+  194,
+  194,
+  194,
+  194,
+  194,
+  194,
+  194,
+  194,
+  194,
+  194,
+  194,
+  194,
+  246,
+  246,
+  246,
+  246,
+  246,
+  246,
+  246,
+  246,
+  246,
+  246,
+  246,
+  246,
+  246,
+  246,
+  246,
+  246,
+  254,
+  254,
+  254,
+  254,
+  254,
+  254,
+  254,
+  254,
+  254,
+  254,
+  254,
+  254,
+  254,
+  254,
+  254,
+  254,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  256,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  256,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  256,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  256,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  256,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  256,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  256,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  256,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  256,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  256,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  256,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  256,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  256,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  256,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  256,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  256,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  256,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  256,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  256,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  256,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  256,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  256,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  256,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  256,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  256,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  256,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  256,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  256,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  256,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+  255,
+};
+int ex02_seqHt_size = sizeof(ex02_seqHt)/sizeof(ex02_seqHt[0]);
\ No newline at end of file
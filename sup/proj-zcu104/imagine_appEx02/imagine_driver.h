@@ -12,6 +12,8 @@
 // Hardware IP Parameters
 #define IMAGINE_PEPERBLOCK 16
 #define IMAGINE_PEREGWIDTH 16
+#define IMAGINE_BLKROWCNT  64	// no. of PiCaSO block rows
+#define IMAGINE_BLKCOLCNT  4	// no. of PiCaSO block columns
 
 /******************/
 
@@ -21,6 +23,15 @@
 #define IMAGINE_DOUT_VALID    1
 
 
+// Register number for img_invalidateRegImage() to invalidate all registers
+#define IMG_ALLREGS  -1
+
+// Max. no. of kernels the kernel cache of the IP can hold
+#define IMG_KCACHE_MAXKERNELS  16
+
+// Timeout value for img_waitEOV() to wait without a timeout
+#define IMG_WAIT_FOREVER  0xFFFFFFFFu
+
 // IMAGine output vector value type
 typedef int16_t img_vecval_t;
 
@@ -33,12 +44,38 @@ typedef struct {
 
 
 
+// EOV completion callback type
+typedef void (*img_eovCallback_t)(void *arg);
+
+
 // IMAGine API functions
+int  img_openDevice();
+void img_closeDevice();
 void img_pushInstruction(uint32_t instr);
+int  img_pushInstructions(const uint32_t *instr, const int size);
+int  img_tryPushInstructions(const uint32_t *instr, const int size);
 bool img_isEOV();
 void img_clearEOV();
+int  img_initEOVInterrupt();
+int  img_waitEOV(uint32_t timeoutUs);
+void img_setEOVCallback(img_eovCallback_t callback, void *arg);
+void img_setAutoStrobe(bool enable);
 int  img_test();
 IMAGine_Dout img_popData();
+int  img_popDataBurst(img_vecval_t *buff, const int size);
+void img_setPackedOutput(bool enable);
+int  img_popDataBurstPacked(img_vecval_t *buff, const int size);
+
+// DMA instruction stream API functions
+int  img_initDMA();
+int  img_pushInstructionsDMA(const uint32_t *instr, const int size);
+bool img_isDMABusy();
+void img_waitDMA();
+
+// Kernel cache API functions
+int  img_cacheInstructions(const uint32_t *instr, const int size);
+int  img_runCached(int kernelID);
+void img_clearCache();
 
 
 // Low-level datatypes and API functions
@@ -58,10 +95,25 @@ int img_makePe2BramBlock(img_bramrow_t *outArr,
 // IMAGine JIT Assembly instructions
 int img_mv_selectAll();
 int img_mv_selectCol(img_bramid_t colID);
+void img_invalidateRegImage(int reg);
+void img_markRegsZero();
 int img_mv_CLRREG(int reg);
 int img_mv_LOADVEC_ROW(const int reg,
 					   const img_vecval_t *vector,
 					   const int size);
+int img_mv_LOADMAT(const int reg,
+				   const img_vecval_t *mat,
+				   const int rows,
+				   const int cols);
+
+// Max. no. of instructions img_genMV_LOADVEC_ROW() generates for a vector size
+#define IMG_LOADVEC_MAXINSTR(size) \
+	((IMAGINE_PEREGWIDTH+1) * (1 + ((size)+IMAGINE_PEPERBLOCK-1)/IMAGINE_PEPERBLOCK))
+
+int img_genMV_LOADVEC_ROW(uint32_t *instr, const int maxLen,
+						  const int reg,
+						  const img_vecval_t *vector,
+						  const int size);
 
 
 #endif  // IMAGINE_DRIVER_H
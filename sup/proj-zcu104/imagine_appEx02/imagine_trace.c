@@ -0,0 +1,113 @@
+#include "imagine_platform.h"
+
+#if IMG_BACKEND == IMG_BACKEND_TRACE
+
+#include <stddef.h>
+#include "imagine_backend.h"
+#include "imagine_trace.h"
+
+
+#define TRACE_OFF     0
+#define TRACE_RECORD  1
+#define TRACE_REPLAY  2
+
+static int   traceMode = TRACE_OFF;
+static IMAGine_TraceEntry       *recordBuff = NULL;
+static const IMAGine_TraceEntry *replayBuff = NULL;
+static int   traceSize  = 0;		// capacity (record) or length (replay) of the buffer
+static int   traceIndex = 0;		// next entry
+static int   mismatches = 0;		// accesses that could not be recorded or replayed
+
+
+// Logs one access while recording
+static inline
+void recordAccess(bool isWrite, int regNo, uint32_t data) {
+	if(traceIndex == traceSize) {
+		++mismatches;	// buffer full
+		return;
+	}
+	IMAGine_TraceEntry *entry = &recordBuff[traceIndex++];
+	entry->isWrite = isWrite;
+	entry->regNo   = (uint8_t)regNo;
+	entry->data    = data;
+}
+
+
+// Returns the next logged access while replaying if it matches, else NULL
+static inline
+const IMAGine_TraceEntry* replayAccess(bool isWrite, int regNo) {
+	if(traceIndex == traceSize) {
+		++mismatches;	// ran past the end of the trace
+		return NULL;
+	}
+	const IMAGine_TraceEntry *entry = &replayBuff[traceIndex++];
+	if(entry->isWrite != isWrite || entry->regNo != regNo) {
+		++mismatches;
+		return NULL;
+	}
+	return entry;
+}
+
+
+uint32_t img_traceReadReg(uintptr_t regOffset) {
+	const int regNo = (int)(regOffset / sizeof(uint32_t));
+	if(traceMode == TRACE_REPLAY) {
+		const IMAGine_TraceEntry *entry = replayAccess(false, regNo);
+		return entry ? entry->data : 0;
+	}
+	const uint32_t data = rawReadImgReg(regOffset);
+	if(traceMode == TRACE_RECORD) recordAccess(false, regNo, data);
+	return data;
+}
+
+
+void img_traceWriteReg(uintptr_t regOffset, uint32_t data) {
+	const int regNo = (int)(regOffset / sizeof(uint32_t));
+	if(traceMode == TRACE_REPLAY) {
+		const IMAGine_TraceEntry *entry = replayAccess(true, regNo);
+		if(entry && entry->data != data) ++mismatches;
+		return;
+	}
+	rawWriteImgReg(regOffset, data);
+	if(traceMode == TRACE_RECORD) recordAccess(true, regNo, data);
+}
+
+
+// Starts recording the register accesses into buff.
+// Accesses beyond the capacity are not recorded and count as mismatches.
+void img_traceRecord(IMAGine_TraceEntry *buff, const int capacity) {
+	recordBuff = buff;
+	traceSize  = capacity;
+	traceIndex = 0;
+	mismatches = 0;
+	traceMode  = TRACE_RECORD;
+}
+
+
+// Starts replaying the register accesses from buff.
+void img_traceReplay(const IMAGine_TraceEntry *buff, const int size) {
+	replayBuff = buff;
+	traceSize  = size;
+	traceIndex = 0;
+	mismatches = 0;
+	traceMode  = TRACE_REPLAY;
+}
+
+
+// Stops recording/replaying; the accesses pass through to the target again.
+// @return  No. of entries recorded or replayed.
+int img_traceStop() {
+	traceMode = TRACE_OFF;
+	return traceIndex;
+}
+
+
+// Returns the no. of accesses that differ from the trace while replaying
+// (or could not be recorded while recording).
+// A replay is exact if this is 0 and img_traceStop() returns the trace size.
+int img_traceMismatches() {
+	return mismatches;
+}
+
+
+#endif  // IMG_BACKEND == IMG_BACKEND_TRACE
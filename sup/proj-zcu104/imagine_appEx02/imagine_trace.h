@@ -0,0 +1,35 @@
+#ifndef IMAGINE_TRACE_H
+#define IMAGINE_TRACE_H
+
+
+#include <stdbool.h>
+#include <stdint.h>
+
+
+// AK-NOTE: Record/replay of the register accesses, used by the
+// IMG_BACKEND_TRACE backend. While recording, the accesses go to the
+// IMG_TRACE_TARGET backend and are logged into a caller buffer. While
+// replaying, the target is not touched: reads return the logged values
+// and writes are checked against the log. Otherwise, the accesses
+// pass through to the target.
+
+// One register access
+typedef struct {
+	uint8_t  isWrite;
+	uint8_t  regNo;
+	uint32_t data;
+} IMAGine_TraceEntry;
+
+
+// Register accesses (used by imagine_backend.h)
+uint32_t img_traceReadReg(uintptr_t regOffset);
+void     img_traceWriteReg(uintptr_t regOffset, uint32_t data);
+
+// Trace control API
+void img_traceRecord(IMAGine_TraceEntry *buff, const int capacity);
+void img_traceReplay(const IMAGine_TraceEntry *buff, const int size);
+int  img_traceStop();
+int  img_traceMismatches();
+
+
+#endif  // IMAGINE_TRACE_H
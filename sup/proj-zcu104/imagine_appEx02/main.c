@@ -71,7 +71,8 @@ void load_ex02_params() {
 	extern IMAGine_Prog ex02_loader;	// defined in ex02_loader.c
 	xil_printf("INFO: ex02_loader has %d instructions\n", ex02_loader.size);
 	print("INFO: Pushing loader program\n");
-	img_pushProgram(&ex02_loader);
+	img_submitProgramDMA(&ex02_loader);	// falls back to register pushes if no DMA
+	img_waitDMA();
 	xil_printf("INFO: Finished pushing ex02_loader program\n");
 }
 
@@ -256,7 +257,10 @@ int main()
 
     
     // Perform initialization and tests
+    img_openDevice();	// maps the IP registers (Linux), resets the FIFO modes
     img_test();			// Tests if IMAGine is set up correctly
+    img_initDMA();		// DMA instruction stream, if present in the design
+    img_initEOVInterrupt();	// wait on EOV without polling, if the IRQ is connected
     load_ex02_params();	// Load the model parameter
     int misCount = test_ex02_kernel();	// Test using test-vectors
     if(misCount > 0) {
@@ -4,22 +4,7 @@
 static const uint32_t word_arr[] = {
     // ---- MACRO: MV_CLRREG reg=0; dependency of MV_LOADMAT
     0x18C00000, 
-    0x04000000, 
-    0x04010000, 
-    0x04020000, 
-    0x04030000, 
-    0x04040000, 
-    0x04050000, 
-    0x04060000, 
-    0x04070000, 
-    0x04080000, 
-    0x04090000, 
-    0x040A0000, 
-    0x040B0000, 
-    0x040C0000, 
-    0x040D0000, 
-    0x040E0000, 
-    0x040F0000, 
+    0x20010000, 
     // ---- End of MACRO
     // ---- MACRO: MV_LOADMAT Mat(64, 36)
     0x18400000, 
@@ -1916,94 +1901,82 @@ static const uint32_t word_arr[] = {
 
     // ---- MACRO: MV_CLRREG reg=1; dependency of MV_LOADVEC_COL
     0x18C00000, 
-    0x04100000, 
-    0x04110000, 
-    0x04120000, 
-    0x04130000, 
-    0x04140000, 
-    0x04150000, 
-    0x04160000, 
-    0x04170000, 
-    0x04180000, 
-    0x04190000, 
-    0x041A0000, 
-    0x041B0000, 
-    0x041C0000, 
-    0x041D0000, 
-    0x041E0000, 
-    0x041F0000, 
+    0x20090000, 
     // ---- End of MACRO
     // ---- MACRO: MV_LOADVEC_COL Vec(64)
+    0x18C00000, 
+    0x0414FFFF, 
+    0x0415FFFF, 
     0x18800000, 
     0x0413FFFF, 
+    0x04140000, 
+    0x04150000, 
     0x0416FFFF, 
     0x18800100, 
     0x0412FFFF, 
     0x0413FFFF, 
-    0x0414FFFF, 
-    0x0415FFFF, 
     0x0419FFFF, 
     0x041AFFFF, 
     0x18800200, 
     0x0411FFFF, 
     0x0412FFFF, 
     0x0413FFFF, 
+    0x04140000, 
+    0x04150000, 
     0x0416FFFF, 
     0x0417FFFF, 
     0x0418FFFF, 
     0x18800300, 
     0x0410FFFF, 
     0x0412FFFF, 
-    0x0414FFFF, 
-    0x0415FFFF, 
     0x0418FFFF, 
     0x041BFFFF, 
     0x18800400, 
     0x0413FFFF, 
-    0x0414FFFF, 
+    0x04150000, 
     0x0418FFFF, 
     0x18800500, 
     0x0410FFFF, 
     0x0411FFFF, 
-    0x0414FFFF, 
-    0x0415FFFF, 
     0x0418FFFF, 
     0x0419FFFF, 
     0x18800600, 
     0x0410FFFF, 
     0x0411FFFF, 
     0x0412FFFF, 
-    0x0414FFFF, 
+    0x04150000, 
     0x0417FFFF, 
     0x041BFFFF, 
     0x18800700, 
     0x0411FFFF, 
     0x0412FFFF, 
-    0x0414FFFF, 
-    0x0415FFFF, 
     0x0419FFFF, 
     0x041AFFFF, 
     0x18800800, 
     0x0410FFFF, 
     0x0411FFFF, 
-    0x0415FFFF, 
+    0x04140000, 
     0x041AFFFF, 
     0x18800900, 
-    0x0414FFFF, 
+    0x04150000, 
     0x0416FFFF, 
     0x0418FFFF, 
     0x0419FFFF, 
     0x041AFFFF, 
     0x18800A00, 
     0x0411FFFF, 
+    0x04140000, 
+    0x04150000, 
     0x041AFFFF, 
     0x18800B00, 
-    0x0414FFFF, 
+    0x04150000, 
     0x0417FFFF, 
     0x0418FFFF, 
     0x18800C00, 
     0x0412FFFF, 
     0x0413FFFF, 
+    0x04140000, 
+    0x04150000, 
     0x0416FFFF, 
     0x0417FFFF, 
     0x0418FFFF, 
@@ -2011,13 +1984,11 @@ static const uint32_t word_arr[] = {
     0x18800D00, 
     0x0410FFFF, 
     0x0413FFFF, 
-    0x0414FFFF, 
-    0x0415FFFF, 
     0x0417FFFF, 
     0x041BFFFF, 
     0x18800E00, 
     0x0410FFFF, 
-    0x0415FFFF, 
+    0x04140000, 
     0x0416FFFF, 
     0x0418FFFF, 
     0x0419FFFF, 
@@ -2026,27 +1997,27 @@ static const uint32_t word_arr[] = {
     0x0411FFFF, 
     0x0412FFFF, 
     0x0413FFFF, 
+    0x04140000, 
+    0x04150000, 
     0x0416FFFF, 
     0x0417FFFF, 
     0x0419FFFF, 
     0x18801000, 
     0x0411FFFF, 
-    0x0414FFFF, 
+    0x04150000, 
     0x0418FFFF, 
     0x041AFFFF, 
     0x18801100, 
-    0x0415FFFF, 
+    0x04140000, 
     0x0416FFFF, 
     0x0417FFFF, 
     0x18801200, 
     0x0410FFFF, 
-    0x0415FFFF, 
+    0x04140000, 
     0x0416FFFF, 
     0x18801300, 
     0x0410FFFF, 
     0x0412FFFF, 
-    0x0414FFFF, 
-    0x0415FFFF, 
     0x0416FFFF, 
     0x0418FFFF, 
     0x041BFFFF, 
@@ -2054,19 +2025,19 @@ static const uint32_t word_arr[] = {
     0x0410FFFF, 
     0x0412FFFF, 
     0x0413FFFF, 
-    0x0415FFFF, 
+    0x04140000, 
     0x041AFFFF, 
     0x18801500, 
     0x0410FFFF, 
     0x0411FFFF, 
     0x0412FFFF, 
     0x0413FFFF, 
-    0x0415FFFF, 
+    0x04140000, 
     0x0419FFFF, 
     0x18801600, 
     0x0410FFFF, 
     0x0411FFFF, 
-    0x0415FFFF, 
+    0x04140000, 
     0x0416FFFF, 
     0x0417FFFF, 
     0x0418FFFF, 
@@ -2074,6 +2045,8 @@ static const uint32_t word_arr[] = {
     0x041AFFFF, 
     0x18801700, 
     0x0411FFFF, 
+    0x04140000, 
+    0x04150000, 
     0x0416FFFF, 
     0x0418FFFF, 
     0x041AFFFF, 
@@ -2081,70 +2054,64 @@ static const uint32_t word_arr[] = {
     0x0410FFFF, 
     0x0412FFFF, 
     0x0413FFFF, 
-    0x0414FFFF, 
+    0x04150000, 
     0x0417FFFF, 
     0x0419FFFF, 
     0x041AFFFF, 
     0x18801900, 
     0x0410FFFF, 
     0x0412FFFF, 
-    0x0414FFFF, 
+    0x04150000, 
     0x0418FFFF, 
     0x18801A00, 
     0x0412FFFF, 
-    0x0414FFFF, 
-    0x0415FFFF, 
     0x0416FFFF, 
     0x041AFFFF, 
     0x18801B00, 
     0x0412FFFF, 
-    0x0414FFFF, 
+    0x04150000, 
     0x041AFFFF, 
     0x18801C00, 
     0x0410FFFF, 
-    0x0414FFFF, 
-    0x0415FFFF, 
     0x0416FFFF, 
     0x0417FFFF, 
     0x0419FFFF, 
     0x18801D00, 
     0x0413FFFF, 
+    0x04140000, 
+    0x04150000, 
     0x0416FFFF, 
     0x0417FFFF, 
     0x0418FFFF, 
     0x18801E00, 
     0x0412FFFF, 
     0x0413FFFF, 
-    0x0414FFFF, 
-    0x0415FFFF, 
     0x0417FFFF, 
     0x041BFFFF, 
     0x18801F00, 
     0x0412FFFF, 
     0x0413FFFF, 
-    0x0415FFFF, 
+    0x04140000, 
     0x0416FFFF, 
     0x0418FFFF, 
     0x0419FFFF, 
     0x041AFFFF, 
     0x18802000, 
     0x0411FFFF, 
-    0x0415FFFF, 
+    0x04140000, 
     0x0417FFFF, 
     0x0418FFFF, 
     0x041AFFFF, 
     0x18802100, 
     0x0411FFFF, 
     0x0413FFFF, 
-    0x0414FFFF, 
-    0x0415FFFF, 
     0x0417FFFF, 
     0x0419FFFF, 
     0x18802200, 
     0x0410FFFF, 
     0x0411FFFF, 
     0x0412FFFF, 
-    0x0414FFFF, 
+    0x04150000, 
     0x0416FFFF, 
     0x0419FFFF, 
     0x041AFFFF, 
@@ -2152,21 +2119,21 @@ static const uint32_t word_arr[] = {
     0x0410FFFF, 
     0x0411FFFF, 
     0x0413FFFF, 
-    0x0414FFFF, 
+    0x04150000, 
     0x041AFFFF, 
     0x18802400, 
     0x0410FFFF, 
     0x0412FFFF, 
+    0x04140000, 
+    0x04150000, 
     0x18802500, 
     0x0410FFFF, 
     0x0413FFFF, 
-    0x0414FFFF, 
-    0x0415FFFF, 
     0x0419FFFF, 
     0x041AFFFF, 
     0x18802600, 
     0x0413FFFF, 
-    0x0415FFFF, 
+    0x04140000, 
     0x0417FFFF, 
     0x0419FFFF, 
     0x041AFFFF, 
@@ -2175,55 +2142,59 @@ static const uint32_t word_arr[] = {
     0x0411FFFF, 
     0x0412FFFF, 
     0x0413FFFF, 
-    0x0414FFFF, 
+    0x04150000, 
     0x0417FFFF, 
     0x0418FFFF, 
     0x041BFFFF, 
     0x18802800, 
     0x0411FFFF, 
+    0x04140000, 
+    0x04150000, 
     0x0416FFFF, 
     0x041BFFFF, 
     0x18802900, 
     0x0410FFFF, 
     0x0413FFFF, 
+    0x04140000, 
+    0x04150000, 
     0x0416FFFF, 
     0x0417FFFF, 
     0x18802A00, 
     0x0411FFFF, 
     0x0413FFFF, 
-    0x0415FFFF, 
+    0x04140000, 
     0x0418FFFF, 
     0x0419FFFF, 
     0x18802B00, 
-    0x0414FFFF, 
-    0x0415FFFF, 
     0x0416FFFF, 
     0x18802C00, 
     0x0411FFFF, 
     0x0412FFFF, 
     0x0413FFFF, 
-    0x0415FFFF, 
+    0x04140000, 
     0x0417FFFF, 
     0x18802D00, 
     0x0411FFFF, 
     0x0412FFFF, 
-    0x0415FFFF, 
+    0x04140000, 
     0x0417FFFF, 
     0x041AFFFF, 
     0x18802E00, 
     0x0411FFFF, 
     0x0412FFFF, 
-    0x0414FFFF, 
+    0x04150000, 
     0x0419FFFF, 
     0x18802F00, 
     0x0410FFFF, 
     0x0411FFFF, 
     0x0413FFFF, 
-    0x0414FFFF, 
+    0x04150000, 
     0x0417FFFF, 
     0x18803000, 
     0x0410FFFF, 
     0x0412FFFF, 
+    0x04140000, 
+    0x04150000, 
     0x0416FFFF, 
     0x0419FFFF, 
     0x041AFFFF, 
@@ -2231,38 +2202,36 @@ static const uint32_t word_arr[] = {
     0x0410FFFF, 
     0x0411FFFF, 
     0x0412FFFF, 
-    0x0414FFFF, 
-    0x0415FFFF, 
     0x0418FFFF, 
     0x041BFFFF, 
     0x18803200, 
+    0x04140000, 
+    0x04150000, 
     0x0416FFFF, 
     0x041BFFFF, 
     0x18803300, 
     0x0410FFFF, 
     0x0413FFFF, 
+    0x04140000, 
+    0x04150000, 
     0x0417FFFF, 
     0x18803400, 
     0x0411FFFF, 
     0x0413FFFF, 
-    0x0414FFFF, 
-    0x0415FFFF, 
     0x0416FFFF, 
     0x0417FFFF, 
     0x0419FFFF, 
     0x18803500, 
-    0x0415FFFF, 
+    0x04140000, 
     0x0416FFFF, 
     0x18803600, 
     0x0412FFFF, 
-    0x0414FFFF, 
-    0x0415FFFF, 
     0x041AFFFF, 
     0x18803700, 
     0x0410FFFF, 
     0x0411FFFF, 
     0x0413FFFF, 
-    0x0414FFFF, 
+    0x04150000, 
     0x0416FFFF, 
     0x0418FFFF, 
     0x041BFFFF, 
@@ -2270,7 +2239,7 @@ static const uint32_t word_arr[] = {
     0x0410FFFF, 
     0x0412FFFF, 
     0x0413FFFF, 
-    0x0415FFFF, 
+    0x04140000, 
     0x0416FFFF, 
     0x0417FFFF, 
     0x0418FFFF, 
@@ -2278,41 +2247,41 @@ static const uint32_t word_arr[] = {
     0x0411FFFF, 
     0x0412FFFF, 
     0x0413FFFF, 
+    0x04140000, 
+    0x04150000, 
     0x0416FFFF, 
     0x0418FFFF, 
     0x0419FFFF, 
     0x041AFFFF, 
     0x18803A00, 
     0x0412FFFF, 
-    0x0414FFFF, 
-    0x0415FFFF, 
     0x0416FFFF, 
     0x0417FFFF, 
     0x041AFFFF, 
     0x18803B00, 
     0x0411FFFF, 
-    0x0414FFFF, 
-    0x0415FFFF, 
     0x0418FFFF, 
     0x041AFFFF, 
     0x18803C00, 
     0x0412FFFF, 
-    0x0414FFFF, 
+    0x04150000, 
     0x0416FFFF, 
     0x041BFFFF, 
     0x18803D00, 
     0x0412FFFF, 
     0x0413FFFF, 
-    0x0414FFFF, 
+    0x04150000, 
     0x0418FFFF, 
     0x0419FFFF, 
     0x18803E00, 
+    0x04140000, 
+    0x04150000, 
     0x0416FFFF, 
     0x0418FFFF, 
     0x0419FFFF, 
     0x18803F00, 
     0x0410FFFF, 
-    0x0415FFFF, 
+    0x04140000, 
     0x0416FFFF, 
     0x0418FFFF, 
     0x0419FFFF, 
@@ -2322,22 +2291,7 @@ static const uint32_t word_arr[] = {
 
     // ---- MACRO: MV_CLRREG reg=2; dependency of MV_LOADVEC_ROW
     0x18C00000, 
-    0x04200000, 
-    0x04210000, 
-    0x04220000, 
-    0x04230000, 
-    0x04240000, 
-    0x04250000, 
-    0x04260000, 
-    0x04270000, 
-    0x04280000, 
-    0x04290000, 
-    0x042A0000, 
-    0x042B0000, 
-    0x042C0000, 
-    0x042D0000, 
-    0x042E0000, 
-    0x042F0000, 
+    0x20110000, 
     // ---- End of MACRO
     // ---- MACRO: MV_LOADVEC_ROW Vec(36)
     0x18000000, 
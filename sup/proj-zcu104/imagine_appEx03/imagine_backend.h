@@ -0,0 +1,85 @@
+#ifndef IMAGINE_BACKEND_H
+#define IMAGINE_BACKEND_H
+
+
+#include <stdint.h>
+#include "imagine_platform.h"
+
+
+// AK-NOTE: All register accesses of the driver go through readImgReg() and
+// writeImgReg(). The backend is fixed at compile time (see imagine_platform.h),
+// so on the MMIO and MMAP backends these inline to a single volatile load/store.
+
+
+// Raw register accesses of the target backend
+#if IMG_REG_TARGET == IMG_BACKEND_MMIO || IMG_REG_TARGET == IMG_BACKEND_MMAP
+
+static inline
+uint32_t rawReadImgReg(uintptr_t regOffset)
+{
+	return *(volatile uint32_t *) (IMG_BASEADDR + regOffset);
+}
+
+static inline
+void rawWriteImgReg(uintptr_t regOffset, uint32_t data)
+{
+	volatile uint32_t *addr = (volatile uint32_t *)(IMG_BASEADDR + regOffset);
+	*addr = data;
+}
+
+#elif IMG_REG_TARGET == IMG_BACKEND_SWMODEL
+
+#include "imagine_swmodel.h"
+
+static inline
+uint32_t rawReadImgReg(uintptr_t regOffset)
+{
+	return img_swmReadReg(regOffset);
+}
+
+static inline
+void rawWriteImgReg(uintptr_t regOffset, uint32_t data)
+{
+	img_swmWriteReg(regOffset, data);
+}
+
+#else
+#error "imagine_backend.h: unsupported IMG_REG_TARGET"
+#endif
+
+
+// Register read-write utilities
+#if IMG_BACKEND == IMG_BACKEND_TRACE
+
+#include "imagine_trace.h"
+
+static inline
+uint32_t readImgReg(uintptr_t regOffset)
+{
+	return img_traceReadReg(regOffset);
+}
+
+static inline
+void writeImgReg(uintptr_t regOffset, uint32_t data)
+{
+	img_traceWriteReg(regOffset, data);
+}
+
+#else
+
+static inline
+uint32_t readImgReg(uintptr_t regOffset)
+{
+	return rawReadImgReg(regOffset);
+}
+
+static inline
+void writeImgReg(uintptr_t regOffset, uint32_t data)
+{
+	rawWriteImgReg(regOffset, data);
+}
+
+#endif  // IMG_BACKEND
+
+
+#endif  // IMAGINE_BACKEND_H
@@ -0,0 +1,221 @@
+#include <string.h>
+#include "imagine_platform.h"
+#include "imagine_driver.h"
+#include "imagine_binprog.h"
+
+// Hosted builds map the container file, or read it if mmap() is not available
+#if IMG_REG_TARGET != IMG_BACKEND_MMIO
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#define IMG_BIN_USE_MMAP
+#ifdef MAP_POPULATE
+#define BIN_MMAP_FLAGS  (MAP_PRIVATE | MAP_POPULATE)	// pre-faults the pages, they are all read by the checksum
+#else
+#define BIN_MMAP_FLAGS  MAP_PRIVATE
+#endif
+#else
+#include <stdlib.h>
+#endif
+#endif
+
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "The binary program container is little-endian"
+#endif
+
+_Static_assert(sizeof(IMAGine_BinHeader) == 32, "IMAGine_BinHeader must match bin_header of imagine_assembler.py");
+_Static_assert(sizeof(IMAGine_BinSection) == 32, "IMAGine_BinSection must match bin_section of imagine_assembler.py");
+
+#define BIN_IDWIDTH      8		// width of PiCaSO block row/column IDs
+#define BIN_CRC_OFFSET   16		// the checksum covers the file after the checksum field
+
+// Values for IMAGine_BinProg.source
+#define BIN_SRC_CALLER   0		// memory of the caller
+#define BIN_SRC_MMAP     1		// mapped by img_loadBinFile()
+#define BIN_SRC_HEAP     2		// read by img_loadBinFile()
+
+
+// CRC-32 (reflected, polynomial 0xEDB88320), same as zlib.crc32.
+// Uses a 16-entry table, one lookup per nibble.
+static uint32_t img_binCrc32(const uint8_t *data, size_t size) {
+	static const uint32_t table[16] = {
+		0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+		0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+	};
+	uint32_t crc = 0xFFFFFFFFu;
+	for(size_t i=0; i<size; ++i) {
+		crc ^= data[i];
+		crc = (crc >> 4) ^ table[crc & 0xF];
+		crc = (crc >> 4) ^ table[crc & 0xF];
+	}
+	return ~crc;
+}
+
+
+// Validates a container image and opens it. The image is used in place, it must
+// be 4-byte aligned and stay valid until img_closeBinProgram().
+// The target configuration must match the IP: the same PE count and register
+// width, and the GEMV dimensions must fit in the IP.
+// @param bin   [out]  Opened container.
+// @param image [in]   Container image.
+// @param size  [in]   Size of the image in bytes.
+// @return  0 on success, -ve value is error code (IMG_BIN_E*).
+int img_openBinProgram(IMAGine_BinProg *bin, const void *image, const size_t size) {
+	const IMAGine_BinHeader *header = (const IMAGine_BinHeader *)image;
+	memset(bin, 0, sizeof(*bin));
+	if(((uintptr_t)image & 3) || size < sizeof(IMAGine_BinHeader)) return IMG_BIN_EFORMAT;
+	if(header->magic != IMG_BIN_MAGIC || header->version != IMG_BIN_VERSION) return IMG_BIN_EFORMAT;
+	const size_t tableEnd = sizeof(IMAGine_BinHeader) + header->sectCount*sizeof(IMAGine_BinSection);
+	if(header->fileSize > size || header->fileSize < tableEnd) return IMG_BIN_EFORMAT;
+	if(img_binCrc32((const uint8_t *)image + BIN_CRC_OFFSET, header->fileSize - BIN_CRC_OFFSET) != header->checksum)
+		return IMG_BIN_ECHECKSUM;
+	// the sections must be inside the file
+	const IMAGine_BinSection *sections = (const IMAGine_BinSection *)(header + 1);
+	for(int i=0; i<header->sectCount; ++i) {
+		const IMAGine_BinSection *sect = &sections[i];
+		if((sect->offset & 3) || sect->offset < tableEnd || sect->offset > header->fileSize
+		   || sect->size > (header->fileSize - sect->offset) / sizeof(uint32_t)
+		   || sect->name[IMG_BIN_NAMELEN-1] != '\0') return IMG_BIN_EFORMAT;
+	}
+	// the programs must run on the live IP
+	if(header->peCount != IMAGINE_PEPERBLOCK || header->regWidth != IMAGINE_PEREGWIDTH
+	   || header->idWidth != BIN_IDWIDTH || header->fracWidth > IMAGINE_PEREGWIDTH
+	   || header->mvMaxRow > IMAGINE_BLKROWCNT
+	   || header->mvMaxCol > IMAGINE_BLKCOLCNT*IMAGINE_PEPERBLOCK) return IMG_BIN_ECONFIG;
+	bin->header    = header;
+	bin->sections  = sections;
+	bin->image     = (const uint8_t *)image;
+	bin->imageSize = size;
+	bin->source    = BIN_SRC_CALLER;
+	return 0;
+}
+
+
+// Opens a container file (hosted builds). The file is mapped read-only if
+// possible, otherwise it is read into memory.
+// @param bin  [out]  Opened container.
+// @param path [in]   Path of the container file.
+// @return  0 on success, -ve value is error code (IMG_BIN_E*).
+int img_loadBinFile(IMAGine_BinProg *bin, const char *path) {
+#if defined(IMG_BIN_USE_MMAP)
+	memset(bin, 0, sizeof(*bin));
+	const int fd = open(path, O_RDONLY);
+	if(fd < 0) return IMG_BIN_EIO;
+	struct stat st;
+	if(fstat(fd, &st) < 0 || st.st_size <= 0) {
+		close(fd);
+		return IMG_BIN_EIO;
+	}
+	const size_t size = (size_t)st.st_size;
+	void *image = mmap(NULL, size, PROT_READ, BIN_MMAP_FLAGS, fd, 0);
+	close(fd);		// the mapping stays valid
+	if(image == MAP_FAILED) return IMG_BIN_EIO;
+	const int err = img_openBinProgram(bin, image, size);
+	if(err) {
+		munmap(image, size);
+		return err;
+	}
+	bin->source = BIN_SRC_MMAP;
+	return 0;
+#elif IMG_REG_TARGET != IMG_BACKEND_MMIO
+	memset(bin, 0, sizeof(*bin));
+	FILE *fin = fopen(path, "rb");
+	if(!fin) return IMG_BIN_EIO;
+	long size = -1;
+	if(fseek(fin, 0, SEEK_END) == 0) size = ftell(fin);
+	void *image = size > 0 ? malloc((size_t)size) : NULL;	// malloc() memory is aligned
+	const int ok = image && fseek(fin, 0, SEEK_SET) == 0 && fread(image, 1, (size_t)size, fin) == (size_t)size;
+	fclose(fin);
+	if(!ok) {
+		free(image);
+		return IMG_BIN_EIO;
+	}
+	const int err = img_openBinProgram(bin, image, (size_t)size);
+	if(err) {
+		free(image);
+		return err;
+	}
+	bin->source = BIN_SRC_HEAP;
+	return 0;
+#else
+	// AK-NOTE: There is no file system on the standalone BSP. Read the container
+	// with the storage stack of the application and open it with img_openBinProgram().
+	(void)path;
+	memset(bin, 0, sizeof(*bin));
+	return IMG_BIN_EIO;
+#endif
+}
+
+
+// Closes a container, releasing the image if it was loaded by img_loadBinFile().
+// The programs of the container must not be in use (e.g. cached or in a DMA transfer).
+// @param bin [in]  Container to close.
+void img_closeBinProgram(IMAGine_BinProg *bin) {
+#if defined(IMG_BIN_USE_MMAP)
+	if(bin->source == BIN_SRC_MMAP) munmap((void *)bin->image, bin->imageSize);
+#elif IMG_REG_TARGET != IMG_BACKEND_MMIO
+	if(bin->source == BIN_SRC_HEAP) free((void *)bin->image);
+#endif
+	memset(bin, 0, sizeof(*bin));
+}
+
+
+// Finds a section by name.
+// @param bin  [in]  Opened container.
+// @param name [in]  Section name (progname of export_binary()).
+// @return  Index of the section, IMG_BIN_ENOSECT if not found.
+int img_findBinSection(const IMAGine_BinProg *bin, const char *name) {
+	for(int i=0; i<bin->header->sectCount; ++i) {
+		if(strncmp(bin->sections[i].name, name, IMG_BIN_NAMELEN) == 0) return i;
+	}
+	return IMG_BIN_ENOSECT;
+}
+
+
+// Returns the program of a section, which can be used with the program APIs
+// (e.g. img_pushProgram(), img_cacheProgram()). The instructions point into the
+// container image. The section index must be valid.
+// @param bin  [in]  Opened container.
+// @param sect [in]  Section index.
+IMAGine_Prog img_binSectionProg(const IMAGine_BinProg *bin, const int sect) {
+	const IMAGine_BinHeader  *header = bin->header;
+	const IMAGine_BinSection *section = &bin->sections[sect];
+	const IMAGine_Prog prog = {
+		(const uint32_t *)(bin->image + section->offset),
+		(int)section->size,
+		header->fracWidth,
+		header->mvMaxRow,
+		header->mvMaxCol,
+		header->regWidth,
+		header->idWidth,
+		header->peCount,
+	};
+	return prog;
+}
+
+
+// Pushes the instructions of a section into FIFO-in as a burst, directly
+// from the container image.
+// @param bin  [in]  Opened container.
+// @param sect [in]  Section index.
+// @return  Number of instructions pushed, -ve value is error code.
+int img_pushBinSection(const IMAGine_BinProg *bin, const int sect) {
+	if(sect < 0 || sect >= bin->header->sectCount) return IMG_BIN_ENOSECT;
+	const IMAGine_BinSection *section = &bin->sections[sect];
+	return img_pushInstructions((const uint32_t *)(bin->image + section->offset), (int)section->size);
+}
+
+
+// Pushes all loader sections in the order they appear in the container.
+// @param bin [in]  Opened container.
+// @return  Number of instructions pushed.
+int img_pushBinLoaders(const IMAGine_BinProg *bin) {
+	int pushed = 0;
+	for(int i=0; i<bin->header->sectCount; ++i) {
+		if((bin->sections[i].type & IMG_BIN_TYPEMASK) == IMG_BIN_LOADER) pushed += img_pushBinSection(bin, i);
+	}
+	return pushed;
+}
@@ -0,0 +1,97 @@
+#ifndef IMAGINE_PLATFORM_H
+#define IMAGINE_PLATFORM_H
+
+
+#include <stdint.h>
+
+
+// Register backends of the driver, selected at compile time with IMG_BACKEND
+#define IMG_BACKEND_MMIO     1   // bare-metal memory-mapped IO (standalone Xilinx BSP)
+#define IMG_BACKEND_MMAP     2   // Linux userspace, register window mapped through UIO or /dev/mem
+#define IMG_BACKEND_SWMODEL  3   // in-process software model of the register map
+#define IMG_BACKEND_TRACE    4   // records/replays the accesses to IMG_TRACE_TARGET
+
+#ifndef IMG_BACKEND
+#ifdef IMG_USE_UIO
+#define IMG_BACKEND  IMG_BACKEND_MMAP
+#else
+#define IMG_BACKEND  IMG_BACKEND_MMIO
+#endif
+#endif
+
+// IMG_REG_TARGET is the backend that finally handles the register accesses
+#if IMG_BACKEND == IMG_BACKEND_TRACE
+#ifndef IMG_TRACE_TARGET
+#define IMG_TRACE_TARGET  IMG_BACKEND_MMIO
+#endif
+#define IMG_REG_TARGET  IMG_TRACE_TARGET
+#else
+#define IMG_REG_TARGET  IMG_BACKEND
+#endif
+
+#if IMG_REG_TARGET == IMG_BACKEND_MMAP && !defined(IMG_USE_UIO)
+#define IMG_USE_UIO
+#endif
+
+
+// AK-NOTE: Only the MMIO target is built on a standalone Xilinx BSP. The other
+// targets are hosted builds (Linux or any host with a C library). The MMAP
+// target maps the register window of the IP once (see img_openDevice()), so
+// register accesses stay plain loads/stores without system calls.
+
+#if IMG_REG_TARGET == IMG_BACKEND_MMIO
+
+#include <xparameters.h>
+#include <imagine_gemv.h>
+#include <xil_printf.h>
+
+#define IMG_BASEADDR  XPAR_IMAGINE_GEMV_0_S00_AXI_BASEADDR
+
+#else   // hosted build
+
+#include <stdio.h>
+
+#ifdef IMG_USE_UIO
+// Device file of the register window: a UIO device, /dev/mem, or any file
+// of at least IMG_REGWIN_SIZE bytes (useful as a fake register window)
+#ifndef IMG_UIO_DEVICE
+#define IMG_UIO_DEVICE  "/dev/uio0"
+#endif
+// Offset of the register window in the device file.
+// Use the physical base address of the IP when IMG_UIO_DEVICE is /dev/mem.
+#ifndef IMG_REGWIN_OFFSET
+#define IMG_REGWIN_OFFSET  0
+#endif
+#define IMG_REGWIN_SIZE  4096
+
+// Register window mapped by img_openDevice()
+extern volatile uint8_t *img_regWindow;
+#define IMG_BASEADDR  ((uintptr_t)img_regWindow)
+#endif  // IMG_USE_UIO
+
+// Register offsets (same as imagine_gemv.h of the BSP)
+#define IMAGINE_GEMV_S00_AXI_SLV_REG0_OFFSET  0
+#define IMAGINE_GEMV_S00_AXI_SLV_REG1_OFFSET  4
+#define IMAGINE_GEMV_S00_AXI_SLV_REG2_OFFSET  8
+#define IMAGINE_GEMV_S00_AXI_SLV_REG3_OFFSET  12
+#define IMAGINE_GEMV_S00_AXI_SLV_REG4_OFFSET  16
+#define IMAGINE_GEMV_S00_AXI_SLV_REG5_OFFSET  20
+#define IMAGINE_GEMV_S00_AXI_SLV_REG6_OFFSET  24
+#define IMAGINE_GEMV_S00_AXI_SLV_REG7_OFFSET  28
+#define IMAGINE_GEMV_S00_AXI_SLV_REG8_OFFSET  32
+#define IMAGINE_GEMV_S00_AXI_SLV_REG9_OFFSET  36
+#define IMAGINE_GEMV_S00_AXI_SLV_REG10_OFFSET 40
+#define IMAGINE_GEMV_S00_AXI_SLV_REG11_OFFSET 44
+#define IMAGINE_GEMV_S00_AXI_SLV_REG12_OFFSET 48
+#define IMAGINE_GEMV_S00_AXI_SLV_REG13_OFFSET 52
+#define IMAGINE_GEMV_S00_AXI_SLV_REG14_OFFSET 56
+#define IMAGINE_GEMV_S00_AXI_SLV_REG15_OFFSET 60
+
+// Console output of the standalone BSP
+#define print(str)  fputs((str), stdout)
+#define xil_printf  printf
+
+#endif  // IMG_REG_TARGET
+
+
+#endif  // IMAGINE_PLATFORM_H
@@ -0,0 +1,49 @@
+#ifndef IMAGINE_QUEUE_H
+#define IMAGINE_QUEUE_H
+
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "imagine_driver.h"
+#include "imagine_prog.h"     // This header needs to be supplied by the compiled program
+
+
+/**** AK-NOTE: ****/
+/* Change these constants based on your application. */
+
+// No. of jobs the submission ring can hold (power of 2)
+#define IMG_QUEUE_LENGTH    8
+// Max. size of the vector of a load-vector stage
+#define IMG_QUEUE_MAXVECTOR 256
+
+/******************/
+
+
+// A job runs the following stages in order; a stage is skipped if
+// its pointer is NULL. All buffers must stay valid until the job completes.
+typedef struct {
+	// load-vector stage: img_mv_LOADVEC_ROW(reg, vector, vectorSize)
+	int                 reg;
+	const img_vecval_t *vector;
+	int                 vectorSize;
+	// run-program stage: pushes all instructions of prog
+	const IMAGine_Prog *prog;
+	// collect-output stage: pops exactly outSize data into outBuff,
+	// then clears the EOV flag (the queue owns it while jobs are pending)
+	img_vecval_t       *outBuff;
+	int                 outSize;
+} IMAGine_Job;
+
+// Completion handle of a submitted job
+typedef uint32_t img_jobid_t;
+
+
+// IMAGine submission queue API functions
+int  img_qSubmit(const IMAGine_Job *job, img_jobid_t *id);
+int  img_qProgress();
+bool img_qIsDone(img_jobid_t id);
+void img_qWait(img_jobid_t id);
+int  img_qPending();
+
+
+#endif  // IMAGINE_QUEUE_H
@@ -0,0 +1,43 @@
+#ifndef IMAGINE_SWMODEL_H
+#define IMAGINE_SWMODEL_H
+
+
+#include <stdbool.h>
+#include <stdint.h>
+
+
+// AK-NOTE: Software model of the IP's register map and FIFOs, used by the
+// IMG_BACKEND_SWMODEL backend to run the driver without a board. The model
+// does not execute instructions: they are captured in FIFO-in for the test
+// code to inspect, or handed to an instruction handler. The test code plays
+// the device side and emits the output data into FIFO-out.
+
+// Depth of the model FIFOs (same as the IP)
+#define IMG_SWM_FIFO_DEPTH  1024
+
+
+// Called for every instruction pushed into FIFO-in; the instruction is
+// consumed by the handler and not kept in FIFO-in.
+typedef void (*img_swmInstrHandler_t)(uint32_t instr, void *arg);
+
+// Called before every register access of the driver. A device model can
+// advance its own time from it, e.g. to account for the bus latency.
+typedef void (*img_swmAccessHook_t)(void *arg);
+
+
+// Register accesses (used by imagine_backend.h)
+uint32_t img_swmReadReg(uintptr_t regOffset);
+void     img_swmWriteReg(uintptr_t regOffset, uint32_t data);
+
+// Device-side API for the test code
+void img_swmReset();
+void img_swmSetInstrHandler(img_swmInstrHandler_t handler, void *arg);
+void img_swmSetAccessHook(img_swmAccessHook_t hook, void *arg);
+void img_swmSetEovClearLag(int reads);
+int  img_swmInstructionCount();
+bool img_swmPopInstruction(uint32_t *instr);
+bool img_swmEmitData(int16_t data, bool isLast);
+int  img_swmEmitVector(const int16_t *vector, const int size);
+
+
+#endif  // IMAGINE_SWMODEL_H
@@ -70,7 +70,8 @@ void load_ex03_params() {
 	extern IMAGine_Prog ex03_loader;	// defined in ex03_loader.c
 	xil_printf("INFO: ex03_loader has %d instructions\n", ex03_loader.size);
 	print("INFO: Pushing loader program\n");
-	img_pushProgram(&ex03_loader);
+	img_submitProgramDMA(&ex03_loader);	// falls back to register pushes if no DMA
+	img_waitDMA();
 	xil_printf("INFO: Finished pushing ex03_loader program\n");
 }
 
@@ -252,7 +253,10 @@ int main()
 
     
     // Perform initialization and tests
+    img_openDevice();	// maps the IP registers (Linux), resets the FIFO modes
     img_test();			// Tests if IMAGine is set up correctly
+    img_initDMA();		// DMA instruction stream, if present in the design
+    img_initEOVInterrupt();	// wait on EOV without polling, if the IRQ is connected
     load_ex03_params();	// Load the model parameter
     int misCount = test_ex03_kernel();	// Test using test-vectors
     if(misCount > 0) {
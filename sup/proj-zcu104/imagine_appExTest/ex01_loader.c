@@ -4,22 +4,7 @@
 static const uint32_t word_arr[] = {
     // ---- MACRO: MV_CLRREG reg=0; dependency of MV_LOADMAT
     0x18C00000, 
-    0x04000000, 
-    0x04010000, 
-    0x04020000, 
-    0x04030000, 
-    0x04040000, 
-    0x04050000, 
-    0x04060000, 
-    0x04070000, 
-    0x04080000, 
-    0x04090000, 
-    0x040A0000, 
-    0x040B0000, 
-    0x040C0000, 
-    0x040D0000, 
-    0x040E0000, 
-    0x040F0000, 
+    0x20010000, 
     // ---- End of MACRO
     // ---- MACRO: MV_LOADMAT Mat(16, 32)
     0x18400000, 
@@ -347,22 +332,7 @@ static const uint32_t word_arr[] = {
 
     // ---- MACRO: MV_CLRREG reg=1; dependency of MV_LOADVEC_COL
     0x18C00000, 
-    0x04100000, 
-    0x04110000, 
-    0x04120000, 
-    0x04130000, 
-    0x04140000, 
-    0x04150000, 
-    0x04160000, 
-    0x04170000, 
-    0x04180000, 
-    0x04190000, 
-    0x041A0000, 
-    0x041B0000, 
-    0x041C0000, 
-    0x041D0000, 
-    0x041E0000, 
-    0x041F0000, 
+    0x20090000, 
     // ---- End of MACRO
     // ---- MACRO: MV_LOADVEC_COL Vec(16)
     0x18800000, 
@@ -443,22 +413,7 @@ static const uint32_t word_arr[] = {
 
     // ---- MACRO: MV_CLRREG reg=2; dependency of MV_LOADVEC_ROW
     0x18C00000, 
-    0x04200000, 
-    0x04210000, 
-    0x04220000, 
-    0x04230000, 
-    0x04240000, 
-    0x04250000, 
-    0x04260000, 
-    0x04270000, 
-    0x04280000, 
-    0x04290000, 
-    0x042A0000, 
-    0x042B0000, 
-    0x042C0000, 
-    0x042D0000, 
-    0x042E0000, 
-    0x042F0000, 
+    0x20110000, 
     // ---- End of MACRO
     // ---- MACRO: MV_LOADVEC_ROW Vec(32)
     0x18000000, 
@@ -320,6 +320,7 @@ int main()
     init_platform();
 
     print("\n\nINFO: Start of new session.\n");
+    img_openDevice();	// maps the IP registers (Linux), resets the FIFO modes
     img_test();
 
     //ex01_tests();
@@ -9,7 +9,10 @@
 
 // IMAGine API functions
 int img_pushProgram(const IMAGine_Prog *prog);
+int img_submitProgramDMA(const IMAGine_Prog *prog);
+int img_cacheProgram(const IMAGine_Prog *prog);
 int img_popVector(img_vecval_t * const buff, const int size);
+int img_popVectorPacked(img_vecval_t * const buff, const int size);
 int img_popVectorf(float * const buff, const int size, const int fracWidth);
 int img_loadVectorf_row(const int reg,
 		                const float *vector,
@@ -0,0 +1,228 @@
+#include "imagine_platform.h"
+
+#if IMG_REG_TARGET == IMG_BACKEND_SWMODEL
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "imagine_driver.h"
+#include "imagine_test.h"
+
+
+// AK-NOTE: Functional model of the PiCaSO array for the loader tests. It
+// executes the instructions that move data into the BRAMs (SELECT, WRITE,
+// FILLREG), the REPEAT/WRUN front-end of the interface and the kernel
+// cache (KLOAD/KRUN), on a plain copy of the BRAM of every block. Compute
+// instructions are not modeled, they are counted as errors. Install
+// img_testArrayExec() as the instruction handler of the software model.
+
+#define BRAM_DEPTH   1024		// rows of a BRAM block, 10-bit addresses
+#define KCACHE_SIZE  1024		// instruction slots of the kernel cache
+
+// Instruction fields (see imagine_assembler.py, picaso_assembler.py)
+#define SUBM_MV          0
+#define SUBM_VV          1
+#define SUBM_KC          2
+#define SUBM_RPT         3
+#define OPCODE_NOP       0
+#define OPCODE_WRITE     1
+#define OPCODE_SELECT    6
+#define OPCODE_SUPEROP   8
+#define SCODE_FILLREG    1
+#define KC_OP_LOAD       1
+#define KC_OP_RUN        2
+#define SELECT_COL       0
+#define SELECT_BLOCK     1
+#define SELECT_ROW       2
+#define SELECT_ALL       3
+
+
+typedef struct {
+	uint16_t bram[IMAGINE_BLKROWCNT][IMAGINE_BLKCOLCNT][BRAM_DEPTH];
+	bool     selected[IMAGINE_BLKROWCNT][IMAGINE_BLKCOLCNT];
+	int      rptCount;			// pending REPEAT of the next instruction
+	uint32_t rptIncrement;
+	uint32_t wrunBase;			// WRITE run being decoded
+	uint32_t wrunMask;			// rows of the run not written yet
+	uint32_t kcache[KCACHE_SIZE];
+	int      kcBase[IMG_KCACHE_MAXKERNELS];
+	int      kcLen[IMG_KCACHE_MAXKERNELS];
+	int      kcLoading;			// instructions of the KLOAD being captured
+	int      kcLoadPtr;
+	long     dispatched;		// instructions dispatched to the array
+	int      errors;
+} ArrayModel;
+
+static ArrayModel model;
+
+
+// Puts the array in its power-on state. The BRAMs are either zero
+// (bitstream initialization) or random, to catch missing clears.
+// @param randomFill [in]  true: random BRAM contents.
+void img_testArrayReset(bool randomFill) {
+	memset(&model, 0, sizeof(model));
+	if(!randomFill) return;
+	for(int r=0; r<IMAGINE_BLKROWCNT; ++r)
+		for(int c=0; c<IMAGINE_BLKCOLCNT; ++c)
+			for(int a=0; a<BRAM_DEPTH; ++a) model.bram[r][c][a] = (uint16_t)rand();
+}
+
+
+// Executes an instruction of the mv submodule on the selected blocks
+static
+void img_testArrayDispatch(uint32_t instr) {
+	const uint32_t opcode = (instr >> 26) & 0xF;
+	const uint32_t seg1   = (instr >> 16) & 0x3FF;
+	const uint16_t data   = instr & 0xFFFF;
+	++model.dispatched;
+	if(opcode == OPCODE_NOP) return;
+	if(opcode == OPCODE_SELECT) {
+		const uint32_t fn = (instr >> 22) & 0x3;
+		const int row = (instr >> 8) & 0xFF;
+		const int col = instr & 0xFF;
+		for(int r=0; r<IMAGINE_BLKROWCNT; ++r) {
+			for(int c=0; c<IMAGINE_BLKCOLCNT; ++c) {
+				model.selected[r][c] = fn == SELECT_ALL
+									|| (fn == SELECT_COL && c == col)
+									|| (fn == SELECT_ROW && r == row)
+									|| (fn == SELECT_BLOCK && r == row && c == col);
+			}
+		}
+		return;
+	}
+	int base = seg1, len = 1;
+	if(opcode == OPCODE_SUPEROP && (seg1 & 0x7) == SCODE_FILLREG) {
+		base = (seg1 >> 3) * IMAGINE_PEREGWIDTH;	// [RD, S_CODE], fills all rows of RD
+		len = IMAGINE_PEREGWIDTH;
+	} else if(opcode != OPCODE_WRITE) {
+		++model.errors;		// not a data movement instruction
+		return;
+	}
+	for(int r=0; r<IMAGINE_BLKROWCNT; ++r) {
+		for(int c=0; c<IMAGINE_BLKCOLCNT; ++c) {
+			if(!model.selected[r][c]) continue;
+			for(int a=base; a<base+len; ++a) model.bram[r][c][a] = data;
+		}
+	}
+}
+
+
+// Executes an instruction after the kernel cache, i.e. the REPEAT/WRUN
+// front-end and the array
+static
+void img_testArrayFrontEnd(uint32_t instr) {
+	if(model.wrunMask) {
+		// data word of a WRITE run, low halfword first
+		for(int half=0; half<2 && model.wrunMask; ++half) {
+			const int i = __builtin_ctz(model.wrunMask);
+			model.wrunMask &= model.wrunMask - 1;
+			img_testArrayDispatch(0x04000000 | ((model.wrunBase + i) << 16) | ((instr >> 16*half) & 0xFFFF));
+		}
+		return;
+	}
+	if(model.rptCount > 0) {
+		const int count = model.rptCount;
+		model.rptCount = 0;
+		for(int i=0; i<count; ++i) img_testArrayDispatch(instr + i*model.rptIncrement);
+		return;
+	}
+	const uint32_t submCode = instr >> 30;
+	if(submCode == SUBM_RPT && (instr & (1u << 16))) {
+		model.wrunBase = (instr >> 20) & 0x3FF;		// [BASE:10] [xxx] [1] [MASK:16]
+		model.wrunMask = instr & 0xFFFF;
+	} else if(submCode == SUBM_RPT) {
+		model.rptCount = (instr >> 22) & 0xFF;		// [COUNT:8] [SHIFT:5] [0] [STRIDE:16]
+		model.rptIncrement = (instr & 0xFFFF) << ((instr >> 17) & 0x1F);
+	} else if(submCode == SUBM_MV) {
+		img_testArrayDispatch(instr);
+	} else if(submCode == SUBM_VV) {
+		++model.dispatched;		// vector shift-register, does not touch the BRAMs
+	} else {
+		++model.errors;
+	}
+}
+
+
+// Instruction handler of the software model: the kernel cache, then the
+// front-end. KLOAD = [2][0001][ID:4][x][LEN:11][BASE:10],
+// KRUN = [2][0010][ID:4][x...]. The data words of a WRITE run are never
+// decoded as cache instructions.
+void img_testArrayExec(uint32_t instr, void *arg) {
+	(void)arg;
+	if(model.kcLoading > 0) {
+		model.kcache[model.kcLoadPtr++ % KCACHE_SIZE] = instr;
+		--model.kcLoading;
+		return;
+	}
+	const bool isData = model.wrunMask != 0;
+	if(!isData && (instr >> 30) == SUBM_KC) {
+		const int id = (instr >> 22) & 0xF;
+		const uint32_t op = (instr >> 26) & 0xF;
+		if(op == KC_OP_LOAD) {
+			model.kcBase[id] = instr & 0x3FF;
+			model.kcLen[id] = (instr >> 10) & 0x7FF;
+			model.kcLoadPtr = model.kcBase[id];
+			model.kcLoading = model.kcLen[id];
+		} else if(op == KC_OP_RUN) {
+			for(int i=0; i<model.kcLen[id]; ++i)
+				img_testArrayFrontEnd(model.kcache[(model.kcBase[id] + i) % KCACHE_SIZE]);
+		} else {
+			++model.errors;
+		}
+		return;
+	}
+	img_testArrayFrontEnd(instr);
+}
+
+
+// Returns the value of a PE register, read back from the BRAM rows
+// of its block (bit b of the register is bit pe of row b).
+int16_t img_testArrayPeReg(int blkRow, int blkCol, int pe, int reg) {
+	uint16_t value = 0;
+	for(int b=0; b<IMAGINE_PEREGWIDTH; ++b)
+		value |= ((model.bram[blkRow][blkCol][reg*IMAGINE_PEREGWIDTH + b] >> pe) & 1) << b;
+	return (int16_t)value;
+}
+
+
+// Compares a register of all PEs against a matrix: element (r, j) is in PE
+// j of block row r, the PEs outside the matrix must be 0. With rowVector,
+// every block row holds the first matrix row (a row vector, rows = 1).
+// @return  No. of mismatching PEs.
+int img_testArrayCompare(int reg, const img_vecval_t *mat, int rows, int cols, bool rowVector) {
+	int misCount = 0;
+	for(int r=0; r<IMAGINE_BLKROWCNT; ++r) {
+		const int matRow = rowVector ? 0 : r;
+		for(int j=0; j<IMAGINE_BLKCOLCNT*IMAGINE_PEPERBLOCK; ++j) {
+			const img_vecval_t expected = (matRow < rows && j < cols) ? mat[matRow*cols + j] : 0;
+			const int16_t actual = img_testArrayPeReg(r, j / IMAGINE_PEPERBLOCK, j % IMAGINE_PEPERBLOCK, reg);
+			if(actual != expected) ++misCount;
+		}
+	}
+	return misCount;
+}
+
+
+// Hash (FNV-1a) of all the BRAMs, to compare the array after two programs
+uint32_t img_testArrayHash() {
+	const uint16_t *word = &model.bram[0][0][0];
+	uint32_t hash = 2166136261u;
+	for(size_t i=0; i<sizeof(model.bram)/sizeof(uint16_t); ++i) hash = (hash ^ word[i]) * 16777619u;
+	return hash;
+}
+
+
+// No. of instructions dispatched to the array, REPEATs and WRITE runs expanded
+long img_testArrayDispatched() {
+	return model.dispatched;
+}
+
+
+// No. of instructions the model could not execute
+int img_testArrayErrors() {
+	return model.errors;
+}
+
+
+#endif  // IMG_REG_TARGET == IMG_BACKEND_SWMODEL
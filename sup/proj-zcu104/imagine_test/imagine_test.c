@@ -0,0 +1,117 @@
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "imagine_platform.h"
+#include "imagine_driver.h"
+#include "imagine_test.h"
+
+#if IMG_REG_TARGET == IMG_BACKEND_SWMODEL
+#include "imagine_swmodel.h"
+#endif
+
+
+// Tests of this build, run in order
+static const IMAGine_Test tests[] = {
+#if IMG_REG_TARGET == IMG_BACKEND_SWMODEL
+	{"swmodel: register map",          test_swmRegisterMap},
+	{"swmodel: push/pop",              test_swmPushPop},
+	{"swmodel: FIFO reset",            test_swmFifoReset},
+	{"push: stale FIFO control",       test_pushStaleFifoCtrl},
+	{"push: burst order",              test_pushBurstOrder},
+	{"eov: wait (polling)",            test_eovWaitPoll},
+	{"eov: clear with synchronizer",   test_eovClearLag},
+	{"queue: job order",               test_queueOrder},
+	{"transpose: bit-exact",           test_transposeBitExact},
+	{"loadmat: random matrices",       test_loadmatRandom},
+	{"loadmat: ex01 golden",           test_loadmatGolden},
+	{"loadmat: invalid arguments",     test_loadmatErrors},
+	{"regimage: delta reload",         test_regimageDelta},
+	{"regimage: invalidation",         test_regimageInvalidate},
+	{"zeroreg: clear elision",         test_zeroregElision},
+	{"zeroreg: random operations",     test_zeroregRandomOps},
+	{"binprog: ex02 container",        test_binprogEx02},
+	{"binprog: rejected containers",   test_binprogErrors},
+	{"binprog: compressed loaders",    test_binprogCompressed},
+#endif
+#if IMG_REG_TARGET == IMG_BACKEND_MMAP
+	{"mmap: register window",          test_mmapRegWindow},
+	{"mmap: EOV polling",              test_mmapEovPoll},
+	{"mmap: reopen",                   test_mmapReopen},
+#endif
+#if IMG_BACKEND == IMG_BACKEND_TRACE
+	{"trace: record/replay",           test_traceReplay},
+	{"push: MMIO count",               test_pushMmioCount},
+	{"eov: control register shadow",   test_eovCtrlShadow},
+	{"queue: empty stages",            test_queueSkipEmptyStage},
+#endif
+};
+
+// Benchmarks of this build (imagine_test -b)
+static const IMAGine_Test benches[] = {
+#if IMG_BACKEND == IMG_BACKEND_SWMODEL
+	{"queue: ex02 step throughput",    bench_queue},
+	{"transpose: host throughput",     bench_transpose},
+	{"loadmat: host throughput",       bench_loadmat},
+	{"regimage: reload traffic",       bench_regimage},
+	{"binprog: ex02 load-to-ready",    bench_binprog},
+#endif
+};
+
+
+// Returns a monotonic time stamp in seconds
+double img_testTime() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec*1e-9;
+}
+
+
+// Puts the device in its power-on state and (re)opens it.
+// The driver state that outlives img_openDevice() is reset too.
+void img_testResetDevice() {
+#if IMG_REG_TARGET == IMG_BACKEND_SWMODEL
+	img_swmReset();
+#elif IMG_REG_TARGET == IMG_BACKEND_MMAP
+	img_closeDevice();
+	img_testMakeRegWindow();
+#endif
+	img_openDevice();
+	img_setAutoStrobe(false);
+	img_setPackedOutput(false);
+	img_clearEOV();
+	img_clearCache();
+	img_invalidateRegImage(IMG_ALLREGS);
+}
+
+
+// Runs the tests whose name starts with the filter (all if NULL).
+// @return  No. of failed tests.
+static
+int img_runTests(const IMAGine_Test *list, const int count, const char *filter) {
+	int failed = 0;
+	for(int i=0; i<count; ++i) {
+		if(filter && strncmp(list[i].name, filter, strlen(filter)) != 0) continue;
+		img_testResetDevice();
+		const int err = list[i].func();
+		printf("%s  %s\n", err ? "FAIL" : "PASS", list[i].name);
+		if(err) ++failed;
+	}
+	return failed;
+}
+
+
+#define COUNT_OF(arr)  ((int)(sizeof(arr)/sizeof((arr)[0])))
+
+// Usage: imagine_test [-b] [name-prefix]
+//   -b  runs the benchmarks instead of the tests
+int main(int argc, char *argv[]) {
+	const bool runBenches = argc > 1 && strcmp(argv[1], "-b") == 0;
+	const int  argNo = runBenches ? 2 : 1;
+	const char *filter = argc > argNo ? argv[argNo] : NULL;
+	const int failed = runBenches ? img_runTests(benches, COUNT_OF(benches), filter)
+								  : img_runTests(tests, COUNT_OF(tests), filter);
+	img_closeDevice();
+	if(failed) printf("%d test(s) failed\n", failed);
+	return failed ? 1 : 0;
+}
@@ -0,0 +1,100 @@
+#ifndef IMAGINE_TEST_H
+#define IMAGINE_TEST_H
+
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "imagine_platform.h"
+#include "imagine_driver.h"
+
+
+// AK-NOTE: Host tests and benchmarks of the driver. They are built against the
+// hosted backends (see Makefile), the device side is played by the software
+// model of the IP (imagine_swmodel.h). Each test returns 0 on success; the
+// checks print the failing condition and return -1 from the test.
+
+#define TEST_CHECK(cond)  do { \
+		if(!(cond)) { \
+			printf("    %s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+			return -1; \
+		} \
+	} while(0)
+
+
+// A test or benchmark function
+typedef int (*img_testFunc_t)();
+
+typedef struct {
+	const char     *name;
+	img_testFunc_t  func;
+} IMAGine_Test;
+
+
+// Test utilities (imagine_test.c)
+double img_testTime();
+void   img_testResetDevice();
+
+
+#if IMG_REG_TARGET == IMG_BACKEND_SWMODEL
+// Software model of the IP (test_swmodel.c)
+int test_swmRegisterMap();
+int test_swmPushPop();
+int test_swmFifoReset();
+// Instruction push (test_push.c)
+int test_pushStaleFifoCtrl();
+int test_pushBurstOrder();
+// EOV wait (test_eov.c)
+int test_eovWaitPoll();
+int test_eovClearLag();
+// Submission queue (test_queue.c)
+int test_queueOrder();
+int bench_queue();
+// PiCaSO array model (array_model.c)
+void     img_testArrayReset(bool randomFill);
+void     img_testArrayExec(uint32_t instr, void *arg);
+int16_t  img_testArrayPeReg(int blkRow, int blkCol, int pe, int reg);
+int      img_testArrayCompare(int reg, const img_vecval_t *mat, int rows, int cols, bool rowVector);
+uint32_t img_testArrayHash();
+long     img_testArrayDispatched();
+int      img_testArrayErrors();
+// Matrix loader (test_loadmat.c)
+int test_loadmatRandom();
+int test_loadmatGolden();
+int test_loadmatErrors();
+int bench_loadmat();
+// Register images (test_regimage.c)
+int test_regimageDelta();
+int test_regimageInvalidate();
+int bench_regimage();
+// Known-zero registers (test_zeroreg.c)
+int test_zeroregElision();
+int test_zeroregRandomOps();
+// Binary program container (test_binprog.c)
+int test_binprogEx02();
+int test_binprogErrors();
+int test_binprogCompressed();
+int bench_binprog();
+// PE to BRAM transpose (test_transpose.c)
+int test_transposeBitExact();
+int bench_transpose();
+#endif
+
+#if IMG_REG_TARGET == IMG_BACKEND_MMAP
+// Register window mapped from a fake device file (test_mmap.c)
+void img_testMakeRegWindow();
+int test_mmapRegWindow();
+int test_mmapEovPoll();
+int test_mmapReopen();
+#endif
+
+#if IMG_BACKEND == IMG_BACKEND_TRACE
+// Trace backend
+int test_traceReplay();
+int test_pushMmioCount();
+int test_eovCtrlShadow();
+int test_queueSkipEmptyStage();
+#endif
+
+
+#endif  // IMAGINE_TEST_H
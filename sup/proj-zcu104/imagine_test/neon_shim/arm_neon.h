@@ -0,0 +1,56 @@
+#ifndef IMAGINE_TEST_ARM_NEON_H
+#define IMAGINE_TEST_ARM_NEON_H
+
+
+#include <stdint.h>
+
+
+// AK-NOTE: Portable stand-in for <arm_neon.h>, so that the NEON kernel of
+// img_transpose16x16() can be built and checked on a host without an
+// AArch64 compiler (make test, test-simd-neon). Only the intrinsics used by
+// the driver are provided, with the lane semantics of the Arm ACLE
+// reference. It checks the algorithm of the kernel, not the code an AArch64
+// compiler generates for it.
+
+typedef struct {
+	uint16_t lane[8];
+} uint16x8_t;
+
+
+// Loads 8 lanes
+static inline uint16x8_t vld1q_u16(const uint16_t *ptr) {
+	uint16x8_t r;
+	for(int i=0; i<8; ++i) r.lane[i] = ptr[i];
+	return r;
+}
+
+// Sets all lanes to a value
+static inline uint16x8_t vdupq_n_u16(uint16_t value) {
+	uint16x8_t r;
+	for(int i=0; i<8; ++i) r.lane[i] = value;
+	return r;
+}
+
+// Lane-wise test: all ones if (a & b) != 0, else 0
+static inline uint16x8_t vtstq_u16(uint16x8_t a, uint16x8_t b) {
+	uint16x8_t r;
+	for(int i=0; i<8; ++i) r.lane[i] = (a.lane[i] & b.lane[i]) ? 0xFFFF : 0;
+	return r;
+}
+
+// Lane-wise AND
+static inline uint16x8_t vandq_u16(uint16x8_t a, uint16x8_t b) {
+	uint16x8_t r;
+	for(int i=0; i<8; ++i) r.lane[i] = a.lane[i] & b.lane[i];
+	return r;
+}
+
+// Sum of all lanes, modulo 2^16
+static inline uint16_t vaddvq_u16(uint16x8_t a) {
+	uint16_t sum = 0;
+	for(int i=0; i<8; ++i) sum = (uint16_t)(sum + a.lane[i]);
+	return sum;
+}
+
+
+#endif  // IMAGINE_TEST_ARM_NEON_H
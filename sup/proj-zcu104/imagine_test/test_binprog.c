@@ -0,0 +1,310 @@
+#include "imagine_platform.h"
+
+#if IMG_REG_TARGET == IMG_BACKEND_SWMODEL
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "imagine_driver.h"
+#include "imagine_util.h"
+#include "imagine_binprog.h"
+#include "imagine_swmodel.h"
+#include "imagine_test.h"
+
+
+#define BIN_FILE     IMG_TEST_BUILD_DIR "/ex02_model.bin"
+#define BIN_MAXSIZE  (64*1024)
+#define BUS_NS       100		// one AXI-Lite register access from the A53, same as test_queue.c
+
+
+// CRC-32 of zlib, bit by bit (independent of the driver's table version)
+static
+uint32_t crc32Bitwise(const uint8_t *data, size_t size) {
+	uint32_t crc = 0xFFFFFFFFu;
+	for(size_t i=0; i<size; ++i) {
+		crc ^= data[i];
+		for(int b=0; b<8; ++b) crc = (crc >> 1) ^ (0xEDB88320u & -(crc & 1));
+	}
+	return ~crc;
+}
+
+
+// Builds the container of ex02 (loader + kernel) the way export_binary()
+// of the assembler lays it out. The loader section is the given program.
+// @return  Size of the image in bytes.
+static
+size_t makeEx02Image(uint32_t *image, const IMAGine_Prog *loader, const uint32_t loaderType) {
+	extern IMAGine_Prog ex02_kernel;	// defined in ex02_kernel.c
+	const IMAGine_Prog *progs[2] = {loader, &ex02_kernel};
+	const char *names[2] = {"ex02_loader", "ex02_kernel"};
+	const uint32_t types[2] = {loaderType, IMG_BIN_KERNEL};
+	IMAGine_BinHeader *header = (IMAGine_BinHeader *)image;
+	IMAGine_BinSection *sections = (IMAGine_BinSection *)(header + 1);
+	memset(image, 0, sizeof(IMAGine_BinHeader) + 2*sizeof(IMAGine_BinSection));
+	uint32_t offset = sizeof(IMAGine_BinHeader) + 2*sizeof(IMAGine_BinSection);
+	for(int i=0; i<2; ++i) {
+		strncpy(sections[i].name, names[i], IMG_BIN_NAMELEN-1);
+		sections[i].type = types[i];
+		sections[i].offset = offset;
+		sections[i].size = progs[i]->size;
+		memcpy((uint8_t *)image + offset, progs[i]->instruction, 4*progs[i]->size);
+		offset += 4*progs[i]->size;
+	}
+	header->magic = IMG_BIN_MAGIC;
+	header->version = IMG_BIN_VERSION;
+	header->sectCount = 2;
+	header->fileSize = offset;
+	header->fracWidth = loader->fracWidth;
+	header->regWidth = loader->regWidth;
+	header->idWidth = loader->idWidth;
+	header->peCount = loader->peCount;
+	header->mvMaxRow = loader->mvMaxRow;
+	header->mvMaxCol = loader->mvMaxCol;
+	header->checksum = crc32Bitwise((const uint8_t *)image + 16, offset - 16);
+	return offset;
+}
+
+
+static
+int writeFile(const char *path, const void *data, size_t size) {
+	FILE *fout = fopen(path, "wb");
+	if(!fout) return -1;
+	const size_t written = fwrite(data, 1, size, fout);
+	fclose(fout);
+	return written == size ? 0 : -1;
+}
+
+
+// Instruction handler comparing the pushed instructions with a program
+typedef struct {
+	const IMAGine_Prog *prog;
+	int  next;
+	int  mismatches;
+} Matcher;
+
+static
+void matchInstr(uint32_t instr, void *arg) {
+	Matcher *m = (Matcher *)arg;
+	if(m->next >= m->prog->size || m->prog->instruction[m->next] != instr) ++m->mismatches;
+	++m->next;
+}
+
+
+// The container file of ex02 opens (mapped), its sections are the ex02
+// programs and the loaders are pushed word for word
+int test_binprogEx02() {
+	extern IMAGine_Prog ex02_loader;
+	extern IMAGine_Prog ex02_kernel;
+	static uint32_t image[BIN_MAXSIZE/4];
+	const size_t size = makeEx02Image(image, &ex02_loader, IMG_BIN_LOADER);
+	TEST_CHECK(writeFile(BIN_FILE, image, size) == 0);
+	IMAGine_BinProg bin;
+	TEST_CHECK(img_loadBinFile(&bin, BIN_FILE) == 0);
+	const int loader = img_findBinSection(&bin, "ex02_loader");
+	const int kernel = img_findBinSection(&bin, "ex02_kernel");
+	TEST_CHECK(loader == 0 && kernel == 1);
+	TEST_CHECK(img_findBinSection(&bin, "ex02") == IMG_BIN_ENOSECT);
+	const IMAGine_Prog prog = img_binSectionProg(&bin, kernel);
+	TEST_CHECK(prog.size == ex02_kernel.size && prog.fracWidth == ex02_kernel.fracWidth);
+	TEST_CHECK(memcmp(prog.instruction, ex02_kernel.instruction, 4*prog.size) == 0);
+	Matcher matcher = {&ex02_loader, 0, 0};
+	img_swmSetInstrHandler(matchInstr, &matcher);
+	TEST_CHECK(img_pushBinLoaders(&bin) == ex02_loader.size);
+	TEST_CHECK(matcher.next == ex02_loader.size && matcher.mismatches == 0);
+	img_closeBinProgram(&bin);
+	return 0;
+}
+
+
+// Corrupted or mismatching containers are rejected
+int test_binprogErrors() {
+	extern IMAGine_Prog ex02_loader;
+	static uint32_t image[BIN_MAXSIZE/4];
+	const size_t size = makeEx02Image(image, &ex02_loader, IMG_BIN_LOADER);
+	IMAGine_BinHeader *header = (IMAGine_BinHeader *)image;
+	IMAGine_BinProg bin;
+	TEST_CHECK(img_openBinProgram(&bin, image, size) == 0);
+	TEST_CHECK(img_openBinProgram(&bin, image, size - 4) == IMG_BIN_EFORMAT);		// truncated
+	TEST_CHECK(img_openBinProgram(&bin, (uint8_t *)image + 2, size - 2) == IMG_BIN_EFORMAT);	// unaligned
+	image[size/4 - 1] ^= 1;		// last instruction word
+	TEST_CHECK(img_openBinProgram(&bin, image, size) == IMG_BIN_ECHECKSUM);
+	image[size/4 - 1] ^= 1;
+	header->peCount = 8;		// another IP configuration
+	header->checksum = crc32Bitwise((const uint8_t *)image + 16, size - 16);
+	TEST_CHECK(img_openBinProgram(&bin, image, size) == IMG_BIN_ECONFIG);
+	header->peCount = IMAGINE_PEPERBLOCK;
+	header->mvMaxRow = IMAGINE_BLKROWCNT + 1;
+	header->checksum = crc32Bitwise((const uint8_t *)image + 16, size - 16);
+	TEST_CHECK(img_openBinProgram(&bin, image, size) == IMG_BIN_ECONFIG);
+	header->version = IMG_BIN_VERSION + 1;
+	TEST_CHECK(img_openBinProgram(&bin, image, size) == IMG_BIN_EFORMAT);
+	TEST_CHECK(img_loadBinFile(&bin, IMG_TEST_BUILD_DIR "/no-such-file.bin") == IMG_BIN_EIO);
+	return 0;
+}
+
+
+
+// WRITE runs of a program as WRUNs, the way compressWords() of the assembler
+// exports them: runs of at least 4 WRITEs to increasing rows within 16 rows
+// of the first, not following a REPEAT.
+// @return  No. of words in the compressed program.
+static
+int compressProg(uint32_t *out, const uint32_t *instr, const int size) {
+	const uint32_t opWrite = 0x04000000u;
+	int outSize = 0;
+	for(int i=0; i<size; ) {
+		const bool afterRepeat = i > 0 && (instr[i-1] >> 30) == 3;
+		int end = i;
+		if((instr[i] & 0xFC000000u) == opWrite && !afterRepeat) {
+			const uint32_t base = (instr[i] >> 16) & 0x3FF;
+			for(end=i+1; end<size && (instr[end] & 0xFC000000u) == opWrite; ++end) {
+				const uint32_t addr = (instr[end] >> 16) & 0x3FF;
+				if(addr <= ((instr[end-1] >> 16) & 0x3FF) || addr >= base + 16) break;
+			}
+		}
+		if(end - i < 4) {
+			out[outSize++] = instr[i++];
+			continue;
+		}
+		// [3] [BASE:10] [000] [1] [MASK:16], then the data, low half first
+		const uint32_t base = (instr[i] >> 16) & 0x3FF;
+		uint32_t mask = 0;
+		for(int k=i; k<end; ++k) mask |= 1u << (((instr[k] >> 16) & 0x3FF) - base);
+		out[outSize++] = 0xC0010000u | (base << 20) | mask;
+		for(int k=i; k<end; k+=2) {
+			const uint32_t high = k+1 < end ? instr[k+1] & 0xFFFF : 0;
+			out[outSize++] = (instr[k] & 0xFFFF) | (high << 16);
+		}
+		i = end;
+	}
+	return outSize;
+}
+
+
+// A program with the compressed instructions of another one, stored in words
+static
+IMAGine_Prog compressedProg(uint32_t *words, const IMAGine_Prog *prog) {
+	const IMAGine_Prog zProg = {
+		words,
+		compressProg(words, prog->instruction, prog->size),
+		prog->fracWidth,
+		prog->mvMaxRow,
+		prog->mvMaxCol,
+		prog->regWidth,
+		prog->idWidth,
+		prog->peCount,
+	};
+	return zProg;
+}
+
+
+// Compressed loaders give the same array as the plain ones: ex01 from the
+// kernel cache, where WRUN data words that look like KCACHE instructions
+// must pass as data, and ex02 from a container section flagged compressed
+int test_binprogCompressed() {
+	extern IMAGine_Prog ex01_loader;	// defined in ex01_loader.c
+	extern IMAGine_Prog ex02_loader;
+	static uint32_t words[BIN_MAXSIZE/4];
+	static uint32_t image[BIN_MAXSIZE/4];
+	img_swmSetInstrHandler(img_testArrayExec, NULL);
+	// ex01 through the kernel cache
+	img_testArrayReset(false);
+	img_pushProgram(&ex01_loader);
+	const uint32_t ex01Hash = img_testArrayHash();
+	const IMAGine_Prog zEx01 = compressedProg(words, &ex01_loader);
+	TEST_CHECK(zEx01.size < ex01_loader.size);
+	int kcacheLike = 0;		// data words with the KCACHE submodule code
+	for(int i=0; i<zEx01.size; ++i) {
+		if((words[i] >> 30) != 3 || !(words[i] & 0x10000)) continue;
+		const int dataWords = (__builtin_popcount(words[i] & 0xFFFF) + 1) / 2;
+		for(int k=1; k<=dataWords; ++k) kcacheLike += (words[i+k] >> 30) == 2;
+		i += dataWords;
+	}
+	TEST_CHECK(kcacheLike > 0);
+	img_testArrayReset(false);
+	img_clearCache();
+	const int kernelID = img_cacheProgram(&zEx01);
+	TEST_CHECK(kernelID >= 0);
+	TEST_CHECK(img_runCached(kernelID) == 0);
+	TEST_CHECK(img_testArrayHash() == ex01Hash);
+	img_clearCache();
+	// ex02 from a container
+	img_testArrayReset(false);
+	img_pushProgram(&ex02_loader);
+	const uint32_t ex02Hash = img_testArrayHash();
+	const IMAGine_Prog zEx02 = compressedProg(words, &ex02_loader);
+	const size_t size = makeEx02Image(image, &zEx02, IMG_BIN_LOADER | IMG_BIN_COMPRESSED);
+	IMAGine_BinProg bin;
+	TEST_CHECK(img_openBinProgram(&bin, image, size) == 0);
+	img_testArrayReset(false);
+	TEST_CHECK(img_pushBinLoaders(&bin) == zEx02.size);
+	TEST_CHECK(img_testArrayHash() == ex02Hash);
+	TEST_CHECK(img_testArrayErrors() == 0);
+	return 0;
+}
+
+
+
+
+// ---- Benchmark
+static
+void discardInstr(uint32_t instr, void *arg) {
+	(void)instr;
+	(void)arg;
+}
+
+static
+void countAccess(void *arg) {
+	++*(long *)arg;
+}
+
+
+// Load-to-ready time of the ex02 model: the container file is opened
+// (mapped and validated, host time), then the loader is pushed and the
+// kernel is cached (register accesses, modeled at BUS_NS each). The
+// firmware-linked loader (ex02_loader.c) is the baseline.
+int bench_binprog() {
+	extern IMAGine_Prog ex02_loader;
+	extern IMAGine_Prog ex02_kernel;
+	static uint32_t image[BIN_MAXSIZE/4];
+	const size_t size = makeEx02Image(image, &ex02_loader, IMG_BIN_LOADER);
+	if(writeFile(BIN_FILE, image, size) != 0) return -1;
+	const int loadCount = 200;
+	long accesses = 0;
+	img_swmSetInstrHandler(discardInstr, NULL);
+	img_swmSetAccessHook(countAccess, &accesses);
+	// open and validate
+	IMAGine_BinProg bin;
+	double start = img_testTime();
+	for(int n=0; n<loadCount; ++n) {
+		if(img_loadBinFile(&bin, BIN_FILE) != 0) return -1;
+		img_closeBinProgram(&bin);
+	}
+	const double openUs = (img_testTime() - start) / loadCount * 1e6;
+	// push the loader, cache the kernel
+	img_loadBinFile(&bin, BIN_FILE);
+	accesses = 0;
+	start = img_testTime();
+	img_pushBinLoaders(&bin);
+	const IMAGine_Prog kernel = img_binSectionProg(&bin, img_findBinSection(&bin, "ex02_kernel"));
+	const int kernelID = img_cacheProgram(&kernel);
+	const double pushUs = (img_testTime() - start) * 1e6;
+	const double binBusUs = accesses * BUS_NS * 1e-3;
+	img_clearCache();
+	img_closeBinProgram(&bin);
+	accesses = 0;
+	img_pushProgram(&ex02_loader);
+	img_cacheProgram(&ex02_kernel);
+	const double linkedBusUs = accesses * BUS_NS * 1e-3;
+	img_swmSetAccessHook(NULL, NULL);
+	if(kernelID < 0) return -1;
+	printf("    container: %d bytes, %d loader words\n", (int)size, ex02_loader.size);
+	printf("    open+validate (mmap, CRC): %8.1f us (host)\n", openUs);
+	printf("    push loader + cache kernel: %7.1f us (host), %7.1f us bus (modeled, %d ns/access)\n",
+		   pushUs, binBusUs, BUS_NS);
+	printf("    load-to-ready: %.1f us, linked programs: %.1f us bus (modeled)\n", openUs + binBusUs, linkedBusUs);
+	return 0;
+}
+
+
+#endif  // IMG_REG_TARGET == IMG_BACKEND_SWMODEL
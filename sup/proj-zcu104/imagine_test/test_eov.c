@@ -0,0 +1,78 @@
+#include "imagine_platform.h"
+
+#if IMG_REG_TARGET == IMG_BACKEND_SWMODEL
+
+#include <stdint.h>
+#include "imagine_driver.h"
+#include "imagine_swmodel.h"
+#include "imagine_test.h"
+
+#if IMG_BACKEND == IMG_BACKEND_TRACE
+#include "imagine_trace.h"
+#endif
+
+
+#define BIT_IMG_CLREOV  (1u << 0)
+
+
+// Without the interrupt path, img_waitEOV() polls the flag until the timeout
+int test_eovWaitPoll() {
+	static const int16_t vector[3] = {1, 2, 3};
+	TEST_CHECK(img_initEOVInterrupt() != 0);	// no interrupt on the software model
+	TEST_CHECK(img_waitEOV(100) == -1);
+	TEST_CHECK(img_swmEmitVector(vector, 2) == 2);
+	TEST_CHECK(img_waitEOV(100) == 0);
+	TEST_CHECK(img_waitEOV(IMG_WAIT_FOREVER) == 0);
+	img_clearEOV();
+	TEST_CHECK(!img_isEOV());
+	TEST_CHECK(img_waitEOV(100) == -1);
+	TEST_CHECK(img_swmEmitData(vector[2], false));	// not the end of a vector
+	TEST_CHECK(img_waitEOV(100) == -1);
+	// the timeout is counted on a clock, not in polls
+	const double start = img_testTime();
+	TEST_CHECK(img_waitEOV(20000) == -1);
+	TEST_CHECK(img_testTime() - start >= 0.02);
+	return 0;
+}
+
+
+// img_clearEOV() returns once reg10 reads the flag clear, although the
+// synchronizer of the IP keeps the old flag for a few reads
+int test_eovClearLag() {
+	static const int16_t vector[1] = {1};
+	img_swmSetEovClearLag(3);
+	TEST_CHECK(img_swmEmitVector(vector, 1) == 1);
+	TEST_CHECK(img_isEOV());
+	img_clearEOV();
+	TEST_CHECK(!img_isEOV());
+	TEST_CHECK(img_waitEOV(100) == -1);
+	// a flag that stays set (EOV of a new vector) does not hang the clear
+	img_swmSetEovClearLag(1000);
+	TEST_CHECK(img_swmEmitVector(vector, 1) == 1);
+	img_clearEOV();
+	TEST_CHECK(img_isEOV());
+	return 0;
+}
+
+
+#if IMG_BACKEND == IMG_BACKEND_TRACE
+// img_clearEOV() writes reg2 from its shadow, without reading it back,
+// then reads reg10 until the flag is clear
+int test_eovCtrlShadow() {
+	static IMAGine_TraceEntry trace[16];
+	static const int16_t vector[1] = {1};
+	img_swmEmitVector(vector, 1);
+	img_traceRecord(trace, 16);
+	img_clearEOV();
+	const int size = img_traceStop();
+	TEST_CHECK(!img_isEOV());
+	TEST_CHECK(size == 3);
+	TEST_CHECK(trace[0].isWrite && trace[0].regNo == 2 && trace[0].data == BIT_IMG_CLREOV);
+	TEST_CHECK(trace[1].isWrite && trace[1].regNo == 2 && trace[1].data == 0);
+	TEST_CHECK(!trace[2].isWrite && trace[2].regNo == 10 && trace[2].data == 0);
+	return 0;
+}
+#endif
+
+
+#endif  // IMG_REG_TARGET == IMG_BACKEND_SWMODEL
@@ -0,0 +1,156 @@
+#include "imagine_platform.h"
+
+#if IMG_REG_TARGET == IMG_BACKEND_SWMODEL
+
+#include <stdint.h>
+#include <stdlib.h>
+#include "imagine_driver.h"
+#include "imagine_prog.h"
+#include "imagine_swmodel.h"
+#include "imagine_test.h"
+
+
+#define MAT_ELEMENTS  (IMAGINE_BLKROWCNT*IMAGINE_BLKCOLCNT*IMAGINE_PEPERBLOCK)
+#define CAPTURE_SIZE  (8*1024)
+
+
+// Instruction handler recording the instructions, in order
+typedef struct {
+	uint32_t instr[CAPTURE_SIZE];
+	int      size;
+} Capture;
+
+static
+void captureInstr(uint32_t instr, void *arg) {
+	Capture *cap = (Capture *)arg;
+	if(cap->size < CAPTURE_SIZE) cap->instr[cap->size] = instr;
+	++cap->size;
+}
+
+
+// Returns the index of the first occurrence of a 2-word sequence in a
+// program at or after start, prog->size if there is none
+static
+int findPair(const IMAGine_Prog *prog, int start, uint32_t first, uint32_t second) {
+	for(int i=start; i+1<prog->size; ++i) {
+		if(prog->instruction[i] == first && prog->instruction[i+1] == second) return i;
+	}
+	return prog->size;
+}
+
+
+// Fills a matrix with values of a random class: sparse, few distinct
+// values (rows shared by many blocks, the broadcast path), or dense
+static
+void randomMatrix(img_vecval_t *mat, const int size) {
+	const int kind = rand() % 4;
+	const img_vecval_t common = (img_vecval_t)rand();
+	for(int i=0; i<size; ++i) {
+		switch(kind) {
+		case 0:  mat[i] = rand() % 8 == 0 ? (img_vecval_t)rand() : 0; break;
+		case 1:  mat[i] = rand() % 6 == 0 ? (img_vecval_t)rand() : common; break;
+		case 2:  mat[i] = (img_vecval_t)(rand() % 4); break;
+		default: mat[i] = (img_vecval_t)rand(); break;
+		}
+	}
+}
+
+
+// Random matrices end up in the PEs of the array model bit-exact, over a
+// random BRAM content; the rest of the register is cleared
+int test_loadmatRandom() {
+	static img_vecval_t mat[MAT_ELEMENTS];
+	srand(11);
+	img_testArrayReset(true);
+	img_swmSetInstrHandler(img_testArrayExec, NULL);
+	for(int t=0; t<200; ++t) {
+		const int reg  = rand() % 8;
+		const int rows = t == 0 ? IMAGINE_BLKROWCNT : rand() % (IMAGINE_BLKROWCNT+1);
+		const int cols = t == 0 ? IMAGINE_BLKCOLCNT*IMAGINE_PEPERBLOCK : rand() % (IMAGINE_BLKCOLCNT*IMAGINE_PEPERBLOCK+1);
+		randomMatrix(mat, rows*cols);
+		TEST_CHECK(img_mv_LOADMAT(reg, mat, rows, cols) >= 0);
+		TEST_CHECK(img_testArrayCompare(reg, mat, rows, cols, false) == 0);
+	}
+	TEST_CHECK(img_testArrayErrors() == 0);
+	return 0;
+}
+
+
+// The driver generates the same instructions as the assembler for the
+// matrix and the row vector of ex01 (ex01_loader.c)
+int test_loadmatGolden() {
+	extern IMAGine_Prog ex01_loader;	// defined in ex01_loader.c
+	extern int16_t ex01_testMat[];		// defined in ex01_testvec.c
+	extern int ex01_testMat_size;
+	extern int ex01_testMat_cols;
+	extern int16_t ex01_testInp[];		// same file
+	extern int ex01_testInp_size;
+	static Capture cap;
+	img_swmSetInstrHandler(captureInstr, &cap);
+	// MV_CLRREG reg=0 + MV_LOADMAT, up to the clear of reg 1
+	const int matEnd = findPair(&ex01_loader, 0, 0x18C00000, 0x20090000);
+	cap.size = 0;
+	const int rows = ex01_testMat_size / ex01_testMat_cols;
+	TEST_CHECK(img_mv_LOADMAT(0, ex01_testMat, rows, ex01_testMat_cols) == matEnd);
+	TEST_CHECK(cap.size == matEnd);
+	for(int i=0; i<matEnd; ++i) TEST_CHECK(cap.instr[i] == ex01_loader.instruction[i]);
+	// MV_CLRREG reg=2 + MV_LOADVEC_ROW, up to the end
+	const int vecStart = findPair(&ex01_loader, matEnd, 0x18C00000, 0x20110000);
+	cap.size = 0;
+	TEST_CHECK(vecStart < ex01_loader.size);
+	TEST_CHECK(img_mv_LOADVEC_ROW(2, ex01_testInp, ex01_testInp_size) == ex01_loader.size - vecStart);
+	TEST_CHECK(cap.size == ex01_loader.size - vecStart);
+	for(int i=0; i<cap.size; ++i) TEST_CHECK(cap.instr[i] == ex01_loader.instruction[vecStart + i]);
+	return 0;
+}
+
+
+// Invalid arguments push nothing
+int test_loadmatErrors() {
+	static img_vecval_t mat[MAT_ELEMENTS + IMAGINE_PEPERBLOCK];
+	const int maxCols = IMAGINE_BLKCOLCNT*IMAGINE_PEPERBLOCK;
+	TEST_CHECK(img_mv_LOADMAT(-1, mat, 1, 1) < 0);
+	TEST_CHECK(img_mv_LOADMAT(1 << 10, mat, 1, 1) < 0);
+	TEST_CHECK(img_mv_LOADMAT(0, mat, IMAGINE_BLKROWCNT+1, 1) < 0);
+	TEST_CHECK(img_mv_LOADMAT(0, mat, 1, maxCols+1) < 0);
+	TEST_CHECK(img_swmInstructionCount() == 0);
+	// an all-zero matrix only clears the register
+	TEST_CHECK(img_mv_LOADMAT(0, mat, IMAGINE_BLKROWCNT, maxCols) == 2);
+	return 0;
+}
+
+
+
+
+// ---- Benchmark
+static
+void discardInstr(uint32_t instr, void *arg) {
+	(void)instr;
+	++*(long *)arg;
+}
+
+
+// Host-side throughput of img_mv_LOADMAT() (bit transpose, broadcast
+// selection and instruction generation) on full-size matrices. The
+// instructions are discarded by the device side.
+int bench_loadmat() {
+	static img_vecval_t mat[MAT_ELEMENTS];
+	const int cols = IMAGINE_BLKCOLCNT*IMAGINE_PEPERBLOCK;
+	const int loadCount = 200;
+	long instCount = 0;
+	img_swmSetInstrHandler(discardInstr, &instCount);
+	srand(12);
+	for(int kind=0; kind<2; ++kind) {
+		for(int i=0; i<MAT_ELEMENTS; ++i) mat[i] = kind ? (img_vecval_t)rand() : (rand() % 8 ? 0 : (img_vecval_t)rand());
+		instCount = 0;
+		const double start = img_testTime();
+		for(int n=0; n<loadCount; ++n) img_mv_LOADMAT(n % 4, mat, IMAGINE_BLKROWCNT, cols);
+		const double elapsed = img_testTime() - start;
+		printf("    %s %dx%d: %6.1f M elements/s, %ld instructions/load\n", kind ? "dense " : "sparse",
+			   IMAGINE_BLKROWCNT, cols, loadCount*(double)MAT_ELEMENTS/elapsed*1e-6, instCount/loadCount);
+	}
+	return 0;
+}
+
+
+#endif  // IMG_REG_TARGET == IMG_BACKEND_SWMODEL
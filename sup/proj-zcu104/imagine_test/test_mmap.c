@@ -0,0 +1,109 @@
+#include "imagine_platform.h"
+
+#if IMG_REG_TARGET == IMG_BACKEND_MMAP
+
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "imagine_driver.h"
+#include "imagine_test.h"
+
+
+// Register offsets and bits (see imagine_driver.c)
+#define REG0_OFFSET      0
+#define REG1_OFFSET      4
+#define REG2_OFFSET      8
+#define REG9_OFFSET      36
+#define REG10_OFFSET     40
+#define REG11_OFFSET     44
+#define REG14_OFFSET     56
+#define REG15_OFFSET     60
+#define BIT_FINP_AUTOWR  (1u << 3)
+#define BIT_FOUT_AUTORD  (1u << 4)
+#define BIT_IMG_EOVINT   (1u << 0)
+
+
+// Reads a register of the fake window through the file, not the mapping
+static
+uint32_t fileReadReg(int regOffset) {
+	uint32_t data = 0;
+	const int fd = open(IMG_UIO_DEVICE, O_RDONLY);
+	if(fd < 0) return 0xDEADBEEF;
+	if(pread(fd, &data, sizeof(data), IMG_REGWIN_OFFSET + regOffset) != sizeof(data)) data = 0xDEADBEEF;
+	close(fd);
+	return data;
+}
+
+
+// Writes a register of the fake window through the file, as the IP would
+static
+void fileWriteReg(int regOffset, uint32_t data) {
+	const int fd = open(IMG_UIO_DEVICE, O_WRONLY);
+	if(fd < 0) return;
+	if(pwrite(fd, &data, sizeof(data), IMG_REGWIN_OFFSET + regOffset) != sizeof(data)) data = 0;
+	close(fd);
+}
+
+
+// Creates the fake register window: zeros, and the magic numbers of the IP
+void img_testMakeRegWindow() {
+	const int fd = open(IMG_UIO_DEVICE, O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if(fd < 0 || ftruncate(fd, IMG_REGWIN_OFFSET + IMG_REGWIN_SIZE) != 0) {
+		printf("    could not create %s\n", IMG_UIO_DEVICE);
+		if(fd >= 0) close(fd);
+		return;
+	}
+	close(fd);
+	fileWriteReg(REG14_OFFSET, 0x47414D49);
+	fileWriteReg(REG15_OFFSET, 0x00656E69);
+}
+
+
+// The register window is mapped once; the accesses of the driver are plain
+// loads/stores that show up in the file, and reads see the file content
+int test_mmapRegWindow() {
+	TEST_CHECK(img_regWindow != NULL);
+	TEST_CHECK(img_openDevice() == 0);		// already open, same mapping
+	volatile uint8_t *window = img_regWindow;
+	TEST_CHECK(img_openDevice() == 0 && img_regWindow == window);
+	TEST_CHECK(img_test() == 0);
+	// FIFO-in is never full in the fake window (reg9 = 0)
+	img_pushInstruction(0x04010002);
+	TEST_CHECK(fileReadReg(REG0_OFFSET) == 0x04010002);
+	TEST_CHECK(fileReadReg(REG1_OFFSET) == 0);		// pulse written and cleared
+	img_setAutoStrobe(true);
+	TEST_CHECK(fileReadReg(REG1_OFFSET) == (BIT_FINP_AUTOWR | BIT_FOUT_AUTORD));
+	img_setAutoStrobe(false);
+	// the burst push trusts the free-slot count of reg11
+	static const uint32_t instr[3] = {0x18C00000, 0x04000001, 0x04020003};
+	fileWriteReg(REG11_OFFSET, 2);
+	TEST_CHECK(img_tryPushInstructions(instr, 3) == 2);
+	TEST_CHECK(fileReadReg(REG0_OFFSET) == instr[1]);
+	return 0;
+}
+
+
+// Without a UIO device the EOV wait polls the status register
+int test_mmapEovPoll() {
+	TEST_CHECK(img_initEOVInterrupt() != 0);	// not a /dev/uio device
+	TEST_CHECK(img_waitEOV(100) == -1);
+	fileWriteReg(REG10_OFFSET, BIT_IMG_EOVINT);
+	TEST_CHECK(img_isEOV());
+	TEST_CHECK(img_waitEOV(100) == 0);
+	img_clearEOV();
+	TEST_CHECK(fileReadReg(REG2_OFFSET) == 0);	// CLREOV pulse written and cleared
+	return 0;
+}
+
+
+// The window is unmapped on close and can be opened again
+int test_mmapReopen() {
+	img_closeDevice();
+	TEST_CHECK(img_regWindow == NULL);
+	TEST_CHECK(img_openDevice() == 0 && img_regWindow != NULL);
+	TEST_CHECK(img_test() == 0);
+	return 0;
+}
+
+
+#endif  // IMG_REG_TARGET == IMG_BACKEND_MMAP
@@ -0,0 +1,146 @@
+#include "imagine_platform.h"
+
+#if IMG_REG_TARGET == IMG_BACKEND_SWMODEL
+
+#include <stdint.h>
+#include "imagine_driver.h"
+#include "imagine_swmodel.h"
+#include "imagine_test.h"
+
+#if IMG_BACKEND == IMG_BACKEND_TRACE
+#include "imagine_trace.h"
+#endif
+
+
+#define REG1_OFFSET      4
+#define BIT_FINP_AUTOWR  (1u << 3)
+#define BIT_FOUT_AUTORD  (1u << 4)
+#define BIT_FOUT_PACK    (1u << 5)
+
+#define INSTR_COUNT  100
+
+
+// Fills an instruction array with distinct WRITE instructions
+static
+void fillInstructions(uint32_t *instr, const int size) {
+	for(int i=0; i<size; ++i) instr[i] = 0x04000000 | ((i % 1024) << 16) | (uint16_t)(i*7 + 1);
+}
+
+
+// Checks that FIFO-in holds exactly the instructions, in order
+static
+int checkFinp(const uint32_t *instr, const int size) {
+	TEST_CHECK(img_swmInstructionCount() == size);
+	for(int i=0; i<size; ++i) {
+		uint32_t word = 0;
+		TEST_CHECK(img_swmPopInstruction(&word) && word == instr[i]);
+	}
+	return 0;
+}
+
+
+// The FIFO modes left in reg1 by an earlier session are reset by
+// img_openDevice() and img_test(), so each instruction is pushed once
+int test_pushStaleFifoCtrl() {
+	uint32_t instr[5];
+	fillInstructions(instr, 5);
+	const uint32_t stale = BIT_FINP_AUTOWR | BIT_FOUT_AUTORD | BIT_FOUT_PACK;
+	img_swmWriteReg(REG1_OFFSET, stale);
+	img_openDevice();
+	TEST_CHECK(img_swmReadReg(REG1_OFFSET) == 0);
+	TEST_CHECK(img_pushInstructions(instr, 5) == 5);
+	if(checkFinp(instr, 5)) return -1;
+	img_swmWriteReg(REG1_OFFSET, stale);
+	TEST_CHECK(img_test() == 0);
+	TEST_CHECK(img_swmReadReg(REG1_OFFSET) == 0);
+	img_pushInstruction(instr[0]);
+	if(checkFinp(instr, 1)) return -1;
+	return 0;
+}
+
+
+// A burst larger than the free space of FIFO-in waits for the device
+// and keeps the order
+static
+void drainOne(uint32_t instr, void *arg) {
+	(void)instr;
+	++*(int *)arg;
+}
+
+int test_pushBurstOrder() {
+	static uint32_t instr[3*IMG_SWM_FIFO_DEPTH];
+	fillInstructions(instr, 3*IMG_SWM_FIFO_DEPTH);
+	for(int autoStrobe=0; autoStrobe<2; ++autoStrobe) {
+		img_setAutoStrobe(autoStrobe);
+		TEST_CHECK(img_pushInstructions(instr, IMG_SWM_FIFO_DEPTH - 3) == IMG_SWM_FIFO_DEPTH - 3);
+		TEST_CHECK(img_tryPushInstructions(instr + IMG_SWM_FIFO_DEPTH - 3, 10) == 3);
+		TEST_CHECK(img_tryPushInstructions(instr, 10) == 0);
+		if(checkFinp(instr, IMG_SWM_FIFO_DEPTH)) return -1;
+		int drained = 0;
+		img_swmSetInstrHandler(drainOne, &drained);
+		TEST_CHECK(img_pushInstructions(instr, 3*IMG_SWM_FIFO_DEPTH) == 3*IMG_SWM_FIFO_DEPTH);
+		TEST_CHECK(drained == 3*IMG_SWM_FIFO_DEPTH);
+		img_swmSetInstrHandler(NULL, NULL);
+	}
+	return 0;
+}
+
+
+#if IMG_BACKEND == IMG_BACKEND_TRACE
+// Counts the recorded accesses of a register
+static
+int countAccesses(const IMAGine_TraceEntry *trace, const int size, const int regNo, const int isWrite) {
+	int count = 0;
+	for(int i=0; i<size; ++i) {
+		if(trace[i].regNo == regNo && trace[i].isWrite == isWrite) ++count;
+	}
+	return count;
+}
+
+
+// A burst checks the FIFO-in space once (reg11), a single push checks
+// the full flag (reg9) for every instruction; auto-strobe saves the pulses
+int test_pushMmioCount() {
+	static IMAGine_TraceEntry trace[8*INSTR_COUNT];
+	uint32_t instr[INSTR_COUNT];
+	fillInstructions(instr, INSTR_COUNT);
+	// burst, pulse-gen mode
+	img_traceRecord(trace, 8*INSTR_COUNT);
+	img_pushInstructions(instr, INSTR_COUNT);
+	int size = img_traceStop();
+	TEST_CHECK(img_traceMismatches() == 0);
+	TEST_CHECK(size == 1 + 3*INSTR_COUNT);
+	TEST_CHECK(countAccesses(trace, size, 11, 0) == 1);
+	TEST_CHECK(countAccesses(trace, size, 0, 1) == INSTR_COUNT);
+	TEST_CHECK(countAccesses(trace, size, 1, 1) == 2*INSTR_COUNT);
+	if(checkFinp(instr, INSTR_COUNT)) return -1;
+	// burst, auto-strobe mode
+	img_setAutoStrobe(true);
+	img_traceRecord(trace, 8*INSTR_COUNT);
+	img_pushInstructions(instr, INSTR_COUNT);
+	size = img_traceStop();
+	TEST_CHECK(size == 1 + INSTR_COUNT);
+	TEST_CHECK(countAccesses(trace, size, 0, 1) == INSTR_COUNT);
+	if(checkFinp(instr, INSTR_COUNT)) return -1;
+	// one instruction at a time, pulse-gen mode
+	img_setAutoStrobe(false);
+	img_traceRecord(trace, 8*INSTR_COUNT);
+	for(int i=0; i<INSTR_COUNT; ++i) img_pushInstruction(instr[i]);
+	size = img_traceStop();
+	TEST_CHECK(size == 4*INSTR_COUNT);
+	TEST_CHECK(countAccesses(trace, size, 9, 0) == INSTR_COUNT);
+	if(checkFinp(instr, INSTR_COUNT)) return -1;
+	// a try-push into an almost full FIFO-in checks the space once
+	static uint32_t fill[IMG_SWM_FIFO_DEPTH];
+	fillInstructions(fill, IMG_SWM_FIFO_DEPTH);
+	img_pushInstructions(fill, IMG_SWM_FIFO_DEPTH - INSTR_COUNT/2);
+	img_traceRecord(trace, 8*INSTR_COUNT);
+	TEST_CHECK(img_tryPushInstructions(instr, INSTR_COUNT) == INSTR_COUNT/2);
+	size = img_traceStop();
+	TEST_CHECK(size == 1 + 3*(INSTR_COUNT/2));
+	return 0;
+}
+#endif
+
+
+#endif  // IMG_REG_TARGET == IMG_BACKEND_SWMODEL
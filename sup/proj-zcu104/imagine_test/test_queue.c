@@ -0,0 +1,267 @@
+#include "imagine_platform.h"
+
+#if IMG_REG_TARGET == IMG_BACKEND_SWMODEL
+
+#include <stdint.h>
+#include "imagine_driver.h"
+#include "imagine_prog.h"
+#include "imagine_util.h"
+#include "imagine_queue.h"
+#include "imagine_swmodel.h"
+#include "imagine_test.h"
+
+#if IMG_BACKEND == IMG_BACKEND_TRACE
+#include "imagine_trace.h"
+#endif
+
+
+#define VV_PARALLEL_EN  0x48000000u		// the mock devices emit a vector on it
+#define IMGROW_SIZE     64				// length of the vector shift register
+#define JOB_COUNT       20
+
+
+// ---- Functional tests
+// Mock device: emits a vector of 4 data on each VV_PARALLEL_EN, the data
+// count the emitted vectors and their elements
+static
+void emitOnParallelEn(uint32_t instr, void *arg) {
+	int *vectorNo = (int *)arg;
+	if(instr != VV_PARALLEL_EN) return;
+	int16_t vector[4];
+	for(int i=0; i<4; ++i) vector[i] = (int16_t)(*vectorNo*4 + i);
+	img_swmEmitVector(vector, 4);
+	++*vectorNo;
+}
+
+
+// Jobs complete in order with their own outputs, the ring wraps around,
+// and the EOV flag is clear once the queue is idle
+int test_queueOrder() {
+	static const uint32_t kernel[3] = {0x18C00000, VV_PARALLEL_EN, 0x40000000};
+	static const IMAGine_Prog prog = {kernel, 3, 8, 64, 64, 16, 8, 16};
+	static img_vecval_t vector[JOB_COUNT][20];
+	static img_vecval_t outBuff[JOB_COUNT][4];
+	img_jobid_t id[JOB_COUNT];
+	int vectorNo = 0;
+	img_swmSetInstrHandler(emitOnParallelEn, &vectorNo);
+	for(int j=0; j<JOB_COUNT; ++j) {
+		for(int i=0; i<20; ++i) vector[j][i] = (img_vecval_t)(j*20 + i);
+		const IMAGine_Job job = {20, vector[j], 20, &prog, outBuff[j], 4};
+		while(img_qSubmit(&job, &id[j]) != 0) img_qProgress();	// ring full
+		TEST_CHECK(img_qPending() <= IMG_QUEUE_LENGTH);
+	}
+	img_qWait(id[JOB_COUNT-1]);
+	TEST_CHECK(img_qPending() == 0);
+	for(int j=0; j<JOB_COUNT; ++j) {
+		TEST_CHECK(img_qIsDone(id[j]));
+		for(int i=0; i<4; ++i) TEST_CHECK(outBuff[j][i] == j*4 + i);
+	}
+	TEST_CHECK(vectorNo == JOB_COUNT);
+	TEST_CHECK(!img_isEOV());
+	// a vector longer than the queue buffer is rejected
+	const IMAGine_Job bigJob = {20, vector[0], IMG_QUEUE_MAXVECTOR+1, &prog, NULL, 0};
+	TEST_CHECK(img_qSubmit(&bigJob, NULL) != 0);
+	return 0;
+}
+
+
+#if IMG_BACKEND == IMG_BACKEND_TRACE
+// Counts the reads of the FIFO-in free-slot register (reg11)
+static
+int countFreeSlotReads(const IMAGine_TraceEntry *trace, const int size) {
+	int count = 0;
+	for(int i=0; i<size; ++i) if(!trace[i].isWrite && trace[i].regNo == 11) ++count;
+	return count;
+}
+
+
+// A stage without instructions (no vector, or no program) is not pushed,
+// so it costs no FIFO-in space check
+int test_queueSkipEmptyStage() {
+	static const uint32_t kernel[2] = {0x18C00000, 0x40000000};
+	static const IMAGine_Prog prog = {kernel, 2, 8, 64, 64, 16, 8, 16};
+	static const img_vecval_t vector[4] = {1, 2, 3, 4};
+	static IMAGine_TraceEntry trace[256];
+	img_jobid_t id;
+	const IMAGine_Job progOnly = {0, NULL, 0, &prog, NULL, 0};
+	img_traceRecord(trace, 256);
+	TEST_CHECK(img_qSubmit(&progOnly, &id) == 0);
+	img_qWait(id);
+	int size = img_traceStop();
+	TEST_CHECK(countFreeSlotReads(trace, size) == 1);
+	const IMAGine_Job vectorOnly = {3, vector, 4, NULL, NULL, 0};
+	img_traceRecord(trace, 256);
+	TEST_CHECK(img_qSubmit(&vectorOnly, &id) == 0);
+	img_qWait(id);
+	size = img_traceStop();
+	TEST_CHECK(countFreeSlotReads(trace, size) == 1);
+	TEST_CHECK(img_swmInstructionCount() > 2);
+	return 0;
+}
+#endif
+
+
+
+
+// ---- Benchmark
+// AK-NOTE: The mock device keeps a modeled time instead of running on its
+// own thread, so the result does not depend on the host. Every register
+// access of the driver costs BUS_NS, and the device executes the
+// instructions in FIFO-in while the modeled time moves forward, one
+// instruction at a time, with a rough cycle cost per instruction class.
+// The CPU work of a step (activations) moves the time forward as well.
+// The costs are estimates for illustration, not measurements of the IP.
+#define BUS_NS       100		// one AXI-Lite register access from the A53
+#define CYCLE_NS     4			// IP clock period
+#define STEP_WORK_NS 20000		// CPU work per step
+#define STEP_COUNT   1000
+#define OUT_SIZE     (4*IMGROW_SIZE)	// ex02_kernel emits 4 vectors
+
+typedef struct {
+	uint64_t now;			// modeled time of the CPU
+	uint64_t devTime;		// the device is busy until this time
+	int      rptCount;		// pending REPEAT of the next instruction
+	uint64_t accesses;		// register accesses
+	int      slowdown;		// multiplies the instruction cycles, models bigger kernels
+} MockDevice;
+
+static MockDevice mock;
+
+
+// Rough no. of cycles an instruction occupies the IP
+static
+int mockCycles(uint32_t instr) {
+	const uint32_t subm = instr >> 30;
+	const uint32_t opcode = (instr >> 26) & 0xF;
+	if(instr == VV_PARALLEL_EN) return IMGROW_SIZE;		// shifts out a vector
+	if(subm != 0) return 2;
+	switch(opcode) {
+	case 9:  return 400;	// MULT, bit-serial over the multiplier bits
+	case 3:  return 40;		// UPDATEPP
+	case 4:  return 60;		// ACCUM
+	case 5:  return 20;		// ALUOP
+	case 7:  return 20;		// MOV
+	default: return 2;
+	}
+}
+
+
+// Runs the device until it catches up with the CPU time
+static
+void mockAdvance() {
+	static const int16_t vector[IMGROW_SIZE] = {0};
+	while(mock.devTime < mock.now) {
+		uint32_t instr;
+		if(!img_swmPopInstruction(&instr)) {
+			mock.devTime = mock.now;	// idle
+			break;
+		}
+		if((instr >> 30) == 3) {		// REPEAT, applies to the next instruction
+			mock.rptCount = (instr >> 22) & 0xFF;
+			continue;
+		}
+		const int count = mock.rptCount ? mock.rptCount : 1;
+		mock.rptCount = 0;
+		mock.devTime += (uint64_t)count * mockCycles(instr) * CYCLE_NS * mock.slowdown;
+		if(instr == VV_PARALLEL_EN) img_swmEmitVector(vector, IMGROW_SIZE);
+	}
+}
+
+
+static
+void mockBusAccess(void *arg) {
+	(void)arg;
+	mock.now += BUS_NS;
+	++mock.accesses;
+	mockAdvance();
+}
+
+
+static
+void mockCpuWork(uint64_t ns) {
+	mock.now += ns;
+	mockAdvance();
+}
+
+
+static
+void mockReset(int slowdown) {
+	img_testResetDevice();
+	mock = (MockDevice){0};
+	mock.slowdown = slowdown;
+	img_swmSetAccessHook(mockBusAccess, NULL);
+	img_setAutoStrobe(true);
+}
+
+
+// Input vector of a step
+static
+const img_vecval_t* stepInput(int step) {
+	static img_vecval_t input[16][20];
+	img_vecval_t *vector = input[step % 16];
+	for(int i=0; i<20; ++i) vector[i] = (img_vecval_t)((step*31 + i*17) % 4096 - 2048);
+	return vector;
+}
+
+
+// Steps of the ex02 kernel, one after the other (same as runLSTMCell())
+static
+double benchSerial(int slowdown) {
+	extern IMAGine_Prog ex02_kernel;
+	static img_vecval_t outBuff[OUT_SIZE];
+	mockReset(slowdown);
+	for(int step=0; step<STEP_COUNT; ++step) {
+		img_mv_LOADVEC_ROW(20, stepInput(step), 20);
+		img_clearEOV();
+		img_pushProgram(&ex02_kernel);
+		for(int got=0; got<OUT_SIZE; ) got += img_popDataBurst(outBuff + got, OUT_SIZE - got);
+		mockCpuWork(STEP_WORK_NS);
+	}
+	return mock.now * 1e-9;
+}
+
+
+// Same steps through the submission queue, the next depth-1 steps are
+// queued while the CPU works on a step
+static
+double benchQueued(int depth, int slowdown) {
+	extern IMAGine_Prog ex02_kernel;
+	static img_vecval_t outBuff[IMG_QUEUE_LENGTH][OUT_SIZE];
+	img_jobid_t id[IMG_QUEUE_LENGTH];
+	mockReset(slowdown);
+	for(int step=0; step<STEP_COUNT + depth-1; ++step) {
+		if(step < STEP_COUNT) {
+			const int slot = step % IMG_QUEUE_LENGTH;
+			const IMAGine_Job job = {20, stepInput(step), 20, &ex02_kernel, outBuff[slot], OUT_SIZE};
+			while(img_qSubmit(&job, &id[slot]) != 0) img_qProgress();
+		}
+		const int done = step - (depth-1);
+		if(done < 0) continue;
+		img_qWait(id[done % IMG_QUEUE_LENGTH]);
+		mockCpuWork(STEP_WORK_NS);
+	}
+	return mock.now * 1e-9;
+}
+
+
+// End-to-end step throughput of the ex02 kernel with and without the queue.
+// The device is slowed down to model kernels that keep it busy longer
+// than the CPU spends on the registers of a step.
+int bench_queue() {
+	printf("    mock device: %d ns/access, %d ns/cycle, %d ns CPU work/step\n", BUS_NS, CYCLE_NS, STEP_WORK_NS);
+	for(int slowdown=1; slowdown<=16; slowdown*=4) {
+		const double serialTime = benchSerial(slowdown);
+		printf("    device slowdown %2dx\n", slowdown);
+		printf("      serial       : %7.0f steps/s (modeled), %d accesses/step\n",
+			   STEP_COUNT/serialTime, (int)(mock.accesses/STEP_COUNT));
+		for(int depth=1; depth<=4; depth*=2) {
+			const double queuedTime = benchQueued(depth, slowdown);
+			printf("      queue depth %d: %7.0f steps/s (modeled), %d accesses/step, %.2fx\n", depth,
+				   STEP_COUNT/queuedTime, (int)(mock.accesses/STEP_COUNT), serialTime/queuedTime);
+		}
+	}
+	return 0;
+}
+
+
+#endif  // IMG_REG_TARGET == IMG_BACKEND_SWMODEL
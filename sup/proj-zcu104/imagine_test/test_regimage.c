@@ -0,0 +1,155 @@
+#include "imagine_platform.h"
+
+#if IMG_REG_TARGET == IMG_BACKEND_SWMODEL
+
+#include <stdint.h>
+#include <stdlib.h>
+#include "imagine_driver.h"
+#include "imagine_util.h"
+#include "imagine_swmodel.h"
+#include "imagine_test.h"
+
+
+#define REG_XT       20		// input register of ex02_kernel
+#define XT_SIZE      20
+#define HP_SIZE      16
+#define VECTOR_SIZE  (IMAGINE_BLKCOLCNT*IMAGINE_PEPERBLOCK)
+
+
+// Instruction handler counting the instructions and executing them on the
+// array model
+static
+void countAndExec(uint32_t instr, void *arg) {
+	++*(long *)arg;
+	img_testArrayExec(instr, NULL);
+}
+
+
+// Reloading a register only writes the rows that changed: no clear, no
+// instruction at all for the same vector, and the array holds the new
+// vector after every load
+int test_regimageDelta() {
+	extern int16_t ex02_seqXt[];	// defined in ex02_testvec.c
+	extern int ex02_seqSteps;
+	long instCount = 0;
+	img_testArrayReset(true);
+	img_swmSetInstrHandler(countAndExec, &instCount);
+	TEST_CHECK(img_mv_LOADVEC_ROW(REG_XT, ex02_seqXt, XT_SIZE) > 2);
+	for(int t=1; t<ex02_seqSteps; ++t) {
+		const int16_t *prev = &ex02_seqXt[(t-1)*XT_SIZE];
+		const int16_t *next = &ex02_seqXt[t*XT_SIZE];
+		int changedRows = 0;	// upper bound: bits that differ, a row can hold several
+		for(int i=0; i<XT_SIZE; ++i) changedRows += __builtin_popcount((uint16_t)(prev[i] ^ next[i]));
+		instCount = 0;
+		const int n = img_mv_LOADVEC_ROW(REG_XT, next, XT_SIZE);
+		TEST_CHECK(n == instCount);
+		TEST_CHECK(n <= changedRows + IMAGINE_BLKCOLCNT);	// + one select per block column
+		TEST_CHECK(img_testArrayCompare(REG_XT, next, 1, XT_SIZE, true) == 0);
+		TEST_CHECK(img_mv_LOADVEC_ROW(REG_XT, next, XT_SIZE) == 0);
+	}
+	// a shorter vector clears the tail
+	static const int16_t shortVec[3] = {1, -1, 5};
+	TEST_CHECK(img_mv_LOADVEC_ROW(REG_XT, shortVec, 3) > 0);
+	TEST_CHECK(img_testArrayCompare(REG_XT, shortVec, 1, 3, true) == 0);
+	TEST_CHECK(img_testArrayErrors() == 0);
+	return 0;
+}
+
+
+// The image of a register is dropped when a pushed program may write the
+// register; programs that do not touch it keep the image
+int test_regimageInvalidate() {
+	static const int16_t vector[4] = {3, 1, 4, 1};
+	static const int16_t other[4]  = {2, 7, 1, 8};
+	static const uint32_t noWrite[3] = {0x18C00000, 0x48000000, 0x40000000};	// select, vv
+	const uint32_t baseHi = (REG_XT*IMAGINE_PEREGWIDTH + 3) << 16;
+	const uint32_t writeRow[2] = {0x18C00000, 0x04000000 | baseHi | 0x1234};				// WRITE
+	const uint32_t repeatRow[3] = {0x18C00000, 0xC0A00001, 0x04000000 | baseHi | 0x1234};	// REPEAT x2 WRITE
+	const uint32_t wrunRow[3] = {0x18C00000, 0xC0010000 | (baseHi << 4) | 0x3, 0x00050006};	// WRUN
+	const uint32_t fillReg[2] = {0x18C00000, 0x20010000 | (REG_XT << 19) | 0x00FF};		// FILLREG
+	const uint32_t *writers[4] = {writeRow, repeatRow, wrunRow, fillReg};
+	const int writerSize[4] = {2, 3, 3, 2};
+	long instCount = 0;
+	img_testArrayReset(true);
+	img_swmSetInstrHandler(countAndExec, &instCount);
+	img_mv_LOADVEC_ROW(REG_XT, vector, 4);
+	const IMAGine_Prog keep = {noWrite, 3, 8, 64, 64, 16, 8, 16};
+	img_pushProgram(&keep);
+	TEST_CHECK(img_mv_LOADVEC_ROW(REG_XT, vector, 4) == 0);		// image kept
+	for(int w=0; w<4; ++w) {
+		const IMAGine_Prog prog = {writers[w], writerSize[w], 8, 64, 64, 16, 8, 16};
+		img_pushProgram(&prog);
+		TEST_CHECK(img_testArrayCompare(REG_XT, vector, 1, 4, true) != 0);	// the program changed it
+		TEST_CHECK(img_mv_LOADVEC_ROW(REG_XT, other, 4) > 0);
+		TEST_CHECK(img_testArrayCompare(REG_XT, other, 1, 4, true) == 0);
+		TEST_CHECK(img_mv_LOADVEC_ROW(REG_XT, vector, 4) > 0);
+		TEST_CHECK(img_testArrayCompare(REG_XT, vector, 1, 4, true) == 0);
+	}
+	// an explicit invalidation (e.g. after an IP reset) forces a clear
+	img_invalidateRegImage(REG_XT);
+	instCount = 0;
+	TEST_CHECK(img_mv_LOADVEC_ROW(REG_XT, vector, 4) > 2);
+	TEST_CHECK(img_testArrayCompare(REG_XT, vector, 1, 4, true) == 0);
+	TEST_CHECK(img_testArrayErrors() == 0);
+	return 0;
+}
+
+
+
+
+// ---- Benchmark
+static
+void countInstr(uint32_t instr, void *arg) {
+	(void)instr;
+	++*(long *)arg;
+}
+
+
+// Instructions pushed to load a sequence of vectors, one per step, with
+// the register images (delta) or with a clear before each load
+static
+long loadSequence(const int16_t *seq, const int steps, const int size, const bool delta) {
+	long instCount = 0;
+	img_swmSetInstrHandler(countInstr, &instCount);
+	img_invalidateRegImage(IMG_ALLREGS);
+	for(int t=0; t<steps; ++t) {
+		if(!delta) img_invalidateRegImage(REG_XT);
+		img_mv_LOADVEC_ROW(REG_XT, &seq[t*size], size);
+	}
+	return instCount;
+}
+
+
+// Per-step instruction traffic of the vector reloads on the recorded
+// ex02 sequences (ex02_testvec.py) and on a slow random walk
+int bench_regimage() {
+	extern int16_t ex02_seqXt[];	// defined in ex02_testvec.c
+	extern int16_t ex02_seqHt[];
+	extern int ex02_seqSteps;
+	static int16_t walk[256*VECTOR_SIZE];
+	srand(13);
+	for(int i=0; i<VECTOR_SIZE; ++i) walk[i] = (int16_t)(rand() % 1024 - 512);
+	for(int t=1; t<256; ++t) {
+		for(int i=0; i<VECTOR_SIZE; ++i) walk[t*VECTOR_SIZE + i] = walk[(t-1)*VECTOR_SIZE + i] + rand() % 5 - 2;
+	}
+	const struct {
+		const char    *name;
+		const int16_t *seq;
+		int            steps;
+		int            size;
+	} seqs[3] = {
+		{"ex02 Xt (sensor)", ex02_seqXt, ex02_seqSteps, XT_SIZE},
+		{"ex02 Hp (state) ", ex02_seqHt, ex02_seqSteps, HP_SIZE},
+		{"random walk     ", walk, 256, VECTOR_SIZE},
+	};
+	for(int s=0; s<3; ++s) {
+		const long full  = loadSequence(seqs[s].seq, seqs[s].steps, seqs[s].size, false);
+		const long delta = loadSequence(seqs[s].seq, seqs[s].steps, seqs[s].size, true);
+		printf("    %s x%d: %6.1f instructions/step cleared, %6.1f delta, %.2fx\n", seqs[s].name, seqs[s].size,
+			   (double)full/seqs[s].steps, (double)delta/seqs[s].steps, (double)full/delta);
+	}
+	return 0;
+}
+
+
+#endif  // IMG_REG_TARGET == IMG_BACKEND_SWMODEL
@@ -0,0 +1,135 @@
+#include "imagine_platform.h"
+
+#if IMG_REG_TARGET == IMG_BACKEND_SWMODEL
+
+#include <stdint.h>
+#include "imagine_driver.h"
+#include "imagine_swmodel.h"
+#include "imagine_test.h"
+
+#if IMG_BACKEND == IMG_BACKEND_TRACE
+#include "imagine_trace.h"
+#endif
+
+
+// Register offsets and bits used to play the device side (see imagine_swmodel.c)
+#define REG1_OFFSET    4
+#define REG11_OFFSET   44
+#define REG12_OFFSET   48
+#define REG13_OFFSET   52
+#define BIT_FIFO_RST   (1u << 0)
+#define BIT_FOUT_PACK  (1u << 5)
+
+
+// The magic numbers and the FIFO levels of an idle device
+int test_swmRegisterMap() {
+	TEST_CHECK(img_test() == 0);
+	TEST_CHECK(img_swmReadReg(REG13_OFFSET) == IMG_SWM_FIFO_DEPTH);
+	TEST_CHECK(img_swmReadReg(REG11_OFFSET) == IMG_SWM_FIFO_DEPTH);
+	TEST_CHECK(img_swmReadReg(REG12_OFFSET) == 0);
+	TEST_CHECK(!img_isEOV());
+	return 0;
+}
+
+
+// Instructions and data go through the FIFOs in order, in pulse-gen
+// and auto-strobe modes, and the last datum of a vector sets EOV
+int test_swmPushPop() {
+	static const uint32_t instr[5] = {0x18C00000, 0x04000001, 0x04010002, 0x04020003, 0x18000001};
+	static const int16_t  vector[5] = {1, -2, 3, -4, 5};
+	for(int autoStrobe=0; autoStrobe<2; ++autoStrobe) {
+		img_setAutoStrobe(autoStrobe);
+		img_pushInstruction(instr[0]);
+		TEST_CHECK(img_pushInstructions(instr+1, 3) == 3);
+		TEST_CHECK(img_tryPushInstructions(instr+4, 1) == 1);
+		TEST_CHECK(img_swmInstructionCount() == 5);
+		for(int i=0; i<5; ++i) {
+			uint32_t word = 0;
+			TEST_CHECK(img_swmPopInstruction(&word) && word == instr[i]);
+		}
+		TEST_CHECK(!img_swmPopInstruction(NULL));
+		TEST_CHECK(img_swmEmitVector(vector, 5) == 5);
+		TEST_CHECK(img_isEOV());
+		img_clearEOV();
+		TEST_CHECK(!img_isEOV());
+		const IMAGine_Dout first = img_popData();
+		TEST_CHECK(first.status == IMAGINE_DOUT_VALID && first.data == vector[0]);
+		img_vecval_t buff[8];
+		TEST_CHECK(img_popDataBurst(buff, 8) == 4);
+		for(int i=0; i<4; ++i) TEST_CHECK(buff[i] == vector[i+1]);
+		TEST_CHECK(img_popData().status == IMAGINE_DOUT_INVALID);
+	}
+	// packed mode, odd-length vector
+	img_setAutoStrobe(false);
+	img_setPackedOutput(true);
+	TEST_CHECK(img_swmEmitVector(vector, 5) == 5);
+	TEST_CHECK(img_swmReadReg(REG12_OFFSET) == 3);
+	img_vecval_t buff[5];
+	TEST_CHECK(img_popDataBurstPacked(buff, 5) == 5);
+	for(int i=0; i<5; ++i) TEST_CHECK(buff[i] == vector[i]);
+	return 0;
+}
+
+
+// FIFO_RST empties FIFO-in only, like the IP (fifoout_srst is tied to 0):
+// the FIFO-out words and a half-packed datum survive it
+int test_swmFifoReset() {
+	static const uint32_t instr[3] = {0x18C00000, 0x04000001, 0x04010002};
+	static const int16_t  vector[3] = {7, 8, 9};
+	img_pushInstructions(instr, 3);
+	img_setPackedOutput(true);
+	TEST_CHECK(img_swmEmitVector(vector, 2) == 2);
+	TEST_CHECK(img_swmEmitData(vector[2], false));	// held for packing
+	const uint32_t ctrl = img_swmReadReg(REG1_OFFSET);
+	img_swmWriteReg(REG1_OFFSET, ctrl | BIT_FIFO_RST);
+	img_swmWriteReg(REG1_OFFSET, ctrl);
+	TEST_CHECK(img_swmInstructionCount() == 0);
+	TEST_CHECK(img_swmReadReg(REG11_OFFSET) == IMG_SWM_FIFO_DEPTH);
+	TEST_CHECK(img_swmReadReg(REG12_OFFSET) == 1);
+	// the held datum is paired with the next one
+	TEST_CHECK(img_swmReadReg(REG1_OFFSET) & BIT_FOUT_PACK);
+	TEST_CHECK(img_swmEmitData(vector[0], true));
+	TEST_CHECK(img_swmReadReg(REG12_OFFSET) == 2);
+	img_vecval_t buff[4];
+	TEST_CHECK(img_popDataBurstPacked(buff, 4) == 4);
+	TEST_CHECK(buff[0] == vector[0] && buff[1] == vector[1]);
+	TEST_CHECK(buff[2] == vector[2] && buff[3] == vector[0]);
+	TEST_CHECK(img_swmReadReg(REG12_OFFSET) == 0);
+	return 0;
+}
+
+
+#if IMG_BACKEND == IMG_BACKEND_TRACE
+// A recorded session replays without touching the device, and a
+// session that issues different accesses is caught
+int test_traceReplay() {
+	static const uint32_t instr[4] = {0x18C00000, 0x04000001, 0x04010002, 0x04020003};
+	static IMAGine_TraceEntry trace[256];
+	img_traceRecord(trace, 256);
+	img_pushInstructions(instr, 4);
+	img_swmEmitData(42, true);
+	const IMAGine_Dout dout = img_popData();
+	const int size = img_traceStop();
+	TEST_CHECK(img_traceMismatches() == 0 && size > 0);
+	TEST_CHECK(dout.status == IMAGINE_DOUT_VALID && dout.data == 42);
+	// replay: the device sees nothing, the output comes from the trace
+	img_swmReset();
+	img_traceReplay(trace, size);
+	img_pushInstructions(instr, 4);
+	const IMAGine_Dout replayed = img_popData();
+	TEST_CHECK(img_traceStop() == size && img_traceMismatches() == 0);
+	TEST_CHECK(replayed.status == IMAGINE_DOUT_VALID && replayed.data == 42);
+	TEST_CHECK(img_swmInstructionCount() == 0);
+	// a different instruction stream does not match
+	img_traceReplay(trace, size);
+	img_pushInstructions(instr+1, 3);
+	img_pushInstruction(instr[0]);
+	img_popData();
+	img_traceStop();
+	TEST_CHECK(img_traceMismatches() > 0);
+	return 0;
+}
+#endif
+
+
+#endif  // IMG_REG_TARGET == IMG_BACKEND_SWMODEL
@@ -0,0 +1,89 @@
+#include "imagine_platform.h"
+
+#if IMG_REG_TARGET == IMG_BACKEND_SWMODEL
+
+#include <stdint.h>
+#include <stdlib.h>
+#include "imagine_driver.h"
+#include "imagine_test.h"
+
+
+// Kernel name of this build, see the simd-* builds of the Makefile
+#ifndef IMG_TEST_SIMD
+#define IMG_TEST_SIMD  "target default"
+#endif
+
+#define BLOCK_COUNT  4096
+
+static volatile int benchSink;	// keeps the calls of the benchmark
+
+
+// Reference transpose: bit b of peArr[p] goes to bit p of outArr[b]
+static
+int transposeRef(img_bramrow_t *outArr, const img_vecval_t *peArr, const int size) {
+	int nzCount = 0;
+	for(int b=0; b<IMAGINE_PEREGWIDTH; ++b) {
+		img_bramrow_t row = 0;
+		for(int p=0; p<size; ++p) row |= (img_bramrow_t)(((uint16_t)peArr[p] >> b) & 1) << p;
+		outArr[b] = row;
+		if(row) ++nzCount;
+	}
+	return nzCount;
+}
+
+
+// Fills a block with values of a random class: full range, sparse,
+// single bits, or the extreme values
+static
+void randomBlock(img_vecval_t *peArr) {
+	const int kind = rand() % 4;
+	for(int p=0; p<IMAGINE_PEPERBLOCK; ++p) {
+		switch(kind) {
+		case 0:  peArr[p] = (img_vecval_t)rand(); break;
+		case 1:  peArr[p] = rand() % 4 ? 0 : (img_vecval_t)rand(); break;
+		case 2:  peArr[p] = (img_vecval_t)(1u << (rand() % 16)); break;
+		default: peArr[p] = rand() % 2 ? INT16_MIN : -1; break;
+		}
+	}
+}
+
+
+// The transpose kernel of this build matches the reference bit-exact on
+// random blocks, full and partial; the PEs past the size are ignored
+int test_transposeBitExact() {
+	img_vecval_t peArr[IMAGINE_PEPERBLOCK];
+	img_bramrow_t out[IMAGINE_PEREGWIDTH], ref[IMAGINE_PEREGWIDTH];
+	srand(10);
+	for(int t=0; t<100000; ++t) {
+		randomBlock(peArr);
+		const int size = t % 2 ? IMAGINE_PEPERBLOCK : rand() % (IMAGINE_PEPERBLOCK+1);
+		const int nzCount = img_makePe2BramBlock(out, peArr, size);
+		TEST_CHECK(nzCount == transposeRef(ref, peArr, size));
+		for(int b=0; b<IMAGINE_PEREGWIDTH; ++b) TEST_CHECK(out[b] == ref[b]);
+	}
+	TEST_CHECK(img_makePe2BramBlock(out, peArr, IMAGINE_PEPERBLOCK+1) < 0);
+	return 0;
+}
+
+
+
+
+// ---- Benchmark
+// Host throughput of img_makePe2BramBlock() on full blocks
+int bench_transpose() {
+	static img_vecval_t blocks[BLOCK_COUNT][IMAGINE_PEPERBLOCK];
+	static img_bramrow_t out[IMAGINE_PEREGWIDTH];
+	srand(10);
+	for(int i=0; i<BLOCK_COUNT; ++i) randomBlock(blocks[i]);
+	const int rounds = 200;
+	const double start = img_testTime();
+	for(int n=0; n<rounds; ++n) {
+		for(int i=0; i<BLOCK_COUNT; ++i) benchSink = img_makePe2BramBlock(out, blocks[i], IMAGINE_PEPERBLOCK);
+	}
+	const double elapsed = img_testTime() - start;
+	printf("    kernel %-14s: %7.1f M blocks/s\n", IMG_TEST_SIMD, rounds*(double)BLOCK_COUNT/elapsed*1e-6);
+	return 0;
+}
+
+
+#endif  // IMG_REG_TARGET == IMG_BACKEND_SWMODEL
@@ -0,0 +1,159 @@
+#include "imagine_platform.h"
+
+#if IMG_REG_TARGET == IMG_BACKEND_SWMODEL
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "imagine_driver.h"
+#include "imagine_util.h"
+#include "imagine_swmodel.h"
+#include "imagine_test.h"
+
+
+#define REG_COUNT    8		// registers used by the tests
+#define PE_COLS      (IMAGINE_BLKCOLCNT*IMAGINE_PEPERBLOCK)
+#define SELECT_ALL   0x18C00000u
+#define FILLREG(reg) (0x20010000u | ((uint32_t)(reg) << 19))
+
+
+// Instruction handler counting the FILLREG instructions (register clears)
+// and executing all of them on the array model
+typedef struct {
+	long instCount;
+	long clearCount;
+} Counts;
+
+static
+void countClears(uint32_t instr, void *arg) {
+	Counts *counts = (Counts *)arg;
+	++counts->instCount;
+	if((instr & 0xFC070000u) == FILLREG(0)) ++counts->clearCount;
+	img_testArrayExec(instr, NULL);
+}
+
+
+// Clears are only pushed when a register may hold something
+int test_zeroregElision() {
+	static const int16_t vector[5] = {9, 0, -3, 0, 1};
+	static const int16_t zeros[PE_COLS] = {0};
+	Counts counts = {0, 0};
+	img_testArrayReset(false);		// power-on: BRAMs are 0
+	img_markRegsZero();
+	img_swmSetInstrHandler(countClears, &counts);
+	TEST_CHECK(img_mv_CLRREG(3) == 0);
+	TEST_CHECK(img_mv_LOADVEC_ROW(3, vector, 5) > 0);
+	TEST_CHECK(counts.clearCount == 0);
+	TEST_CHECK(img_testArrayCompare(3, vector, 1, 5, true) == 0);
+	// a loaded register is cleared once
+	TEST_CHECK(img_mv_CLRREG(3) == 2);
+	TEST_CHECK(img_mv_CLRREG(3) == 0);
+	TEST_CHECK(counts.clearCount == 1);
+	TEST_CHECK(img_testArrayCompare(3, zeros, 1, PE_COLS, true) == 0);
+	// an all-zero vector into a zero register pushes nothing
+	TEST_CHECK(img_mv_LOADVEC_ROW(3, zeros, PE_COLS) == 0);
+	// a program that may write the register makes it unknown again
+	const uint32_t fill[2] = {SELECT_ALL, FILLREG(3) | 0x0001};
+	const IMAGine_Prog prog = {fill, 2, 8, 64, 64, 16, 8, 16};
+	img_pushProgram(&prog);
+	counts.clearCount = 0;
+	TEST_CHECK(img_mv_LOADVEC_ROW(3, vector, 5) > 2);
+	TEST_CHECK(counts.clearCount == 1);
+	TEST_CHECK(img_testArrayCompare(3, vector, 1, 5, true) == 0);
+	// all registers start as unknown
+	img_invalidateRegImage(IMG_ALLREGS);
+	TEST_CHECK(img_mv_CLRREG(4) == 2);
+	TEST_CHECK(img_testArrayErrors() == 0);
+	return 0;
+}
+
+
+// Expected register contents of the random operations, one value per PE
+static int16_t expected[REG_COUNT][IMAGINE_BLKROWCNT][PE_COLS];
+
+// Applies a WRITE of a register row to all blocks on the expected contents
+static
+void expectRowWrite(int reg, int bitNo, uint16_t data) {
+	for(int r=0; r<IMAGINE_BLKROWCNT; ++r) {
+		for(int j=0; j<PE_COLS; ++j) {
+			const uint16_t bit = (data >> (j % IMAGINE_PEPERBLOCK)) & 1;
+			expected[reg][r][j] = (int16_t)((expected[reg][r][j] & ~(1u << bitNo)) | (bit << bitNo));
+		}
+	}
+}
+
+
+// Runs a random sequence of loads, clears and user programs from the
+// power-on state, with or without the register tracking (all registers
+// invalidated before each operation). The array must match the expected
+// contents after each operation.
+// @return  No. of FILLREG instructions pushed, -ve on a mismatch.
+static
+long runRandomOps(const bool tracking) {
+	static img_vecval_t mat[IMAGINE_BLKROWCNT*PE_COLS];
+	Counts counts = {0, 0};
+	memset(expected, 0, sizeof(expected));
+	img_testArrayReset(false);
+	img_markRegsZero();
+	img_swmSetInstrHandler(countClears, &counts);
+	srand(14);
+	for(int op=0; op<400; ++op) {
+		const int reg = rand() % REG_COUNT;
+		if(!tracking) img_invalidateRegImage(IMG_ALLREGS);
+		switch(rand() % 5) {
+		case 0:
+		case 1: {	// row vector, often sparse or repeated
+			const int size = rand() % (PE_COLS+1);
+			const int sparse = rand() % 2;
+			for(int i=0; i<size; ++i) mat[i] = sparse && rand() % 4 ? 0 : (img_vecval_t)(rand() % 64 - 32);
+			if(img_mv_LOADVEC_ROW(reg, mat, size) < 0) return -1;
+			for(int r=0; r<IMAGINE_BLKROWCNT; ++r)
+				for(int j=0; j<PE_COLS; ++j) expected[reg][r][j] = j < size ? mat[j] : 0;
+			break;
+		}
+		case 2: {	// matrix
+			const int rows = rand() % (IMAGINE_BLKROWCNT+1);
+			const int cols = rand() % (PE_COLS+1);
+			for(int i=0; i<rows*cols; ++i) mat[i] = rand() % 3 ? 0 : (img_vecval_t)rand();
+			if(img_mv_LOADMAT(reg, mat, rows, cols) < 0) return -1;
+			for(int r=0; r<IMAGINE_BLKROWCNT; ++r)
+				for(int j=0; j<PE_COLS; ++j) expected[reg][r][j] = (r < rows && j < cols) ? mat[r*cols + j] : 0;
+			break;
+		}
+		case 3:		// clear
+			if(img_mv_CLRREG(reg) < 0) return -1;
+			memset(expected[reg], 0, sizeof(expected[reg]));
+			break;
+		default: {	// user program writing one row of the register in all blocks
+			const int bitNo = rand() % IMAGINE_PEREGWIDTH;
+			const uint16_t data = rand() % 2 ? 0 : (uint16_t)rand();
+			const uint32_t instr[2] = {SELECT_ALL, 0x04000000u | ((reg*IMAGINE_PEREGWIDTH + bitNo) << 16) | data};
+			const IMAGine_Prog prog = {instr, 2, 8, 64, 64, 16, 8, 16};
+			img_pushProgram(&prog);
+			expectRowWrite(reg, bitNo, data);
+			break;
+		}
+		}
+		for(int r=0; r<REG_COUNT; ++r) {
+			if(img_testArrayCompare(r, &expected[r][0][0], IMAGINE_BLKROWCNT, PE_COLS, false) != 0) {
+				printf("    op %d: register %d mismatch\n", op, r);
+				return -1;
+			}
+		}
+	}
+	if(img_testArrayErrors() != 0) return -1;
+	return counts.clearCount;
+}
+
+
+// The tracking changes the instruction traffic, not the array contents
+int test_zeroregRandomOps() {
+	const long trackedClears = runRandomOps(true);
+	const long plainClears = runRandomOps(false);
+	TEST_CHECK(trackedClears >= 0 && plainClears >= 0);
+	TEST_CHECK(trackedClears < plainClears);
+	return 0;
+}
+
+
+#endif  // IMG_REG_TARGET == IMG_BACKEND_SWMODEL